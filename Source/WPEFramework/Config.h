@@ -253,6 +253,97 @@ namespace PluginHost {
                 Core::JSON::Boolean OutputEnabled;
             };
 
+            class CompressionConfig : public Core::JSON::Container {
+            public:
+                CompressionConfig()
+                    : Core::JSON::Container()
+                    , Level(0)
+                    , Threshold(1024)
+                    , WindowBits(15)
+                    , ContextTakeover(true)
+                {
+                    Add(_T("level"), &Level);
+                    Add(_T("threshold"), &Threshold);
+                    Add(_T("windowbits"), &WindowBits);
+                    Add(_T("contexttakeover"), &ContextTakeover);
+                }
+                CompressionConfig(const CompressionConfig& copy)
+                    : Core::JSON::Container()
+                    , Level(copy.Level)
+                    , Threshold(copy.Threshold)
+                    , WindowBits(copy.WindowBits)
+                    , ContextTakeover(copy.ContextTakeover)
+                {
+                    Add(_T("level"), &Level);
+                    Add(_T("threshold"), &Threshold);
+                    Add(_T("windowbits"), &WindowBits);
+                    Add(_T("contexttakeover"), &ContextTakeover);
+                }
+                ~CompressionConfig() override = default;
+
+                CompressionConfig& operator=(const CompressionConfig& RHS)
+                {
+                    Level = RHS.Level;
+                    Threshold = RHS.Threshold;
+                    WindowBits = RHS.WindowBits;
+                    ContextTakeover = RHS.ContextTakeover;
+                    return (*this);
+                }
+
+                Core::JSON::DecUInt8 Level;
+                Core::JSON::DecUInt32 Threshold;
+                // WebSocket (permessage-deflate) only
+                Core::JSON::DecUInt8 WindowBits;
+                Core::JSON::Boolean ContextTakeover;
+            };
+
+            // Limits on the work the connections hand to the worker pool, 0 means no limit.
+            class AdmissionConfig : public Core::JSON::Container {
+            public:
+                AdmissionConfig()
+                    : Core::JSON::Container()
+                    , InFlight(0)
+                    , Pending(0)
+                    , Rate(0)
+                    , Burst(0)
+                {
+                    Add(_T("inflight"), &InFlight);
+                    Add(_T("pending"), &Pending);
+                    Add(_T("rate"), &Rate);
+                    Add(_T("burst"), &Burst);
+                }
+                AdmissionConfig(const AdmissionConfig& copy)
+                    : Core::JSON::Container()
+                    , InFlight(copy.InFlight)
+                    , Pending(copy.Pending)
+                    , Rate(copy.Rate)
+                    , Burst(copy.Burst)
+                {
+                    Add(_T("inflight"), &InFlight);
+                    Add(_T("pending"), &Pending);
+                    Add(_T("rate"), &Rate);
+                    Add(_T("burst"), &Burst);
+                }
+                ~AdmissionConfig() override = default;
+
+                AdmissionConfig& operator=(const AdmissionConfig& RHS)
+                {
+                    InFlight = RHS.InFlight;
+                    Pending = RHS.Pending;
+                    Rate = RHS.Rate;
+                    Burst = RHS.Burst;
+                    return (*this);
+                }
+
+                // Requests of a single connection, handed to the pool and not yet handled.
+                Core::JSON::DecUInt16 InFlight;
+                // Requests of all connections together, handed to the pool and not yet handled.
+                Core::JSON::DecUInt32 Pending;
+                // Requests per second, and how many at once, from a single remote address.
+                Core::JSON::DecUInt32 Rate;
+                Core::JSON::DecUInt32 Burst;
+            };
+
 #ifdef PROCESSCONTAINERS_ENABLED
 
             class ProcessContainerConfig : public Core::JSON::Container {
@@ -311,6 +402,10 @@ namespace PluginHost {
                 , Redirect(_T("http://127.0.0.1/Service/Controller/UI"))
                 , Signature(_T("TestSecretKey"))
                 , IdleTime(0)
+                , BatchSize(32)
+                , Acceptors(1)
+                , Compression()
+                , Admission()
                 , IPV6(false)
                 , DefaultTraceCategories(false)
                 , DefaultWarningReportingCategories(false)
@@ -342,6 +437,10 @@ namespace PluginHost {
                 Add(_T("communicator"), &Communicator);
                 Add(_T("signature"), &Signature);
                 Add(_T("idletime"), &IdleTime);
+                Add(_T("batchsize"), &BatchSize);
+                Add(_T("acceptors"), &Acceptors);
+                Add(_T("compression"), &Compression);
+                Add(_T("admission"), &Admission);
                 Add(_T("ipv6"), &IPV6);
                 Add(_T("tracing"), &DefaultTraceCategories); 
                 Add(_T("warningreporting"), &DefaultWarningReportingCategories); 
@@ -379,6 +478,10 @@ namespace PluginHost {
             Core::JSON::String Redirect;
             Core::JSON::String Signature;
             Core::JSON::DecUInt16 IdleTime;
+            Core::JSON::DecUInt16 BatchSize;
+            Core::JSON::DecUInt8 Acceptors;
+            CompressionConfig Compression;
+            AdmissionConfig Admission;
             Core::JSON::Boolean IPV6;
             Core::JSON::String DefaultTraceCategories;
             Core::JSON::String DefaultWarningReportingCategories; 
@@ -536,6 +639,17 @@ namespace PluginHost {
                 _redirect = config.Redirect.Value();
                 _version = config.Version.Value();
                 _idleTime = config.IdleTime.Value();
+                _batchSize = config.BatchSize.Value();
+                _acceptors = (config.Acceptors.Value() == 0 ? 1 : config.Acceptors.Value());
+                _compressionLevel = (config.Compression.Level.Value() > 9 ? 9 : config.Compression.Level.Value());
+                _compressionThreshold = config.Compression.Threshold.Value();
+                _compressionWindowBits = (config.Compression.WindowBits.Value() < 9 ? 9 : (config.Compression.WindowBits.Value() > 15 ? 15 : config.Compression.WindowBits.Value()));
+                _compressionContextTakeover = config.Compression.ContextTakeover.Value();
+                _admissionInFlight = config.Admission.InFlight.Value();
+                _admissionPending = config.Admission.Pending.Value();
+                _admissionRate = config.Admission.Rate.Value();
+                // Without a burst, a second worth of requests may come at once.
+                _admissionBurst = (config.Admission.Burst.Value() != 0 ? config.Admission.Burst.Value() : _admissionRate);
                 _IPV6 = config.IPV6.Value();
                 _binding = config.Binding.Value();
                 _interface = config.Interface.Value();
@@ -709,6 +823,45 @@ namespace PluginHost {
         inline uint16_t IdleTime() const {
             return (_idleTime);
         }
+        // Maximum number of requests accepted in one JSON-RPC batch.
+        inline uint16_t BatchSize() const {
+            return (_batchSize);
+        }
+        // Number of listening sockets sharing the port (SO_REUSEPORT), each with its own thread handling its connections.
+        inline uint8_t Acceptors() const {
+            return (_acceptors);
+        }
+        // zlib level used to compress HTTP response bodies, 0 means no compression.
+        inline uint8_t CompressionLevel() const {
+            return (_compressionLevel);
+        }
+        // Smallest HTTP response body, or WebSocket message, in bytes, that is worth compressing.
+        inline uint32_t CompressionThreshold() const {
+            return (_compressionThreshold);
+        }
+        // Largest window [9..15] for WebSocket compression, 2^bits of memory per direction.
+        inline uint8_t CompressionWindowBits() const {
+            return (_compressionWindowBits);
+        }
+        // Can a WebSocket compressor refer to earlier messages, or is it reset after each message?
+        inline bool CompressionContextTakeover() const {
+            return (_compressionContextTakeover);
+        }
+        // Most requests a single connection can have in the worker pool, 0 means no limit.
+        inline uint16_t AdmissionInFlight() const {
+            return (_admissionInFlight);
+        }
+        // Most requests all connections together can have in the worker pool, 0 means no limit.
+        inline uint32_t AdmissionPending() const {
+            return (_admissionPending);
+        }
+        // Requests per second a remote address can sustain, 0 means no limit, and how many it can send at once.
+        inline uint32_t AdmissionRate() const {
+            return (_admissionRate);
+        }
+        inline uint32_t AdmissionBurst() const {
+            return (_admissionBurst);
+        }
         inline const string& URL() const {
             return (_URL);
         }
@@ -868,6 +1021,16 @@ namespace PluginHost {
         uint16_t _portNumber;
         bool _IPV6;
         uint16_t _idleTime;
+        uint16_t _batchSize;
+        uint8_t _acceptors;
+        uint8_t _compressionLevel;
+        uint32_t _compressionThreshold;
+        uint8_t _compressionWindowBits;
+        bool _compressionContextTakeover;
+        uint16_t _admissionInFlight;
+        uint32_t _admissionPending;
+        uint32_t _admissionRate;
+        uint32_t _admissionBurst;
         uint32_t _stackSize;
         int32_t _latitude;
         int32_t _longitude;
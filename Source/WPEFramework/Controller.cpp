@@ -572,6 +572,31 @@ namespace Plugin {
             }
         }
 
+        return (response);
+    }
+    /* virtual */ Core::ProxyType<Core::JSONRPC::Message> Controller::Cached(const string& token, const uint32_t channelId, const Core::JSONRPC::Message& inbound)
+    {
+        string callsign(inbound.Callsign());
+        Core::ProxyType<Core::JSONRPC::Message> response;
+
+        if (callsign.empty() || (callsign == PluginHost::JSONRPC::Callsign())) {
+            response = PluginHost::JSONRPC::Cached(token, channelId, inbound);
+        } else {
+            Core::ProxyType<PluginHost::Server::Service> service;
+
+            if (_pluginServer->Services().FromIdentifier(callsign, service) == Core::ERROR_NONE) {
+                ASSERT(service.IsValid());
+
+                Core::JSONRPC::Message forwarder;
+
+                forwarder.Id = inbound.Id;
+                forwarder.Parameters = inbound.Parameters;
+
+                forwarder.Designator = inbound.VersionedFullMethod();
+                response = service->Cached(token, channelId, forwarder);
+            }
+        }
+
         return (response);
     }
 }
@@ -267,6 +267,7 @@ namespace Plugin {
         //  IDispatch methods
         // -------------------------------------------------------------------------------------------------------
         Core::ProxyType<Core::JSONRPC::Message> Invoke(const string& token, const uint32_t channelId, const Core::JSONRPC::Message& inbound) override;
+        Core::ProxyType<Core::JSONRPC::Message> Cached(const string& token, const uint32_t channelId, const Core::JSONRPC::Message& inbound) override;
 
         inline Core::ProxyType<PluginHost::Server::Service> FromIdentifier(const string& callsign) const
         {
@@ -283,6 +284,9 @@ namespace Plugin {
             data.PendingRequests = snapshot.Pending;
             data.PoolOccupation = snapshot.Occupation;
 
+            // What was kept away from the pool by the admission limits.
+            _pluginServer->Dispatcher().GetMetaData(data);
+
             for (uint8_t teller = 0; teller < snapshot.Slots; teller++) {
                 // Example of why copy-constructor and assignment constructor should be equal...
                 Core::JSON::DecUInt32 newElement;
@@ -21,6 +21,16 @@ string(TOLOWER ${NAMESPACE} NAMESPACE_LIB)
 set(PORT 80 CACHE STRING "The port for the webinterface")
 set(BINDING "0.0.0.0" CACHE STRING "The binding interface")
 set(IDLE_TIME 180 CACHE STRING "Idle time")
+set(BATCH_SIZE 32 CACHE STRING "Maximum number of requests in a JSON-RPC batch")
+set(ACCEPTORS 1 CACHE STRING "Number of listening sockets sharing the port, each on its own thread")
+set(COMPRESSION_LEVEL 0 CACHE STRING "zlib level [0 - 9] for HTTP response bodies, 0 disables compression")
+set(COMPRESSION_THRESHOLD 1024 CACHE STRING "Smallest HTTP response body, in bytes, that gets compressed")
+set(COMPRESSION_WINDOW_BITS 15 CACHE STRING "Largest WebSocket compression window [9 - 15], 2^bits bytes per direction")
+set(COMPRESSION_CONTEXT_TAKEOVER true CACHE STRING "WebSocket compression refers to earlier messages")
+set(ADMISSION_INFLIGHT 0 CACHE STRING "Most requests of one connection in the worker pool, 0 means no limit")
+set(ADMISSION_PENDING 0 CACHE STRING "Most requests of all connections in the worker pool, 0 means no limit")
+set(ADMISSION_RATE 0 CACHE STRING "Requests per second from one remote address, 0 means no limit")
+set(ADMISSION_BURST 0 CACHE STRING "Requests at once from one remote address, 0 takes the rate")
 set(PERSISTENT_PATH "/root" CACHE STRING "Persistent path")
 set(DATA_PATH "${CMAKE_INSTALL_PREFIX}/share/${NAMESPACE}" CACHE STRING "Data path")
 set(SYSTEM_PATH "${CMAKE_INSTALL_PREFIX}/lib/${NAMESPACE_LIB}/plugins" CACHE STRING "System path")
@@ -49,6 +59,8 @@ map_set(${CONFIG} port ${PORT})
 map_set(${CONFIG} binding ${BINDING})
 map_set(${CONFIG} ipv6 ${IPV6_SUPPORT})
 map_set(${CONFIG} idletime ${IDLE_TIME})
+map_set(${CONFIG} batchsize ${BATCH_SIZE})
+map_set(${CONFIG} acceptors ${ACCEPTORS})
 map_set(${CONFIG} persistentpath ${PERSISTENT_PATH})
 map_set(${CONFIG} volatilepath ${VOLATILE_PATH})
 map_set(${CONFIG} datapath ${DATA_PATH})
@@ -70,6 +82,24 @@ end()
 ans(PROCESS_CONFIG)
 map_append(${CONFIG} process ${PROCESS_CONFIG})
 
+map()
+    kv(level ${COMPRESSION_LEVEL})
+    kv(threshold ${COMPRESSION_THRESHOLD})
+    kv(windowbits ${COMPRESSION_WINDOW_BITS})
+    kv(contexttakeover ${COMPRESSION_CONTEXT_TAKEOVER})
+end()
+ans(COMPRESSION_CONFIG)
+map_append(${CONFIG} compression ${COMPRESSION_CONFIG})
+
+map()
+    kv(inflight ${ADMISSION_INFLIGHT})
+    kv(pending ${ADMISSION_PENDING})
+    kv(rate ${ADMISSION_RATE})
+    kv(burst ${ADMISSION_BURST})
+end()
+ans(ADMISSION_CONFIG)
+map_append(${CONFIG} admission ${ADMISSION_CONFIG})
+
 list(LENGTH EXIT_REASONS EXIT_REASONS_LENGTH)
 if (EXIT_REASONS_LENGTH GREATER 0)
     map_append(${CONFIG} exitreasons ___array___ ${EXIT_REASONS})
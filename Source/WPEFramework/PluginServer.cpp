@@ -53,11 +53,13 @@ namespace PluginHost
     /* static */ Core::ProxyType<Web::Response> Server::Channel::_incorrectVersion(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Channel::WebRequestJob::_missingResponse(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Channel::_unauthorizedRequest(Core::ProxyType<Web::Response>::Create());
+    /* static */ Core::ProxyType<Web::Response> Server::Channel::_overloaded(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Service::_missingHandler(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Service::_unavailableHandler(Core::ProxyType<Web::Response>::Create());
 
     /* static */ Core::ProxyPoolType<Server::Channel::WebRequestJob> Server::Channel::_webJobs(2);
     /* static */ Core::ProxyPoolType<Server::Channel::JSONElementJob> Server::Channel::_jsonJobs(2);
+    /* static */ Core::ProxyPoolType<Server::Channel::BatchJob> Server::Channel::_batchJobs(8);
     /* static */ Core::ProxyPoolType<Server::Channel::TextJob> Server::Channel::_textJobs(2);
 
 #ifdef __WINDOWS__
@@ -205,11 +207,43 @@ namespace PluginHost
             if (name.empty() == false) {
                 newInfo.Name = name;
             }
+            if (client->Dropped() != 0) {
+                newInfo.Dropped = client->Dropped();
+            }
+            if (client->Coalesced() != 0) {
+                newInfo.Coalesced = client->Coalesced();
+            }
+            newInfo.Buffers = client->Link().Allocated();
+            if (client->Shed() != 0) {
+                newInfo.Shed = client->Shed();
+            }
+
+            // Enough to spot the slow clients (blocked, partial, queue) and the busy ones (bytes, calls).
+            const Core::SocketPort::Statistics metrics(client->Link().Metrics());
+
+            newInfo.Received = metrics.Received;
+            newInfo.Sent = metrics.Sent;
+            newInfo.Reads = metrics.Reads;
+            newInfo.Writes = metrics.Writes;
+            newInfo.Partial = metrics.Partial;
+            newInfo.Queue = metrics.Queue;
+            newInfo.Blocked = metrics.Blocked;
+            if (metrics.RoundTrip != 0) {
+                newInfo.RoundTrip = metrics.RoundTrip;
+                newInfo.Retransmits = metrics.Retransmits;
+            }
 
             metaData.Add(newInfo);
         }
     }
 
+    void Server::ChannelMap::GetMetaData(MetaData::Server& metaData) const
+    {
+        metaData.ShedRate = _admission.ShedRate();
+        metaData.ShedInFlight = _admission.ShedInFlight();
+        metaData.ShedPending = _admission.ShedPending();
+    }
+
     void Server::ServiceMap::Destroy()
     {
         _adminLock.Lock();
@@ -235,6 +269,8 @@ namespace PluginHost
         controller->Deactivate(PluginHost::IShell::SHUTDOWN);
 
         // Now release them all
+        std::atomic_store(&_lookup, std::shared_ptr<const Lookup>());
+
         index = _services.begin();
 
         while (index != _services.end()) {
@@ -638,8 +674,14 @@ namespace PluginHost
         , _security(_parent.Officer())
         , _service()
         , _requestClose(false)
+        , _origin(remoteId.HostAddress())
+        , _inflight(0)
+        , _shed(0)
     {
         TRACE(Activity, (_T("Construct a link with ID: [%d] to [%s]"), Id(), remoteId.QualifiedName().c_str()));
+
+        Compression(_parent.Configuration().CompressionLevel(), _parent.Configuration().CompressionThreshold());
+        MessageCompression(_parent.Configuration().CompressionLevel(), _parent.Configuration().CompressionThreshold(), _parent.Configuration().CompressionWindowBits(), _parent.Configuration().CompressionContextTakeover());
     }
 
     /* virtual */ Server::Channel::~Channel()
@@ -666,7 +708,7 @@ namespace PluginHost
 
     Server::Server(Config& configuration, const bool background)
         : _dispatcher(configuration.StackSize())
-        , _connections(*this, configuration.Binder(), configuration.IdleTime())
+        , _connections(*this, configuration.Binder(), configuration.Acceptors(), configuration.IdleTime())
         , _config(configuration)
         , _services(*this, _config)
         , _controller()
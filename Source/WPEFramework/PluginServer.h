@@ -599,7 +599,7 @@ namespace PluginHost {
                     result = _unavailableHandler;
                 } else if (IsWebServerRequest(request.Path) == true) {
                     result = IFactories::Instance().Response();
-                    FileToServe(request.Path, *result);
+                    FileToServe(request, *result);
                 } else if (request.Verb == Web::Request::HTTP_OPTIONS) {
 
                     result = IFactories::Instance().Response();
@@ -681,6 +681,31 @@ namespace PluginHost {
 
                 return (result);
             }
+            Core::ProxyType<Core::JSONRPC::Message> Cached(const string& token, const uint32_t id, const Core::JSONRPC::Message& message)
+            {
+                Core::ProxyType<Core::JSONRPC::Message> result;
+
+                Lock();
+
+                if ((_jsonrpc != nullptr) && (IsActive() == true)) {
+                    IDispatcher* service(_jsonrpc);
+                    service->AddRef();
+                    Unlock();
+
+                    result = service->Cached(token, id, message);
+
+#if THUNDER_RUNTIME_STATISTICS
+                    if (result.IsValid() == true) {
+                        IncrementProcessedRequests();
+                    }
+#endif
+                    service->Release();
+                } else {
+                    Unlock();
+                }
+
+                return (result);
+            }
             inline Core::ProxyType<Core::JSON::IElement> Inbound(const uint32_t ID, const Core::ProxyType<Core::JSON::IElement>& element)
             {
                 Core::ProxyType<Core::JSON::IElement> result;
@@ -764,6 +789,18 @@ namespace PluginHost {
                 if (_versionHash.empty() == false)
                     metaData.Hash = _versionHash;
 
+                Lock();
+
+                // Only an in process dispatcher has its response cache at hand.
+                const PluginHost::JSONRPC* dispatcher = (_jsonrpc != nullptr ? dynamic_cast<const PluginHost::JSONRPC*>(_jsonrpc) : nullptr);
+
+                if (dispatcher != nullptr) {
+                    metaData.CacheHits = dispatcher->CacheHits();
+                    metaData.CacheMisses = dispatcher->CacheMisses();
+                }
+
+                Unlock();
+
                 PluginHost::Service::GetMetaData(metaData);
             }
             inline void Evaluate()
@@ -1054,6 +1091,8 @@ namespace PluginHost {
             typedef std::map<const string, IRemoteInstantiation*> RemoteInstantiators;
 
         private:
+            typedef std::unordered_map<string, Core::ProxyType<Service>> Lookup;
+
             ServiceMap() = delete;
             ServiceMap(const ServiceMap&) = delete;
             ServiceMap& operator=(const ServiceMap&) = delete;
@@ -1587,6 +1626,7 @@ namespace PluginHost {
                 , _adminLock()
                 , _notificationLock()
                 , _services()
+                , _lookup()
                 , _notifiers()
                 , _engine(Core::ProxyType<RPC::InvokeServer>::Create(&(server._dispatcher)))
                 , _processAdministrator(
@@ -1786,6 +1826,8 @@ namespace PluginHost {
                     // Fire up the interface. Let it handle the messages.
                     _services.insert(std::pair<const string, Core::ProxyType<Service>>(configuration.Callsign.Value(), newService));
 
+                    Publish();
+
                     _adminLock.Unlock();
                 }
 
@@ -1810,6 +1852,8 @@ namespace PluginHost {
                         // Fire up the interface. Let it handle the messages.
                         _services.insert(std::pair<const string, Core::ProxyType<Service>>(newConfiguration.Callsign.Value(), newService));
 
+                        Publish();
+
                         newService->Evaluate();
 
                         result = Core::ERROR_NONE;
@@ -1830,6 +1874,8 @@ namespace PluginHost {
                 if (index != _services.end()) {
                     index->second->Destroy();
                     _services.erase(index);
+
+                    Publish();
                 }
 
                 _adminLock.Unlock();
@@ -1873,35 +1919,33 @@ namespace PluginHost {
             {
                 uint32_t result = Core::ERROR_UNAVAILABLE;
 
-                _adminLock.Lock();
+                // Every request passes here, it works on the published snapshot, no lock needed.
+                std::shared_ptr<const Lookup> lookup(std::atomic_load(&_lookup));
+
+                if (lookup != nullptr) {
+                    Lookup::const_iterator index(lookup->find(callSign));
+
+                    if (index != lookup->cend()) {
+                        // Service found, did not requested specific version
+                        service = index->second;
+                        result = Core::ERROR_NONE;
+                    } else {
+                        size_t position = callSign.find_last_of('.');
 
-                for (auto index : _services) {
-                    const string& source(index.first);
-                    uint32_t length = static_cast<uint32_t>(source.length());
-
-                    if (callSign.compare(0, source.length(), source) == 0) {
-                        if (callSign.length() == length) {
-                            // Service found, did not requested specific version
-                            service = index.second;
-                            result = Core::ERROR_NONE;
-                            break;
-                        } else if (callSign[length] == '.') {
+                        if ((position != string::npos) && ((index = lookup->find(callSign.substr(0, position))) != lookup->cend())) {
                             // Requested specific version of a plugin
-                            if (index.second->HasVersionSupport(callSign.substr(length + 1)) == true) {
+                            if (index->second->HasVersionSupport(callSign.substr(position + 1)) == true) {
                                 // Requested version of service is supported!
-                                service = index.second;
+                                service = index->second;
                                 result = Core::ERROR_NONE;
                             } else {
                                 // Requested version is not supported
                                 result = Core::ERROR_INVALID_SIGNATURE;
                             }
-                            break;
                         }
                     }
                 }
 
-                _adminLock.Unlock();
-
                 return (result);
             }
             uint32_t FromLocator(const string& identifier, Core::ProxyType<Service>& service, bool& serviceCall);
@@ -1914,6 +1958,13 @@ namespace PluginHost {
             }
 
         private:
+            // Publish a new snapshot of the services, the callee holds the _adminLock.
+            void Publish()
+            {
+                std::shared_ptr<Lookup> lookup(std::make_shared<Lookup>(_services.begin(), _services.end()));
+
+                std::atomic_store(&_lookup, std::shared_ptr<const Lookup>(lookup));
+            }
             void Remove(const string& connector) const
             {
                 // This is already locked by the callee, so safe to operate on the map..
@@ -1984,6 +2035,7 @@ namespace PluginHost {
             mutable Core::CriticalSection _adminLock;
             Core::CriticalSection _notificationLock;
             std::map<const string, Core::ProxyType<Service>> _services;
+            std::shared_ptr<const Lookup> _lookup;
             mutable RemoteInstantiators _instantiators;
             std::list<IPlugin::INotification*> _notifiers;
             Core::ProxyType<RPC::InvokeServer> _engine;
@@ -2009,6 +2061,7 @@ namespace PluginHost {
                     : _ID(~0)
                     , _server(server)
                     , _service()
+                    , _admitted(false)
                 {
                     ASSERT(server != nullptr);
                 }
@@ -2032,11 +2085,20 @@ namespace PluginHost {
                 }
                 void Clear()
                 {
+                    if (_admitted == true) {
+                        // Handled, it no longer counts against the limits of the channel and the server.
+                        _admitted = false;
+                        _server->Dispatcher().Completed(_ID);
+                    }
                     _ID = ~0;
                     if (_service.IsValid() == true) {
                         _service.Release();
                     }
                 }
+                void Admitted()
+                {
+                    _admitted = true;
+                }
                 void Set(const uint32_t id, Core::ProxyType<Service>& service)
                 {
                     ASSERT(_service.IsValid() == false);
@@ -2082,11 +2144,241 @@ namespace PluginHost {
                     ASSERT(_service.IsValid() == true);
                     return _service->Callsign();
                 }
+                // The requests of a batch are independent, they are all handed to the worker pool
+                // at once. The last one that completes sends the responses in one go. Each of them
+                // counts against the admission limits, the first takes over the slot of this job. A
+                // refused one is answered with an error in the batch response.
+                void Distribute(const string& token, const Core::ProxyType<Core::JSONRPC::Message>& message, const bool web, const bool close, const Web::EncodingTypes compression = Web::ENCODING_UNKNOWN)
+                {
+                    ASSERT(message->IsBatch() == true);
+
+                    Core::JSONRPC::Message::BatchList& requests(message->Batch());
+                    Core::ProxyType<Core::JSONRPC::Message> response(Core::proxy_cast<Core::JSONRPC::Message>(IFactories::Instance().JSONRPC()));
+
+                    if ((requests.empty() == true) || (requests.size() > _server->Configuration().BatchSize())) {
+                        response->Error.InvalidRequest(requests.empty() == true ? _T("Batch holds no requests.") : _T("Batch holds more than ") + Core::NumberType<uint16_t>(_server->Configuration().BatchSize()).Text() + _T(" requests."));
+                        Complete(response, web, close, compression);
+                    } else {
+                        response->Batch(static_cast<uint16_t>(requests.size()));
+
+                        Core::ProxyType<Batch> batch(Core::ProxyType<Batch>::Create(response, web, close, compression));
+
+                        for (uint16_t index = 0; index < requests.size(); index++) {
+                            Core::ProxyType<BatchJob> job(_batchJobs.Element(_server));
+                            const Core::ProxyType<Core::JSONRPC::Message>& request(requests[index]);
+                            bool admitted = false;
+
+                            ASSERT(job.IsValid() == true);
+
+                            // What is refused already, is answered without taking a slot.
+                            if (request->Error.IsSet() == false) {
+                                if (_admitted == true) {
+                                    _admitted = false;
+                                    admitted = true;
+                                } else if (_server->Dispatcher().Admit(_ID) == true) {
+                                    admitted = true;
+                                } else {
+                                    PluginHost::Admission::Refused(*request);
+                                }
+                            }
+
+                            job->Set(_ID, _service, batch, index, request, token);
+
+                            if (admitted == true) {
+                                job->Admitted();
+                            }
+
+                            _server->Submit(Core::proxy_cast<Core::IDispatch>(job));
+                        }
+                    }
+                }
+                void Complete(const Core::ProxyType<Core::JSONRPC::Message>& message, const bool web, const bool close, const Web::EncodingTypes compression = Web::ENCODING_UNKNOWN)
+                {
+                    // A batch of notifications only, has nothing to answer.
+                    const bool answered = ((message->IsBatch() == false) || (message->Entries() > 0));
+
+                    if (web == false) {
+                        if (answered == true) {
+                            Job::Submit(Core::ProxyType<Core::JSON::IElement>(message));
+                        }
+                    } else {
+                        Core::ProxyType<Web::Response> response(IFactories::Instance().Response());
+
+                        if (answered == false) {
+                            response->ErrorCode = Web::STATUS_NO_CONTENT;
+                        } else {
+                            response->Body(message);
+                            if (Streamed(*message) == true) {
+                                Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> body(message);
+
+                                if (body.IsValid() == true) {
+                                    body->Chunked(true);
+                                }
+                            }
+                            if (message->Error.IsSet() == false) {
+                                response->ErrorCode = Web::STATUS_OK;
+                                response->Message = _T("JSONRPC executed succesfully");
+                            } else {
+                                response->ErrorCode = Web::STATUS_ACCEPTED;
+                                response->Message = _T("Failure on JSONRPC: ") + Core::NumberType<uint32_t>(message->Error.Code).Text();
+                            }
+                        }
+
+                        response->AccessControlOrigin = _T("*");
+                        response->CacheControl = _T("no-cache, private, no-store, must-revalidate, max-stale=0, post-check=0, pre-check=0");
+                        response->Compression(compression);
+
+                        Job::Submit(response);
+
+                        if (close == true) {
+                            Job::Close();
+                        }
+                    }
+                }
+
+            private:
+                // Results that are handed over as element, are not converted to text for the HTTP body either.
+                static bool Streamed(const Core::JSONRPC::Message& message)
+                {
+                    bool result = message.IsStreamed();
+
+                    if (message.IsBatch() == true) {
+                        for (const Core::ProxyType<Core::JSONRPC::Message>& entry : message.Batch()) {
+                            result = result || ((entry.IsValid() == true) && (entry->IsStreamed() == true));
+                        }
+                    }
+
+                    return (result);
+                }
 
             private:
                 uint32_t _ID;
                 Server* _server;
                 Core::ProxyType<Service> _service;
+                bool _admitted;
+            };
+            // Collects the responses of a batch, in the order of the requests.
+            class Batch {
+            public:
+                Batch() = delete;
+                Batch(const Batch&) = delete;
+                Batch& operator=(const Batch&) = delete;
+
+                Batch(const Core::ProxyType<Core::JSONRPC::Message>& response, const bool web, const bool close, const Web::EncodingTypes compression)
+                    : _response(response)
+                    , _pending(static_cast<uint16_t>(response->Batch().size()))
+                    , _web(web)
+                    , _close(close)
+                    , _compression(compression)
+                {
+                }
+                ~Batch() = default;
+
+            public:
+                void Set(const uint16_t index, const Core::ProxyType<Core::JSONRPC::Message>& response)
+                {
+                    // Every request owns its own slot, no need to lock.
+                    _response->Batch()[index] = response;
+                }
+                // Returns true for the request that completes the batch.
+                bool Completed()
+                {
+                    return (_pending.fetch_sub(1) == 1);
+                }
+                const Core::ProxyType<Core::JSONRPC::Message>& Response() const
+                {
+                    return (_response);
+                }
+                bool Web() const
+                {
+                    return (_web);
+                }
+                bool Closing() const
+                {
+                    return (_close);
+                }
+                Web::EncodingTypes Compression() const
+                {
+                    return (_compression);
+                }
+
+            private:
+                Core::ProxyType<Core::JSONRPC::Message> _response;
+                std::atomic<uint16_t> _pending;
+                const bool _web;
+                const bool _close;
+                const Web::EncodingTypes _compression;
+            };
+            class BatchJob : public Job {
+            public:
+                BatchJob() = delete;
+                BatchJob(const BatchJob&) = delete;
+                BatchJob& operator=(const BatchJob&) = delete;
+
+                BatchJob(Server* server)
+                    : Job(server)
+                    , _batch()
+                    , _request()
+                    , _index(0)
+                    , _token()
+                {
+                }
+                ~BatchJob() override
+                {
+                    ASSERT(_request.IsValid() == false);
+                    ASSERT(_batch.IsValid() == false);
+                }
+
+            public:
+                void Set(const uint32_t id, Core::ProxyType<Service>& service, const Core::ProxyType<Batch>& batch, const uint16_t index, const Core::ProxyType<Core::JSONRPC::Message>& request, const string& token)
+                {
+                    Job::Set(id, service);
+
+                    ASSERT(_request.IsValid() == false);
+
+                    _batch = batch;
+                    _request = request;
+                    _index = index;
+                    _token = token;
+                }
+                void Dispatch() override
+                {
+                    ASSERT(Job::HasService() == true);
+                    ASSERT(_request.IsValid() == true);
+
+                    Core::ProxyType<Core::JSONRPC::Message> response;
+
+                    if (_request->Error.IsSet() == true) {
+                        // Refused before it was dispatched, report why.
+                        response = Core::proxy_cast<Core::JSONRPC::Message>(IFactories::Instance().JSONRPC());
+                        response->Id = _request->Id;
+                        response->Error = _request->Error;
+                    } else {
+                        response = Job::Process(_token, _request);
+                    }
+
+                    // Notifications, requests without an id, are not answered. Neither are the
+                    // asynchronous ones here, their response follows when it is available.
+                    if ((response.IsValid() == true) && (_request->Id.IsSet() == true)) {
+                        _batch->Set(_index, response);
+                    }
+
+                    _request.Release();
+
+                    if (_batch->Completed() == true) {
+                        Job::Complete(_batch->Response(), _batch->Web(), _batch->Closing(), _batch->Compression());
+                    }
+
+                    _batch.Release();
+
+                    Job::Clear();
+                }
+
+            private:
+                Core::ProxyType<Batch> _batch;
+                Core::ProxyType<Core::JSONRPC::Message> _request;
+                uint16_t _index;
+                string _token;
             };
             class WebRequestJob : public Job {
             public:
@@ -2136,7 +2428,10 @@ namespace PluginHost {
                     if (_jsonrpc == true) {
                         Core::ProxyType<Core::JSONRPC::Message> message(_request->Body<Core::JSONRPC::Message>());
 
-                        if (message->IsSet()) {
+                        if (message->IsBatch() == true) {
+                            // Answered when all requests in it are handled.
+                            Job::Distribute(_token, message, true, (_request->Connection.Value() == Web::Request::CONNECTION_CLOSE), Compression());
+                        } else if (message->IsSet()) {
                             Core::ProxyType<Core::JSONRPC::Message> body = Job::Process(_token, message);
 
                             // If we have no response body, it looks like an async-call...
@@ -2177,6 +2472,11 @@ namespace PluginHost {
                         if (response->CacheControl.IsSet() == false)
                             response->CacheControl = _T("no-cache, private, no-store, must-revalidate, max-stale=0, post-check=0, pre-check=0");
 
+                        // Shared responses have no body, leave those untouched.
+                        if (response->HasBody() == true) {
+                            response->Compression(Compression());
+                        }
+
                         Job::Submit(response);
 
                         if (_request->Connection.Value() == Web::Request::CONNECTION_CLOSE) {
@@ -2191,6 +2491,13 @@ namespace PluginHost {
                     
                 }
 
+            private:
+                // The encoding the requester accepts, if any, to compress the response body with.
+                Web::EncodingTypes Compression() const
+                {
+                    return (_request->AcceptEncoding.IsSet() == true ? _request->AcceptEncoding.Value() : Web::ENCODING_UNKNOWN);
+                }
+
             private:
                 Core::ProxyType<Web::Request> _request;
                 string _token;
@@ -2244,7 +2551,12 @@ namespace PluginHost {
                         Core::ProxyType<Core::JSONRPC::Message> message(Core::proxy_cast<Core::JSONRPC::Message>(_element));
                         ASSERT(message.IsValid() == true);
 
-                        _element = Core::ProxyType<Core::JSON::IElement>(Job::Process(_token, message));
+                        if (message->IsBatch() == true) {
+                            Job::Distribute(_token, message, false, false);
+                            _element.Release();
+                        } else {
+                            _element = Core::ProxyType<Core::JSON::IElement>(Job::Process(_token, message));
+                        }
 
 #if THUNDER_PERFORMANCE
 			tracking->Execution();
@@ -2333,6 +2645,30 @@ namespace PluginHost {
 
                 _unauthorizedRequest->ErrorCode = Web::STATUS_UNAUTHORIZED;
                 _unauthorizedRequest->Message = _T("Request needs authorization, but it was not authorized");
+
+                PluginHost::Admission::Refused(*_overloaded);
+            }
+            // The remote address, requests from one address share a rate limit.
+            inline const string& Origin() const
+            {
+                return (_origin);
+            }
+            inline uint16_t InFlight() const
+            {
+                return (_inflight);
+            }
+            inline uint32_t Shed() const
+            {
+                return (_shed);
+            }
+            inline void Admitted()
+            {
+                _inflight++;
+            }
+            inline void Completed()
+            {
+                ASSERT(_inflight > 0);
+                _inflight--;
             }
             void Revoke(PluginHost::ISecurity* baseRights)
             {
@@ -2379,7 +2715,30 @@ namespace PluginHost {
                 _requestClose = true;
             }
 
+            // Every request that would go to the worker pool asks first, on the thread of this channel or,
+            // for the requests of a batch, on the thread that distributes them.
+            bool Admit()
+            {
+                bool result = _parent.Dispatcher().Admit(*this);
+
+                if (result == false) {
+                    _shed++;
+                }
+
+                return (result);
+            }
+
         private:
+            void Overloaded(const Core::ProxyType<Core::JSONRPC::Message>& message)
+            {
+                if (message.IsValid() == true) {
+                    Core::ProxyType<Core::JSONRPC::Message> response(Core::proxy_cast<Core::JSONRPC::Message>(IFactories::Instance().JSONRPC()));
+
+                    if (PluginHost::Admission::Refused(*message, *response) == true) {
+                        Submit(Core::ProxyType<Core::JSON::IElement>(response));
+                    }
+                }
+            }
             bool Allowed(const string& pathParameter, const string& queryParameters)
             {
                 Core::URL::KeyValue options(queryParameters);
@@ -2433,7 +2792,10 @@ namespace PluginHost {
                     if (serviceCall == true) {
                         service->Inbound(*request);
                     } else {
-                        request->Body(IFactories::Instance().JSONRPC());
+                        Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> body(IFactories::Instance().JSONRPC());
+
+                        body->BatchLimit(_parent.Configuration().BatchSize());
+                        request->Body(body);
                     }
                 }
             }
@@ -2482,8 +2844,20 @@ namespace PluginHost {
                         request->Service(status, Core::proxy_cast<PluginHost::Service>(service), serviceCall);
                     } else if ((request->State() == Request::COMPLETE) && (request->HasBody() == true)) {
                         Core::ProxyType<Core::JSONRPC::Message> message(request->Body<Core::JSONRPC::Message>());
-                        if ((message.IsValid() == true) && (security->Allowed(*message) == false)) {
-                            request->Unauthorized();
+                        if (message.IsValid() == true) {
+                            if (message->IsBatch() == false) {
+                                if (security->Allowed(*message) == false) {
+                                    request->Unauthorized();
+                                }
+                            } else {
+                                // All requests in the batch must be allowed.
+                                for (const Core::ProxyType<Core::JSONRPC::Message>& entry : message->Batch()) {
+                                    if (security->Allowed(*entry) == false) {
+                                        request->Unauthorized();
+                                        break;
+                                    }
+                                }
+                            }
                         }
                     }
                 }
@@ -2534,6 +2908,9 @@ namespace PluginHost {
                     if (response.IsValid() == true) {
                         // Report that the calls sign could not be found !!
                         Submit(response);
+                    } else if (Admit() == false) {
+                        // Refused, answered right away, it never gets near the worker pool.
+                        Submit(_overloaded);
                     } else {
                         // Send the Request object out to be handled.
                         // By definition, we can issue it on a rental thread..
@@ -2544,7 +2921,10 @@ namespace PluginHost {
                         if (job.IsValid() == true) {
                             Core::ProxyType<Web::Request> baseRequest(Core::proxy_cast<Web::Request>(request));
                             job->Set(Id(), service, baseRequest, _security->Token(), !request->ServiceCall());
+                            job->Admitted();
                             _parent.Submit(Core::proxy_cast<Core::IDispatchType<void>>(job));
+                        } else {
+                            _parent.Dispatcher().Completed(Id());
                         }
                     }
                     break;
@@ -2572,7 +2952,10 @@ namespace PluginHost {
 
                 if (_service.IsValid() == true) {
                     if (State() == JSONRPC) {
-                        result = Core::ProxyType<Core::JSON::IElement>(IFactories::Instance().JSONRPC());
+                        Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message(IFactories::Instance().JSONRPC());
+
+                        message->BatchLimit(_parent.Configuration().BatchSize());
+                        result = Core::ProxyType<Core::JSON::IElement>(message);
                     } else {
                         result = _service->Inbound(identifier);
                     }
@@ -2594,7 +2977,20 @@ namespace PluginHost {
 
                 if (securityClearance == false) {
                     Core::ProxyType<Core::JSONRPC::Message> message(Core::proxy_cast<Core::JSONRPC::Message>(element));
-                    if (message.IsValid()) {
+                    if ((message.IsValid() == true) && (message->IsBatch() == true)) {
+                        // The requests in a batch are judged one by one, the refused ones are
+                        // answered with an error in the batch response.
+                        PluginHost::Channel::Lock();
+                        for (const Core::ProxyType<Core::JSONRPC::Message>& entry : message->Batch()) {
+                            if (_security->Allowed(*entry) == false) {
+                                entry->Error.SetError(Core::ERROR_PRIVILIGED_REQUEST);
+                                entry->Error.Text = _T("method invokation not allowed.");
+                            }
+                        }
+                        PluginHost::Channel::Unlock();
+
+                        securityClearance = true;
+                    } else if (message.IsValid()) {
                         PluginHost::Channel::Lock();
                         securityClearance = _security->Allowed(*message);
                         PluginHost::Channel::Unlock();
@@ -2610,15 +3006,38 @@ namespace PluginHost {
                 }
 
                 if (securityClearance == true) {
-                    // Send the JSON object out to be handled.
-                    // By definition, we can issue it on a rental thread..
-                    Core::ProxyType<JSONElementJob> job(_jsonJobs.Element(&_parent));
+                    Core::ProxyType<Core::JSONRPC::Message> cached;
 
-                    ASSERT(job.IsValid() == true);
+                    if ((State() & Channel::JSONRPC) != 0) {
+                        Core::ProxyType<Core::JSONRPC::Message> message(Core::proxy_cast<Core::JSONRPC::Message>(element));
 
-                    if ((_service.IsValid() == true) && (job.IsValid() == true)) {
-                        job->Set(Id(), _service, element, _security->Token(), ((State() & Channel::JSONRPC) != 0));
-                        _parent.Submit(Core::proxy_cast<Core::IDispatch>(job));
+                        // What the response cache holds is answered right here, no need for a rental thread.
+                        if ((message.IsValid() == true) && (message->IsBatch() == false) && (message->Error.IsSet() == false)) {
+                            cached = _service->Cached(_security->Token(), Id(), *message);
+                        }
+                    }
+
+                    if (cached.IsValid() == true) {
+                        Submit(Core::ProxyType<Core::JSON::IElement>(cached));
+                    } else if (Admit() == false) {
+                        // Refused, a JSONRPC request is answered right away. Anything else has no way to tell.
+                        if ((State() & Channel::JSONRPC) != 0) {
+                            Overloaded(Core::proxy_cast<Core::JSONRPC::Message>(element));
+                        }
+                    } else {
+                        // Send the JSON object out to be handled.
+                        // By definition, we can issue it on a rental thread..
+                        Core::ProxyType<JSONElementJob> job(_jsonJobs.Element(&_parent));
+
+                        ASSERT(job.IsValid() == true);
+
+                        if ((_service.IsValid() == true) && (job.IsValid() == true)) {
+                            job->Set(Id(), _service, element, _security->Token(), ((State() & Channel::JSONRPC) != 0));
+                            job->Admitted();
+                            _parent.Submit(Core::proxy_cast<Core::IDispatch>(job));
+                        } else {
+                            _parent.Dispatcher().Completed(Id());
+                        }
                     }
                 }
             }
@@ -2628,15 +3047,21 @@ namespace PluginHost {
 
                 TRACE(TextFlow, (value));
 
-                // Send the JSON object out to be handled.
-                // By definition, we can issue it on a rental thread..
-                Core::ProxyType<TextJob> job(_textJobs.Element(&_parent));
+                // Refused text has no way to tell, it is dropped (and counted).
+                if (Admit() == true) {
+                    // Send the JSON object out to be handled.
+                    // By definition, we can issue it on a rental thread..
+                    Core::ProxyType<TextJob> job(_textJobs.Element(&_parent));
 
-                ASSERT(job.IsValid() == true);
+                    ASSERT(job.IsValid() == true);
 
-                if ((_service.IsValid() == true) && (job.IsValid() == true)) {
-                    job->Set(Id(), _service, value);
-                    _parent.Submit(Core::proxy_cast<Core::IDispatch>(job));
+                    if ((_service.IsValid() == true) && (job.IsValid() == true)) {
+                        job->Set(Id(), _service, value);
+                        job->Admitted();
+                        _parent.Submit(Core::proxy_cast<Core::IDispatch>(job));
+                    } else {
+                        _parent.Dispatcher().Completed(Id());
+                    }
                 }
             }
 
@@ -2703,6 +3128,8 @@ namespace PluginHost {
                             State(TEXT, false);
                         } else if (Protocol() == _T("jsonrpc")) {
                             State(JSONRPC, false);
+                        } else if (Protocol() == _T("jsonrpc.msgpack")) {
+                            State(JSONRPC, false, true);
                         } else {
                             // Channel is a raw communication channel.
                             // This channel allows for passing binary data back and forth
@@ -2721,7 +3148,8 @@ namespace PluginHost {
                         if (Name().length() > (JSONRPCHeader.length() + 1)) {
                             Properties(static_cast<uint32_t>(JSONRPCHeader.length()) + 1);
                         }
-                        State(JSONRPC, false);
+                        // JSONRPC messages travel as JSON text, unless the client asked for the binary MessagePack encoding.
+                        State(JSONRPC, false, (Protocol() == _T("jsonrpc.msgpack")));
 
                         // The state needs to be correct before we c
                         if (_service->Subscribe(*this) == false) {
@@ -2744,10 +3172,14 @@ namespace PluginHost {
             PluginHost::ISecurity* _security;
             Core::ProxyType<Service> _service;
             bool _requestClose;
+            const string _origin;
+            std::atomic<uint16_t> _inflight;
+            std::atomic<uint32_t> _shed;
 
             // Factories for creating jobs that can be placed on the PluginHost Worker pool.
             static Core::ProxyPoolType<WebRequestJob> _webJobs;
             static Core::ProxyPoolType<JSONElementJob> _jsonJobs;
+            static Core::ProxyPoolType<BatchJob> _batchJobs;
             static Core::ProxyPoolType<TextJob> _textJobs;
 
             // If there is no call sign or the associated handler does not exist,
@@ -2761,6 +3193,9 @@ namespace PluginHost {
             // If a request requires security clearance, but it is not give, for
             // whatever reason, we will report back that the request is unauthorized.
             static Core::ProxyType<Web::Response> _unauthorizedRequest;
+
+            // Requests refused by the admission limits are answered right away, before they take up a thread.
+            static Core::ProxyType<Web::Response> _overloaded;
         };
         class ChannelMap : public Core::SocketServerType<Channel> {
         private:
@@ -2800,11 +3235,12 @@ namespace PluginHost {
 #ifdef __WINDOWS__
 #pragma warning(disable : 4355)
 #endif
-            ChannelMap(Server& parent, const Core::NodeId& listeningNode, const uint16_t connectionCheckTimer)
-                : Core::SocketServerType<Channel>(listeningNode)
+            ChannelMap(Server& parent, const Core::NodeId& listeningNode, const uint8_t acceptors, const uint16_t connectionCheckTimer)
+                : Core::SocketServerType<Channel>(listeningNode, acceptors)
                 , _parent(parent)
                 , _connectionCheckTimer(connectionCheckTimer * 1000)
                 , _job(Core::ProxyType<Job>::Create(this))
+                , _admission()
             {
                 if (connectionCheckTimer != 0) {
                     Core::Time NextTick = Core::Time::Now();
@@ -2873,8 +3309,46 @@ namespace PluginHost {
                 }
             }
             void GetMetaData(Core::JSON::ArrayType<MetaData::Channel>& metaData) const;
+            void GetMetaData(MetaData::Server& metaData) const;
+
+            // Decides, before it is handed to the worker pool, whether a request of this channel is taken on.
+            bool Admit(Channel& channel)
+            {
+                return (_admission.Admit(Limits(), channel, Core::Time::Now().Ticks()));
+            }
+            // A request that is issued from a job, a channel that is gone already takes nothing on anymore.
+            bool Admit(const uint32_t id)
+            {
+                Core::ProxyType<Channel> client(BaseClass::Client(id));
+
+                return ((client.IsValid() == true) && (client->Admit() == true));
+            }
+            // An admitted request is handled, the channel might be gone already.
+            void Completed(const uint32_t id)
+            {
+                const PluginHost::Admission::Limits limits(Limits());
+                Core::ProxyType<Channel> client;
+
+                if (limits.InFlight != 0) {
+                    client = BaseClass::Client(id);
+                }
+
+                _admission.Completed(limits, (client.IsValid() == true ? &(*client) : nullptr));
+            }
 
         private:
+            PluginHost::Admission::Limits Limits() const
+            {
+                const PluginHost::Config& config(_parent.Configuration());
+                PluginHost::Admission::Limits result;
+
+                result.InFlight = config.AdmissionInFlight();
+                result.Pending = config.AdmissionPending();
+                result.Rate = config.AdmissionRate();
+                result.Burst = config.AdmissionBurst();
+
+                return (result);
+            }
             void Timed()
             {
                 TRACE(Activity, (string(_T("Cleanup job running..\n"))));
@@ -2882,6 +3356,8 @@ namespace PluginHost {
                 // First clear all shit from last time..
                 Cleanup();
 
+                _admission.Prune(Limits(), Core::Time::Now().Ticks());
+
                 if (_connectionCheckTimer != 0) {
                     // Now suspend those that have no activity.
                     BaseClass::Iterator index(BaseClass::Clients());
@@ -2910,6 +3386,7 @@ namespace PluginHost {
             Server& _parent;
             const uint32_t _connectionCheckTimer;
             Core::ProxyType<Core::IDispatchType<void>> _job;
+            PluginHost::Admission _admission;
         };
 
     public:
@@ -126,6 +126,8 @@ namespace Plugin {
         , _model(model)
         , _destinations()
     {
+        // Discovery requests come in storms, take what is waiting in one go.
+        Link().Batch(16);
 
         if (Link().Open(1000) != Core::ERROR_NONE) {
             ASSERT(false && "Seems we can not open the discovery port");
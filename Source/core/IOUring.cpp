@@ -0,0 +1,395 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IOUring.h"
+#include "Trace.h"
+
+#ifdef __CORE_IO_URING__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#endif
+
+namespace WPEFramework {
+namespace Core {
+
+    IOUring::IOUring(const uint32_t entries)
+        : _descriptor(-1)
+        , _submissionRing(nullptr)
+        , _submissionRingSize(0)
+        , _completionRing(nullptr)
+        , _completionRingSize(0)
+        , _entries(nullptr)
+        , _entriesSize(0)
+        , _submissionHead(nullptr)
+        , _submissionTail(nullptr)
+        , _submissionArray(nullptr)
+        , _submissionMask(0)
+        , _submissionCount(0)
+        , _queued(0)
+        , _completionHead(nullptr)
+        , _completionTail(nullptr)
+        , _completions(nullptr)
+        , _completionMask(0)
+        , _transfers(false)
+    {
+#ifdef __CORE_IO_URING__
+        struct io_uring_params parameters;
+
+        ::memset(&parameters, 0, sizeof(parameters));
+
+        int descriptor = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &parameters));
+
+        if (descriptor == -1) {
+            TRACE_L1("io_uring is not available, error %d", errno);
+        } else if ((parameters.features & IORING_FEAT_NODROP) == 0) {
+            // A dropped completion is a poll that never reports, the resource would never be serviced again.
+            TRACE_L1("io_uring does not guarantee completions, features: 0x%X", parameters.features);
+            ::close(descriptor);
+        } else {
+            _submissionRingSize = parameters.sq_off.array + (parameters.sq_entries * sizeof(uint32_t));
+            _completionRingSize = parameters.cq_off.cqes + (parameters.cq_entries * sizeof(struct io_uring_cqe));
+            _entriesSize = parameters.sq_entries * sizeof(struct io_uring_sqe);
+
+            _descriptor = descriptor;
+
+            if ((parameters.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+                _submissionRingSize = std::max(_submissionRingSize, _completionRingSize);
+                _submissionRing = Map(_submissionRingSize, IORING_OFF_SQ_RING);
+                _completionRing = _submissionRing;
+            } else {
+                _submissionRing = Map(_submissionRingSize, IORING_OFF_SQ_RING);
+                _completionRing = Map(_completionRingSize, IORING_OFF_CQ_RING);
+            }
+
+            _entries = reinterpret_cast<struct io_uring_sqe*>(Map(_entriesSize, IORING_OFF_SQES));
+
+            if ((_submissionRing == nullptr) || (_completionRing == nullptr) || (_entries == nullptr)) {
+                TRACE_L1("io_uring rings could not be mapped, error %d", errno);
+                Destroy();
+            } else {
+                uint8_t* submission = static_cast<uint8_t*>(_submissionRing);
+                uint8_t* completion = static_cast<uint8_t*>(_completionRing);
+
+                _submissionHead = reinterpret_cast<uint32_t*>(&(submission[parameters.sq_off.head]));
+                _submissionTail = reinterpret_cast<uint32_t*>(&(submission[parameters.sq_off.tail]));
+                _submissionArray = reinterpret_cast<uint32_t*>(&(submission[parameters.sq_off.array]));
+                _submissionMask = *reinterpret_cast<uint32_t*>(&(submission[parameters.sq_off.ring_mask]));
+                _submissionCount = parameters.sq_entries;
+                _queued = *_submissionTail;
+
+                _completionHead = reinterpret_cast<uint32_t*>(&(completion[parameters.cq_off.head]));
+                _completionTail = reinterpret_cast<uint32_t*>(&(completion[parameters.cq_off.tail]));
+                _completions = reinterpret_cast<struct io_uring_cqe*>(&(completion[parameters.cq_off.cqes]));
+                _completionMask = *reinterpret_cast<uint32_t*>(&(completion[parameters.cq_off.ring_mask]));
+
+#if defined(IORING_FEAT_FAST_POLL) && defined(IOSQE_BUFFER_SELECT)
+                _transfers = ((parameters.features & IORING_FEAT_FAST_POLL) != 0);
+#endif
+            }
+        }
+#else
+        DEBUG_VARIABLE(entries);
+#endif
+    }
+
+    IOUring::~IOUring()
+    {
+        Destroy();
+    }
+
+    void* IOUring::Map(const uint32_t size, const uint64_t offset) const
+    {
+        void* result = nullptr;
+
+#ifdef __CORE_IO_URING__
+        result = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _descriptor, offset);
+
+        if (result == MAP_FAILED) {
+            result = nullptr;
+        }
+#else
+        DEBUG_VARIABLE(size);
+        DEBUG_VARIABLE(offset);
+#endif
+
+        return (result);
+    }
+
+    void IOUring::Destroy()
+    {
+#ifdef __CORE_IO_URING__
+        if (_entries != nullptr) {
+            ::munmap(_entries, _entriesSize);
+        }
+        if ((_completionRing != nullptr) && (_completionRing != _submissionRing)) {
+            ::munmap(_completionRing, _completionRingSize);
+        }
+        if (_submissionRing != nullptr) {
+            ::munmap(_submissionRing, _submissionRingSize);
+        }
+        if (_descriptor != -1) {
+            // Closing the ring cancels whatever is still in flight.
+            ::close(_descriptor);
+        }
+#endif
+
+        _entries = nullptr;
+        _completionRing = nullptr;
+        _submissionRing = nullptr;
+        _descriptor = -1;
+    }
+
+    struct io_uring_sqe* IOUring::Entry()
+    {
+        struct io_uring_sqe* result = nullptr;
+
+#ifdef __CORE_IO_URING__
+        if ((_queued - __atomic_load_n(_submissionHead, __ATOMIC_ACQUIRE)) >= _submissionCount) {
+            // Ring is full, hand what we have to the kernel to make room.
+            Submit(false);
+        }
+
+        if ((_queued - __atomic_load_n(_submissionHead, __ATOMIC_ACQUIRE)) < _submissionCount) {
+            const uint32_t index = (_queued & _submissionMask);
+
+            result = &(_entries[index]);
+            ::memset(result, 0, sizeof(struct io_uring_sqe));
+            _submissionArray[index] = index;
+            _queued++;
+        }
+#endif
+
+        return (result);
+    }
+
+    bool IOUring::Poll(const int descriptor, const uint16_t events, const uint64_t userData)
+    {
+        struct io_uring_sqe* entry = Entry();
+
+#ifdef __CORE_IO_URING__
+        if (entry != nullptr) {
+            entry->opcode = IORING_OP_POLL_ADD;
+            entry->fd = descriptor;
+            entry->user_data = userData;
+#if defined(IORING_FEAT_POLL_32BITS)
+#if __BYTE_ORDER == __BIG_ENDIAN
+            entry->poll32_events = ((static_cast<uint32_t>(events) << 16) | (static_cast<uint32_t>(events) >> 16));
+#else
+            entry->poll32_events = events;
+#endif
+#else
+            entry->poll_events = events;
+#endif
+        }
+#else
+        DEBUG_VARIABLE(descriptor);
+        DEBUG_VARIABLE(events);
+        DEBUG_VARIABLE(userData);
+#endif
+
+        return (entry != nullptr);
+    }
+
+    bool IOUring::Accept(const int descriptor, const uint64_t userData)
+    {
+        struct io_uring_sqe* entry = nullptr;
+
+#if defined(__CORE_IO_URING__) && defined(IORING_ACCEPT_MULTISHOT)
+        entry = Entry();
+
+        if (entry != nullptr) {
+            entry->opcode = IORING_OP_ACCEPT;
+            entry->fd = descriptor;
+            entry->ioprio = IORING_ACCEPT_MULTISHOT;
+            // One address buffer would be shared by all connections, the remote address is left to getpeername.
+            entry->addr = 0;
+            entry->addr2 = 0;
+            entry->accept_flags = SOCK_CLOEXEC;
+            entry->user_data = userData;
+        }
+#else
+        DEBUG_VARIABLE(descriptor);
+        DEBUG_VARIABLE(userData);
+#endif
+
+        return (entry != nullptr);
+    }
+
+    bool IOUring::Provide(uint8_t buffer[], const uint32_t size, const uint16_t count, const uint16_t group, const uint16_t first, const uint64_t userData)
+    {
+        struct io_uring_sqe* entry = nullptr;
+
+#if defined(__CORE_IO_URING__) && defined(IOSQE_BUFFER_SELECT)
+        entry = Entry();
+
+        if (entry != nullptr) {
+            entry->opcode = IORING_OP_PROVIDE_BUFFERS;
+            entry->fd = count;
+            entry->addr = reinterpret_cast<uintptr_t>(buffer);
+            entry->len = size;
+            entry->off = first;
+            entry->buf_group = group;
+            entry->user_data = userData;
+        }
+#else
+        DEBUG_VARIABLE(buffer);
+        DEBUG_VARIABLE(size);
+        DEBUG_VARIABLE(count);
+        DEBUG_VARIABLE(group);
+        DEBUG_VARIABLE(first);
+        DEBUG_VARIABLE(userData);
+#endif
+
+        return (entry != nullptr);
+    }
+
+    bool IOUring::Receive(const int descriptor, const uint32_t length, const uint16_t group, const uint64_t userData)
+    {
+        struct io_uring_sqe* entry = nullptr;
+
+#if defined(__CORE_IO_URING__) && defined(IOSQE_BUFFER_SELECT)
+        entry = Entry();
+
+        if (entry != nullptr) {
+            entry->opcode = IORING_OP_RECV;
+            entry->flags = IOSQE_BUFFER_SELECT;
+            entry->fd = descriptor;
+            entry->addr = 0;
+            entry->len = length;
+            entry->buf_group = group;
+            entry->user_data = userData;
+        }
+#else
+        DEBUG_VARIABLE(descriptor);
+        DEBUG_VARIABLE(length);
+        DEBUG_VARIABLE(group);
+        DEBUG_VARIABLE(userData);
+#endif
+
+        return (entry != nullptr);
+    }
+
+    bool IOUring::Send(const int descriptor, const uint8_t buffer[], const uint32_t length, const uint64_t userData)
+    {
+        struct io_uring_sqe* entry = nullptr;
+
+#if defined(__CORE_IO_URING__) && defined(IOSQE_BUFFER_SELECT)
+        entry = Entry();
+
+        if (entry != nullptr) {
+            entry->opcode = IORING_OP_SEND;
+            entry->fd = descriptor;
+            entry->addr = reinterpret_cast<uintptr_t>(buffer);
+            entry->len = length;
+            // A peer that is gone is reported in the completion, not by a signal.
+            entry->msg_flags = MSG_NOSIGNAL;
+            entry->user_data = userData;
+        }
+#else
+        DEBUG_VARIABLE(descriptor);
+        DEBUG_VARIABLE(buffer);
+        DEBUG_VARIABLE(length);
+        DEBUG_VARIABLE(userData);
+#endif
+
+        return (entry != nullptr);
+    }
+
+    bool IOUring::Cancel(const uint64_t userData, const bool poll)
+    {
+        struct io_uring_sqe* entry = Entry();
+
+#ifdef __CORE_IO_URING__
+        if (entry != nullptr) {
+            // POLL_REMOVE is as old as the polls, anything else is cancelled with ASYNC_CANCEL.
+            entry->opcode = (poll == true ? IORING_OP_POLL_REMOVE : IORING_OP_ASYNC_CANCEL);
+            entry->fd = -1;
+            entry->addr = userData;
+            entry->user_data = 0;
+        }
+#else
+        DEBUG_VARIABLE(userData);
+        DEBUG_VARIABLE(poll);
+#endif
+
+        return (entry != nullptr);
+    }
+
+    int IOUring::Submit(const bool wait)
+    {
+        int result = -1;
+
+#ifdef __CORE_IO_URING__
+        const uint32_t pending = _queued - __atomic_load_n(_submissionHead, __ATOMIC_ACQUIRE);
+
+        __atomic_store_n(_submissionTail, _queued, __ATOMIC_RELEASE);
+
+        result = static_cast<int>(::syscall(__NR_io_uring_enter, _descriptor, pending, (wait == true ? 1 : 0), (wait == true ? IORING_ENTER_GETEVENTS : 0), nullptr, 0));
+
+        if ((result == -1) && (errno == EBUSY)) {
+            // The completions overflowed, they are waiting to be harvested.
+            result = 0;
+        }
+#else
+        DEBUG_VARIABLE(wait);
+        errno = ENOSYS;
+#endif
+
+        return (result);
+    }
+
+    bool IOUring::Completion(uint64_t& userData, int32_t& result, bool& more, int32_t& buffer)
+    {
+        bool available = false;
+
+#ifdef __CORE_IO_URING__
+        const uint32_t head = *_completionHead;
+
+        if (head != __atomic_load_n(_completionTail, __ATOMIC_ACQUIRE)) {
+            const struct io_uring_cqe& entry(_completions[head & _completionMask]);
+
+            userData = entry.user_data;
+            result = entry.res;
+#ifdef IORING_CQE_F_MORE
+            more = ((entry.flags & IORING_CQE_F_MORE) != 0);
+#else
+            more = false;
+#endif
+#ifdef IOSQE_BUFFER_SELECT
+            buffer = ((entry.flags & IORING_CQE_F_BUFFER) != 0 ? static_cast<int32_t>(entry.flags >> IORING_CQE_BUFFER_SHIFT) : -1);
+#else
+            buffer = -1;
+#endif
+            available = true;
+
+            __atomic_store_n(_completionHead, head + 1, __ATOMIC_RELEASE);
+        }
+#else
+        DEBUG_VARIABLE(userData);
+        DEBUG_VARIABLE(result);
+        DEBUG_VARIABLE(more);
+        DEBUG_VARIABLE(buffer);
+#endif
+
+        return (available);
+    }
+}
+} // namespace WPEFramework::Core
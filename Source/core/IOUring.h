@@ -0,0 +1,117 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "Portability.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace WPEFramework {
+namespace Core {
+
+    // The submission/completion rings of an io_uring, talking to the kernel directly (no liburing). It
+    // only offers what the ResourceMonitor needs: one shot polls, multishot accepts, receives into provided
+    // buffers, sends, cancelling them and harvesting the completions. Whether the kernel (or the build, see
+    // IO_URING) supports it is only known once it is constructed, check IsValid(). All methods are to be
+    // called from a single thread.
+    class EXTERNAL IOUring {
+    public:
+        IOUring() = delete;
+        IOUring(const IOUring&) = delete;
+        IOUring& operator=(const IOUring&) = delete;
+
+        IOUring(const uint32_t entries);
+        ~IOUring();
+
+    public:
+        inline bool IsValid() const
+        {
+            return (_descriptor != -1);
+        }
+        // Whether receives into provided buffers and sends can be queued. Before 5.7 (IORING_FEAT_FAST_POLL)
+        // the kernel either lacks them, or has a worker thread block on every socket that is not ready.
+        inline bool Transfers() const
+        {
+            return (_transfers);
+        }
+
+        // Queue a one shot poll, it completes (with the signalled events as result) once any of the events
+        // is set, which might be immediately. userData identifies the completion.
+        bool Poll(const int descriptor, const uint16_t events, const uint64_t userData);
+
+        // Queue a multishot accept, every connection accepted on the listening descriptor completes with
+        // userData and the new descriptor (close on exec) as result. It stays queued as long as its
+        // completions report more. Kernels before 5.19 refuse it, it completes with -EINVAL.
+        bool Accept(const int descriptor, const uint64_t userData);
+
+        // Queue handing count buffers of size bytes each, laid out from buffer on, to the kernel as the given group.
+        // They are identified by first and up, a receive that selects from the group takes one of them.
+        bool Provide(uint8_t buffer[], const uint32_t size, const uint16_t count, const uint16_t group, const uint16_t first, const uint64_t userData);
+
+        // Queue a receive of at most length bytes into a buffer the kernel selects from the group, it completes with
+        // the bytes received (0 if the peer closed) and the buffer taken. Without a buffer left it completes with -ENOBUFS.
+        bool Receive(const int descriptor, const uint32_t length, const uint16_t group, const uint64_t userData);
+
+        // Queue a send of the buffer, it completes with the bytes sent. The buffer must stay as is till then.
+        bool Send(const int descriptor, const uint8_t buffer[], const uint32_t length, const uint64_t userData);
+
+        // Queue the cancellation of the poll (or accept) queued with userData. It completes with -ECANCELED,
+        // unless it already completed, the cancellation itself completes with userData 0.
+        bool Cancel(const uint64_t userData, const bool poll = true);
+
+        // Hand all queued requests to the kernel, if requested wait till at least one completion is available.
+        // Returns -1 (and errno) on failure, like poll does.
+        int Submit(const bool wait);
+
+        // Take the oldest completion, if there is one. More tells if the request stays queued (multishot), buffer
+        // is the provided buffer a receive took, -1 if none.
+        bool Completion(uint64_t& userData, int32_t& result, bool& more, int32_t& buffer);
+
+    private:
+        void* Map(const uint32_t size, const uint64_t offset) const;
+        void Destroy();
+        struct io_uring_sqe* Entry();
+
+    private:
+        int _descriptor;
+        void* _submissionRing;
+        uint32_t _submissionRingSize;
+        void* _completionRing;
+        uint32_t _completionRingSize;
+        struct io_uring_sqe* _entries;
+        uint32_t _entriesSize;
+
+        uint32_t* _submissionHead;
+        uint32_t* _submissionTail;
+        uint32_t* _submissionArray;
+        uint32_t _submissionMask;
+        uint32_t _submissionCount;
+        uint32_t _queued;
+
+        uint32_t* _completionHead;
+        uint32_t* _completionTail;
+        struct io_uring_cqe* _completions;
+        uint32_t _completionMask;
+        bool _transfers;
+    };
+}
+} // namespace WPEFramework::Core
@@ -724,7 +724,12 @@ namespace Core {
                 bool completed = ((_set & ERROR) != 0);
 
                 while ((loaded < maxLength) && (completed == false)) {
-                    if (isdigit(stream[loaded])) {
+                    uint32_t chunk;
+
+                    if (((_set & 0x1F) == DECIMAL) && ((maxLength - loaded) >= 8) && (FromEightDigits(&(stream[loaded]), chunk) == true)) {
+                        _value = static_cast<TYPE>((static_cast<uint64_t>(_value) * 100000000) + chunk);
+                        loaded += 8;
+                    } else if (isdigit(stream[loaded])) {
                         _value *= (_set & 0x1F);
                         _value += (stream[loaded] - '0');
                         loaded++;
@@ -775,7 +780,7 @@ namespace Core {
 
             uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint32_t& offset) override
             {
-                uint8_t loaded = 0;
+                uint16_t loaded = 0;
                 if (offset == 0) {
                     // First byte depicts a lot. Find out what we need to read
                     _value = 0;
@@ -787,58 +792,53 @@ namespace Core {
                         _set = (1 << (header - 0xCC)) << 12;
                         offset = 1;
                     } else if ((header >= 0xD0) && (header <= 0xD3)) {
-                        _set = (1 << (header - 0xD0)) << 12;
+                        _set = ((1 << (header - 0xD0)) << 12) | NEGATIVE;
                         offset = 1;
-                    } else if ((header & 0x80) == 0) {
-                        _value = (header & 0x7F);
-                    } else if ((header & 0xE0) == 0xE0) {
-                        _value = (header & 0x0F);
-                        _set = NEGATIVE;
+                    } else if (((header & 0x80) == 0) || ((header & 0xE0) == 0xE0)) {
+                        // Positive and negative fixints carry the value in the header.
+                        _value = static_cast<TYPE>(static_cast<int8_t>(header));
+                        _set = SET;
                     } else {
                         _set = ERROR;
                     }
                 }
 
-                while ((loaded < maxLength) && (offset != 0)) {
-                    _value = _value << 8;
-                    _value += stream[loaded++];
-                    offset = (offset == ((_set >> 12) & 0xF) ? 0 : offset + 1);
-                }
+                if (offset != 0) {
+                    const uint8_t bytes = static_cast<uint8_t>(_set >> 12);
 
-                if (_value != 0) {
-                    _set |= SET;
+                    while ((loaded < maxLength) && (offset != 0)) {
+                        _value = static_cast<TYPE>((static_cast<uint64_t>(_value) << 8) | stream[loaded++]);
+                        offset = (offset == bytes ? 0 : offset + 1);
+                    }
+
+                    if (offset == 0) {
+                        // Signed values narrower than TYPE need their sign extended.
+                        if (((_set & NEGATIVE) != 0) && (bytes < sizeof(TYPE)) && (((static_cast<uint64_t>(_value) >> ((8 * bytes) - 1)) & 0x01) != 0)) {
+                            _value = static_cast<TYPE>(static_cast<uint64_t>(_value) | (~static_cast<uint64_t>(0) << (8 * bytes)));
+                        }
+                        _set = SET;
+                    }
                 }
+
                 return (loaded);
             }
 
-            uint16_t Convert(char stream[], const uint16_t maxLength, uint32_t& offset, const TYPE serialize) const
+            uint16_t Convert(char stream[], const uint16_t maxLength, uint32_t& offset, const uint64_t serialize) const
             {
-                uint8_t parsed = 4;
+                char digits[24];
                 uint16_t loaded = 0;
-                TYPE divider = 1;
-                TYPE value = (serialize / BASETYPE);
+                const uint8_t length = (BASETYPE == BASE_HEXADECIMAL ? Core::ToHexadecimal(serialize, &digits[sizeof(digits)]) : BASETYPE == BASE_OCTAL ? Core::ToOctal(serialize, &digits[sizeof(digits)]) : Core::ToDecimal(serialize, &digits[sizeof(digits)]));
+                const char* text = &digits[sizeof(digits) - length];
 
-                while (divider <= value) {
-                    divider *= BASETYPE;
-                }
-
-                value = serialize;
+                // The digits already written are accounted for in the offset, beyond 4.
+                uint32_t index = (offset - 4);
 
-                while ((divider > 0) && (loaded < maxLength)) {
-                    if (parsed >= offset) {
-                        uint8_t digit = static_cast<uint8_t>(value / divider);
-                        if ((BASETYPE != BASE_HEXADECIMAL) || (digit < 10)) {
-                            stream[loaded++] = static_cast<char>('0' + digit);
-                        } else {
-                            stream[loaded++] = static_cast<char>('A' - 10 + digit);
-                        }
-                        offset++;
-                    }
-                    parsed++;
-                    value %= divider;
-                    divider /= BASETYPE;
+                while ((index < length) && (loaded < maxLength)) {
+                    stream[loaded++] = text[index++];
                 }
 
+                offset = index + 4;
+
                 if ((BASETYPE == BASE_DECIMAL) && (loaded < maxLength)) {
                     offset = 0;
                 }
@@ -848,26 +848,23 @@ namespace Core {
 
             uint16_t Convert(char stream[], const uint16_t maxLength, uint32_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
             {
-                return (Convert(stream, maxLength, offset, _value));
+                return (Convert(stream, maxLength, offset, static_cast<uint64_t>(_value)));
             }
 
             uint16_t Convert(char stream[], const uint16_t maxLength, uint32_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
             {
-                return (Convert(stream, maxLength, offset, ::abs(_value)));
+                // Negate in the unsigned domain, the most negative value has no positive counterpart.
+                return (Convert(stream, maxLength, offset, (_value < 0 ? (static_cast<uint64_t>(0) - static_cast<uint64_t>(_value)) : static_cast<uint64_t>(_value))));
             }
 
             uint16_t Convert(uint8_t stream[], const uint16_t maxLength, uint32_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
             {
                 uint8_t loaded = 0;
-                uint8_t bytes = (_value <= 0x7F ? 0 : _value < 0xFF ? 1 : _value < 0xFFFF ? 2 : _value < 0xFFFFFFFF ? 4 : 8);
+                uint8_t bytes = (_value <= 0x7F ? 0 : _value <= 0xFF ? 1 : _value <= 0xFFFF ? 2 : _value <= 0xFFFFFFFF ? 4 : 8);
 
                 if (offset == 0) {
                     if (bytes == 0) {
-                        if (_value != 0) {
-                            stream[loaded++] = static_cast<uint8_t>(_value);
-                        } else {
-                            stream[loaded++] = IMessagePack::NullValue;
-                        }
+                        stream[loaded++] = static_cast<uint8_t>(_value);
                     } else {
                         switch (bytes) {
                         case 1:
@@ -902,11 +899,11 @@ namespace Core {
             uint16_t Convert(uint8_t stream[], const uint16_t maxLength, uint32_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
             {
                 uint8_t loaded = 0;
-                uint8_t bytes = (((_value < 16) && (_value > -15)) ? 0 : ((_value < 128) && (_value > -127)) ? 1 : ((_value < 32767) && (_value > -32766)) ? 2 : ((_value < 2147483647) && (_value > -2147483646)) ? 4 : 8);
+                uint8_t bytes = (((_value <= 127) && (_value >= -32)) ? 0 : ((_value <= 127) && (_value >= -128)) ? 1 : ((_value <= 32767) && (_value >= -32768)) ? 2 : ((_value <= 2147483647) && (_value >= (-2147483647 - 1))) ? 4 : 8);
 
                 if (offset == 0) {
                     if (bytes == 0) {
-                        stream[loaded++] = (_value & 0x1F) | 0xE0;
+                        stream[loaded++] = static_cast<uint8_t>(_value);
                     } else {
                         switch (bytes) {
                         case 1:
@@ -1067,93 +1064,87 @@ namespace Core {
             // If this should be serialized/deserialized, it is indicated by a MinSize > 0)
             uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
             {
+                char text[32];
+                const char* source = IElement::NullTag;
+                uint32_t length = static_cast<uint32_t>(strlen(IElement::NullTag));
                 uint16_t loaded = 0;
 
                 ASSERT(maxLength > 0);
 
-                if ((_set & UNDEFINED) != 0 || 
-                    std::isinf(_value) ||
-                    std::isnan(_value)) 
-                {
-                    auto len = strlen(IElement::NullTag);
-                    ASSERT (offset < len);
-                    while(loaded < (len - offset))
-                    {
-                        stream[loaded] = IElement::NullTag[offset + loaded];
-                        loaded++;
-                    }
+                if (((_set & UNDEFINED) == 0) && (std::isinf(_value) == false) && (std::isnan(_value) == false)) {
+                    length = Core::ToShortest(_value, text);
+                    source = text;
                 }
-                else
-                {
-                    auto num = std::snprintf(stream,maxLength,"%g",_value);
-                    loaded = num > 0 ? num : 0;
+
+                while ((offset < length) && (loaded < maxLength)) {
+                    stream[loaded++] = source[offset++];
                 }
-                
-                return loaded;
+
+                if (offset == length) {
+                    offset = 0;
+                }
+
+                return (loaded);
             }
-            
-            uint16_t Deserialize(const char stream[], const uint16_t, uint32_t& offset, Core::OptionalType<Error>& error) override
+
+            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override
             {
                 uint16_t loaded = 0;
 
                 if (offset == 0) {
                     _value = 0;
                     _set = 0;
+                    _text.clear();
+
+                    if ((maxLength > 0) && (stream[0] == '\"')) {
+                        _set = QUOTED;
+                        loaded++;
+                    }
+                    offset = 1;
                 }
 
-                std::string str;
+                const uint16_t start = loaded;
 
-                if (stream[loaded] == '\"') {
-                    _set = QUOTED;
-                    offset++;
+                while ((loaded < maxLength) && (stream[loaded] != '\"') && (stream[loaded] != ',') && (stream[loaded] != ']') && (stream[loaded] != '}') && (stream[loaded] != ')') && (stream[loaded] != '\0') && (((_set & QUOTED) != 0) || (::isspace(stream[loaded]) == 0))) {
                     loaded++;
                 }
 
-                while(stream[loaded] != '\"' && 
-                      stream[loaded] != ',' && 
-                      stream[loaded] != ']' && 
-                      stream[loaded] != '}' &&
-                      stream[loaded] != ')') {
-                    
-                    str += stream[loaded++];
+                if (loaded == maxLength) {
+                    // The number continues in the next chunk.
+                    _text.append(&(stream[start]), loaded - start);
+                } else {
+                    const char* text = &(stream[start]);
+                    uint32_t length = loaded - start;
 
-                }
+                    if (_text.empty() == false) {
+                        _text.append(text, length);
+                        text = _text.c_str();
+                        length = static_cast<uint32_t>(_text.length());
+                    }
 
-                if (stream[loaded] == '\"') {
-                    loaded++;
-                }
+                    if (stream[loaded] == '\"') {
+                        loaded++;
+                    }
 
-                if(str == IElement::NullTag)
-                {
-                    _set |= UNDEFINED;
-                    return loaded;
-                }
+                    if ((length == strlen(IElement::NullTag)) && (::strncmp(text, IElement::NullTag, length) == 0)) {
+                        _set |= UNDEFINED;
+                    } else {
+                        TYPE value;
 
-                TYPE val;
-                char* end;
-                if(std::is_same<float,TYPE>::value)
-                {
-                    val = std::strtof(str.c_str(), &end);
-                }
-                else
-                {
-                    val = static_cast<TYPE>(std::strtod(str.c_str(), &end));
-                }
+                        if (Core::FromText(text, length, value) == 0) {
+                            error = Error{ "Error converting \"" + std::string(text, length) + "\" to a float/double" };
+                            _set = ERROR;
+                        } else {
+                            _value = value;
+                            _set |= SET;
+                        }
+                    }
 
-                if(end == str.c_str())
-                {
-                    error = Error{ "Error converting \"" + str + "\" to a float/double" };
-                    _set = ERROR;
-                }
-                else
-                {
-                    _value = val;
-                    _set |= SET;
+                    _text.clear();
+                    offset = 0;
                 }
-                
-                offset = 0;
 
-                return loaded;
+                return (loaded);
             }
 
             // IMessagePack iface:
@@ -1232,6 +1223,7 @@ namespace Core {
             uint16_t _set;
             TYPE _value;
             TYPE _default;
+            std::string _text;
         };
 
         typedef FloatType<float> Float;
@@ -1867,45 +1859,42 @@ namespace Core {
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint32_t& offset) const override
             {
                 uint16_t loaded = 0;
+                const uint32_t length = static_cast<uint32_t>(_value.length());
+
                 if (offset == 0) {
                     if ((_scopeCount & NullBit) != 0) {
                         stream[loaded++] = IMessagePack::NullValue;
-                    } else if (_value.length() <= 31) {
-                        _unaccountedCount = 1;
-                        stream[loaded++] = static_cast<uint8_t>(_value.length() | 0xA0);
-                        offset++;
-                    } else if (_value.length() <= 0xFF) {
-                        _unaccountedCount = 2;
-                        stream[loaded++] = 0xD9;
-                        offset++;
-                    } else if (_value.length() <= 0xFFFF) {
-                        _unaccountedCount = 3;
-                        stream[loaded++] = 0xDA;
-                        offset++;
                     } else {
-                        stream[loaded++] = IMessagePack::NullValue;
+                        // _unaccountedCount holds the size of the header, the payload follows it.
+                        if (length <= 31) {
+                            _unaccountedCount = 1;
+                            stream[loaded++] = static_cast<uint8_t>(length | 0xA0);
+                        } else if (length <= 0xFF) {
+                            _unaccountedCount = 2;
+                            stream[loaded++] = 0xD9;
+                        } else if (length <= 0xFFFF) {
+                            _unaccountedCount = 3;
+                            stream[loaded++] = 0xDA;
+                        } else {
+                            _unaccountedCount = 5;
+                            stream[loaded++] = 0xDB;
+                        }
+                        offset = 1;
                     }
                 }
 
                 if (offset != 0) {
                     while ((loaded < maxLength) && (offset < _unaccountedCount)) {
-                        stream[loaded++] = static_cast<uint8_t>((_value.length() >> (8 * (_unaccountedCount - offset - 1))) & 0xFF);
+                        stream[loaded++] = static_cast<uint8_t>((length >> (8 * (_unaccountedCount - offset - 1))) & 0xFF);
                         offset++;
                     }
 
-                    uint16_t copied = 0;
-                    while ((loaded < maxLength) && (offset != 0)) {
-                        copied = static_cast<uint16_t>(_value.copy(reinterpret_cast<char*>(&stream[loaded]), (maxLength - loaded), offset - _unaccountedCount));
-                        offset += copied;
-                        loaded += copied;
-                        if (_unaccountedCount) {
-                           offset -=_unaccountedCount;
-                           _unaccountedCount = 0;
-                        }
+                    if (offset >= _unaccountedCount) {
+                        const uint32_t position = offset - _unaccountedCount;
+                        uint16_t copied = static_cast<uint16_t>(_value.copy(reinterpret_cast<char*>(&stream[loaded]), (maxLength - loaded), position));
 
-                        if (offset >= _value.length()) {
-                            offset = 0;
-                        }
+                        loaded += copied;
+                        offset = ((position + copied) >= length ? 0 : offset + copied);
                     }
                 }
 
@@ -1915,42 +1904,51 @@ namespace Core {
             uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint32_t& offset) override
             {
                 uint16_t loaded = 0;
+
+                // The offset counts the header bytes still to come up to 5, the payload follows it.
                 if (offset == 0) {
+                    uint8_t header = stream[loaded++];
+
                     _value.clear();
-                    if (stream[loaded] == IMessagePack::NullValue) {
+                    _unaccountedCount = 0;
+
+                    if (header == IMessagePack::NullValue) {
                         _scopeCount |= NullBit;
-                        loaded++;
-                    } else if ((stream[loaded] & 0xA0) == 0xA0) {
-                        _unaccountedCount = stream[loaded] & 0x1F;
+                    } else if ((header & 0xE0) == 0xA0) {
+                        _unaccountedCount = header & 0x1F;
+                        offset = 5;
+                    } else if (header == 0xD9) {
+                        offset = 4;
+                    } else if (header == 0xDA) {
                         offset = 3;
-                        loaded++;
-                    } else if (stream[loaded] == 0xD9) {
-                        _unaccountedCount = 0;
-                        offset = 2;
-                        loaded++;
-                    } else if (stream[loaded] == 0xDA) {
-                        _unaccountedCount = 0;
+                    } else if (header == 0xDB) {
                         offset = 1;
-                        loaded++;
                     } else {
                         loaded = maxLength;
                     }
                 }
 
                 if (offset != 0) {
-                    while ((loaded < maxLength) && (offset < 3)) {
-                        _unaccountedCount = (_unaccountedCount << 8) + stream[loaded++];
+                    while ((loaded < maxLength) && (offset < 5)) {
+                        _unaccountedCount = (_unaccountedCount << 8) | stream[loaded++];
                         offset++;
                     }
 
-                    while ((loaded < maxLength) && ((offset - 3) < static_cast<uint16_t>(_unaccountedCount))) {
-                        _value += static_cast<char>(stream[loaded++]);
-                        offset++;
-                    }
+                    if (offset >= 5) {
+                        const uint32_t position = offset - 5;
+                        const uint32_t copied = std::min(static_cast<uint32_t>(maxLength - loaded), _unaccountedCount - position);
 
-                    if ((offset >= 3) && (static_cast<uint16_t>(offset - 3) == _unaccountedCount)) {
-                        offset = 0;
-                        _scopeCount |= ((_scopeCount & QuoteFoundBit) ? SetBit : (_value == NullTag ? NullBit : SetBit));
+                        if (position == 0) {
+                            _value.reserve(_unaccountedCount);
+                        }
+                        _value.append(reinterpret_cast<const char*>(&stream[loaded]), copied);
+                        loaded += static_cast<uint16_t>(copied);
+                        offset += copied;
+
+                        if ((position + copied) == _unaccountedCount) {
+                            offset = 0;
+                            _scopeCount |= ((_scopeCount & QuoteFoundBit) ? SetBit : (_value == NullTag ? NullBit : SetBit));
+                        }
                     }
                 }
 
@@ -2499,6 +2497,7 @@ namespace Core {
                 if ((offset == 0) && (_state != UNDEFINED)) {
                     if (_package.IsSet() == true) {
                         _value = static_cast<ENUMERATE>(_package.Value());
+                        _state = SET;
                     } else {
                         _state = ERROR;
                     }
@@ -3029,13 +3028,14 @@ namespace Core {
                 if (offset == 0) {
                     if (stream[0] == IMessagePack::NullValue) {
                         _state = UNDEFINED;
-                        loaded = 1;
                     } else if ((stream[0] & 0xF0) == 0x90) {
                         _count = (stream[0] & 0x0F);
-                        offset = PARSE;
-                    } else if (stream[0] & 0xDC) {
+                        offset = (_count > 0 ? PARSE : 0);
+                    } else if (stream[0] == 0xDC) {
+                        _count = 0;
                         offset = 1;
                     }
+                    loaded = 1;
                 }
 
                 while ((loaded < maxLength) && (offset > 0) && (offset < PARSE)) {
@@ -3044,24 +3044,22 @@ namespace Core {
                         offset = 2;
                     } else if (offset == 2) {
                         _count = (_count << 8) | stream[loaded++];
-                        offset = PARSE;
+                        offset = (_count > 0 ? PARSE : 0);
                     }
                 }
 
                 while ((loaded < maxLength) && (offset >= PARSE)) {
-
                     if (offset == PARSE) {
-                        if (_count > 0) {
-                            _count--;
-                            _data.emplace_back(ELEMENT());
-                        } else {
-                            offset = 0;
-                        }
+                        _count--;
+                        _data.emplace_back(ELEMENT());
                     }
-                    if (offset >= PARSE) {
-                        offset -= PARSE;
-                        loaded += static_cast<IMessagePack&>(_data.back()).Deserialize(stream, maxLength, offset);
-                        offset += PARSE;
+
+                    offset -= PARSE;
+                    loaded += static_cast<IMessagePack&>(_data.back()).Deserialize(&(stream[loaded]), maxLength - loaded, offset);
+                    offset += PARSE;
+
+                    if ((offset == PARSE) && (_count == 0)) {
+                        offset = 0;
                     }
                 }
 
@@ -3094,6 +3092,79 @@ namespace Core {
             typedef std::pair<const TCHAR*, IElement*> JSONLabelValue;
             typedef std::list<JSONLabelValue> JSONElementList;
 
+        public:
+            // A member known at compile time. Containers constructed on a static table of
+            // these do not need to register (Add) their members for every instance.
+            struct Field {
+                const TCHAR* Label;
+                IElement* (*Element)(Container& parent);
+            };
+
+            template <typename CONTAINER, typename ELEMENT, ELEMENT CONTAINER::*MEMBER>
+            static IElement* Member(Container& parent)
+            {
+                return (&(static_cast<CONTAINER&>(parent).*MEMBER));
+            }
+
+        private:
+            // Walks the static fields first, followed by the members that were added.
+            class Cursor {
+            public:
+                Cursor() = delete;
+                Cursor(const Cursor& copy) = delete;
+                Cursor& operator=(const Cursor& RHS) = delete;
+
+                Cursor(const Container& parent)
+                    : _parent(parent)
+                    , _index(0)
+                    , _entry(parent._data.begin())
+                {
+                }
+                ~Cursor()
+                {
+                }
+
+            public:
+                void Reset()
+                {
+                    _index = 0;
+                    _entry = _parent._data.begin();
+                }
+                bool IsValid() const
+                {
+                    return ((_index < _parent._count) || (_entry != _parent._data.end()));
+                }
+                void Next()
+                {
+                    ASSERT(IsValid() == true);
+
+                    if (_index < _parent._count) {
+                        _index++;
+                    } else {
+                        _entry++;
+                    }
+                }
+                const TCHAR* Label() const
+                {
+                    ASSERT(IsValid() == true);
+
+                    return (_index < _parent._count ? _parent._fields[_index].Label : _entry->first);
+                }
+                IElement* Element() const
+                {
+                    ASSERT(IsValid() == true);
+
+                    return (_index < _parent._count ? _parent._fields[_index].Element(const_cast<Container&>(_parent)) : _entry->second);
+                }
+
+            private:
+                const Container& _parent;
+                uint16_t _index;
+                JSONElementList::const_iterator _entry;
+            };
+
+            // Walks the members the way Serialize/Deserialize do (on a Cursor of its own), the static fields
+            // first, followed by the members that were added.
             class Iterator {
             private:
                 enum State {
@@ -3108,10 +3179,8 @@ namespace Core {
                 Iterator& operator=(const Iterator& RHS);
 
             public:
-                Iterator(Container& parent, JSONElementList& container)
-                    : _parent(parent)
-                    , _container(container)
-                    , _iterator(container.begin())
+                Iterator(Container& parent)
+                    : _cursor(parent)
                     , _state(AT_BEGINNING)
                 {
                 }
@@ -3123,7 +3192,7 @@ namespace Core {
             public:
                 void Reset()
                 {
-                    _iterator = _container.begin();
+                    _cursor.Reset();
                     _state = AT_BEGINNING;
                 }
 
@@ -3131,10 +3200,10 @@ namespace Core {
                 {
                     if (_state != AT_END) {
                         if (_state != AT_BEGINNING) {
-                            _iterator++;
+                            _cursor.Next();
                         }
 
-                        _state = (_iterator != _container.end() ? AT_ELEMENT : AT_END);
+                        _state = (_cursor.IsValid() == true ? AT_ELEMENT : AT_END);
                     }
                     return (_state == AT_ELEMENT);
                 }
@@ -3143,21 +3212,19 @@ namespace Core {
                 {
                     ASSERT(_state == AT_ELEMENT);
 
-                    return (*_iterator).first;
+                    return (_cursor.Label());
                 }
 
                 IElement* Element()
                 {
                     ASSERT(_state == AT_ELEMENT);
-                    ASSERT((*_iterator).second != nullptr);
+                    ASSERT(_cursor.Element() != nullptr);
 
-                    return ((*_iterator).second);
+                    return (_cursor.Element());
                 }
 
             private:
-                Container& _parent;
-                JSONElementList& _container;
-                JSONElementList::iterator _iterator;
+                Cursor _cursor;
                 State _state;
             };
 
@@ -3167,8 +3234,21 @@ namespace Core {
 
             Container()
                 : _state(0)
+                , _fields(nullptr)
+                , _count(0)
+                , _pending(0)
+                , _data()
+                , _iterator(*this)
+                , _fieldName(true)
+            {
+            }
+            Container(const Field fields[], const uint16_t count)
+                : _state(0)
+                , _fields(fields)
+                , _count(count)
+                , _pending(0)
                 , _data()
-                , _iterator()
+                , _iterator(*this)
                 , _fieldName(true)
             {
             }
@@ -3180,25 +3260,25 @@ namespace Core {
         public:
             bool HasLabel(const string& label) const
             {
-                JSONElementList::const_iterator index(_data.begin());
+                Cursor index(*this);
 
-                while ((index != _data.end()) && (index->first != label)) {
-                    index++;
+                while ((index.IsValid() == true) && (index.Label() != label)) {
+                    index.Next();
                 }
 
-                return (index != _data.end());
+                return (index.IsValid());
             }
 
             // IElement and IMessagePack iface:
             bool IsSet() const override
             {
-                JSONElementList::const_iterator index = _data.begin();
+                Cursor index(*this);
                 // As long as we did not find a set element, continue..
-                while ((index != _data.end()) && (index->second->IsSet() == false)) {
-                    index++;
+                while ((index.IsValid() == true) && (index.Element()->IsSet() == false)) {
+                    index.Next();
                 }
 
-                return (index != _data.end());
+                return (index.IsValid());
             }
 
             bool IsNull() const override
@@ -3209,12 +3289,12 @@ namespace Core {
 
             void Clear() override
             {
-                JSONElementList::const_iterator index = _data.begin();
+                Cursor index(*this);
 
                 // As long as we did not find a set element, continue..
-                while (index != _data.end()) {
-                    index->second->Clear();
-                    index++;
+                while (index.IsValid() == true) {
+                    index.Element()->Clear();
+                    index.Next();
                 }
             }
 
@@ -3222,7 +3302,10 @@ namespace Core {
             {
                 JSONElementList::const_iterator index = _data.begin();
 
-                // As long as we did not find a set element, continue..
+                // The static fields stay, only the added members are dropped.
+                for (uint16_t field = 0; field < _count; field++) {
+                    _fields[field].Element(*this)->Clear();
+                }
                 while (index != _data.end()) {
                     index->second->Clear();
                     index = _data.erase(index);
@@ -3247,19 +3330,19 @@ namespace Core {
                 }
             }
 
-        private:
-            // IElement iface:
+        protected:
+            // IElement iface, derived messages may wrap the (de)serialization of their members:
             uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
             {
                 uint16_t loaded = 0;
 
                 if (offset == FIND_MARKER) {
-                    _iterator = _data.begin();
+                    _iterator.Reset();
                     stream[loaded++] = '{';
 
-                    offset = (_iterator == _data.end() ? ~0 : ((_iterator->second->IsSet() == false) && (FindNext() == false)) ? ~0 : BEGIN_MARKER);
+                    offset = (_iterator.IsValid() == false ? ~0 : ((_iterator.Element()->IsSet() == false) && (FindNext() == false)) ? ~0 : BEGIN_MARKER);
                     if (offset == BEGIN_MARKER) {
-                        _fieldName = string(_iterator->first);
+                        _fieldName = string(_iterator.Label());
                         _current.json = &_fieldName;
                         offset = PARSE;
                     }
@@ -3275,12 +3358,12 @@ namespace Core {
                     } else if (offset == BEGIN_MARKER) {
                         if (_current.json == &_fieldName) {
                             stream[loaded++] = ':';
-                            _current.json = _iterator->second;
+                            _current.json = _iterator.Element();
                             offset = PARSE;
                         } else {
                             if (FindNext() != false) {
                                 stream[loaded++] = ',';
-                                _fieldName = string(_iterator->first);
+                                _fieldName = string(_iterator.Label());
                                 _current.json = &_fieldName;
                                 offset = PARSE;
                             } else {
@@ -3346,7 +3429,7 @@ namespace Core {
                         if (loaded < maxLength) {
                             switch (stream[loaded]) {
                             case '}':
-                                if (offset == SKIP_BEFORE && !_data.empty()) {
+                                if ((offset == SKIP_BEFORE) && ((_count != 0) || (_data.empty() == false))) {
                                     _state = ERROR;
                                     error = Error{ "Expected new element, \"}\" found." };
                                 } else if (offset == SKIP_BEFORE_VALUE || offset == SKIP_AFTER_KEY) {
@@ -3460,10 +3543,10 @@ namespace Core {
 
                 uint16_t elementSize = Size();
                 if (offset == 0) {
-                    _iterator = _data.begin();
+                    _iterator.Reset();
                     if (elementSize <= 15) {
-                        stream[loaded++] = (0x80 | static_cast<uint8_t>(Size()));
-                        if (_iterator != _data.end()) {
+                        stream[loaded++] = (0x80 | static_cast<uint8_t>(elementSize));
+                        if (_iterator.IsValid() == true) {
                             offset = PARSE;
                         }
                     } else {
@@ -3471,10 +3554,10 @@ namespace Core {
                         offset = 1;
                     }
                     if (offset != 0) {
-                        if ((_iterator->second->IsSet() == false) && (FindNext() == false)) {
+                        if ((_iterator.Element()->IsSet() == false) && (FindNext() == false)) {
                             offset = 0;
                         } else {
-                            _fieldName = string(_iterator->first);
+                            _fieldName = string(_iterator.Label());
                         }
                     }
                 }
@@ -3496,7 +3579,7 @@ namespace Core {
                         }
                         offset += PARSE;
                     } else {
-                        const IMessagePack* element = dynamic_cast<const IMessagePack*>(_iterator->second);
+                        const IMessagePack* element = dynamic_cast<const IMessagePack*>(_iterator.Element());
                         if (element != nullptr) {
                             loaded += element->Serialize(&(stream[loaded]), maxLength - loaded, offset);
                             if (offset == 0) {
@@ -3508,7 +3591,7 @@ namespace Core {
                         offset += PARSE;
                         if (offset == PARSE) {
                             if (FindNext() != false) {
-                                _fieldName = string(_iterator->first);
+                                _fieldName = string(_iterator.Label());
                             } else {
                                offset = 0;
                                _fieldName.Clear();
@@ -3527,10 +3610,11 @@ namespace Core {
                 if (offset == 0) {
                     if (stream[0] == IMessagePack::NullValue) {
                         _state = UNDEFINED;
-                    } else if ((stream[0] & 0x80) == 0x80) {
-                        _count = (stream[0] & 0x0F);
-                        offset = (_count > 0 ? PARSE : 0);
-                    } else if (stream[0] & 0xDE) {
+                    } else if ((stream[0] & 0xF0) == 0x80) {
+                        _pending = (stream[0] & 0x0F);
+                        offset = (_pending > 0 ? PARSE : 0);
+                    } else if (stream[0] == 0xDE) {
+                        _pending = 0;
                         offset = 1;
                     }
                     loaded = 1;
@@ -3538,11 +3622,11 @@ namespace Core {
 
                 while ((loaded < maxLength) && (offset > 0) && (offset < PARSE)) {
                     if (offset == 1) {
-                        _count = (_count << 8) | stream[loaded++];
+                        _pending = (_pending << 8) | stream[loaded++];
                         offset = 2;
                     } else if (offset == 2) {
-                        _count = (_count << 8) | stream[loaded++];
-                        offset = (_count > 0 ? PARSE : 0);
+                        _pending = (_pending << 8) | stream[loaded++];
+                        offset = (_pending > 0 ? PARSE : 0);
                     }
                 }
 
@@ -3556,8 +3640,8 @@ namespace Core {
                             if (offset == PARSE) {
                                 _fieldName.Clear();
                             // Seems like another field is completed. Reduce the count
-                                _count--;
-                                if (_count == 0) {
+                                _pending--;
+                                if (_pending == 0) {
                                     offset = 0;
                                 }
                             }
@@ -3578,21 +3662,23 @@ namespace Core {
                 return (loaded);
             }
 
+        private:
             IElement* Find(const char label[])
             {
                 IElement* result = nullptr;
 
-                JSONElementList::iterator index = _data.begin();
+                Cursor cursor(*this);
 
-                while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
-                    index++;
+                while ((cursor.IsValid() == true) && (strcmp(label, cursor.Label()) != 0)) {
+                    cursor.Next();
                 }
 
-                if (index != _data.end()) {
-                    result = index->second;
+                if (cursor.IsValid() == true) {
+                    result = cursor.Element();
                 }
                 else if (Request(label) == true) {
-                    index = _data.end();
+                    // Requested members are always added, never static.
+                    JSONElementList::iterator index = _data.end();
 
                     while ((result == nullptr) && (index != _data.begin())) {
                         index--;
@@ -3606,24 +3692,22 @@ namespace Core {
 
             bool FindNext() const
             {
-                _iterator++;
-                while ((_iterator != _data.end()) && (_iterator->second->IsSet() == false)) {
-                    _iterator++;
+                _iterator.Next();
+                while ((_iterator.IsValid() == true) && (_iterator.Element()->IsSet() == false)) {
+                    _iterator.Next();
                 }
-                return (_iterator != _data.end());
+                return (_iterator.IsValid());
             }
 
             uint16_t Size() const
             {
                 uint16_t count = 0;
-                if (_data.size() > 0) {
-                    JSONElementList::const_iterator iterator = _data.begin();
-                    while (iterator != _data.end()) {
-                        if (iterator->second->IsSet() != false) {
-                            count++;
-                        }
-                        iterator++;
+                Cursor index(*this);
+                while (index.IsValid() == true) {
+                    if (index.Element()->IsSet() != false) {
+                        count++;
                     }
+                    index.Next();
                 }
                 return count;
             }
@@ -3635,16 +3719,162 @@ namespace Core {
 
         private:
             uint8_t _state;
+            const Field* _fields;
             uint16_t _count;
+            uint16_t _pending;
             union {
                 mutable IElement* json;
                 mutable IMessagePack* pack;
             } _current;
             JSONElementList _data;
-            mutable JSONElementList::const_iterator _iterator;
+            mutable Cursor _iterator;
             mutable String _fieldName;
         };
 
+        // Bump allocator that keeps all allocations of a single document together. Individual
+        // allocations are never returned, the whole arena is released in one go when the
+        // document it belongs to is cleared or destructed.
+        class EXTERNAL Arena {
+        private:
+            struct Block {
+                Block* Next;
+            };
+
+        public:
+            Arena(const Arena&) = delete;
+            Arena& operator=(const Arena&) = delete;
+
+            explicit Arena(const uint32_t blockSize = 2048)
+                : _blocks(nullptr)
+                , _current(nullptr)
+                , _available(0)
+                , _blockSize(blockSize)
+            {
+            }
+            ~Arena()
+            {
+                Release();
+            }
+
+        public:
+            void* Allocate(const size_t size, const size_t alignment)
+            {
+                void* result;
+                size_t padding = Padding(_current, alignment);
+
+                if ((padding + size) <= _available) {
+                    result = &(_current[padding]);
+                    _current += (padding + size);
+                    _available -= (padding + size);
+                } else if ((size + alignment) > _blockSize) {
+                    // Oversized requests get a block of their own, the current block remains in use.
+                    uint8_t* location = NewBlock(size + alignment);
+                    result = &(location[Padding(location, alignment)]);
+                } else {
+                    _current = NewBlock(_blockSize);
+                    _available = _blockSize;
+                    padding = Padding(_current, alignment);
+                    result = &(_current[padding]);
+                    _current += (padding + size);
+                    _available -= (padding + size);
+                }
+
+                return (result);
+            }
+            const TCHAR* Duplicate(const TCHAR text[])
+            {
+                size_t length = (_tcslen(text) + 1) * sizeof(TCHAR);
+                TCHAR* result = reinterpret_cast<TCHAR*>(Allocate(length, alignof(TCHAR)));
+                ::memcpy(result, text, length);
+                return (result);
+            }
+            void Release()
+            {
+                while (_blocks != nullptr) {
+                    Block* next = _blocks->Next;
+                    ::free(_blocks);
+                    _blocks = next;
+                }
+                _current = nullptr;
+                _available = 0;
+            }
+
+        private:
+            static inline size_t Padding(const uint8_t* location, const size_t alignment)
+            {
+                return ((alignment - (reinterpret_cast<uintptr_t>(location) % alignment)) % alignment);
+            }
+            uint8_t* NewBlock(const size_t size)
+            {
+                Block* block = reinterpret_cast<Block*>(::malloc(sizeof(Block) + size));
+
+                ASSERT(block != nullptr);
+
+                block->Next = _blocks;
+                _blocks = block;
+
+                return (reinterpret_cast<uint8_t*>(&(block[1])));
+            }
+
+        private:
+            Block* _blocks;
+            uint8_t* _current;
+            size_t _available;
+            const uint32_t _blockSize;
+        };
+
+        // Standard allocator on top of an Arena, so STL containers can be kept in it.
+        template <typename TYPE>
+        class ArenaAllocator {
+        public:
+            typedef TYPE value_type;
+
+            template <typename OTHER>
+            struct rebind {
+                typedef ArenaAllocator<OTHER> other;
+            };
+
+        public:
+            ArenaAllocator() = delete;
+
+            explicit ArenaAllocator(Arena& arena)
+                : _arena(&arena)
+            {
+            }
+            template <typename OTHER>
+            ArenaAllocator(const ArenaAllocator<OTHER>& copy)
+                : _arena(copy.Storage())
+            {
+            }
+
+        public:
+            TYPE* allocate(const size_t count)
+            {
+                return (reinterpret_cast<TYPE*>(_arena->Allocate(count * sizeof(TYPE), alignof(TYPE))));
+            }
+            void deallocate(TYPE*, const size_t)
+            {
+                // Released together with the arena.
+            }
+            inline Arena* Storage() const
+            {
+                return (_arena);
+            }
+            template <typename OTHER>
+            inline bool operator==(const ArenaAllocator<OTHER>& rhs) const
+            {
+                return (_arena == rhs.Storage());
+            }
+            template <typename OTHER>
+            inline bool operator!=(const ArenaAllocator<OTHER>& rhs) const
+            {
+                return (_arena != rhs.Storage());
+            }
+
+        private:
+            Arena* _arena;
+        };
+
         class VariantContainer;
 
         class EXTERNAL Variant : public JSON::String {
@@ -3664,6 +3894,7 @@ namespace Core {
             Variant()
                 : JSON::String(false)
                 , _type(type::EMPTY)
+                , _native()
             {
                 String::operator=("null");
             }
@@ -3671,59 +3902,70 @@ namespace Core {
             Variant(const int32_t value)
                 : JSON::String(false)
                 , _type(type::NUMBER)
+                , _native()
             {
-                String::operator=(Core::NumberType<int32_t, true, NumberBase::BASE_DECIMAL>(value).Text());
+                Integer(Core::NumberType<int32_t, true, NumberBase::BASE_DECIMAL>(value).Text());
             }
 
             Variant(const int64_t value)
                 : JSON::String(false)
                 , _type(type::NUMBER)
+                , _native()
             {
-                String::operator=(Core::NumberType<int64_t, true, NumberBase::BASE_DECIMAL>(value).Text());
+                Integer(Core::NumberType<int64_t, true, NumberBase::BASE_DECIMAL>(value).Text());
             }
 
             Variant(const uint32_t value)
                 : JSON::String(false)
                 , _type(type::NUMBER)
+                , _native()
             {
-                String::operator=(Core::NumberType<uint32_t, false, NumberBase::BASE_DECIMAL>(value).Text());
+                Integer(Core::NumberType<uint32_t, false, NumberBase::BASE_DECIMAL>(value).Text());
             }
 
             Variant(const uint64_t value)
                 : JSON::String(false)
                 , _type(type::NUMBER)
+                , _native()
             {
-                String::operator=(Core::NumberType<uint64_t, false, NumberBase::BASE_DECIMAL>(value).Text());
+                Integer(Core::NumberType<uint64_t, false, NumberBase::BASE_DECIMAL>(value).Text());
             }
 
             Variant(const float value)
                 : JSON::String(false)
                 , _type(type::FLOAT)
+                , _native()
             {
                 string result;
                 JSON::Float(value).ToString(result);
                 String::operator=(result);
+                _native.real = value;
             }
 
             Variant(const double value)
                 : JSON::String(false)
                 , _type(type::DOUBLE)
+                , _native()
             {
                 string result;
                 JSON::Double(value).ToString(result);
                 String::operator=(result);
+                _native.real = value;
             }
 
             Variant(const bool value)
                 : JSON::String(false)
                 , _type(type::BOOLEAN)
+                , _native()
             {
                 String::operator=(value ? _T("true") : _T("false"));
+                _native.boolean = value;
             }
 
             Variant(const string& text)
                 : JSON::String(true)
                 , _type(type::STRING)
+                , _native()
             {
                 String::operator=(text);
             }
@@ -3731,6 +3973,7 @@ namespace Core {
             Variant(const TCHAR* text)
                 : JSON::String(true)
                 , _type(type::STRING)
+                , _native()
             {
                 String::operator=(text);
             }
@@ -3738,6 +3981,7 @@ namespace Core {
             Variant(const Variant& copy)
                 : JSON::String(copy)
                 , _type(copy._type)
+                , _native(copy._native)
             {
             }
 
@@ -3751,6 +3995,7 @@ namespace Core {
             {
                 JSON::String::operator=(RHS);
                 _type = RHS._type;
+                _native = RHS._native;
                 return (*this);
             }
 
@@ -3760,11 +4005,13 @@ namespace Core {
                 return _type;
             }
 
+            // Scalars are kept in their native form next to their text, so reading
+            // them does not require the text to be parsed again.
             bool Boolean() const
             {
                 bool result = false;
                 if (_type == type::BOOLEAN) {
-                    result = (Value() == "true");
+                    result = _native.boolean;
                 }
                 return result;
             }
@@ -3773,7 +4020,7 @@ namespace Core {
             {
                 int64_t result = 0;
                 if (_type == type::NUMBER) {
-                    result = Core::NumberType<int64_t>(Value().c_str(), static_cast<uint32_t>(Value().length()));
+                    result = _native.integer;
                 } else if (_type == type::FLOAT) {
                     result = static_cast<int64_t>(Float());
                 } else if (_type == type::DOUBLE) {
@@ -3787,13 +4034,8 @@ namespace Core {
                 float result = 0.0f;
                 if (_type == type::NUMBER) {
                     result = static_cast<float>(Number());
-                } else if (_type == type::FLOAT) {
-                    JSON::Float value;
-                    if (value.FromString(Value())) {
-                        result = value.Value();
-                    }
-                } else if (_type == type::DOUBLE) {
-                    result = static_cast<float>(Double());
+                } else if ((_type == type::FLOAT) || (_type == type::DOUBLE)) {
+                    result = static_cast<float>(_native.real);
                 }
                 return result;
             }
@@ -3806,10 +4048,7 @@ namespace Core {
                 } else if (_type == type::FLOAT) {
                     result = static_cast<double>(Float());
                 } else if (_type == type::DOUBLE) {
-                    JSON::Double value;
-                    if (value.FromString(Value())) {
-                        result = value.Value();
-                    }
+                    result = _native.real;
                 }
                 return result;
             }
@@ -3835,6 +4074,7 @@ namespace Core {
                 _type = type::BOOLEAN;
                 String::SetQuoted(false);
                 String::operator=(value ? _T("true") : _T("false"));
+                _native.boolean = value;
             }
 
             template <typename TYPE>
@@ -3842,7 +4082,7 @@ namespace Core {
             {
                 _type = type::NUMBER;
                 String::SetQuoted(false);
-                String::operator=(Core::NumberType<TYPE>(value).Text());
+                Integer(Core::NumberType<TYPE>(value).Text());
             }
 
             void Number(const float value)
@@ -3852,6 +4092,7 @@ namespace Core {
                 string result;
                 JSON::Float(value).ToString(result);
                 String::operator=(result);
+                _native.real = value;
             }
 
             void Number(const double value)
@@ -3861,6 +4102,7 @@ namespace Core {
                 string result;
                 JSON::Double(value).ToString(result);
                 String::operator=(result);
+                _native.real = value;
             }
 
             void String(const TCHAR* value)
@@ -3932,6 +4174,13 @@ namespace Core {
             // IElement iface:
             uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint32_t& offset, Core::OptionalType<Error>& error) override;
 
+            // The native value is taken from the text, so it reads back exactly as it did when it was parsed on access.
+            void Integer(const string& text)
+            {
+                String::operator=(text);
+                _native.integer = Core::NumberType<int64_t>(text.c_str(), static_cast<uint32_t>(text.length()));
+            }
+
             static uint16_t FindEndOfScope(const char stream[], uint16_t maxLength)
             {
                 ASSERT(maxLength > 0 && (stream[0] == '{' || stream[0] == '['));
@@ -3960,37 +4209,59 @@ namespace Core {
 
         private:
             type _type;
+            union {
+                bool boolean;
+                int64_t integer;
+                double real;
+            } _native;
         };
 
         class EXTERNAL VariantContainer : public Container {
         private:
-            typedef std::list<std::pair<string, WPEFramework::Core::JSON::Variant>> Elements;
+            // All labels and element nodes of a container are allocated from its own arena,
+            // they are released in one go on a Clear or on destruction.
+            typedef std::pair<const TCHAR*, WPEFramework::Core::JSON::Variant> Element;
+            typedef std::list<Element, ArenaAllocator<Element>> Elements;
+            typedef std::list<std::pair<string, WPEFramework::Core::JSON::Variant>> Values;
 
         public:
             class Iterator {
             public:
                 Iterator()
                     : _container(nullptr)
+                    , _values(nullptr)
                     , _index()
+                    , _value()
                     , _start(true)
                 {
                 }
 
                 Iterator(const Elements& container)
                     : _container(&container)
+                    , _values(nullptr)
                     , _index(_container->begin())
+                    , _value()
+                    , _start(true)
+                {
+                }
+
+                Iterator(const Values& container)
+                    : _container(nullptr)
+                    , _values(&container)
+                    , _index()
+                    , _value(_values->begin())
                     , _start(true)
                 {
                 }
 
                 Iterator(const Iterator& copy)
                     : _container(copy._container)
+                    , _values(copy._values)
                     , _index()
+                    , _value()
                     , _start(true)
                 {
-                    if (_container != nullptr) {
-                        _index = _container->begin();
-                    }
+                    Reset();
                 }
 
                 ~Iterator()
@@ -4000,7 +4271,9 @@ namespace Core {
                 Iterator& operator=(const Iterator& rhs)
                 {
                     _container = rhs._container;
+                    _values = rhs._values;
                     _index = rhs._index;
+                    _value = rhs._value;
                     _start = rhs._start;
 
                     return (*this);
@@ -4009,26 +4282,33 @@ namespace Core {
             public:
                 bool IsValid() const
                 {
-                    return ((_container != nullptr) && (_start == false) && (_index != _container->end()));
+                    return ((_start == false) && (AtEnd() == false));
                 }
 
                 void Reset()
                 {
+                    _start = true;
+
                     if (_container != nullptr) {
-                        _start = true;
                         _index = _container->begin();
+                    } else if (_values != nullptr) {
+                        _value = _values->begin();
                     }
                 }
 
                 bool Next()
                 {
-                    if (_container != nullptr) {
+                    if ((_container != nullptr) || (_values != nullptr)) {
                         if (_start == true) {
                             _start = false;
-                        } else if (_index != _container->end()) {
-                            _index++;
+                        } else if (AtEnd() == false) {
+                            if (_container != nullptr) {
+                                _index++;
+                            } else {
+                                _value++;
+                            }
                         }
-                        return (_index != _container->end());
+                        return (AtEnd() == false);
                     }
 
                     return (false);
@@ -4036,64 +4316,76 @@ namespace Core {
 
                 const TCHAR* Label() const
                 {
-                    return (_index->first.c_str());
+                    return (_container != nullptr ? _index->first : _value->first.c_str());
                 }
 
                 const JSON::Variant& Current() const
                 {
-                    return (_index->second);
+                    return (_container != nullptr ? _index->second : _value->second);
+                }
+
+            private:
+                bool AtEnd() const
+                {
+                    return (_container != nullptr ? (_index == _container->end()) : ((_values == nullptr) || (_value == _values->end())));
                 }
 
             private:
                 const Elements* _container;
+                const Values* _values;
                 Elements::const_iterator _index;
+                Values::const_iterator _value;
                 bool _start;
             };
 
         public:
             VariantContainer()
                 : Container()
-                , _elements()
+                , _arena()
+                , _elements(ArenaAllocator<Element>(_arena))
             {
             }
 
             VariantContainer(const TCHAR serialized[])
                 : Container()
-                , _elements()
+                , _arena()
+                , _elements(ArenaAllocator<Element>(_arena))
             {
                 Container::FromString(serialized);
             }
 
             VariantContainer(const string& serialized)
                 : Container()
-                , _elements()
+                , _arena()
+                , _elements(ArenaAllocator<Element>(_arena))
             {
                 Container::FromString(serialized);
             }
 
             VariantContainer(const VariantContainer& copy)
                 : Container()
-                , _elements(copy._elements)
+                , _arena()
+                , _elements(ArenaAllocator<Element>(_arena))
             {
-                Elements::iterator index(_elements.begin());
+                Elements::const_iterator index(copy._elements.begin());
 
-                while (index != _elements.end()) {
-                    if (copy.HasLabel(index->first.c_str()))
-                        Container::Add(index->first.c_str(), &(index->second));
+                while (index != copy._elements.end()) {
+                    if (copy.HasLabel(index->first)) {
+                        Insert(index->first, index->second);
+                    }
                     index++;
                 }
             }
 
-            VariantContainer(const Elements& values)
+            VariantContainer(const Values& values)
                 : Container()
+                , _arena()
+                , _elements(ArenaAllocator<Element>(_arena))
             {
-                Elements::const_iterator index(values.begin());
+                Values::const_iterator index(values.begin());
 
                 while (index != values.end()) {
-                    _elements.emplace_back(std::piecewise_construct,
-                        std::forward_as_tuple(index->first),
-                        std::forward_as_tuple(index->second));
-                    Container::Add(_elements.back().first.c_str(), &(_elements.back().second));
+                    Insert(index->first.c_str(), index->second);
                     index++;
                 }
             }
@@ -4105,36 +4397,29 @@ namespace Core {
         public:
             VariantContainer& operator=(const VariantContainer& rhs)
             {
-                // combine the labels
-                Elements::iterator index(_elements.begin());
+                if (&rhs != this) {
+                    if (SameLabels(rhs) == true) {
+                        // Only the values change, they are copied in place, the arena does not grow.
+                        Elements::iterator index(_elements.begin());
+                        Elements::const_iterator rhs_index(rhs._elements.begin());
 
-                // First copy all existing ones over, if the rhs does not have a value, remove the entry.
-                while (index != _elements.end()) {
-                    // Check if the rhs, has these..
-                    Elements::const_iterator rhs_index(rhs.Find(index->first.c_str()));
-
-                    if (rhs_index != rhs._elements.end()) {
-                        // This is a valid element, copy the value..
-                        index->second = rhs_index->second;
-                        index++;
+                        while (index != _elements.end()) {
+                            index->second = rhs_index->second;
+                            index++;
+                            rhs_index++;
+                        }
                     } else {
-                        // This element does not exist on the other side..
-                        Container::Remove(index->first.c_str());
-                        index = _elements.erase(index);
-                    }
-                }
+                        // The contents are replaced wholesale, the arena is released with them. Otherwise
+                        // the labels and nodes that are left behind would only come back on a Clear().
+                        Clear();
 
-                Elements::const_iterator rhs_index(rhs._elements.begin());
+                        Elements::const_iterator rhs_index(rhs._elements.begin());
 
-                // Now add the ones we are missing from the RHS
-                while (rhs_index != rhs._elements.end()) {
-                    if (Find(rhs_index->first.c_str()) == _elements.end()) {
-                        _elements.emplace_back(std::piecewise_construct,
-                            std::forward_as_tuple(rhs_index->first),
-                            std::forward_as_tuple(rhs_index->second));
-                        Container::Add(_elements.back().first.c_str(), &(_elements.back().second));
+                        while (rhs_index != rhs._elements.end()) {
+                            Insert(rhs_index->first, rhs_index->second);
+                            rhs_index++;
+                        }
                     }
-                    rhs_index++;
                 }
 
                 return (*this);
@@ -4146,10 +4431,7 @@ namespace Core {
                 if (index != _elements.end()) {
                     index->second = value;
                 } else {
-                    _elements.emplace_back(std::piecewise_construct,
-                        std::forward_as_tuple(fieldName),
-                        std::forward_as_tuple(value));
-                    Container::Add(_elements.back().first.c_str(), &(_elements.back().second));
+                    Insert(fieldName, value);
                 }
             }
 
@@ -4171,12 +4453,7 @@ namespace Core {
                 Elements::iterator index(Find(fieldName));
 
                 if (index == _elements.end()) {
-                    _elements.emplace_back(std::piecewise_construct,
-                        std::forward_as_tuple(fieldName),
-                        std::forward_as_tuple());
-                    Container::Add(_elements.back().first.c_str(), &(_elements.back().second));
-                    index = _elements.end();
-                    index--;
+                    index = Insert(fieldName, JSON::Variant());
                 }
 
                 return (index->second);
@@ -4204,14 +4481,39 @@ namespace Core {
             void Clear()
             {
                 Reset();
+                _elements.clear();
+                _arena.Release();
             }
             string GetDebugString(int indent = 0) const;
 
         private:
+            Elements::iterator Insert(const TCHAR fieldName[], const JSON::Variant& value)
+            {
+                _elements.emplace_back(std::piecewise_construct,
+                    std::forward_as_tuple(_arena.Duplicate(fieldName)),
+                    std::forward_as_tuple(value));
+                Container::Add(_elements.back().first, &(_elements.back().second));
+
+                return (--_elements.end());
+            }
+
+            bool SameLabels(const VariantContainer& rhs) const
+            {
+                Elements::const_iterator index(_elements.begin());
+                Elements::const_iterator rhs_index(rhs._elements.begin());
+
+                while ((index != _elements.end()) && (rhs_index != rhs._elements.end()) && (_tcscmp(index->first, rhs_index->first) == 0)) {
+                    index++;
+                    rhs_index++;
+                }
+
+                return ((index == _elements.end()) && (rhs_index == rhs._elements.end()));
+            }
+
             Elements::iterator Find(const TCHAR fieldName[])
             {
                 Elements::iterator index(_elements.begin());
-                while ((index != _elements.end()) && (index->first != fieldName)) {
+                while ((index != _elements.end()) && (_tcscmp(index->first, fieldName) != 0)) {
                     index++;
                 }
                 return (index);
@@ -4220,7 +4522,7 @@ namespace Core {
             Elements::const_iterator Find(const TCHAR fieldName[]) const
             {
                 Elements::const_iterator index(_elements.begin());
-                while ((index != _elements.end()) && (index->first != fieldName)) {
+                while ((index != _elements.end()) && (_tcscmp(index->first, fieldName) != 0)) {
                     index++;
                 }
                 return (index);
@@ -4231,16 +4533,13 @@ namespace Core {
             {
                 // Whetever comes in and has no counter part, we need to create a Variant for it, so
                 // it can be filled.
-                _elements.emplace_back(std::piecewise_construct,
-                    std::forward_as_tuple(label),
-                    std::forward_as_tuple());
-
-                Container::Add(_elements.back().first.c_str(), &(_elements.back().second));
+                Insert(label, JSON::Variant());
 
                 return (true);
             }
 
         private:
+            Arena _arena;
             Elements _elements;
         };
 
@@ -4297,10 +4596,14 @@ namespace Core {
                     SetQuoted(quoted);
                     // If it is not quoted, it can be a boolean or a number...
                     if (quoted == false) {
-                        if ((Value() == _T("true")) || (Value() == _T("false"))) {
+                        const string text(Value());
+
+                        if ((text == _T("true")) || (text == _T("false"))) {
                             _type = type::BOOLEAN;
+                            _native.boolean = (text[0] == 't');
                         } else if (IsNull() == false) {
                             _type = type::NUMBER;
+                            _native.integer = Core::NumberType<int64_t>(text.c_str(), static_cast<uint32_t>(text.length()));
                         }
                     }
                 }
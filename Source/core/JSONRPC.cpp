@@ -26,6 +26,7 @@ namespace Core {
     namespace JSONRPC {
 
         /* static */ constexpr TCHAR Message::DefaultVersion[];
+        /* static */ Core::ProxyPoolType<Message> Message::_entries(8);
     }
 }
 } // namespace WPEramework::Core::JSONRPC
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "JSON.h"
+#include "JSONRPCPayload.h"
 #include "Module.h"
 #include "TypeTraits.h"
 
@@ -45,7 +46,7 @@ namespace Core {
                     : Core::JSON::Container()
                     , Code(0)
                     , Text()
-                    , Data(false)
+                    , Data()
                 {
                     Add(_T("code"), &Code);
                     Add(_T("message"), &Text);
@@ -55,7 +56,7 @@ namespace Core {
                     : Core::JSON::Container()
                     , Code(0)
                     , Text()
-                    , Data(false)
+                    , Data()
                 {
                     Add(_T("code"), &Code);
                     Add(_T("message"), &Text);
@@ -109,12 +110,124 @@ namespace Core {
                         break;
                     }
                 }
+                void InvalidRequest(const string& reason)
+                {
+                    Code = -32600; // Invalid request
+                    Text = reason;
+                }
                 Core::JSON::DecSInt32 Code;
                 Core::JSON::String Text;
-                Core::JSON::String Data;
+                Payload Data;
+            };
+
+        private:
+            // A result that is serialized straight from its element, it is never converted to text first.
+            // Only used on outbound messages, inbound the result is always picked up as text.
+            class Deferred : public Core::JSON::IElement, public Core::JSON::IMessagePack {
+            public:
+                Deferred(const Deferred&) = delete;
+                Deferred& operator=(const Deferred&) = delete;
+
+                Deferred()
+                    : _element()
+                    , _packed()
+                {
+                }
+                ~Deferred() override = default;
+
+            public:
+                void Set(const Core::ProxyType<Core::JSON::IElement>& element)
+                {
+                    _element = element;
+                }
+                const Core::ProxyType<Core::JSON::IElement>& Element() const
+                {
+                    return (_element);
+                }
+
+                // IElement iface:
+                void Clear() override
+                {
+                    if (_element.IsValid() == true) {
+                        _element.Release();
+                    }
+                }
+                bool IsSet() const override
+                {
+                    return (_element.IsValid());
+                }
+                bool IsNull() const override
+                {
+                    return ((_element.IsValid() == false) || (_element->IsNull() == true));
+                }
+                uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
+                {
+                    ASSERT(_element.IsValid() == true);
+
+                    return (_element->Serialize(stream, maxLength, offset));
+                }
+                uint16_t Deserialize(const char[], const uint16_t, uint32_t& offset, Core::OptionalType<Core::JSON::Error>&) override
+                {
+                    ASSERT(false);
+
+                    offset = 0;
+                    return (0);
+                }
+
+                // IMessagePack iface:
+                uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint32_t& offset) const override
+                {
+                    uint16_t loaded = 0;
+                    const Core::JSON::IMessagePack* element = (IsVariant(*_element) == true ? nullptr : dynamic_cast<const Core::JSON::IMessagePack*>(&(*_element)));
+
+                    if (element != nullptr) {
+                        loaded = element->Serialize(stream, maxLength, offset);
+                    } else {
+                        // Variants pack their values as strings holding text, those (and elements that can
+                        // not pack themselves) are packed from their JSON text.
+                        if (offset == 0) {
+                            string text;
+                            _element->ToString(text);
+                            Payload::Text(text, _packed);
+                        }
+
+                        loaded = Payload::Copy(_packed, stream, maxLength, offset);
+                    }
+
+                    return (loaded);
+                }
+                uint16_t Deserialize(const uint8_t[], const uint16_t, uint32_t& offset) override
+                {
+                    ASSERT(false);
+
+                    offset = 0;
+                    return (0);
+                }
+
+            private:
+                static bool IsVariant(const Core::JSON::IElement& element)
+                {
+                    return ((dynamic_cast<const Core::JSON::VariantContainer*>(&element) != nullptr) || (dynamic_cast<const Core::JSON::Variant*>(&element) != nullptr) || (dynamic_cast<const Core::JSON::ArrayType<Core::JSON::Variant>*>(&element) != nullptr));
+                }
+
+            private:
+                Core::ProxyType<Core::JSON::IElement> _element;
+                mutable std::vector<uint8_t> _packed;
+            };
+
+            // Offsets used while a batch is (de)serialized, the members use their own.
+            enum : uint32_t {
+                BATCH_COMPLETE = 0,
+                BATCH_NEXT = 1,
+                BATCH_END = 2,
+                BATCH_LENGTH_HIGH = 3,
+                BATCH_LENGTH_LOW = 4,
+                BATCH_ELEMENT = 5
             };
 
         public:
+            typedef std::vector<Core::ProxyType<Message>> BatchList;
+
             static constexpr TCHAR DefaultVersion[] = _T("2.0");
 
             Message()
@@ -122,15 +235,22 @@ namespace Core {
                  , JSONRPC(DefaultVersion)
                  , Id(~0)
                  , Designator()
-                 , Parameters(false)
-                 , Result(false)
+                 , Parameters()
+                 , Result()
                  , Error()
+                 , _streamed()
+                 , _batch()
+                 , _batched(false)
+                 , _pending(0)
+                 , _index(0)
+                 , _limit(~0)
             {
                 Add(_T("jsonrpc"), &JSONRPC);
                 Add(_T("id"), &Id);
                 Add(_T("method"), &Designator);
                 Add(_T("params"), &Parameters);
                 Add(_T("result"), &Result);
+                Add(_T("result"), &_streamed);
                 Add(_T("error"), &Error);
 
                 Clear();
@@ -244,7 +364,7 @@ namespace Core {
 
                 return (end == string::npos ? EMPTY_STRING : designator.substr(end + 1, string::npos));
             }
-            void Clear()
+            void Clear() override
             {
                 JSONRPC = DefaultVersion;
                 Id.Clear();
@@ -252,6 +372,71 @@ namespace Core {
                 Parameters.Clear();
                 Result.Clear();
                 Error.Clear();
+                _streamed.Clear();
+                _batch.clear();
+                _batched = false;
+            }
+            bool IsSet() const override
+            {
+                return ((_batched == true) || (Core::JSON::Container::IsSet() == true));
+            }
+
+            // Large results can be handed over as the element they are in, it is serialized into the
+            // channel in pieces, so the complete text is never in memory at once.
+            void Stream(const Core::ProxyType<Core::JSON::IElement>& result)
+            {
+                Result.Clear();
+                _streamed.Set(result);
+            }
+            bool IsStreamed() const
+            {
+                return (_streamed.IsSet());
+            }
+            const Core::ProxyType<Core::JSON::IElement>& Streamed() const
+            {
+                return (_streamed.Element());
+            }
+
+            // A JSON-RPC 2.0 batch is an array of requests, answered by an array of their responses.
+            // Each entry is a message of its own, so they can be handled independently. Responses
+            // are placed at the index of their request, entries left empty are not sent.
+            bool IsBatch() const
+            {
+                return (_batched);
+            }
+            void Batch(const uint16_t count)
+            {
+                _batch.clear();
+                _batch.resize(count);
+                _batched = true;
+            }
+            BatchList& Batch()
+            {
+                return (_batch);
+            }
+            // The number of requests a received batch may hold, a larger one fails to parse before
+            // more entries are taken for it.
+            void BatchLimit(const uint16_t limit)
+            {
+                _limit = limit;
+            }
+            uint16_t BatchLimit() const
+            {
+                return (_limit);
+            }
+            const BatchList& Batch() const
+            {
+                return (_batch);
+            }
+            uint16_t Entries() const
+            {
+                uint16_t count = 0;
+                for (const Core::ProxyType<Message>& entry : _batch) {
+                    if (entry.IsValid() == true) {
+                        count++;
+                    }
+                }
+                return (count);
             }
             string Callsign() const
             {
@@ -284,9 +469,484 @@ namespace Core {
             Core::JSON::String JSONRPC;
             Core::JSON::DecUInt32 Id;
             Core::JSON::String Designator;
-            Core::JSON::String Parameters;
-            Core::JSON::String Result;
+            Payload Parameters;
+            Payload Result;
             Info Error;
+
+        private:
+            uint16_t Next(uint16_t index) const
+            {
+                while ((index < _batch.size()) && (_batch[index].IsValid() == false)) {
+                    index++;
+                }
+                return (index);
+            }
+
+            // IElement iface:
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
+            {
+                uint16_t loaded = 0;
+
+                if (_batched == false) {
+                    loaded = Core::JSON::Container::Serialize(stream, maxLength, offset);
+                } else {
+                    if (offset == 0) {
+                        _index = Next(0);
+                        stream[loaded++] = '[';
+                        offset = (_index < _batch.size() ? BATCH_ELEMENT : BATCH_END);
+                    }
+                    while ((loaded < maxLength) && (offset != 0)) {
+                        if (offset == BATCH_NEXT) {
+                            stream[loaded++] = ',';
+                            offset = BATCH_ELEMENT;
+                        } else if (offset == BATCH_END) {
+                            stream[loaded++] = ']';
+                            offset = 0;
+                        } else {
+                            uint32_t current = offset - BATCH_ELEMENT;
+                            loaded += _batch[_index]->Core::JSON::Container::Serialize(&(stream[loaded]), maxLength - loaded, current);
+
+                            if (current != 0) {
+                                offset = BATCH_ELEMENT + current;
+                            } else {
+                                _index = Next(_index + 1);
+                                offset = (_index < _batch.size() ? BATCH_NEXT : BATCH_END);
+                            }
+                        }
+                    }
+                }
+
+                return (loaded);
+            }
+            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint32_t& offset, Core::OptionalType<Core::JSON::Error>& error) override
+            {
+                uint16_t loaded = 0;
+
+                if (offset == 0) {
+                    while ((loaded < maxLength) && (::isspace(stream[loaded]))) {
+                        loaded++;
+                    }
+                    if ((loaded < maxLength) && (stream[loaded] == '[')) {
+                        _batch.clear();
+                        _batched = true;
+                        offset = BATCH_NEXT;
+                        loaded++;
+                    } else {
+                        loaded = 0;
+                    }
+                }
+
+                if (_batched == false) {
+                    loaded = Core::JSON::Container::Deserialize(stream, maxLength, offset, error);
+                } else {
+                    while ((offset != 0) && (loaded < maxLength) && (error.IsSet() == false)) {
+                        if ((offset == BATCH_NEXT) || (offset == BATCH_END)) {
+                            while ((loaded < maxLength) && (::isspace(stream[loaded]))) {
+                                loaded++;
+                            }
+                            if (loaded < maxLength) {
+                                const TCHAR character = stream[loaded];
+
+                                if ((character == ']') && ((offset == BATCH_END) || (_batch.empty() == true))) {
+                                    offset = 0;
+                                    loaded++;
+                                } else if ((character == ',') && (offset == BATCH_END)) {
+                                    offset = BATCH_NEXT;
+                                    loaded++;
+                                } else if ((character == '{') && (offset == BATCH_NEXT) && (_batch.size() >= _limit)) {
+                                    // What follows belongs to the refused batch, it is not parsed as requests of their own.
+                                    error = Core::JSON::Error{ "A batch holds at most " + Core::NumberType<uint16_t>(_limit).Text() + " requests." };
+                                    Clear();
+                                    loaded = maxLength;
+                                    offset = 0;
+                                } else if ((character == '{') && (offset == BATCH_NEXT)) {
+                                    _batch.push_back(_entries.Element());
+                                    offset = BATCH_ELEMENT;
+                                } else {
+                                    error = Core::JSON::Error{ "A batch holds request objects, separated by \",\"." };
+                                    offset = 0;
+                                }
+                            }
+                        } else {
+                            uint32_t current = offset - BATCH_ELEMENT;
+                            loaded += _batch.back()->Core::JSON::Container::Deserialize(&(stream[loaded]), maxLength - loaded, current, error);
+                            offset = (current != 0 ? BATCH_ELEMENT + current : static_cast<uint32_t>(BATCH_END));
+                        }
+                    }
+                }
+
+                return (loaded);
+            }
+
+            // IMessagePack iface:
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint32_t& offset) const override
+            {
+                uint16_t loaded = 0;
+
+                if (_batched == false) {
+                    loaded = Core::JSON::Container::Serialize(stream, maxLength, offset);
+                } else {
+                    const uint16_t entries = Entries();
+
+                    if (offset == 0) {
+                        _index = Next(0);
+                        if (entries <= 15) {
+                            stream[loaded++] = (0x90 | static_cast<uint8_t>(entries));
+                            offset = (entries > 0 ? BATCH_ELEMENT : BATCH_COMPLETE);
+                        } else {
+                            stream[loaded++] = 0xDC;
+                            offset = BATCH_LENGTH_HIGH;
+                        }
+                    }
+                    while ((loaded < maxLength) && (offset != 0)) {
+                        if (offset == BATCH_LENGTH_HIGH) {
+                            stream[loaded++] = static_cast<uint8_t>(entries >> 8);
+                            offset = BATCH_LENGTH_LOW;
+                        } else if (offset == BATCH_LENGTH_LOW) {
+                            stream[loaded++] = static_cast<uint8_t>(entries & 0xFF);
+                            offset = BATCH_ELEMENT;
+                        } else {
+                            uint32_t current = offset - BATCH_ELEMENT;
+                            loaded += _batch[_index]->Core::JSON::Container::Serialize(&(stream[loaded]), maxLength - loaded, current);
+
+                            if (current != 0) {
+                                offset = BATCH_ELEMENT + current;
+                            } else {
+                                _index = Next(_index + 1);
+                                offset = (_index < _batch.size() ? BATCH_ELEMENT : BATCH_COMPLETE);
+                            }
+                        }
+                    }
+                }
+
+                return (loaded);
+            }
+            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint32_t& offset) override
+            {
+                uint16_t loaded = 0;
+
+                if ((offset == 0) && (maxLength > 0) && (((stream[0] & 0xF0) == 0x90) || (stream[0] == 0xDC))) {
+                    _batch.clear();
+                    _batched = true;
+                    _pending = (stream[0] & 0x0F);
+                    offset = (stream[0] == 0xDC ? BATCH_LENGTH_HIGH : (_pending > 0 ? BATCH_ELEMENT : BATCH_COMPLETE));
+                    loaded = 1;
+                }
+
+                if (_batched == false) {
+                    loaded = Core::JSON::Container::Deserialize(stream, maxLength, offset);
+                } else {
+                    while ((loaded < maxLength) && (offset != 0)) {
+                        if (offset == BATCH_LENGTH_HIGH) {
+                            _pending = (stream[loaded++] << 8);
+                            offset = BATCH_LENGTH_LOW;
+                        } else if (offset == BATCH_LENGTH_LOW) {
+                            _pending |= stream[loaded++];
+                            offset = (_pending > 0 ? BATCH_ELEMENT : BATCH_COMPLETE);
+                        } else if (_pending > _limit) {
+                            // The size is known up front, a batch that is too large takes no entries at all.
+                            // What follows belongs to it, it is not parsed as requests of their own.
+                            TRACE_L1("Parsing failed: A batch holds at most %d requests, %d found.", _limit, _pending);
+                            Clear();
+                            loaded = maxLength;
+                            offset = 0;
+                        } else {
+                            uint32_t current = offset - BATCH_ELEMENT;
+
+                            if (current == 0) {
+                                _batch.push_back(_entries.Element());
+                                _pending--;
+                            }
+
+                            loaded += _batch.back()->Core::JSON::Container::Deserialize(&(stream[loaded]), maxLength - loaded, current);
+                            offset = (current != 0 ? BATCH_ELEMENT + current : static_cast<uint32_t>(_pending > 0 ? BATCH_ELEMENT : BATCH_COMPLETE));
+                        }
+                    }
+                }
+
+                return (loaded);
+            }
+
+        private:
+            Deferred _streamed;
+            BatchList _batch;
+            bool _batched;
+            uint16_t _pending;
+            mutable uint16_t _index;
+            uint16_t _limit;
+
+            // The entries of received batches, constructing a message is not for free.
+            static Core::ProxyPoolType<Message> _entries;
+        };
+
+        // How the notifications of a subscription are delivered to a client that can not keep up.
+        // The defaults deliver every notification, as soon as possible.
+        struct Policy {
+            Policy()
+                : Coalesce(false)
+                , Interval(0)
+                , Depth(0)
+            {
+            }
+
+            bool IsSet() const
+            {
+                return ((Coalesce == true) || (Interval != 0) || (Depth != 0));
+            }
+
+            // A pending notification is replaced by a newer one of the same subscription.
+            bool Coalesce;
+            // Minimum time between two notifications in ms, 0 is unlimited. The latest one that came in
+            // within the interval is held, and send once it expired.
+            uint32_t Interval;
+            // Maximum number of pending notifications, the oldest are dropped, 0 is unlimited.
+            uint16_t Depth;
+        };
+
+        // An event is send to all its subscribers with the same parameters, only the method
+        // differs per subscriber. The Body holds what they share, it is rendered once and
+        // referenced by the Notification of every subscriber, so a fan-out does not copy or
+        // serialize the parameters again for each channel.
+        class EXTERNAL Notification : public Core::JSON::IElement, public Core::JSON::IMessagePack {
+        public:
+            class Body {
+            public:
+                Body() = delete;
+                Body(const Body&) = delete;
+                Body& operator=(const Body&) = delete;
+
+                Body(const string& event, const string& parameters)
+                    : _event(event)
+                    , _parameters(parameters)
+                    , _adminLock()
+                    , _packed()
+                {
+                }
+                ~Body()
+                {
+                }
+
+            public:
+                const string& Event() const
+                {
+                    return (_event);
+                }
+                const string& Parameters() const
+                {
+                    return (_parameters);
+                }
+                string Method(const string& designator) const
+                {
+                    return (designator.empty() == false ? designator + '.' + _event : _event);
+                }
+                // The parameters packed for the subscribers on a MessagePack channel, also done only once.
+                const std::vector<uint8_t>& Packed() const
+                {
+                    _adminLock.Lock();
+
+                    if (_packed.empty() == true) {
+                        Payload::Text(_parameters, _packed);
+                    }
+
+                    _adminLock.Unlock();
+
+                    return (_packed);
+                }
+
+            private:
+                const string _event;
+                const string _parameters;
+                mutable Core::CriticalSection _adminLock;
+                mutable std::vector<uint8_t> _packed;
+            };
+
+        public:
+            Notification(const Notification&) = delete;
+            Notification& operator=(const Notification&) = delete;
+
+            Notification()
+                : _body()
+                , _method()
+                , _quoted()
+                , _policy()
+            {
+            }
+            ~Notification() override
+            {
+            }
+
+        public:
+            void Set(const Core::ProxyType<Body>& body, const string& designator, const JSONRPC::Policy& policy = JSONRPC::Policy())
+            {
+                Core::JSON::String method;
+
+                ASSERT(body.IsValid() == true);
+
+                _body = body;
+                _method = body->Method(designator);
+                _policy = policy;
+
+                method = _method;
+                method.ToString(_quoted);
+            }
+            const string& Method() const
+            {
+                return (_method);
+            }
+            const JSONRPC::Policy& Policy() const
+            {
+                return (_policy);
+            }
+            const string& Parameters() const
+            {
+                ASSERT(_body.IsValid() == true);
+
+                return (_body->Parameters());
+            }
+
+            // IElement and IMessagePack iface:
+            void Clear() override
+            {
+                _body.Release();
+                _method.clear();
+                _quoted.clear();
+                _policy = JSONRPC::Policy();
+            }
+            bool IsSet() const override
+            {
+                return (_body.IsValid());
+            }
+            bool IsNull() const override
+            {
+                return (false);
+            }
+
+            // IElement iface:
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
+            {
+                static constexpr char Head[] = "{\"jsonrpc\":\"2.0\",\"method\":";
+                static constexpr char Params[] = ",\"params\":";
+
+                ASSERT(_body.IsValid() == true);
+
+                const string& parameters(_body->Parameters());
+                const Segment segments[] = {
+                    { reinterpret_cast<const uint8_t*>(Head), sizeof(Head) - 1 },
+                    { reinterpret_cast<const uint8_t*>(_quoted.c_str()), static_cast<uint32_t>(_quoted.length()) },
+                    { reinterpret_cast<const uint8_t*>(Params), sizeof(Params) - 1 },
+                    { reinterpret_cast<const uint8_t*>(parameters.c_str()), static_cast<uint32_t>(parameters.length()) },
+                    { reinterpret_cast<const uint8_t*>("}"), 1 }
+                };
+                const Segment* list[] = { &segments[0], &segments[1], &segments[2], &segments[3], &segments[4] };
+
+                if (parameters.empty() == true) {
+                    list[2] = &segments[4];
+                }
+
+                return (Copy(list, (parameters.empty() == true ? 3 : 5), reinterpret_cast<uint8_t*>(stream), maxLength, offset));
+            }
+            uint16_t Deserialize(const char[], const uint16_t maxLength, uint32_t& offset, Core::OptionalType<Core::JSON::Error>& error) override
+            {
+                // Notifications are only send, what comes in is a Message.
+                error = Core::JSON::Error { "A notification can not be deserialized" };
+                offset = 0;
+
+                return (maxLength);
+            }
+
+            // IMessagePack iface:
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint32_t& offset) const override
+            {
+                ASSERT(_body.IsValid() == true);
+
+                const string& parameters(_body->Parameters());
+                const std::vector<uint8_t>& packed(_body->Packed());
+                const uint8_t head[] = { static_cast<uint8_t>(parameters.empty() == true ? 0x82 : 0x83),
+                    0xA7, 'j', 's', 'o', 'n', 'r', 'p', 'c', 0xA3, '2', '.', '0', 0xA6, 'm', 'e', 't', 'h', 'o', 'd' };
+                uint8_t method[5];
+                const uint8_t params[] = { 0xA6, 'p', 'a', 'r', 'a', 'm', 's' };
+
+                const Segment segments[] = {
+                    { head, sizeof(head) },
+                    { method, Header(static_cast<uint32_t>(_method.length()), method) },
+                    { reinterpret_cast<const uint8_t*>(_method.c_str()), static_cast<uint32_t>(_method.length()) },
+                    { params, sizeof(params) },
+                    { packed.data(), static_cast<uint32_t>(packed.size()) }
+                };
+                const Segment* list[] = { &segments[0], &segments[1], &segments[2], &segments[3], &segments[4] };
+
+                return (Copy(list, (parameters.empty() == true ? 3 : 5), stream, maxLength, offset));
+            }
+            uint16_t Deserialize(const uint8_t[], const uint16_t maxLength, uint32_t& offset) override
+            {
+                ASSERT(false);
+                offset = 0;
+
+                return (maxLength);
+            }
+
+        private:
+            struct Segment {
+                const uint8_t* Data;
+                uint32_t Length;
+            };
+
+            // The offset is the position in the concatenated segments, 0 once all is written.
+            static uint16_t Copy(const Segment* const segments[], const uint8_t count, uint8_t stream[], const uint16_t maxLength, uint32_t& offset)
+            {
+                uint16_t loaded = 0;
+                uint32_t skip = offset;
+                uint32_t total = 0;
+
+                for (uint8_t index = 0; index < count; ++index) {
+                    const Segment& segment(*(segments[index]));
+
+                    total += segment.Length;
+
+                    if (skip >= segment.Length) {
+                        skip -= segment.Length;
+                    } else if (loaded < maxLength) {
+                        const uint16_t size = static_cast<uint16_t>(std::min(segment.Length - skip, static_cast<uint32_t>(maxLength - loaded)));
+
+                        ::memcpy(&(stream[loaded]), &(segment.Data[skip]), size);
+                        loaded += size;
+                        skip = 0;
+                    }
+                }
+
+                offset = ((offset + loaded) >= total ? 0 : offset + loaded);
+
+                return (loaded);
+            }
+            static uint32_t Header(const uint32_t length, uint8_t header[5])
+            {
+                uint32_t size = 0;
+
+                if (length <= 31) {
+                    header[size++] = static_cast<uint8_t>(0xA0 | length);
+                } else if (length <= 0xFF) {
+                    header[size++] = 0xD9;
+                    header[size++] = static_cast<uint8_t>(length);
+                } else if (length <= 0xFFFF) {
+                    header[size++] = 0xDA;
+                    header[size++] = static_cast<uint8_t>(length >> 8);
+                    header[size++] = static_cast<uint8_t>(length);
+                } else {
+                    header[size++] = 0xDB;
+                    header[size++] = static_cast<uint8_t>(length >> 24);
+                    header[size++] = static_cast<uint8_t>(length >> 16);
+                    header[size++] = static_cast<uint8_t>(length >> 8);
+                    header[size++] = static_cast<uint8_t>(length);
+                }
+
+                return (size);
+            }
+
+        private:
+            Core::ProxyType<Body> _body;
+            string _method;
+            string _quoted;
+            JSONRPC::Policy _policy;
         };
 
         class EXTERNAL Connection {
@@ -333,22 +993,26 @@ namespace Core {
 
         typedef std::function<void(const Connection& channel, const string& parameters)> CallbackFunction;
         typedef std::function<uint32_t(const string& method, const string& parameters, string& result)> InvokeFunction;
+        typedef std::function<uint32_t(const string& method, const string& parameters, Core::ProxyType<Core::JSON::IElement>& result)> StreamFunction;
 
         class EXTERNAL Handler {
-        private:
+        public:
+            // What a method is registered with, routing tables refer to it directly.
             class Entry {
             private:
+                enum kind : uint8_t {
+                    INVOKE,
+                    CALLBACK,
+                    STREAM
+                };
+
                 Entry() = delete;
                 Entry& operator=(const Entry&) = delete;
                 
                 union Functions {
-                    Functions(const Functions& function, const bool async)
+                    Functions(const Functions& function, const kind type)
                     {
-                        if (async == true) {
-                            new (&_callback) auto(function._callback);
-                        } else {
-                            new (&_invoke) auto(function._invoke);
-                        }
+                        Construct(function, type);
                     }
                     Functions(const CallbackFunction& function)
                         : _callback(function)
@@ -358,20 +1022,36 @@ namespace Core {
                         : _invoke(function)
                     {
                     }
-                    void Assign(const CallbackFunction& function, bool callbackactive) {
-                        if( callbackactive ) {
-                            _callback = function;
-                        } else {
-                            _invoke.~InvokeFunction();
-                            new (&_callback) auto(function);
+                    Functions(const StreamFunction& function)
+                        : _stream(function)
+                    {
+                    }
+                    void Construct(const Functions& function, const kind type)
+                    {
+                        switch (type) {
+                        case CALLBACK:
+                            new (&_callback) auto(function._callback);
+                            break;
+                        case STREAM:
+                            new (&_stream) auto(function._stream);
+                            break;
+                        default:
+                            new (&_invoke) auto(function._invoke);
+                            break;
                         }
                     }
-                    void Assign(const InvokeFunction& function, bool callbackactive) {
-                        if( callbackactive ) {
+                    void Destruct(const kind type)
+                    {
+                        switch (type) {
+                        case CALLBACK:
                             _callback.~CallbackFunction();
-                            new (&_invoke) auto(function);
-                        } else {
-                            _invoke = function;
+                            break;
+                        case STREAM:
+                            _stream.~StreamFunction();
+                            break;
+                        default:
+                            _invoke.~InvokeFunction();
+                            break;
                         }
                     }
 
@@ -381,69 +1061,98 @@ namespace Core {
 
                     CallbackFunction _callback;
                     InvokeFunction _invoke;
+                    StreamFunction _stream;
                 };
 
             public:
                 Entry(const CallbackFunction& callback)
-                    : _asynchronous(true)
+                    : _type(CALLBACK)
                     , _info(callback)
                 {
                 }
                 Entry(const InvokeFunction& callback)
-                    : _asynchronous(false)
+                    : _type(INVOKE)
+                    , _info(callback)
+                {
+                }
+                Entry(const StreamFunction& callback)
+                    : _type(STREAM)
                     , _info(callback)
                 {
                 }
                 Entry(const Entry& copy)
-                    : _asynchronous(copy._asynchronous)
-                    , _info(copy._info, copy._asynchronous)
+                    : _type(copy._type)
+                    , _info(copy._info, copy._type)
                 {
                 }
                 Entry& operator=(const CallbackFunction& callback) {
-                    _info.Assign(callback, _asynchronous);
-                    _asynchronous = true;
+                    _info.Destruct(_type);
+                    new (&_info._callback) auto(callback);
+                    _type = CALLBACK;
                     return *this;
                 }
                 Entry& operator=(const InvokeFunction& invokefunction) {
-                    _info.Assign(invokefunction, _asynchronous);
-                    _asynchronous = false;
+                    _info.Destruct(_type);
+                    new (&_info._invoke) auto(invokefunction);
+                    _type = INVOKE;
+                    return *this;
+                }
+                Entry& operator=(const StreamFunction& streamfunction) {
+                    _info.Destruct(_type);
+                    new (&_info._stream) auto(streamfunction);
+                    _type = STREAM;
                     return *this;
                 }
                 ~Entry()
                 {
-                    if (_asynchronous == true) {
-                        _info._callback.~CallbackFunction();
-                    } else {
-                        _info._invoke.~InvokeFunction();
-                    }
+                    _info.Destruct(_type);
                 }
 
             public:
                 uint32_t Invoke(const Connection connection, const string& method, const string& parameters, string& response)
+                {
+                    Core::ProxyType<Core::JSON::IElement> element;
+                    uint32_t result = Invoke(connection, method, parameters, response, element);
+
+                    if (element.IsValid() == true) {
+                        element->ToString(response);
+                    }
+                    return (result);
+                }
+                // A streamed method hands over its result as element, all others as text.
+                uint32_t Invoke(const Connection connection, const string& method, const string& parameters, string& response, Core::ProxyType<Core::JSON::IElement>& element)
                 {
                     uint32_t result = ~0;
-                    if (_asynchronous == true) {
+                    switch (_type) {
+                    case CALLBACK:
                         _info._callback(connection, parameters);
-                    } else {
+                        break;
+                    case STREAM:
+                        result = _info._stream(method, parameters, element);
+                        break;
+                    default:
                         result = _info._invoke(method, parameters, response);
+                        break;
                     }
                     return (result);
                 }
 
             private:
-                bool _asynchronous;
+                kind _type;
                 Functions _info;
             };
 
+        private:
             class Observer {
             private:
                 Observer(const Observer&) = delete;
                 Observer& operator=(const Observer&) = delete;
 
             public:
-                Observer(const uint32_t id, const string& designator)
+                Observer(const uint32_t id, const string& designator, const JSONRPC::Policy& policy)
                     : _id(id)
                     , _designator(designator)
+                    , _policy(policy)
                 {
                 }
                 ~Observer()
@@ -467,17 +1176,28 @@ namespace Core {
                 {
                     return (_designator);
                 }
+                const JSONRPC::Policy& Policy() const
+                {
+                    return (_policy);
+                }
 
             private:
                 uint32_t _id;
                 string _designator;
+                JSONRPC::Policy _policy;
             };
 
             typedef std::map<const string, Entry> HandlerMap;
             typedef std::list<Observer> ObserverList;
             typedef std::map<string, ObserverList> ObserverMap;
+            typedef std::map<string, string> CacheMap;
+            typedef std::unordered_map<string, std::unordered_map<string, string>> ResponseMap;
+
+            // The responses kept per method, one for each index and parameter combination.
+            static constexpr uint8_t CacheSlots = 16;
 
             typedef std::function<void(const uint32_t id, const string& designator, const string& data)> NotificationFunction;
+            typedef std::function<void(const uint32_t id, const string& designator, const Policy& policy, const Core::ProxyType<Notification::Body>& body)> FanOutFunction;
 
         public:
             class EventIterator {
@@ -556,16 +1276,56 @@ namespace Core {
                 : _adminLock()
                 , _handlers()
                 , _observers()
-                , _notificationFunction(notificationFunction)
+                , _notificationFunction(Adapt(notificationFunction))
                 , _versions(versions)
+                , _generation(0)
+                , _cached()
+                , _responses()
+                , _revision(0)
+                , _hits(0)
+                , _misses(0)
             {
             }
             Handler(const NotificationFunction& notificationFunction, const std::vector<uint8_t>& versions, const Handler& copy)
                 : _adminLock()
                 , _handlers(copy._handlers)
                 , _observers()
+                , _notificationFunction(Adapt(notificationFunction))
+                , _versions(versions)
+                , _generation(0)
+                , _cached()
+                , _responses()
+                , _revision(0)
+                , _hits(0)
+                , _misses(0)
+            {
+            }
+            Handler(const FanOutFunction& notificationFunction, const std::vector<uint8_t>& versions)
+                : _adminLock()
+                , _handlers()
+                , _observers()
                 , _notificationFunction(notificationFunction)
                 , _versions(versions)
+                , _generation(0)
+                , _cached()
+                , _responses()
+                , _revision(0)
+                , _hits(0)
+                , _misses(0)
+            {
+            }
+            Handler(const FanOutFunction& notificationFunction, const std::vector<uint8_t>& versions, const Handler& copy)
+                : _adminLock()
+                , _handlers(copy._handlers)
+                , _observers()
+                , _notificationFunction(notificationFunction)
+                , _versions(versions)
+                , _generation(0)
+                , _cached()
+                , _responses()
+                , _revision(0)
+                , _hits(0)
+                , _misses(0)
             {
             }
             ~Handler()
@@ -593,6 +1353,7 @@ namespace Core {
                     _handlers.emplace(std::piecewise_construct,
                         std::forward_as_tuple(method),
                         std::forward_as_tuple(info));
+                    _generation++;
                 }
 
                 return (copied);
@@ -607,6 +1368,10 @@ namespace Core {
             {
                 return (std::find(_versions.begin(), _versions.end(), number) != _versions.end());
             }
+            const std::vector<uint8_t>& Versions() const
+            {
+                return (_versions);
+            }
             template <typename PARAMETER, typename GET_METHOD, typename SET_METHOD, typename REALOBJECT>
             typename std::enable_if<(std::is_same<std::nullptr_t, typename std::remove_cv<GET_METHOD>::type>::value && !std::is_same<std::nullptr_t, typename std::remove_cv<SET_METHOD>::type>::value), void>::type
             Property(const string& methodName, GET_METHOD, SET_METHOD setMethod, REALOBJECT* objectPtr)
@@ -686,7 +1451,32 @@ namespace Core {
                     
                 if ( retval.second == false ) {
                     retval.first->second = lambda;
+                    Invalidate(methodName);
                 }
+                _generation++;
+            }
+            void Register(const string& methodName, const StreamFunction& lambda)
+            {
+                auto retval = _handlers.emplace(std::piecewise_construct,
+                                    std::make_tuple(methodName),
+                                    std::make_tuple(lambda));
+
+                if ( retval.second == false ) {
+                    retval.first->second = lambda;
+                    Invalidate(methodName);
+                }
+                _generation++;
+            }
+            // Read only properties with a large value. The value is handed over as element, it is serialized
+            // into the channel piece by piece and never converted to text as a whole.
+            template <typename PARAMETER, typename GET_METHOD, typename REALOBJECT>
+            void Stream(const string& methodName, GET_METHOD getMethod, REALOBJECT* objectPtr)
+            {
+                using COUNT = Core::TypeTraits::func_traits<GET_METHOD>;
+
+                static_assert((COUNT::Arguments == 1) || (COUNT::Arguments == 2), "We need 1 (value to get) or 2 (index and value to get) arguments!!!");
+
+                InternalStream<PARAMETER, GET_METHOD, REALOBJECT>(::TemplateIntToType<COUNT::Arguments>(), methodName, getMethod, objectPtr);
             }
             void Register(const string& methodName, const CallbackFunction& lambda)
             {
@@ -699,7 +1489,9 @@ namespace Core {
 
                 if ( retval.second == false ) {
                     retval.first->second = lambda;
+                    Invalidate(methodName);
                 }
+                _generation++;
             }
             void Unregister(const string& methodName)
             {
@@ -709,8 +1501,21 @@ namespace Core {
 
                 if (index != _handlers.end()) {
                     _handlers.erase(index);
+                    _generation++;
+                    Invalidate(methodName);
                 }
             }
+            // Changes whenever a method is (un)registered, the entries found before might be gone.
+            uint32_t Generation() const
+            {
+                return (_generation);
+            }
+            Entry* Find(const string& methodName)
+            {
+                HandlerMap::iterator index = _handlers.find(methodName);
+
+                return (index != _handlers.end() ? &(index->second) : nullptr);
+            }
             uint32_t Invoke(const Connection connection, const string& method, const string& parameters, string& response)
             {
                 uint32_t result = Core::ERROR_UNKNOWN_KEY;
@@ -723,17 +1528,103 @@ namespace Core {
                 }
                 return (result);
             }
+            // Opt in for methods that answer the same to the same parameters until the plugin tells it
+            // changed, by calling Invalidate() or by sending the event passed here. A call that returns
+            // nothing, like setting a property, is never kept and drops what was kept for the method.
+            void Cache(const string& methodName, const string& event = EMPTY_STRING)
+            {
+                _adminLock.Lock();
+                _cached[methodName] = event;
+                _responses.erase(methodName);
+                _revision++;
+                _adminLock.Unlock();
+            }
+            void Invalidate(const string& methodName)
+            {
+                _adminLock.Lock();
+                _responses.erase(methodName);
+                _revision++;
+                _adminLock.Unlock();
+            }
+            // Changes whenever kept responses are dropped. Take it before invoking, what is stored with an
+            // older one, might already be outdated.
+            uint32_t Revision() const
+            {
+                return (_revision);
+            }
+            bool Cached(const string& method, const string& parameters, string& response)
+            {
+                bool found = false;
+
+                _adminLock.Lock();
+
+                if (_responses.empty() == false) {
+                    ResponseMap::const_iterator index(_responses.find(Message::Method(method)));
+
+                    if (index != _responses.end()) {
+                        std::unordered_map<string, string>::const_iterator entry(index->second.find(method + ' ' + parameters));
+
+                        if (entry != index->second.end()) {
+                            response = entry->second;
+                            found = true;
+                            _hits++;
+                        }
+                    }
+                }
+
+                _adminLock.Unlock();
+
+                return (found);
+            }
+            void Store(const string& method, const string& parameters, const string& response, const uint32_t revision)
+            {
+                _adminLock.Lock();
+
+                if (_cached.empty() == false) {
+                    const string methodName(Message::Method(method));
+
+                    if (_cached.find(methodName) != _cached.end()) {
+                        _misses++;
+
+                        if (response.empty() == true) {
+                            _responses.erase(methodName);
+                            _revision++;
+                        } else if (revision == _revision) {
+                            std::unordered_map<string, string>& responses(_responses[methodName]);
+
+                            if (responses.size() >= CacheSlots) {
+                                responses.clear();
+                            }
+                            responses[method + ' ' + parameters] = response;
+                        }
+                    }
+                }
+
+                _adminLock.Unlock();
+            }
+            uint32_t Hits() const
+            {
+                return (_hits);
+            }
+            uint32_t Misses() const
+            {
+                return (_misses);
+            }
             void Subscribe(const uint32_t id, const string& eventId, const string& callsign, Core::JSONRPC::Message& response)
+            {
+                Subscribe(id, eventId, callsign, JSONRPC::Policy(), response);
+            }
+            void Subscribe(const uint32_t id, const string& eventId, const string& callsign, const JSONRPC::Policy& policy, Core::JSONRPC::Message& response)
             {
                 _adminLock.Lock();
 
                 ObserverMap::iterator index = _observers.find(eventId);
 
                 if (index == _observers.end()) {
-                    _observers[eventId].emplace_back(id, callsign);
+                    _observers[eventId].emplace_back(id, callsign, policy);
                     response.Result = _T("0");
-                } else if (std::find(index->second.begin(), index->second.end(), Observer(id, callsign)) == index->second.end()) {
-                    index->second.emplace_back(id, callsign);
+                } else if (std::find(index->second.begin(), index->second.end(), Observer(id, callsign, policy)) == index->second.end()) {
+                    index->second.emplace_back(id, callsign, policy);
                     response.Result = _T("0");
                 } else {
                     response.Error.SetError(Core::ERROR_DUPLICATE_KEY);
@@ -751,7 +1642,7 @@ namespace Core {
                 if (index != _observers.end()) {
                     ObserverList& clients = index->second;
                     ObserverList::iterator loop = clients.begin();
-                    Observer key(id, callsign);
+                    Observer key(id, callsign, JSONRPC::Policy());
 
                     while ((loop != clients.end()) && (*loop != key)) {
                         loop++;
@@ -822,6 +1713,8 @@ namespace Core {
                 _adminLock.Lock();
 
                 _observers.clear();
+                _responses.clear();
+                _revision++;
 
                 _adminLock.Unlock();
             }
@@ -942,6 +1835,43 @@ namespace Core {
                 };
                 Register(methodName, implementation);
             }
+            template <typename PARAMETER, typename GET_METHOD, typename REALOBJECT>
+            void InternalStream(const ::TemplateIntToType<1>&, const string& methodName, const GET_METHOD& getMethod, REALOBJECT* objectPtr)
+            {
+                std::function<uint32_t(const REALOBJECT&, PARAMETER&)> getter = getMethod;
+                ASSERT(objectPtr != nullptr);
+                StreamFunction implementation = [objectPtr, getter](const string&, const string& inbound, Core::ProxyType<Core::JSON::IElement>& outbound) -> uint32_t {
+                    uint32_t code;
+                    if (inbound.empty() == false) {
+                        code = Core::ERROR_UNAVAILABLE;
+                    } else {
+                        Core::ProxyType<PARAMETER> parameter(Core::ProxyType<PARAMETER>::Create());
+                        code = getter(*objectPtr, *parameter);
+                        outbound = Core::ProxyType<Core::JSON::IElement>(parameter);
+                    }
+                    return (code);
+                };
+                Register(methodName, implementation);
+            }
+            template <typename PARAMETER, typename GET_METHOD, typename REALOBJECT>
+            void InternalStream(const ::TemplateIntToType<2>&, const string& methodName, const GET_METHOD& getMethod, REALOBJECT* objectPtr)
+            {
+                std::function<uint32_t(const REALOBJECT&, const string&, PARAMETER&)> getter = getMethod;
+                ASSERT(objectPtr != nullptr);
+                StreamFunction implementation = [objectPtr, getter](const string& method, const string& inbound, Core::ProxyType<Core::JSON::IElement>& outbound) -> uint32_t {
+                    uint32_t code;
+                    if (inbound.empty() == false) {
+                        code = Core::ERROR_UNAVAILABLE;
+                    } else {
+                        const string index = Message::Index(method);
+                        Core::ProxyType<PARAMETER> parameter(Core::ProxyType<PARAMETER>::Create());
+                        code = getter(*objectPtr, index, *parameter);
+                        outbound = Core::ProxyType<Core::JSON::IElement>(parameter);
+                    }
+                    return (code);
+                };
+                Register(methodName, implementation);
+            }
             template <typename INBOUND, typename OUTBOUND, typename METHOD>
             void InternalRegister(const ::TemplateIntToType<1>&, const ::TemplateIntToType<1>&, const string& methodName, const METHOD& method)
             {
@@ -1093,40 +2023,61 @@ namespace Core {
             uint32_t InternalNotify(const string& event, const string& parameters, std::function<bool(const string&)>&& sendifmethod = std::function<bool(const string&)>())
             {
                 uint32_t result = Core::ERROR_UNKNOWN_KEY;
+                ObserverList clients;
 
+                // Take a snapshot of the subscribers, the sending is done without holding the lock.
                 _adminLock.Lock();
 
-                ObserverMap::iterator index = _observers.find(event);
+                // Whatever was kept for methods that change with this event, is outdated now.
+                for (const std::pair<const string, string>& entry : _cached) {
+                    if ((entry.second.empty() == false) && (entry.second == event)) {
+                        _responses.erase(entry.first);
+                        _revision++;
+                    }
+                }
 
-                if (index != _observers.end()) {
-                    ObserverList& clients = index->second;
-                    ObserverList::iterator loop = clients.begin();
+                ObserverMap::const_iterator index = _observers.find(event);
 
+                if (index != _observers.end()) {
+                    for (const Observer& observer : index->second) {
+                        clients.emplace_back(observer.Id(), observer.Designator(), observer.Policy());
+                    }
                     result = Core::ERROR_NONE;
+                }
 
-                    while (loop != clients.end()) {
-                        const string& designator(loop->Designator());
+                _adminLock.Unlock();
 
-                        if (!sendifmethod || sendifmethod(designator)) {
+                if (clients.empty() == false) {
+                    Core::ProxyType<Notification::Body> body(Core::ProxyType<Notification::Body>::Create(event, parameters));
 
-                            _notificationFunction(loop->Id(), (designator.empty() == false ? designator + '.' + event : event), parameters);
+                    for (const Observer& observer : clients) {
+                        if (!sendifmethod || sendifmethod(observer.Designator())) {
+                            _notificationFunction(observer.Id(), observer.Designator(), observer.Policy(), body);
                         }
-
-                        loop++;
                     }
                 }
 
-                _adminLock.Unlock();
-
                 return (result);
             }
+            static FanOutFunction Adapt(const NotificationFunction& notificationFunction)
+            {
+                return ([notificationFunction](const uint32_t id, const string& designator, const Policy&, const Core::ProxyType<Notification::Body>& body) {
+                    notificationFunction(id, body->Method(designator), body->Parameters());
+                });
+            }
 
         private:
             Core::CriticalSection _adminLock;
             HandlerMap _handlers;
             ObserverMap _observers;
-            NotificationFunction _notificationFunction;
+            FanOutFunction _notificationFunction;
             const std::vector<uint8_t> _versions;
+            std::atomic<uint32_t> _generation;
+            CacheMap _cached;
+            ResponseMap _responses;
+            std::atomic<uint32_t> _revision;
+            std::atomic<uint32_t> _hits;
+            std::atomic<uint32_t> _misses;
         };
 
         using Error = Message::Info;
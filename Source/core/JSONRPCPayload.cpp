@@ -0,0 +1,472 @@
+ /*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JSONRPCPayload.h"
+#include "Number.h"
+
+namespace WPEFramework {
+
+namespace Core {
+
+    namespace JSONRPC {
+
+        namespace {
+
+            // A nested array or map while it is unpacked, a map counts its keys and values.
+            struct Frame {
+                uint64_t Index;
+                uint64_t Count;
+                bool Map;
+            };
+
+            // The character a JSON string escapes a character with, the way a Core::JSON::String does, 0 if none.
+            class Escapes {
+            public:
+                Escapes(const Escapes&) = delete;
+                Escapes& operator=(const Escapes&) = delete;
+
+                Escapes()
+                {
+                    ::memset(_table, 0, sizeof(_table));
+                    _table[static_cast<uint8_t>('\"')] = '\"';
+                    _table[static_cast<uint8_t>('\\')] = '\\';
+                    _table[static_cast<uint8_t>('\b')] = 'b';
+                    _table[static_cast<uint8_t>('\f')] = 'f';
+                    _table[static_cast<uint8_t>('\n')] = 'n';
+                    _table[static_cast<uint8_t>('\r')] = 'r';
+                    _table[static_cast<uint8_t>('\t')] = 't';
+                }
+                ~Escapes() = default;
+
+            public:
+                inline TCHAR operator[](const TCHAR character) const
+                {
+                    return (_table[static_cast<uint8_t>(character)]);
+                }
+
+            private:
+                TCHAR _table[256];
+            };
+
+            static const Escapes EscapeTable;
+
+            // Writes into a string that is grown ahead of what is written, so a value is written without
+            // checking the room for every character. It is cut to the size written when done.
+            class Unpacker {
+            public:
+                Unpacker() = delete;
+                Unpacker(const Unpacker&) = delete;
+                Unpacker& operator=(const Unpacker&) = delete;
+
+                Unpacker(string& text, const uint32_t expected)
+                    : _text(text)
+                    , _used(0)
+                {
+                    _text.resize(expected);
+                }
+                ~Unpacker() = default;
+
+            public:
+                inline TCHAR* Room(const uint32_t size)
+                {
+                    if ((_used + size) > _text.size()) {
+                        _text.resize(std::max(static_cast<uint32_t>(_text.size() * 2), _used + size));
+                    }
+
+                    return (&(_text[0]) + _used);
+                }
+                inline void Character(const TCHAR character)
+                {
+                    *Room(1) = character;
+                    _used++;
+                }
+                void Append(const TCHAR text[], const uint32_t length)
+                {
+                    ::memcpy(Room(length), text, length);
+                    _used += length;
+                }
+                // Escapes the way a Core::JSON::String does, so it reads back the same.
+                void Quote(const TCHAR value[], const uint32_t length)
+                {
+                    TCHAR* const start = Room((2 * length) + 2);
+                    TCHAR* current = start;
+
+                    *current++ = '\"';
+
+                    for (uint32_t index = 0; index < length; ++index) {
+                        const TCHAR escaped = EscapeTable[value[index]];
+
+                        if (escaped == 0) {
+                            *current++ = value[index];
+                        } else {
+                            *current++ = '\\';
+                            *current++ = escaped;
+                        }
+                    }
+
+                    *current++ = '\"';
+
+                    _used += static_cast<uint32_t>(current - start);
+                }
+                void Decimal(const uint64_t value, const bool negative)
+                {
+                    TCHAR buffer[20];
+                    const uint8_t length = Core::ToDecimal((negative == true ? (0 - value) : value), &(buffer[sizeof(buffer)]));
+
+                    if (negative == true) {
+                        Character('-');
+                    }
+
+                    Append(&(buffer[sizeof(buffer) - length]), length);
+                }
+                void Done()
+                {
+                    _text.resize(_used);
+                }
+
+            private:
+                string& _text;
+                uint32_t _used;
+            };
+
+            bool Read(const uint8_t stream[], const uint32_t length, const uint32_t position, const uint8_t size, uint64_t& value)
+            {
+                const bool result = ((position <= length) && ((length - position) >= size));
+
+                if (result == true) {
+                    value = 0;
+
+                    for (uint8_t index = 0; index < size; ++index) {
+                        value = (value << 8) | stream[position + index];
+                    }
+                }
+
+                return (result);
+            }
+            // Adds the text of a value that is not an array or a map, binary data is shown in base64.
+            bool Scalar(const uint8_t stream[], const uint32_t length, uint32_t& position, Unpacker& text)
+            {
+                const uint8_t header = stream[position++];
+                uint64_t value = 0;
+                bool result = true;
+
+                if ((header <= 0x7F) || (header >= 0xE0)) {
+                    text.Decimal(static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(header))), (header >= 0xE0));
+                } else if (header == Core::JSON::IMessagePack::NullValue) {
+                    text.Append(Core::JSON::IElement::NullTag, 4);
+                } else if (header == 0xC3) {
+                    text.Append(_T("true"), 4);
+                } else if (header == 0xC2) {
+                    text.Append(_T("false"), 5);
+                } else if ((header >= 0xCC) && (header <= 0xD3)) {
+                    const uint8_t size = static_cast<uint8_t>(1 << ((header - 0xCC) & 0x03));
+
+                    if ((result = Read(stream, length, position, size, value)) == true) {
+                        if (header <= 0xCF) {
+                            text.Decimal(value, false);
+                        } else {
+                            // Sign extend the narrower formats.
+                            const uint8_t shift = static_cast<uint8_t>(64 - (8 * size));
+                            const int64_t number = (static_cast<int64_t>(value << shift) >> shift);
+                            text.Decimal(static_cast<uint64_t>(number), (number < 0));
+                        }
+                        position += size;
+                    }
+                } else if ((header == 0xCA) || (header == 0xCB)) {
+                    const uint8_t size = (header == 0xCA ? 4 : 8);
+
+                    if ((result = Read(stream, length, position, size, value)) == true) {
+                        char buffer[32];
+                        double real;
+
+                        if (header == 0xCA) {
+                            const uint32_t bits = static_cast<uint32_t>(value);
+                            float single;
+                            ::memcpy(&single, &bits, sizeof(single));
+                            real = single;
+                        } else {
+                            ::memcpy(&real, &value, sizeof(real));
+                        }
+
+                        if ((std::isinf(real) == true) || (std::isnan(real) == true)) {
+                            text.Append(Core::JSON::IElement::NullTag, 4);
+                        } else if (header == 0xCA) {
+                            text.Append(buffer, Core::ToShortest(static_cast<float>(real), buffer));
+                        } else {
+                            text.Append(buffer, Core::ToShortest(real, buffer));
+                        }
+                        position += size;
+                    }
+                } else if (((header & 0xE0) == 0xA0) || ((header >= 0xD9) && (header <= 0xDB)) || ((header >= 0xC4) && (header <= 0xC6))) {
+                    const bool binary = ((header >= 0xC4) && (header <= 0xC6));
+
+                    if ((header & 0xE0) == 0xA0) {
+                        value = (header & 0x1F);
+                    } else {
+                        const uint8_t size = static_cast<uint8_t>(1 << (binary == true ? (header - 0xC4) : (header - 0xD9)));
+
+                        result = Read(stream, length, position, size, value);
+                        position += size;
+                    }
+
+                    if ((result = ((result == true) && (value <= (length - position)))) == true) {
+                        if (binary == false) {
+                            text.Quote(reinterpret_cast<const TCHAR*>(&(stream[position])), static_cast<uint32_t>(value));
+                        } else if ((result = (value <= 0xFFFF)) == true) {
+                            string encoded;
+                            Core::ToString(&(stream[position]), static_cast<uint16_t>(value), true, encoded);
+                            text.Quote(encoded.c_str(), static_cast<uint32_t>(encoded.length()));
+                        }
+                        position += static_cast<uint32_t>(value);
+                    }
+                } else {
+                    // Extension types have no JSON counterpart.
+                    result = false;
+                }
+
+                return (result);
+            }
+            // Moves past the values that are complete in the stream, expected counts the values still to come.
+            bool Skip(const uint8_t stream[], const uint32_t length, uint32_t& position, uint64_t& expected)
+            {
+                bool result = true;
+
+                while ((result == true) && (expected > 0) && (position < length)) {
+                    const uint8_t header = stream[position];
+                    uint8_t size = 0;
+                    uint8_t extra = 0;
+                    uint64_t payload = 0;
+                    uint64_t children = 0;
+                    bool counted = false;
+
+                    if ((header <= 0x7F) || (header >= 0xE0) || (header == 0xC0) || (header == 0xC2) || (header == 0xC3)) {
+                    } else if ((header & 0xF0) == 0x80) {
+                        children = (header & 0x0F) * 2;
+                    } else if ((header & 0xF0) == 0x90) {
+                        children = (header & 0x0F);
+                    } else if ((header & 0xE0) == 0xA0) {
+                        payload = (header & 0x1F);
+                    } else if ((header >= 0xCA) && (header <= 0xD3)) {
+                        payload = (header <= 0xCB ? (header == 0xCA ? 4 : 8) : (1 << ((header - 0xCC) & 0x03)));
+                    } else if ((header >= 0xD4) && (header <= 0xD8)) {
+                        payload = 1 + (1 << (header - 0xD4));
+                    } else if ((header >= 0xC4) && (header <= 0xC6)) {
+                        size = static_cast<uint8_t>(1 << (header - 0xC4));
+                        counted = true;
+                    } else if ((header >= 0xC7) && (header <= 0xC9)) {
+                        size = static_cast<uint8_t>(1 << (header - 0xC7));
+                        extra = 1;
+                        counted = true;
+                    } else if ((header >= 0xD9) && (header <= 0xDB)) {
+                        size = static_cast<uint8_t>(1 << (header - 0xD9));
+                        counted = true;
+                    } else if ((header >= 0xDC) && (header <= 0xDF)) {
+                        size = ((header & 0x01) == 0 ? 2 : 4);
+                    } else {
+                        result = false;
+                    }
+
+                    if (result == true) {
+                        uint64_t value = 0;
+
+                        if (Read(stream, length, position + 1, size, value) == false) {
+                            break;
+                        }
+
+                        if (counted == true) {
+                            payload = value + extra;
+                        } else if (header >= 0xDC) {
+                            children = (header >= 0xDE ? value * 2 : value);
+                        }
+
+                        if ((length - position - 1 - size) < payload) {
+                            break;
+                        }
+
+                        position += static_cast<uint32_t>(1 + size + payload);
+                        expected += children;
+                        expected--;
+                    }
+                }
+
+                return (result);
+            }
+        }
+
+        /* static */ bool Payload::Unpack(const uint8_t stream[], const uint32_t length, string& text)
+        {
+            Unpacker unpacker(text, length + (length / 2));
+            std::vector<Frame> frames;
+            uint32_t position = 0;
+            bool result = true;
+
+            do {
+                bool key = false;
+
+                if (frames.empty() == false) {
+                    Frame& frame(frames.back());
+
+                    if ((frame.Map == true) && ((frame.Index & 1) != 0)) {
+                        unpacker.Character(':');
+                    } else {
+                        if (frame.Index != 0) {
+                            unpacker.Character(',');
+                        }
+                        key = frame.Map;
+                    }
+                    frame.Index++;
+                }
+
+                if (position >= length) {
+                    result = false;
+                } else {
+                    const uint8_t header = stream[position];
+                    uint64_t count = 0;
+                    bool map = false;
+
+                    if (((header & 0xE0) == 0x80) || (header == 0xDC) || (header == 0xDD) || (header == 0xDE) || (header == 0xDF)) {
+                        map = (((header & 0xF0) == 0x80) || (header == 0xDE) || (header == 0xDF));
+
+                        if (key == true) {
+                            result = false;
+                        } else if ((header & 0xE0) == 0x80) {
+                            count = (header & 0x0F);
+                            position++;
+                        } else {
+                            const uint8_t size = (((header == 0xDC) || (header == 0xDE)) ? 2 : 4);
+
+                            result = Read(stream, length, position + 1, size, count);
+                            position += 1 + size;
+                        }
+
+                        if (result == true) {
+                            unpacker.Character(map == true ? '{' : '[');
+                            frames.push_back({ 0, (map == true ? count * 2 : count), map });
+                        }
+                    } else if ((key == false) || ((header & 0xE0) == 0xA0) || ((header >= 0xC4) && (header <= 0xC6)) || ((header >= 0xD9) && (header <= 0xDB))) {
+                        result = Scalar(stream, length, position, unpacker);
+                    } else {
+                        // Keys in JSON are strings, other scalars are quoted, there is nothing in them to escape.
+                        unpacker.Character('\"');
+                        result = Scalar(stream, length, position, unpacker);
+                        unpacker.Character('\"');
+                    }
+                }
+
+                while ((result == true) && (frames.empty() == false) && (frames.back().Index == frames.back().Count)) {
+                    unpacker.Character(frames.back().Map == true ? '}' : ']');
+                    frames.pop_back();
+                }
+            } while ((result == true) && (frames.empty() == false));
+
+            unpacker.Done();
+
+            return ((result == true) && (position == length));
+        }
+
+        /* static */ void Payload::Text(const string& text, std::vector<uint8_t>& stream)
+        {
+            const uint32_t length = static_cast<uint32_t>(text.length());
+
+            stream.clear();
+            stream.reserve(length + 5);
+
+            if (length <= 31) {
+                stream.push_back(static_cast<uint8_t>(0xA0 | length));
+            } else if (length <= 0xFF) {
+                stream.push_back(0xD9);
+                stream.push_back(static_cast<uint8_t>(length));
+            } else if (length <= 0xFFFF) {
+                stream.push_back(0xDA);
+                stream.push_back(static_cast<uint8_t>(length >> 8));
+                stream.push_back(static_cast<uint8_t>(length));
+            } else {
+                stream.push_back(0xDB);
+                stream.push_back(static_cast<uint8_t>(length >> 24));
+                stream.push_back(static_cast<uint8_t>(length >> 16));
+                stream.push_back(static_cast<uint8_t>(length >> 8));
+                stream.push_back(static_cast<uint8_t>(length));
+            }
+
+            stream.insert(stream.end(), text.begin(), text.end());
+        }
+
+        uint16_t Payload::Deserialize(const uint8_t stream[], const uint16_t maxLength, uint32_t& offset)
+        {
+            uint16_t loaded = maxLength;
+
+            if (offset == 0) {
+                const uint8_t header = stream[0];
+
+                Clear();
+
+                _native = ((header != Core::JSON::IMessagePack::NullValue) && ((header & 0xE0) != 0xA0) && ((header < 0xD9) || (header > 0xDB)));
+            }
+
+            if (_native == false) {
+                // The text as is, the way it is sent.
+                loaded = Core::JSON::String::Deserialize(stream, maxLength, offset);
+            } else if (offset == 0) {
+                uint32_t scanned = 0;
+                uint64_t expected = 1;
+
+                if (Skip(stream, maxLength, scanned, expected) == false) {
+                    // There is no way to unpack this, just swallow it.
+                } else if (expected == 0) {
+                    // Mostly the value is complete in what is received, it is unpacked right from it.
+                    loaded = static_cast<uint16_t>(scanned);
+                    Unpacked(stream, scanned);
+                } else {
+                    _packed.assign(stream, stream + maxLength);
+                    _scanned = scanned;
+                    _expected = expected;
+                    offset = 1;
+                }
+            } else {
+                const uint32_t start = static_cast<uint32_t>(_packed.size());
+
+                _packed.insert(_packed.end(), stream, stream + maxLength);
+
+                if (Skip(_packed.data(), static_cast<uint32_t>(_packed.size()), _scanned, _expected) == false) {
+                    // There is no way to unpack this, just swallow it.
+                    _packed.clear();
+                    offset = 0;
+                } else if (_expected == 0) {
+                    loaded = static_cast<uint16_t>(_scanned - start);
+                    offset = 0;
+
+                    Unpacked(_packed.data(), _scanned);
+                    _packed.clear();
+                }
+            }
+
+            return (loaded);
+        }
+
+        void Payload::Unpacked(const uint8_t stream[], const uint32_t length)
+        {
+            string text;
+
+            if (Unpack(stream, length, text) == true) {
+                Core::JSON::String::operator=(text);
+            }
+        }
+    }
+}
+} // namespace WPEFramework::Core::JSONRPC
@@ -0,0 +1,108 @@
+ /*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "JSON.h"
+#include "Module.h"
+
+#include <vector>
+
+namespace WPEFramework {
+
+namespace Core {
+
+    namespace JSONRPC {
+
+        // JSON text, as the handlers take and return the parameters, results and error data. On a
+        // MessagePack channel it travels as a string holding that text, so it is copied as is on both
+        // ends and only the envelope around it is packed. Converting it into the native encoding of the
+        // value it describes costs a parse of the text on both ends, more than the JSON channel spends.
+        // A value that a peer does pack natively is still taken, it is converted into text when received.
+        class EXTERNAL Payload : public Core::JSON::String {
+        public:
+            Payload()
+                : Core::JSON::String(false)
+                , _packed()
+                , _scanned(0)
+                , _expected(0)
+                , _native(false)
+            {
+            }
+            Payload(const Payload& copy)
+                : Core::JSON::String(copy)
+                , _packed()
+                , _scanned(0)
+                , _expected(0)
+                , _native(false)
+            {
+            }
+            ~Payload() override
+            {
+            }
+
+            using Core::JSON::String::operator=;
+
+            Payload& operator=(const Payload& RHS)
+            {
+                Core::JSON::String::operator=(RHS);
+
+                return (*this);
+            }
+
+        public:
+            // Packs the text the way a payload travels, as a string holding it.
+            static void Text(const string& text, std::vector<uint8_t>& stream);
+            // Returns false if the stream does not hold exactly one value that can be expressed in JSON.
+            static bool Unpack(const uint8_t stream[], const uint32_t length, string& text);
+
+            // Copies the next part of a packed value, the offset is the position in it, 0 once all is written.
+            static uint16_t Copy(const std::vector<uint8_t>& packed, uint8_t stream[], const uint16_t maxLength, uint32_t& offset)
+            {
+                const uint16_t loaded = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxLength), static_cast<uint32_t>(packed.size()) - offset));
+
+                ::memcpy(stream, &(packed[offset]), loaded);
+
+                offset = ((offset + loaded) >= packed.size() ? 0 : offset + loaded);
+
+                return (loaded);
+            }
+
+            // IElement and IMessagePack iface:
+            void Clear() override
+            {
+                Core::JSON::String::Clear();
+                _packed.clear();
+            }
+
+        private:
+            // IMessagePack iface:
+            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint32_t& offset) override;
+
+            void Unpacked(const uint8_t stream[], const uint32_t length);
+
+        private:
+            std::vector<uint8_t> _packed;
+            uint32_t _scanned;
+            uint64_t _expected;
+            bool _native;
+        };
+    }
+}
+} // namespace WPEFramework::Core::JSONRPC
@@ -0,0 +1,741 @@
+ /*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __JSONREADER_H
+#define __JSONREADER_H
+
+#include <map>
+#include <vector>
+
+#include "DataElementFile.h"
+#include "FileSystem.h"
+#include "JSON.h"
+#include "Portability.h"
+
+namespace WPEFramework {
+
+namespace Core {
+
+    namespace JSON {
+
+        // The Reader is a pull parser: instead of building an IElement tree for the whole
+        // document, every call to Next() reports the next structural event found in the
+        // text (begin/end of an object or array, a key or a scalar value). The text is
+        // offered in windows (Feed), so the document never needs to be in memory as a whole.
+        // Subtrees can be bound to typed IElement's by path, e.g. "services.3.configuration",
+        // keys are separated by a dot and array entries are addressed by their index. A bound
+        // subtree is handed, as is, to the Deserialize of the element, so only that part of
+        // the document is materialised.
+        class EXTERNAL Reader {
+        private:
+            enum class state : uint8_t {
+                VALUE,
+                FIRST_VALUE,
+                FIRST_KEY,
+                KEY,
+                COLON,
+                SEPARATOR,
+                IN_KEY,
+                IN_STRING,
+                IN_LITERAL,
+                IN_ELEMENT,
+                IN_SKIP,
+                DONE,
+                FAILED
+            };
+
+            struct Frame {
+                Frame(const bool array, const uint32_t length)
+                    : Array(array)
+                    , Index(0)
+                    , Length(length)
+                {
+                }
+
+                bool Array;
+                uint32_t Index;
+                uint32_t Length;
+            };
+
+            typedef std::map<string, IElement*> Bindings;
+
+        public:
+            enum class token : uint8_t {
+                NONE, // More data is needed, Feed or Close the reader.
+                BEGIN_OBJECT,
+                END_OBJECT,
+                BEGIN_ARRAY,
+                END_ARRAY,
+                KEY,
+                STRING,
+                NUMBER,
+                BOOLEAN,
+                NULL_VALUE,
+                BOUND, // A bound element has been deserialized from the document.
+                END,
+                ERROR
+            };
+
+        public:
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            Reader()
+                : _window(nullptr)
+                , _length(0)
+                , _position(0)
+                , _closed(false)
+                , _state(state::VALUE)
+                , _next(state::VALUE)
+                , _scope()
+                , _path()
+                , _text()
+                , _string(true)
+                , _offset(0)
+                , _element(nullptr)
+                , _depth(0)
+                , _quoted(false)
+                , _escaped(false)
+                , _bindings()
+                , _error()
+            {
+            }
+            virtual ~Reader()
+            {
+            }
+
+        public:
+            // The window must stay valid until Next() reports NONE, the reader does not copy it.
+            void Feed(const char data[], const uint32_t length)
+            {
+                ASSERT(_position == _length);
+
+                _window = data;
+                _length = length;
+                _position = 0;
+            }
+            // No more data will be fed, whatever is pending is the end of the document.
+            void Close()
+            {
+                _closed = true;
+            }
+            void Reset()
+            {
+                _window = nullptr;
+                _length = 0;
+                _position = 0;
+                _closed = false;
+                _state = state::VALUE;
+                _next = state::VALUE;
+                _scope.clear();
+                _path.clear();
+                _text.clear();
+                _element = nullptr;
+                _error.Clear();
+            }
+            void Bind(const string& path, IElement& element)
+            {
+                _bindings[path] = &element;
+            }
+            void Unbind(const string& path)
+            {
+                _bindings.erase(path);
+            }
+
+            // Path of the element that the last token reported on.
+            inline const string& Path() const
+            {
+                return (_path);
+            }
+            // Key name, or the (unescaped) scalar value of the last token.
+            inline const string& Text() const
+            {
+                return (_text);
+            }
+            inline uint32_t Depth() const
+            {
+                return (static_cast<uint32_t>(_scope.size()));
+            }
+            inline const Core::OptionalType<JSON::Error>& LastError() const
+            {
+                return (_error);
+            }
+            inline bool IsRelevant(const string& path) const
+            {
+                bool result = false;
+                Bindings::const_iterator index(_bindings.lower_bound(path));
+
+                while ((result == false) && (index != _bindings.end()) && (index->first.compare(0, path.length(), path) == 0)) {
+                    result = ((path.empty() == true) || (index->first.length() == path.length()) || (index->first[path.length()] == '.'));
+                    index++;
+                }
+
+                return (result);
+            }
+
+            // Skip the value that follows a KEY, or the remainder of the object/array that was
+            // just opened, without decoding it.
+            void Skip()
+            {
+                ASSERT((_state == state::COLON) || (_state == state::FIRST_VALUE) || (_state == state::FIRST_KEY));
+
+                if (_state == state::COLON) {
+                    _depth = 0;
+                    _next = state::IN_SKIP;
+                } else {
+                    _depth = 1;
+                    _path.resize(_scope.back().Length);
+                    _scope.pop_back();
+                    _state = state::IN_SKIP;
+                }
+                _quoted = false;
+                _escaped = false;
+                _text.clear();
+            }
+
+            // Deserialize the value that follows a KEY, or the document if nothing was read yet,
+            // into the given element. It is reported as BOUND.
+            void Load(IElement& element)
+            {
+                ASSERT((_state == state::COLON) || ((_state == state::VALUE) && (_scope.empty() == true)));
+
+                _element = &element;
+                _element->Clear();
+                _offset = 0;
+
+                if (_state == state::COLON) {
+                    _next = state::IN_ELEMENT;
+                } else {
+                    _state = state::IN_ELEMENT;
+                }
+            }
+
+            token Next()
+            {
+                token result = token::NONE;
+
+                while (result == token::NONE) {
+
+                    if (_position == _length) {
+                        if (Underflow() == true) {
+                            continue;
+                        } else if (_closed == false) {
+                            break;
+                        }
+                        result = Finish();
+                        break;
+                    }
+
+                    switch (_state) {
+                    case state::IN_KEY:
+                    case state::IN_STRING:
+                        result = ParseString();
+                        break;
+                    case state::IN_LITERAL:
+                        result = ParseLiteral();
+                        break;
+                    case state::IN_ELEMENT:
+                        result = ParseElement();
+                        break;
+                    case state::IN_SKIP:
+                        ParseSkip();
+                        break;
+                    case state::DONE:
+                        if (::isspace(_window[_position]) == 0) {
+                            result = Failed(_T("Unexpected data after the end of the document."));
+                        } else {
+                            _position++;
+                        }
+                        break;
+                    case state::FAILED:
+                        result = token::ERROR;
+                        break;
+                    default:
+                        result = ParseStructure();
+                        break;
+                    }
+                }
+
+                return (result);
+            }
+
+            // Like Next(), but subtrees that do not hold a bound path are skipped, so only
+            // BOUND, END, ERROR and NONE are reported.
+            token Scan()
+            {
+                token result;
+
+                do {
+                    result = Next();
+
+                    if ((result == token::KEY) || (result == token::BEGIN_OBJECT) || (result == token::BEGIN_ARRAY)) {
+                        if (IsRelevant(_path) == false) {
+                            Skip();
+                        }
+                    }
+                } while ((result != token::BOUND) && (result != token::END) && (result != token::ERROR) && (result != token::NONE));
+
+                return (result);
+            }
+
+        protected:
+            // Called when the current window is exhausted. Return true if a new window was fed.
+            virtual bool Underflow()
+            {
+                return (false);
+            }
+
+        private:
+            token Failed(const TCHAR message[])
+            {
+                _error = JSON::Error{ string(message) };
+                _error.Value().Context(_window, _length, _position);
+                _state = state::FAILED;
+                return (token::ERROR);
+            }
+            void Completed()
+            {
+                _state = (_scope.empty() == true ? state::DONE : state::SEPARATOR);
+            }
+            token Finish()
+            {
+                token result = token::END;
+
+                if ((_state == state::IN_LITERAL) || (_state == state::IN_ELEMENT)) {
+                    // A literal is only terminated by its delimiter, offer one.
+                    static const char terminator[] = " ";
+                    const char* window = _window;
+                    uint32_t length = _length;
+                    _window = terminator;
+                    _length = 1;
+                    _position = 0;
+
+                    result = (_state == state::IN_LITERAL ? ParseLiteral() : ParseElement());
+
+                    _window = window;
+                    _length = length;
+                    _position = length;
+
+                    if ((result == token::NONE) && (_state != state::DONE)) {
+                        result = Failed(_T("Unexpected end of the document."));
+                    }
+                } else if ((_state == state::IN_SKIP) && (_depth == 0) && (_quoted == false) && (_text.empty() == false)) {
+                    Completed();
+                } else if (_state == state::FAILED) {
+                    result = token::ERROR;
+                } else if (_state != state::DONE) {
+                    result = Failed(_T("Unexpected end of the document."));
+                }
+
+                return (result);
+            }
+            void Push(const bool array)
+            {
+                _scope.emplace_back(array, static_cast<uint32_t>(_path.length()));
+                _text.clear();
+            }
+            token Pop(const bool array)
+            {
+                token result;
+
+                if ((_scope.empty() == true) || (_scope.back().Array != array)) {
+                    result = Failed(array ? _T("Unexpected \"]\".") : _T("Unexpected \"}\"."));
+                } else {
+                    _path.resize(_scope.back().Length);
+                    _scope.pop_back();
+                    _text.clear();
+                    _position++;
+                    Completed();
+                    result = (array ? token::END_ARRAY : token::END_OBJECT);
+                }
+
+                return (result);
+            }
+            void Label(const TCHAR label[], const uint32_t length)
+            {
+                _path.resize(_scope.back().Length);
+                if (_path.empty() == false) {
+                    _path += '.';
+                }
+                _path.append(label, length);
+            }
+            token StartValue()
+            {
+                token result = token::NONE;
+
+                if ((_scope.empty() == false) && (_scope.back().Array == true)) {
+                    string index(Core::NumberType<uint32_t>(_scope.back().Index++).Text());
+                    Label(index.c_str(), static_cast<uint32_t>(index.length()));
+                }
+
+                Bindings::iterator binding(_bindings.find(_path));
+
+                if (binding != _bindings.end()) {
+                    _element = binding->second;
+                    _element->Clear();
+                    _offset = 0;
+                    _state = state::IN_ELEMENT;
+                } else {
+                    switch (_window[_position]) {
+                    case '{':
+                        _position++;
+                        Push(false);
+                        _state = state::FIRST_KEY;
+                        result = token::BEGIN_OBJECT;
+                        break;
+                    case '[':
+                        _position++;
+                        Push(true);
+                        _state = state::FIRST_VALUE;
+                        result = token::BEGIN_ARRAY;
+                        break;
+                    case '\"':
+                        _string.Clear();
+                        _offset = 0;
+                        _state = state::IN_STRING;
+                        break;
+                    default:
+                        _text.clear();
+                        _state = state::IN_LITERAL;
+                        break;
+                    }
+                }
+
+                return (result);
+            }
+            token ParseStructure()
+            {
+                token result = token::NONE;
+                const TCHAR current = _window[_position];
+
+                if (::isspace(current) != 0) {
+                    _position++;
+                } else {
+                    switch (_state) {
+                    case state::FIRST_VALUE:
+                        if (current == ']') {
+                            result = Pop(true);
+                            break;
+                        }
+                        // fall through
+                    case state::VALUE:
+                        result = StartValue();
+                        break;
+                    case state::FIRST_KEY:
+                        if (current == '}') {
+                            result = Pop(false);
+                            break;
+                        }
+                        // fall through
+                    case state::KEY:
+                        if (current != '\"') {
+                            result = Failed(_T("Key must be properly quoted."));
+                        } else {
+                            _string.Clear();
+                            _offset = 0;
+                            _state = state::IN_KEY;
+                        }
+                        break;
+                    case state::COLON:
+                        if (current != ':') {
+                            result = Failed(_T("Colon expected."));
+                        } else {
+                            _position++;
+                            _state = _next;
+                            _next = state::VALUE;
+                        }
+                        break;
+                    case state::SEPARATOR:
+                        if (current == ',') {
+                            _position++;
+                            _state = (_scope.back().Array == true ? state::VALUE : state::KEY);
+                        } else if ((current == '}') || (current == ']')) {
+                            result = Pop(current == ']');
+                        } else {
+                            result = Failed(_T("Expected either \",\" or the end of the object or array."));
+                        }
+                        break;
+                    default:
+                        ASSERT(false);
+                        break;
+                    }
+                }
+
+                return (result);
+            }
+            token ParseString()
+            {
+                token result = token::NONE;
+                uint16_t length = static_cast<uint16_t>(std::min(_length - _position, static_cast<uint32_t>(0xFFFF)));
+                _position += static_cast<IElement&>(_string).Deserialize(&(_window[_position]), length, _offset, _error);
+
+                if (_error.IsSet() == true) {
+                    _state = state::FAILED;
+                    result = token::ERROR;
+                } else if (_offset == 0) {
+                    _text = _string.Value();
+
+                    if (_state == state::IN_KEY) {
+                        Label(_text.c_str(), static_cast<uint32_t>(_text.length()));
+                        _state = state::COLON;
+                        result = token::KEY;
+                    } else {
+                        Completed();
+                        result = token::STRING;
+                    }
+                }
+
+                return (result);
+            }
+            token ParseLiteral()
+            {
+                token result = token::NONE;
+
+                while ((_position < _length) && (result == token::NONE)) {
+                    const TCHAR current = _window[_position];
+
+                    if ((::isspace(current) == 0) && (current != ',') && (current != '}') && (current != ']')) {
+                        _text += current;
+                        _position++;
+                    } else if (_text == _T("true") || _text == _T("false")) {
+                        result = token::BOOLEAN;
+                    } else if (_text == IElement::NullTag) {
+                        result = token::NULL_VALUE;
+                    } else if (IsNumber(_text) == true) {
+                        result = token::NUMBER;
+                    } else {
+                        result = Failed(_T("Invalid value."));
+                    }
+                }
+
+                if ((result != token::NONE) && (result != token::ERROR)) {
+                    Completed();
+                }
+
+                return (result);
+            }
+
+            // The JSON number grammar: -? (0 | [1-9][0-9]*) (.[0-9]+)? ([eE][+-]?[0-9]+)?
+            static bool IsNumber(const string& text)
+            {
+                const TCHAR* current = text.c_str();
+
+                if (*current == '-') {
+                    current++;
+                }
+                if (*current == '0') {
+                    current++;
+                } else if (::isdigit(*current) != 0) {
+                    while (::isdigit(*current) != 0) {
+                        current++;
+                    }
+                } else {
+                    return (false);
+                }
+                if (*current == '.') {
+                    current++;
+                    if (::isdigit(*current) == 0) {
+                        return (false);
+                    }
+                    while (::isdigit(*current) != 0) {
+                        current++;
+                    }
+                }
+                if ((*current == 'e') || (*current == 'E')) {
+                    current++;
+                    if ((*current == '+') || (*current == '-')) {
+                        current++;
+                    }
+                    if (::isdigit(*current) == 0) {
+                        return (false);
+                    }
+                    while (::isdigit(*current) != 0) {
+                        current++;
+                    }
+                }
+
+                return (*current == '\0');
+            }
+            token ParseElement()
+            {
+                token result = token::NONE;
+
+                if (_offset == 0) {
+                    // Elements expect their value to start at the first character offered.
+                    while ((_position < _length) && (::isspace(_window[_position]) != 0)) {
+                        _position++;
+                    }
+                }
+
+                if (_position < _length) {
+                    uint16_t length = static_cast<uint16_t>(std::min(_length - _position, static_cast<uint32_t>(0xFFFF)));
+
+                    _position += _element->Deserialize(&(_window[_position]), length, _offset, _error);
+
+                    if (_error.IsSet() == true) {
+                        _state = state::FAILED;
+                        result = token::ERROR;
+                    } else if (_offset == 0) {
+                        _element = nullptr;
+                        Completed();
+                        result = token::BOUND;
+                    }
+                }
+
+                return (result);
+            }
+            void ParseSkip()
+            {
+                while (_position < _length) {
+                    const TCHAR current = _window[_position];
+
+                    if (_quoted == true) {
+                        if (_escaped == true) {
+                            _escaped = false;
+                        } else if (current == '\\') {
+                            _escaped = true;
+                        } else if (current == '\"') {
+                            _quoted = false;
+                            if (_depth == 0) {
+                                _position++;
+                                Completed();
+                                break;
+                            }
+                        }
+                    } else if (current == '\"') {
+                        _quoted = true;
+                    } else if ((current == '{') || (current == '[')) {
+                        _depth++;
+                    } else if ((current == '}') || (current == ']') || (current == ',')) {
+                        if (_depth == 0) {
+                            // End of a skipped literal, the delimiter belongs to the parent.
+                            Completed();
+                            break;
+                        } else if (current != ',') {
+                            _depth--;
+                            if (_depth == 0) {
+                                _position++;
+                                Completed();
+                                break;
+                            }
+                        }
+                    } else if ((_depth == 0) && (::isspace(current) != 0) && (_text.empty() == false)) {
+                        Completed();
+                        break;
+                    } else if ((_depth == 0) && (::isspace(current) == 0)) {
+                        // Remember we have seen a literal, the whitespace after it terminates it.
+                        _text = current;
+                    }
+
+                    _position++;
+                }
+            }
+
+        private:
+            const char* _window;
+            uint32_t _length;
+            uint32_t _position;
+            bool _closed;
+            state _state;
+            state _next;
+            std::vector<Frame> _scope;
+            string _path;
+            string _text;
+            String _string;
+            uint32_t _offset;
+            IElement* _element;
+            uint32_t _depth;
+            bool _quoted;
+            bool _escaped;
+            Bindings _bindings;
+            Core::OptionalType<JSON::Error> _error;
+        };
+
+        // Pulls the document from a file through a fixed size window.
+        template <const uint16_t WINDOWSIZE>
+        class FileReaderType : public Reader {
+        public:
+            FileReaderType() = delete;
+            FileReaderType(const FileReaderType<WINDOWSIZE>&) = delete;
+            FileReaderType<WINDOWSIZE>& operator=(const FileReaderType<WINDOWSIZE>&) = delete;
+
+            FileReaderType(Core::File& file)
+                : Reader()
+                , _file(file)
+            {
+                static_assert(WINDOWSIZE > 0, "A window of at least one byte is required");
+            }
+            ~FileReaderType() override
+            {
+            }
+
+        protected:
+            bool Underflow() override
+            {
+                uint32_t loaded = (_file.IsOpen() == true ? _file.Read(reinterpret_cast<uint8_t*>(_buffer), sizeof(_buffer)) : 0);
+
+                if (loaded == 0) {
+                    Close();
+                } else {
+                    Feed(_buffer, loaded);
+                }
+
+                return (loaded != 0);
+            }
+
+        private:
+            Core::File& _file;
+            char _buffer[WINDOWSIZE];
+        };
+
+        // Pulls the document from a memory mapped file, the window is the whole file.
+        class EXTERNAL MappedReader : public Reader {
+        public:
+            MappedReader() = delete;
+            MappedReader(const MappedReader&) = delete;
+            MappedReader& operator=(const MappedReader&) = delete;
+
+            MappedReader(const string& fileName)
+                : Reader()
+                , _storage(fileName, Core::File::USER_READ)
+            {
+                if (_storage.IsValid() == true) {
+                    Feed(reinterpret_cast<const char*>(_storage.Buffer()), static_cast<uint32_t>(_storage.Size()));
+                }
+                Close();
+            }
+            ~MappedReader() override
+            {
+            }
+
+        public:
+            inline bool IsValid() const
+            {
+                return (_storage.IsValid());
+            }
+
+        private:
+            Core::DataElementFile _storage;
+        };
+
+    } // namespace JSON
+} // namespace Core
+} // namespace WPEFramework
+
+#endif // __JSONREADER_H
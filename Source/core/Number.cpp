@@ -83,6 +83,481 @@ namespace Core {
     }
     }
 
+    namespace {
+
+        static const char DigitPairs[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        static const char HexDigits[] = "0123456789ABCDEF";
+
+        static const uint32_t Powers10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+        // The values below 10^22 are exact in a double, 10^10 still is in a float.
+        static const double ExactDoubles[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        static const float ExactFloats[] = {
+            1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+        };
+
+        // Normalized 64 bits significands and binary exponents of 10^k, k = -348, -340, ..., 340.
+        static const uint64_t CachedSignificands[] = {
+            0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL,
+            0xCF42894A5DCE35EAULL, 0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL,
+            0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL, 0xBE5691EF416BD60CULL,
+            0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+            0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL,
+            0xC21094364DFB5637ULL, 0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL,
+            0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL, 0xB23867FB2A35B28EULL,
+            0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+            0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL,
+            0xB5B5ADA8AAFF80B8ULL, 0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL,
+            0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL, 0xA6DFBD9FB8E5B88FULL,
+            0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+            0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL,
+            0xAA242499697392D3ULL, 0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL,
+            0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL, 0x9C40000000000000ULL,
+            0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+            0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL,
+            0x9F4F2726179A2245ULL, 0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL,
+            0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL, 0x924D692CA61BE758ULL,
+            0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+            0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL,
+            0x952AB45CFA97A0B3ULL, 0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL,
+            0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL, 0x88FCF317F22241E2ULL,
+            0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+            0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL,
+            0x8BAB8EEFB6409C1AULL, 0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL,
+            0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL, 0x80444B5E7AA7CF85ULL,
+            0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+            0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL, 0xAF87023B9BF0EE6BULL,
+        };
+        static const int16_t CachedExponents[] = {
+            -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+            -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+            -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+            -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+            56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+            375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+            694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+            1013, 1039, 1066,
+        };
+
+        // A "Do It Yourself Floating Point" number: f * 2^e, as used by Grisu.
+        struct DiyFp {
+            uint64_t f;
+            int32_t e;
+        };
+
+        inline DiyFp Multiply(const DiyFp& lhs, const DiyFp& rhs)
+        {
+            const uint64_t mask = 0xFFFFFFFFULL;
+            const uint64_t a = lhs.f >> 32;
+            const uint64_t b = lhs.f & mask;
+            const uint64_t c = rhs.f >> 32;
+            const uint64_t d = rhs.f & mask;
+            const uint64_t ac = a * c;
+            const uint64_t bc = b * c;
+            const uint64_t ad = a * d;
+            const uint64_t bd = b * d;
+
+            // Round the lower half into the upper one.
+            const uint64_t carry = (bd >> 32) + (ad & mask) + (bc & mask) + (1ULL << 31);
+
+            return (DiyFp { ac + (ad >> 32) + (bc >> 32) + (carry >> 32), lhs.e + rhs.e + 64 });
+        }
+
+        inline DiyFp Normalize(DiyFp value)
+        {
+            while ((value.f & (1ULL << 63)) == 0) {
+                value.f <<= 1;
+                value.e--;
+            }
+            return (value);
+        }
+
+        inline uint8_t DecimalDigits(const uint32_t value)
+        {
+            uint8_t result = 1;
+
+            while ((result < 10) && (value >= Powers10[result])) {
+                result++;
+            }
+            return (result);
+        }
+
+        void Round(char buffer[], const uint8_t length, const uint64_t delta, uint64_t rest, const uint64_t tenKappa, const uint64_t distance)
+        {
+            while ((rest < distance) && ((delta - rest) >= tenKappa) && (((rest + tenKappa) < distance) || ((distance - rest) > (rest + tenKappa - distance)))) {
+                buffer[length - 1]--;
+                rest += tenKappa;
+            }
+        }
+
+        // Generates the shortest digits of W, that are still within [W - delta, Wp].
+        void Digits(const DiyFp& W, const DiyFp& Wp, uint64_t delta, char buffer[], uint8_t& length, int32_t& K)
+        {
+            const uint8_t shift = static_cast<uint8_t>(-Wp.e);
+            const uint64_t one = (1ULL << shift);
+            const uint64_t distance = Wp.f - W.f;
+            uint32_t integral = static_cast<uint32_t>(Wp.f >> shift);
+            uint64_t fraction = Wp.f & (one - 1);
+            int32_t kappa = DecimalDigits(integral);
+
+            length = 0;
+
+            while (kappa > 0) {
+                const uint32_t digit = integral / Powers10[kappa - 1];
+                integral %= Powers10[kappa - 1];
+
+                if ((digit != 0) || (length != 0)) {
+                    buffer[length++] = static_cast<char>('0' + digit);
+                }
+                kappa--;
+
+                const uint64_t rest = (static_cast<uint64_t>(integral) << shift) + fraction;
+                if (rest <= delta) {
+                    K += kappa;
+                    Round(buffer, length, delta, rest, static_cast<uint64_t>(Powers10[kappa]) << shift, distance);
+                    return;
+                }
+            }
+
+            for (;;) {
+                fraction *= 10;
+                delta *= 10;
+
+                const char digit = static_cast<char>(fraction >> shift);
+                if ((digit != 0) || (length != 0)) {
+                    buffer[length++] = static_cast<char>('0' + digit);
+                }
+                fraction &= (one - 1);
+                kappa--;
+
+                if (fraction < delta) {
+                    K += kappa;
+                    Round(buffer, length, delta, fraction, one, (-kappa < 10 ? distance * Powers10[-kappa] : 0));
+                    return;
+                }
+            }
+        }
+
+        // Grisu2 on a value f * 2^e, hidden is the implicit leading bit of its type.
+        void Grisu(const uint64_t f, const int32_t e, const uint64_t hidden, char buffer[], uint8_t& length, int32_t& K)
+        {
+            const DiyFp value = Normalize(DiyFp { f, e });
+            const DiyFp plus = Normalize(DiyFp { (f << 1) + 1, e - 1 });
+            DiyFp minus = (f == hidden ? DiyFp { (f << 2) - 1, e - 2 } : DiyFp { (f << 1) - 1, e - 1 });
+
+            minus.f <<= (minus.e - plus.e);
+            minus.e = plus.e;
+
+            // Pick a cached power that brings the upper boundary in the [-60, -32] binary exponent range.
+            const double estimate = ((-61 - plus.e) * 0.30102999566398114) + 347;
+            int32_t k = static_cast<int32_t>(estimate);
+            if (estimate > k) {
+                k++;
+            }
+            const uint16_t index = static_cast<uint16_t>((k >> 3) + 1);
+            const DiyFp power { CachedSignificands[index], CachedExponents[index] };
+
+            K = 348 - static_cast<int32_t>(index << 3);
+
+            const DiyFp W = Multiply(value, power);
+            DiyFp Wp = Multiply(plus, power);
+            DiyFp Wm = Multiply(minus, power);
+            Wm.f++;
+            Wp.f--;
+
+            Digits(W, Wp, Wp.f - Wm.f, buffer, length, K);
+        }
+
+        // Lays out length digits, to be multiplied by 10^K, the way JSON (and printf) does.
+        uint8_t Layout(char buffer[], const uint8_t length, const int32_t K)
+        {
+            const int32_t point = length + K;
+            uint8_t result;
+
+            if ((K >= 0) && (point <= 21)) {
+                // 1234e7 -> 12340000000
+                ::memset(&buffer[length], '0', K);
+                result = static_cast<uint8_t>(point);
+            } else if ((point > 0) && (point <= 21)) {
+                // 1234e-2 -> 12.34
+                ::memmove(&buffer[point + 1], &buffer[point], length - point);
+                buffer[point] = '.';
+                result = length + 1;
+            } else if ((point > -6) && (point <= 0)) {
+                // 1234e-6 -> 0.001234
+                const uint8_t zeros = static_cast<uint8_t>(2 - point);
+                ::memmove(&buffer[zeros], &buffer[0], length);
+                buffer[0] = '0';
+                buffer[1] = '.';
+                ::memset(&buffer[2], '0', zeros - 2);
+                result = length + zeros;
+            } else {
+                // 1234e30 -> 1.234e+33
+                result = length;
+                if (length > 1) {
+                    ::memmove(&buffer[2], &buffer[1], length - 1);
+                    buffer[1] = '.';
+                    result++;
+                }
+                const int32_t exponent = point - 1;
+                char text[4];
+                const uint8_t digits = ToDecimal(static_cast<uint64_t>(exponent < 0 ? -exponent : exponent), &text[sizeof(text)]);
+
+                buffer[result++] = 'e';
+                buffer[result++] = (exponent < 0 ? '-' : '+');
+                ::memcpy(&buffer[result], &text[sizeof(text) - digits], digits);
+                result += digits;
+            }
+
+            return (result);
+        }
+
+        template <typename FLOAT, typename BITS, const uint8_t MANTISSA, const int32_t BIAS>
+        uint8_t Shortest(const FLOAT value, char buffer[])
+        {
+            BITS bits;
+            uint8_t result = 0;
+
+            ::memcpy(&bits, &value, sizeof(bits));
+
+            if ((bits >> ((sizeof(BITS) * 8) - 1)) != 0) {
+                buffer[result++] = '-';
+            }
+
+            const uint64_t hidden = (1ULL << MANTISSA);
+            const uint64_t significand = (bits & (hidden - 1));
+            const uint32_t exponent = static_cast<uint32_t>((bits >> MANTISSA) & ((1ULL << ((sizeof(BITS) * 8) - 1 - MANTISSA)) - 1));
+
+            if ((exponent == 0) && (significand == 0)) {
+                buffer[result++] = '0';
+            } else {
+                uint8_t length;
+                int32_t K;
+
+                if (exponent != 0) {
+                    Grisu(significand + hidden, static_cast<int32_t>(exponent) - BIAS - MANTISSA, hidden, &buffer[result], length, K);
+                } else {
+                    Grisu(significand, 1 - BIAS - MANTISSA, hidden, &buffer[result], length, K);
+                }
+                result += Layout(&buffer[result], length, K);
+            }
+
+            return (result);
+        }
+
+        // Clinger's fast path: as long as the significand and the power of 10 are both exact,
+        // a single multiplication or division gives the correctly rounded result. Anything
+        // else is left to the C library.
+        template <typename FLOAT, const uint64_t MAXIMUM, const uint8_t POWERS>
+        uint32_t Parse(const char text[], const uint32_t length, FLOAT& value, const FLOAT powers[], FLOAT (*fallback)(const char*, char**))
+        {
+            uint32_t index = 0;
+            bool negative = false;
+            bool exact = true;
+            uint64_t significand = 0;
+            uint8_t digits = 0;
+            int32_t exponent = 0;
+
+            if ((index < length) && ((text[index] == '-') || (text[index] == '+'))) {
+                negative = (text[index] == '-');
+                index++;
+            }
+
+            const uint32_t mark = index;
+
+            // Hexadecimal floats are rare enough to leave them to the C library.
+            if (((index + 1) < length) && (text[index] == '0') && ((text[index + 1] == 'x') || (text[index + 1] == 'X'))) {
+                exact = false;
+            }
+
+            while ((exact == true) && (index < length) && (text[index] >= '0') && (text[index] <= '9')) {
+                uint32_t chunk;
+
+                if ((digits <= 11) && ((length - index) >= 8) && (FromEightDigits(&text[index], chunk) == true)) {
+                    significand = (significand * 100000000) + chunk;
+                    digits = (significand != 0 ? digits + 8 : 0);
+                    index += 8;
+                } else {
+                    significand = (significand * 10) + (text[index] - '0');
+                    digits = (significand != 0 ? digits + 1 : 0);
+                    exact = (digits <= 19);
+                    index++;
+                }
+            }
+
+            uint32_t numerals = index - mark;
+
+            if ((exact == true) && (index < length) && (text[index] == '.')) {
+                index++;
+
+                while ((exact == true) && (index < length) && (text[index] >= '0') && (text[index] <= '9')) {
+                    significand = (significand * 10) + (text[index] - '0');
+                    digits = (significand != 0 ? digits + 1 : 0);
+                    exact = (digits <= 19);
+                    exponent--;
+                    numerals++;
+                    index++;
+                }
+            }
+
+            // Anything without a digit ("inf", "nan", ".", leading spaces) goes to the C library.
+            exact = exact && (numerals > 0);
+
+            if ((exact == true) && (index < length) && ((text[index] == 'e') || (text[index] == 'E'))) {
+                uint32_t position = index + 1;
+                bool negate = false;
+                int32_t power = 0;
+
+                if ((position < length) && ((text[position] == '-') || (text[position] == '+'))) {
+                    negate = (text[position] == '-');
+                    position++;
+                }
+
+                // An 'e' without digits is not part of the number.
+                if ((position < length) && (text[position] >= '0') && (text[position] <= '9')) {
+                    while ((exact == true) && (position < length) && (text[position] >= '0') && (text[position] <= '9')) {
+                        power = (power * 10) + (text[position] - '0');
+                        exact = (power < 10000);
+                        position++;
+                    }
+                    exponent += (negate ? -power : power);
+                    index = position;
+                }
+            }
+
+            if ((exact == true) && (significand <= MAXIMUM) && (exponent >= -static_cast<int32_t>(POWERS)) && (exponent <= static_cast<int32_t>(POWERS))) {
+                value = static_cast<FLOAT>(significand);
+                if (exponent < 0) {
+                    value /= powers[-exponent];
+                } else {
+                    value *= powers[exponent];
+                }
+                if (negative == true) {
+                    value = -value;
+                }
+            } else {
+                char buffer[64];
+                std::string copy;
+                const char* start = buffer;
+                char* end = nullptr;
+
+                if (length < sizeof(buffer)) {
+                    ::memcpy(buffer, text, length);
+                    buffer[length] = '\0';
+                } else {
+                    copy.assign(text, length);
+                    start = copy.c_str();
+                }
+
+                const FLOAT result = fallback(start, &end);
+
+                index = static_cast<uint32_t>(end - start);
+                if (index != 0) {
+                    value = result;
+                }
+            }
+
+            return (index);
+        }
+
+        float FallbackFloat(const char* text, char** end)
+        {
+            return (::strtof(text, end));
+        }
+        double FallbackDouble(const char* text, char** end)
+        {
+            return (::strtod(text, end));
+        }
+    }
+
+    uint8_t ToDecimal(uint64_t value, char* end)
+    {
+        char* current = end;
+
+        while (value >= 0x100000000ULL) {
+            const uint32_t pair = static_cast<uint32_t>(value % 100) * 2;
+            value /= 100;
+            *--current = DigitPairs[pair + 1];
+            *--current = DigitPairs[pair];
+        }
+
+        uint32_t small = static_cast<uint32_t>(value);
+
+        while (small >= 100) {
+            const uint32_t pair = (small % 100) * 2;
+            small /= 100;
+            *--current = DigitPairs[pair + 1];
+            *--current = DigitPairs[pair];
+        }
+
+        if (small >= 10) {
+            *--current = DigitPairs[(small * 2) + 1];
+            *--current = DigitPairs[small * 2];
+        } else {
+            *--current = static_cast<char>('0' + small);
+        }
+
+        return (static_cast<uint8_t>(end - current));
+    }
+
+    uint8_t ToHexadecimal(uint64_t value, char* end)
+    {
+        char* current = end;
+
+        do {
+            *--current = HexDigits[value & 0xF];
+            value >>= 4;
+        } while (value != 0);
+
+        return (static_cast<uint8_t>(end - current));
+    }
+
+    uint8_t ToOctal(uint64_t value, char* end)
+    {
+        char* current = end;
+
+        do {
+            *--current = static_cast<char>('0' + (value & 0x7));
+            value >>= 3;
+        } while (value != 0);
+
+        return (static_cast<uint8_t>(end - current));
+    }
+
+    uint8_t ToShortest(const double value, char buffer[])
+    {
+        return (Shortest<double, uint64_t, 52, 1023>(value, buffer));
+    }
+
+    uint8_t ToShortest(const float value, char buffer[])
+    {
+        return (Shortest<float, uint32_t, 23, 127>(value, buffer));
+    }
+
+    uint32_t FromText(const char text[], const uint32_t length, double& value)
+    {
+        return (Parse<double, (1ULL << 53), 22>(text, length, value, ExactDoubles, FallbackDouble));
+    }
+
+    uint32_t FromText(const char text[], const uint32_t length, float& value)
+    {
+        return (Parse<float, (1ULL << 24), 10>(text, length, value, ExactFloats, FallbackFloat));
+    }
+
     Fractional::Fractional()
         : m_Integer(0)
         , m_Remainder(0)
@@ -38,6 +38,53 @@ namespace Core {
     EXTERNAL TCHAR ToDirect(const unsigned char element);
     }
 
+    // Conversion kernels, shared by the NumberType's, the JSON numbers and the Serialization
+    // helpers. Integers are written backwards, ending just before "end", so a sign or a radix
+    // prefix can be put in front. The number of characters written is returned.
+    EXTERNAL uint8_t ToDecimal(uint64_t value, char* end);
+    EXTERNAL uint8_t ToHexadecimal(uint64_t value, char* end);
+    EXTERNAL uint8_t ToOctal(uint64_t value, char* end);
+
+    // Shortest text that reads back to exactly the same value (Grisu2). The buffer must hold
+    // at least 32 characters, it is not terminated. NaN and infinity are not representable.
+    EXTERNAL uint8_t ToShortest(const double value, char buffer[]);
+    EXTERNAL uint8_t ToShortest(const float value, char buffer[]);
+
+    // Reads a floating point value, strtod semantics. Returns the number of characters used,
+    // 0 if the text does not start with a number.
+    EXTERNAL uint32_t FromText(const char text[], const uint32_t length, double& value);
+    EXTERNAL uint32_t FromText(const char text[], const uint32_t length, float& value);
+
+    // Converts eight decimal digits in one go, returns false if not all of them are digits.
+    inline bool FromEightDigits(const char text[], uint32_t& value)
+    {
+#ifdef LITTLE_ENDIAN_PLATFORM
+        uint64_t chunk;
+        ::memcpy(&chunk, text, sizeof(chunk));
+
+        bool result = ((((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL));
+
+        if (result == true) {
+            chunk -= 0x3030303030303030ULL;
+            chunk = (chunk * 10) + (chunk >> 8);
+            chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) + (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+            value = static_cast<uint32_t>(chunk);
+        }
+#else
+        bool result = true;
+        uint32_t converted = 0;
+
+        for (uint8_t index = 0; (result == true) && (index < 8); index++) {
+            result = ((text[index] >= '0') && (text[index] <= '9'));
+            converted = (converted * 10) + (text[index] - '0');
+        }
+        if (result == true) {
+            value = converted;
+        }
+#endif
+        return (result);
+    }
+
     template <class TYPE, bool SIGNED = (TypeTraits::sign<TYPE>::Signed == 1), const NumberBase BASETYPE = BASE_UNKNOWN>
     class NumberType {
     public:
@@ -208,7 +255,7 @@ namespace Core {
         {
             // Max size needed to dreate
             TCHAR Buffer[36];
-            uint16_t Index = FillBuffer(Buffer, sizeof(Buffer), BASETYPE);
+            uint16_t Index = FillBuffer(Buffer, sizeof(Buffer) / sizeof(TCHAR), BASETYPE);
 
             return (&Buffer[Index]);
         }
@@ -228,8 +275,8 @@ namespace Core {
         uint16_t Serialize(std::wstring& buffer)
         {
             wchar_t Buffer[36];
-            uint16_t Index = FillBuffer(Buffer, sizeof(Buffer), BASETYPE);
-            uint16_t Result = (sizeof(Buffer) - Index - 1 /* Do not account for the closing char */);
+            uint16_t Index = FillBuffer(Buffer, sizeof(Buffer) / sizeof(wchar_t), BASETYPE);
+            uint16_t Result = ((sizeof(Buffer) / sizeof(wchar_t)) - Index - 1 /* Do not account for the closing char */);
 
             // Move it to the actual buffer
             buffer = std::wstring(&Buffer[Index], Result);
@@ -376,75 +423,55 @@ namespace Core {
     private:
         uint16_t FillBuffer(char* buffer, const uint16_t maxLength, const NumberBase BaseType) const
         {
-            TCHAR* Location = &buffer[maxLength - 1];
-            TYPE Value = NumberType<TYPE, SIGNED>(m_Value).Abs();
-            uint16_t Index = maxLength - 1 /* closing character */ - (Negative() ? 1 : 0) - (BaseType == BASE_OCTAL ? 1 : (BaseType == BASE_HEXADECIMAL ? 2 : 0));
-            uint8_t Divider = (BaseType == BASE_UNKNOWN ? BASE_DECIMAL : BaseType);
+            char* Location = &buffer[maxLength - 1];
+            uint64_t Value = Magnitude(TemplateIntToType<SIGNED>());
 
             // Close it with a terminating character!!
-            *Location-- = '\0';
+            *Location = '\0';
 
             // Convert the number to a string
-            do {
-                uint8_t newDigit = (Value % Divider);
-                if (newDigit < 10) {
-                    *Location-- = static_cast<wchar_t>(newDigit + '0');
-                } else {
-                    *Location-- = static_cast<wchar_t>(newDigit - 10 + 'A');
-                }
-                Value = Value / Divider;
-                Index--;
-
-            } while ((Value != 0) && (Index > 0));
-
-            if ((BaseType == BASE_OCTAL) || (BaseType == BASE_HEXADECIMAL)) {
-                if (BaseType == BASE_HEXADECIMAL) {
-                    *Location-- = 'x';
-                }
-                *Location-- = '0';
+            if (BaseType == BASE_HEXADECIMAL) {
+                Location -= ToHexadecimal(Value, Location);
+                *--Location = 'x';
+                *--Location = '0';
+            } else if (BaseType == BASE_OCTAL) {
+                Location -= ToOctal(Value, Location);
+                *--Location = '0';
+            } else {
+                Location -= ToDecimal(Value, Location);
             }
 
             if (Negative()) {
-                *Location = '-';
+                *--Location = '-';
             }
 
-            return (Index);
+            return (static_cast<uint16_t>(Location - buffer));
         }
-        uint16_t FillBuffer(wchar_t* buffer, const uint16_t maxLength, const NumberBase BaseType)
+#ifndef __CORE_NO_WCHAR_SUPPORT__
+        uint16_t FillBuffer(wchar_t* buffer, const uint16_t maxLength, const NumberBase BaseType) const
         {
-            wchar_t* Location = &buffer[maxLength];
-            TYPE Value = NumberType<TYPE, SIGNED>(m_Value).Abs();
-            uint16_t Index = maxLength - (Negative() ? 1 : 0) - (BaseType == BASE_OCTAL ? 1 : (BaseType == BASE_HEXADECIMAL ? 2 : 0));
-            uint8_t Divider = (BaseType == BASE_UNKNOWN ? BASE_DECIMAL : BaseType);
-
-            // Close it with a terminating character!!
-            *Location-- = '\0';
-
-            // Convert the number to a string
-            do {
-                uint8_t newDigit = (Value % Divider);
-                if (newDigit < 10) {
-                    *Location-- = static_cast<wchar_t>(newDigit + '0');
-                } else {
-                    *Location-- = static_cast<wchar_t>(newDigit - 10 + 'A');
-                }
-                Value = Value / Divider;
-                Index--;
+            char Buffer[36];
+            uint16_t Index = FillBuffer(Buffer, sizeof(Buffer), BaseType);
+            uint16_t Length = static_cast<uint16_t>(sizeof(Buffer) - Index);
 
-            } while ((Value != 0) && (Index > 0));
+            ASSERT(Length <= maxLength);
 
-            if ((BaseType == BASE_OCTAL) || (BaseType == BASE_HEXADECIMAL)) {
-                if (BaseType == BASE_HEXADECIMAL) {
-                    *Location-- = 'x';
-                }
-                *Location-- = '0';
+            // Widen the text, including the terminating character.
+            for (uint16_t Position = 0; Position < Length; Position++) {
+                buffer[maxLength - Length + Position] = static_cast<wchar_t>(Buffer[Index + Position]);
             }
 
-            if (Negative()) {
-                *Location = '-';
-            }
-
-            return (Index);
+            return (maxLength - Length);
+        }
+#endif
+        inline uint64_t Magnitude(const TemplateIntToType<false>& /* For compile time diffrentiation */) const
+        {
+            return (static_cast<uint64_t>(m_Value));
+        }
+        inline uint64_t Magnitude(const TemplateIntToType<true>& /* For compile time diffrentiation */) const
+        {
+            // Negate in the unsigned domain, the most negative value has no positive counterpart.
+            return (m_Value < 0 ? (static_cast<uint64_t>(0) - static_cast<uint64_t>(m_Value)) : static_cast<uint64_t>(m_Value));
         }
         template <typename NUMBER>
         static uint32_t
@@ -642,13 +669,19 @@ namespace Core {
             NumberBase Base = Type;
             NUMBER Max = NUMBER_MAX_SIGNED(NUMBER);
             uint32_t ItemsLeft = MaxLength;
+            uint32_t Chunk;
 
             // We start at 0
             Value = 0;
 
             // Convert the number until we reach the 0 character.
             while ((ItemsLeft != 0) && (Success == true) && (*Text != '\0')) {
-                if ((Value == 0) && (*Text == '0') && (Base == BASE_UNKNOWN)) {
+                if ((sizeof(NUMBER) >= sizeof(uint32_t)) && (Base == BASE_DECIMAL) && (ItemsLeft >= 8) && (FromEightDigits(Text, Chunk) == true) && (Sign ? (Value >= ((Max + static_cast<NUMBER>(Chunk)) / 100000000)) : (Value <= ((Max - static_cast<NUMBER>(Chunk)) / 100000000)))) {
+                    // Eight digits in one go, as long as they can not overflow.
+                    Value = (Value * 100000000) + (Sign ? -static_cast<NUMBER>(Chunk) : static_cast<NUMBER>(Chunk));
+                    Text += 7;
+                    ItemsLeft -= 7;
+                } else if ((Value == 0) && (*Text == '0') && (Base == BASE_UNKNOWN)) {
                     // Base change, move over to an OCTAL conversion
                     Base = BASE_OCTAL;
                 } else if ((Value == 0) && (toupper(*Text) == 'X') && ((Base == BASE_OCTAL) || (Base == BASE_HEXADECIMAL))) {
@@ -749,13 +782,19 @@ namespace Core {
             NumberBase Base = Type;
             NUMBER Max = NUMBER_MAX_UNSIGNED(NUMBER);
             uint32_t ItemsLeft = MaxLength;
+            uint32_t Chunk;
 
             // We start at 0
             Value = 0;
 
             // Convert the number until we reach the 0 character.
             while ((ItemsLeft != 0) && (Success == true) && (*Text != '\0')) {
-                if ((Value == 0) && (*Text == '0') && (Base == BASE_UNKNOWN)) {
+                if ((sizeof(NUMBER) >= sizeof(uint32_t)) && (Base == BASE_DECIMAL) && (ItemsLeft >= 8) && (FromEightDigits(Text, Chunk) == true) && (Value <= ((Max - static_cast<NUMBER>(Chunk)) / 100000000))) {
+                    // Eight digits in one go, as long as they can not overflow.
+                    Value = (Value * 100000000) + static_cast<NUMBER>(Chunk);
+                    Text += 7;
+                    ItemsLeft -= 7;
+                } else if ((Value == 0) && (*Text == '0') && (Base == BASE_UNKNOWN)) {
                     // Base change, move over to an OCTAL conversion
                     Base = BASE_OCTAL;
                 } else if ((Value == 0) && (toupper(*Text) == 'X') && ((Base == BASE_OCTAL) || (Base == BASE_HEXADECIMAL))) {
@@ -21,6 +21,7 @@
 #define RESOURCE_MONITOR_TYPE_H
 
 #include "Module.h"
+#include "IOUring.h"
 #include "Portability.h"
 #include "Singleton.h"
 #include "Thread.h"
@@ -41,10 +42,42 @@ namespace Core {
         virtual void Handle(const uint16_t events) = 0;
     };
 
+    // A listening resource that offers this as well, has its connections accepted by the monitor on the
+    // io_uring engine. A single multishot accept stays queued for it and the connections accepted since
+    // the previous run are handed over at once, instead of reporting the listener readable and having it
+    // accept them one by one. Without multishot accept (kernel before 5.19) it is polled like any other.
+    struct EXTERNAL IAcceptor {
+        virtual ~IAcceptor() {}
+
+        // From now on the connections are owned by the acceptor.
+        virtual void Accepted(const IResource::handle connections[], const uint32_t count) = 0;
+    };
+
+    // A connected resource that offers this as well, has its data moved by the monitor on the io_uring engine
+    // while it is transferring. Instead of a poll that reports it readable, a receive is queued into a buffer
+    // the monitor provides (IORING_OP_PROVIDE_BUFFERS), and what it sends is queued on the ring (see Send()),
+    // so the sends of all resources go out in the single system call the monitor waits in. If the kernel lacks
+    // it (before 5.7), or all buffers are taken, the resource is reported readable and reads for itself.
+    struct EXTERNAL ITransfer {
+        virtual ~ITransfer() {}
+
+        // Asked whenever it is armed, while it is not, it is polled like any other resource.
+        virtual bool IsTransferring() const = 0;
+        // Data received in a buffer of the monitor, it is the monitor's again once this returns. A length of 0
+        // means the peer closed, a negative one is the error (-errno).
+        virtual void Received(uint8_t data[], const int32_t length) = 0;
+        // The data queued by Send() went out, the result is the bytes sent or the error (-errno).
+        virtual void Sent(const int32_t result) = 0;
+    };
+
     template <typename RESOURCE, typename WATCHDOG>
     class ResourceMonitorType {
     private:
         static constexpr uint8_t FileDescriptorAllocation = 32;
+        static constexpr uint32_t RingEntries = 256;
+        static constexpr uint16_t ProvidedBuffers = 64;
+        static constexpr uint32_t ProvidedSize = 8 * 1024;
+        static constexpr uint16_t ProvidedGroup = 1;
 
         typedef ResourceMonitorType<RESOURCE, WATCHDOG> Parent;
 
@@ -86,6 +119,43 @@ namespace Core {
             Parent& _parent;
         };
 
+#ifdef __LINUX__
+        // A poll (or an accept for an acceptor, a receive for a transfer) queued on the io_uring, it stays
+        // queued over the monitor runs till it reports or the resource changes its descriptor or events (or leaves).
+        struct Armed {
+            RESOURCE* resource;
+            IAcceptor* acceptor;
+            ITransfer* transfer;
+            bool receive;
+            int descriptor;
+            uint16_t events;
+            int slot;
+        };
+
+        // A copy of what a transfer sends, it is the monitor's till the send completes.
+        struct Outgoing {
+            ITransfer* transfer;
+            int descriptor;
+            std::vector<uint8_t> data;
+            uint32_t offset;
+        };
+
+        // A completed receive or send, handed over after the accepted connections.
+        struct Transferred {
+            ITransfer* transfer;
+            int32_t result;
+            int32_t buffer;
+            bool sent;
+        };
+
+        enum token : uint64_t {
+            CANCEL = 0,
+            SIGNAL = 1,
+            PROVIDE = 2,
+            FIRST = 3
+        };
+#endif
+
     public:
         struct Metadata {
             signed int descriptor;
@@ -95,8 +165,17 @@ namespace Core {
             char filename[128];
         };
 
+        // How the monitor waits for its resources. POLL hands all descriptors to poll(2) on every run.
+        // IO_URING queues a poll on an io_uring per resource and only resubmits the ones that reported
+        // or changed, all in a single system call per run. It is only available on Linux, if the kernel
+        // lacks it (or does not allow it), the monitor falls back to POLL.
+        enum engine : uint8_t {
+            POLL,
+            IO_URING
+        };
+
     public:
-        ResourceMonitorType()
+        ResourceMonitorType(const engine preferred = IO_URING)
             : _monitor(nullptr)
             , _adminLock()
             , _resourceList()
@@ -109,8 +188,27 @@ namespace Core {
             , _descriptorArrayLength(FileDescriptorAllocation)
             , _descriptorArray(static_cast<struct pollfd*>(::malloc(sizeof(::pollfd) * (_descriptorArrayLength + 1))))
             , _signalDescriptor(-1)
+            , _engine(preferred)
+            , _ring(nullptr)
+            , _signalArmed(false)
+            , _token(token::FIRST)
+            , _armed()
+            , _live()
+            , _cancelled()
+            , _multishot(true)
+            , _accepted()
+            , _connections()
+            , _transfers(false)
+            , _provided()
+            , _detached()
+            , _sending()
+            , _transferred()
+            , _worker(static_cast<::ThreadId>(0))
 #endif
         {
+#ifndef __LINUX__
+            DEBUG_VARIABLE(preferred);
+#endif
         }
 
         ~ResourceMonitorType()
@@ -135,6 +233,9 @@ namespace Core {
             }
 
 #ifdef __LINUX__
+            if (_ring != nullptr) {
+                delete _ring;
+            }
             ::free(_descriptorArray);
             if (_signalDescriptor != -1) {
                 ::close(_signalDescriptor);
@@ -162,6 +263,23 @@ namespace Core {
         {
             return (static_cast<uint32_t>(_resourceList.size()));
         }
+        engine Engine() const
+        {
+#ifdef __LINUX__
+            return (_engine);
+#else
+            return (POLL);
+#endif
+        }
+        // Whether the data of the resources that transfer (see ITransfer) is moved by the monitor.
+        bool Transfers() const
+        {
+#ifdef __LINUX__
+            return (_transfers);
+#else
+            return (false);
+#endif
+        }
         bool Info (const uint32_t position, Metadata& info) const
         {
             uint32_t count = position;
@@ -231,6 +349,10 @@ namespace Core {
 
             if (index != _resourceList.end()) {
                 *index = nullptr;
+#ifdef __LINUX__
+                // The resource might be gone before the next run, its poll is cancelled there.
+                Detach(&resource, true);
+#endif
                 Break();
             }
 
@@ -254,6 +376,33 @@ namespace Core {
             ::WSASetEvent(_action);
 #endif
         };
+        // On the io_uring engine, a resource that transfers (see ITransfer) queues what it sends here, from within
+        // the monitor (its Events(), Handle() or the ITransfer calls). The data is copied and goes out with all else
+        // queued in this run, Sent() reports it. Returns false if it can not be queued, the resource sends it itself.
+        bool Send(ITransfer& transfer, const IResource::handle descriptor, const uint8_t data[], const uint32_t length)
+        {
+            bool result = false;
+
+#ifdef __LINUX__
+            if ((_transfers == true) && (_worker.load(std::memory_order_relaxed) == Core::Thread::ThreadId())) {
+                typename std::unordered_map<uint64_t, Outgoing>::iterator entry(_sending.emplace(_token, Outgoing { &transfer, descriptor, std::vector<uint8_t>(data, data + length), 0 }).first);
+
+                if (_ring->Send(descriptor, entry->second.data.data(), length, _token) == true) {
+                    _token++;
+                    result = true;
+                } else {
+                    _sending.erase(entry);
+                }
+            }
+#else
+            DEBUG_VARIABLE(transfer);
+            DEBUG_VARIABLE(descriptor);
+            DEBUG_VARIABLE(data);
+            DEBUG_VARIABLE(length);
+#endif
+
+            return (result);
+        }
 
     private:
         HAS_MEMBER(Arm, hasArm);
@@ -332,16 +481,318 @@ namespace Core {
             _descriptorArray[0].events = POLLIN;
             _descriptorArray[0].revents = 0;
 
+            if (_engine == IO_URING) {
+                _ring = new IOUring(RingEntries);
+
+                if (_ring->IsValid() == false) {
+                    delete _ring;
+                    _ring = nullptr;
+                    _engine = POLL;
+                } else {
+                    _transfers = _ring->Transfers();
+                }
+            }
+
             return (_signalDescriptor != -1 ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
         }
 #endif
 
+#ifdef __LINUX__
+    private:
+        // Make sure the resource in the given slot has a poll queued for the descriptor and events in that slot,
+        // an acceptor gets an accept instead, a transfer that is to receive (and not to wait for room) a receive.
+        void Arm(RESOURCE* entry, const int slot)
+        {
+            const struct ::pollfd& request(_descriptorArray[slot]);
+            const bool receiving = ((_transfers == true) && ((request.events & (POLLIN | POLLOUT)) == POLLIN));
+            typename std::unordered_map<RESOURCE*, uint64_t>::iterator live(_live.find(entry));
+
+            if (live != _live.end()) {
+                Armed& armed(_armed[live->second]);
+                const bool transferring = ((armed.transfer != nullptr) && (receiving == true) && (armed.transfer->IsTransferring() == true));
+
+                if ((armed.descriptor == request.fd) && (armed.events == static_cast<uint16_t>(request.events)) && (transferring == (armed.transfer != nullptr))) {
+                    armed.slot = slot;
+                } else {
+                    Detach(entry, false);
+                    live = _live.end();
+                }
+            }
+
+            if (live == _live.end()) {
+                IAcceptor* acceptor = (_multishot == true ? dynamic_cast<IAcceptor*>(entry) : nullptr);
+                ITransfer* transfer = (((acceptor == nullptr) && (receiving == true)) ? dynamic_cast<ITransfer*>(entry) : nullptr);
+                bool queued;
+
+                if ((acceptor != nullptr) && (_ring->Accept(request.fd, _token) == false)) {
+                    TRACE_L1("Could not queue an accept for descriptor %d, falling back to polls", request.fd);
+                    _multishot = false;
+                    acceptor = nullptr;
+                }
+
+                if ((transfer != nullptr) && (transfer->IsTransferring() == true)) {
+                    if (_provided.empty() == true) {
+                        // Only taken once the first transfer comes along, they go back to the kernel one by one.
+                        _provided.resize(ProvidedBuffers * ProvidedSize);
+                        _ring->Provide(_provided.data(), ProvidedSize, ProvidedBuffers, ProvidedGroup, 0, token::PROVIDE);
+                    }
+                    queued = _ring->Receive(request.fd, ProvidedSize, ProvidedGroup, _token);
+                } else {
+                    transfer = nullptr;
+                    queued = ((acceptor != nullptr) || (_ring->Poll(request.fd, request.events, _token) == true));
+                }
+
+                if (queued == true) {
+                    _armed.emplace(_token, Armed { entry, acceptor, transfer, (transfer != nullptr), request.fd, static_cast<uint16_t>(request.events), slot });
+                    _live.emplace(entry, _token);
+                    _token++;
+                } else {
+                    TRACE_L1("Could not queue a poll for descriptor %d", request.fd);
+                }
+            }
+        }
+        // Queue the cancellations and (if needed) the poll on our own signal descriptor.
+        void Arm()
+        {
+            for (const uint64_t& entry : _cancelled) {
+                typename std::unordered_map<uint64_t, Armed>::const_iterator index(_armed.find(entry));
+
+                // If it completed in the mean time, there is nothing left to cancel.
+                if (index != _armed.end()) {
+                    _ring->Cancel(entry, ((index->second.acceptor == nullptr) && (index->second.receive == false)));
+                } else if (_sending.find(entry) != _sending.end()) {
+                    _ring->Cancel(entry, false);
+                }
+            }
+            _cancelled.clear();
+
+            if (_signalArmed == false) {
+                _signalArmed = _ring->Poll(_signalDescriptor, POLLIN, token::SIGNAL);
+            }
+        }
+        // The resource is armed again (or leaves), whatever its poll reports from now on is not for anyone anymore.
+        // What a receive of a transfer that stays brings in, is still handed over, the stream must stay complete.
+        void Detach(RESOURCE* entry, const bool leaving)
+        {
+            typename std::unordered_map<RESOURCE*, uint64_t>::iterator live(_live.find(entry));
+
+            if (live != _live.end()) {
+                Armed& armed(_armed[live->second]);
+
+                // Connections accepted for it, but not handed over yet, are not for anyone anymore.
+                for (std::pair<IAcceptor*, IResource::handle>& connection : _accepted) {
+                    if ((armed.acceptor != nullptr) && (connection.first == armed.acceptor)) {
+                        ::close(connection.second);
+                        connection.first = nullptr;
+                    }
+                }
+
+                if (leaving == true) {
+                    armed.transfer = nullptr;
+                } else if (armed.transfer != nullptr) {
+                    _detached.push_back(live->second);
+                }
+
+                armed.resource = nullptr;
+                _cancelled.push_back(live->second);
+                _live.erase(live);
+            }
+
+            if ((leaving == true) && ((_detached.empty() == false) || (_sending.empty() == false) || (_transferred.empty() == false))) {
+                ITransfer* transfer = dynamic_cast<ITransfer*>(entry);
+
+                if (transfer != nullptr) {
+                    Forget(transfer);
+                }
+            }
+        }
+        // The transfer leaves, nothing that completes for it is handed over anymore, its sends are cancelled.
+        void Forget(const ITransfer* transfer)
+        {
+            std::list<uint64_t>::iterator index(_detached.begin());
+
+            while (index != _detached.end()) {
+                Armed& armed(_armed[*index]);
+
+                if (armed.transfer == transfer) {
+                    armed.transfer = nullptr;
+                    index = _detached.erase(index);
+                } else {
+                    index++;
+                }
+            }
+
+            for (std::pair<const uint64_t, Outgoing>& outgoing : _sending) {
+                if (outgoing.second.transfer == transfer) {
+                    outgoing.second.transfer = nullptr;
+                    _cancelled.push_back(outgoing.first);
+                }
+            }
+
+            for (Transferred& entry : _transferred) {
+                if (entry.transfer == transfer) {
+                    entry.transfer = nullptr;
+                }
+            }
+        }
+        // Move the completed polls into the descriptor array, as if poll(2) reported them. Accepted connections,
+        // received and sent data wait till they are delivered.
+        void Harvest()
+        {
+            uint64_t userData;
+            int32_t result;
+            bool more;
+            int32_t buffer;
+
+            while (_ring->Completion(userData, result, more, buffer) == true) {
+                if (userData == token::SIGNAL) {
+                    _descriptorArray[0].revents = (result >= 0 ? static_cast<uint16_t>(result) : POLLERR);
+                    _signalArmed = false;
+                } else if (userData == token::PROVIDE) {
+                    if (result < 0) {
+                        // Every receive completes with -ENOBUFS from now on, the resources read for themselves.
+                        TRACE_L1("Buffers could not be provided, error %d, falling back to polls", -result);
+                        _transfers = false;
+                    }
+                } else if (userData != token::CANCEL) {
+                    typename std::unordered_map<uint64_t, Armed>::iterator index(_armed.find(userData));
+
+                    if (index == _armed.end()) {
+                        Sent(userData, result);
+                    } else {
+                        if (index->second.receive == true) {
+                            ITransfer* transfer = index->second.transfer;
+
+                            if ((result == -ENOBUFS) && (index->second.resource != nullptr)) {
+                                // All buffers are taken, it reads for itself.
+                                _descriptorArray[index->second.slot].revents = POLLIN;
+                            } else if ((buffer >= 0) || ((transfer != nullptr) && (result != -ENOBUFS) && (result != -ECANCELED))) {
+                                // A transfer that left (nullptr) only has the buffer it took go back.
+                                _transferred.push_back(Transferred { transfer, result, buffer, false });
+                            }
+                            if ((index->second.resource == nullptr) && (transfer != nullptr)) {
+                                _detached.remove(userData);
+                            }
+                            // A receive is one shot.
+                            more = false;
+                        } else if (index->second.acceptor == nullptr) {
+                            if (index->second.resource != nullptr) {
+                                _descriptorArray[index->second.slot].revents = (result >= 0 ? static_cast<uint16_t>(result) : (result == -EBADF ? POLLNVAL : POLLERR));
+                            }
+                            // A poll is one shot.
+                            more = false;
+                        } else if (index->second.resource == nullptr) {
+                            if (result >= 0) {
+                                ::close(result);
+                            }
+                        } else if (result >= 0) {
+                            _accepted.emplace_back(index->second.acceptor, result);
+                        } else {
+                            if (result == -EINVAL) {
+                                TRACE_L1("Multishot accept is not supported, falling back to polls");
+                                _multishot = false;
+                            }
+                            // Whatever went wrong, the listener finds out when it accepts for itself.
+                            _descriptorArray[index->second.slot].revents = (result == -EBADF ? POLLNVAL : POLLIN);
+                        }
+
+                        if (more == false) {
+                            if (index->second.resource != nullptr) {
+                                _live.erase(index->second.resource);
+                            }
+                            _armed.erase(index);
+                        }
+                    }
+                }
+            }
+        }
+        // A send completed, what it did not take is sent right after it, till it is all out or fails.
+        void Sent(const uint64_t userData, const int32_t result)
+        {
+            typename std::unordered_map<uint64_t, Outgoing>::iterator index(_sending.find(userData));
+
+            ASSERT(index != _sending.end());
+
+            if (index != _sending.end()) {
+                Outgoing& outgoing(index->second);
+                const uint32_t length = static_cast<uint32_t>(outgoing.data.size());
+
+                outgoing.offset += (result > 0 ? result : 0);
+
+                if ((result <= 0) || (outgoing.offset == length) || (outgoing.transfer == nullptr) || (_ring->Send(outgoing.descriptor, &(outgoing.data[outgoing.offset]), length - outgoing.offset, userData) == false)) {
+                    if (outgoing.transfer != nullptr) {
+                        _transferred.push_back(Transferred { outgoing.transfer, (result < 0 ? result : static_cast<int32_t>(outgoing.offset)), -1, true });
+                    }
+                    _sending.erase(index);
+                }
+            }
+        }
+
+        // Hand the accepted connections over, the consecutive ones of an acceptor at once, followed by the
+        // transferred data. A buffer the data was received in goes back to the kernel once it is handed over.
+        void Deliver()
+        {
+            typename std::vector<std::pair<IAcceptor*, IResource::handle>>::iterator index(_accepted.begin());
+
+            while (index != _accepted.end()) {
+                IAcceptor* acceptor = index->first;
+
+                _connections.clear();
+
+                // Taken, so an acceptor that leaves while they are handed over does not close them.
+                while ((index != _accepted.end()) && (index->first == acceptor)) {
+                    _connections.push_back(index->second);
+                    index->first = nullptr;
+                    index++;
+                }
+
+                // A nullptr acceptor left, its connections are closed already.
+                if (acceptor != nullptr) {
+                    Arm<WATCHDOG>();
+
+                    acceptor->Accepted(_connections.data(), static_cast<uint32_t>(_connections.size()));
+
+                    Reset<WATCHDOG>();
+                }
+            }
+
+            _accepted.clear();
+
+            // By position, a transfer that leaves while they are handed over only clears its own.
+            for (uint32_t position = 0; position < _transferred.size(); ++position) {
+                const Transferred entry(_transferred[position]);
+                uint8_t* data = (entry.buffer >= 0 ? &(_provided[entry.buffer * ProvidedSize]) : nullptr);
+
+                if (entry.transfer != nullptr) {
+                    Arm<WATCHDOG>();
+
+                    if (entry.sent == true) {
+                        entry.transfer->Sent(entry.result);
+                    } else {
+                        entry.transfer->Received(data, entry.result);
+                    }
+
+                    Reset<WATCHDOG>();
+                }
+
+                if (data != nullptr) {
+                    _ring->Provide(data, ProvidedSize, 1, ProvidedGroup, static_cast<uint16_t>(entry.buffer), token::PROVIDE);
+                }
+            }
+
+            _transferred.clear();
+        }
+
+    public:
+#endif
+
 #ifdef __LINUX__
         uint32_t Worker()
         {
             uint32_t delay = 0;
 
             _monitorRuns++;
+            _worker.store(Core::Thread::ThreadId(), std::memory_order_relaxed);
 
             // Add entries not in the Array before we start !!!
             _adminLock.Lock();
@@ -361,6 +812,7 @@ namespace Core {
             }
 
             int filledFileDescriptors = 1;
+            _descriptorArray[0].revents = 0;
             typename std::list<RESOURCE*>::iterator index = _resourceList.begin();
 
             // Fill in all entries required/updated..
@@ -370,23 +822,44 @@ namespace Core {
                 uint16_t events;
 
                 if ((entry == nullptr) || ((events = entry->Events()) == 0)) {
+                    if ((entry != nullptr) && (_ring != nullptr)) {
+                        Detach(entry, true);
+                    }
                     index = _resourceList.erase(index);
                 } else {
                     _descriptorArray[filledFileDescriptors].fd = entry->Descriptor();
                     _descriptorArray[filledFileDescriptors].events = events;
                     _descriptorArray[filledFileDescriptors].revents = 0;
+                    if (_ring != nullptr) {
+                        Arm(entry, filledFileDescriptors);
+                    }
                     filledFileDescriptors++;
                     index++;
                 }
             }
 
             if (filledFileDescriptors > 1) {
+                int result;
+
+                if (_ring != nullptr) {
+                    Arm();
+                }
+
                 _adminLock.Unlock();
 
-                int result = poll(_descriptorArray, filledFileDescriptors, -1);
+                if (_ring == nullptr) {
+                    result = poll(_descriptorArray, filledFileDescriptors, -1);
+                } else {
+                    result = _ring->Submit(true);
+                }
 
                 _adminLock.Lock();
 
+                if (_ring != nullptr) {
+                    Harvest();
+                    Deliver();
+                }
+
                 if (result == -1) {
                     TRACE_L1("poll failed with error <%d>", errno);
 
@@ -432,6 +905,12 @@ namespace Core {
                     fd_index++;
                 }
             } else {
+                if (_ring != nullptr) {
+                    // Nothing left to wait for, but the cancelled polls still hold on to their descriptors.
+                    Arm();
+                    _ring->Submit(false);
+                }
+
                 _monitor->Block();
                 delay = Core::infinite;
             }
@@ -528,6 +1007,23 @@ namespace Core {
         uint32_t _descriptorArrayLength;
         struct ::pollfd* _descriptorArray;
         int _signalDescriptor;
+        engine _engine;
+        IOUring* _ring;
+        bool _signalArmed;
+        uint64_t _token;
+        std::unordered_map<uint64_t, Armed> _armed;
+        std::unordered_map<RESOURCE*, uint64_t> _live;
+        std::list<uint64_t> _cancelled;
+        bool _multishot;
+        std::vector<std::pair<IAcceptor*, IResource::handle>> _accepted;
+        std::vector<IResource::handle> _connections;
+        bool _transfers;
+        std::vector<uint8_t> _provided;
+        std::list<uint64_t> _detached;
+        std::unordered_map<uint64_t, Outgoing> _sending;
+        std::vector<Transferred> _transferred;
+        // Thread::Id() holds a truncated handle, so the monitor thread remembers its own to recognise Send() calls.
+        std::atomic<::ThreadId> _worker;
 #endif
 
 #ifdef __WINDOWS__
@@ -217,6 +217,36 @@ namespace Core {
         return (NumberType<int64_t>::Convert(newValue.c_str(), static_cast<uint32_t>(newValue.length()), object, BASE_UNKNOWN) == newValue.length());
     }
 
+    //------------------------------------------------------------------------
+    // Serialize: FLOAT
+    //------------------------------------------------------------------------
+    inline string ToString(const float& object)
+    {
+        char buffer[32];
+        return (ToString(buffer, ToShortest(object, buffer)));
+    }
+
+    inline bool FromString(const string& newValue, float& object)
+    {
+        const std::string text(ToString(newValue));
+        return (FromText(text.c_str(), static_cast<uint32_t>(text.length()), object) == text.length());
+    }
+
+    //------------------------------------------------------------------------
+    // Serialize: DOUBLE
+    //------------------------------------------------------------------------
+    inline string ToString(const double& object)
+    {
+        char buffer[32];
+        return (ToString(buffer, ToShortest(object, buffer)));
+    }
+
+    inline bool FromString(const string& newValue, double& object)
+    {
+        const std::string text(ToString(newValue));
+        return (FromText(text.c_str(), static_cast<uint32_t>(text.length()), object) == text.length());
+    }
+
     //------------------------------------------------------------------------
     // Serialize: boolean
     //------------------------------------------------------------------------
@@ -42,7 +42,9 @@
 #include <sys/event.h>
 #elif defined(__LINUX__)
 #include <signal.h>
+#include <netinet/tcp.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <sys/signalfd.h>
 #endif
 
@@ -201,6 +203,29 @@ namespace Core {
 
 #else
 
+    // The interface a datagram came in on, from the packet info in its control data.
+    static void PacketInfo(struct msghdr& mh, const struct sockaddr* remote, uint32_t& interfaceId)
+    {
+        if ((mh.msg_flags & MSG_CTRUNC) == 0) {
+            for ( // iterate through the control headers
+                struct cmsghdr* cmsg = CMSG_FIRSTHDR(&mh);
+                cmsg != NULL;
+                cmsg = CMSG_NXTHDR(&mh, cmsg))
+            {
+                if ((cmsg->cmsg_level == IPPROTO_IP) && (cmsg->cmsg_type == IP_PKTINFO) && (remote->sa_family == AF_INET)) {
+                    const struct in_pktinfo* info = reinterpret_cast<const struct in_pktinfo*>CMSG_DATA(cmsg);
+                    interfaceId = info->ipi_ifindex;
+                    break;
+                }
+                else if ((cmsg->cmsg_level == IPPROTO_IPV6) && (cmsg->cmsg_type == IPV6_PKTINFO) && (remote->sa_family == AF_INET6)) {
+                    const struct in6_pktinfo* info = reinterpret_cast<const struct in6_pktinfo*>CMSG_DATA(cmsg);
+                    interfaceId = info->ipi6_ifindex;
+                    break;
+                }
+            }
+        }
+    }
+
     static uint32_t ReceiveFrom(SOCKET handle, char* buffer, int bufferSize, struct sockaddr* remote, socklen_t* remoteLength, uint32_t& interfaceId) {
         uint32_t result;
 
@@ -224,27 +249,152 @@ namespace Core {
         };
 
         result = recvmsg(handle, &mh, 0);
-        if ((static_cast<signed int>(result) != SOCKET_ERROR) && ((mh.msg_flags & MSG_CTRUNC) == 0)) {
-            for ( // iterate through the control headers
-                struct cmsghdr* cmsg = CMSG_FIRSTHDR(&mh);
-                cmsg != NULL;
-                cmsg = CMSG_NXTHDR(&mh, cmsg))
-            {
-                if ((cmsg->cmsg_level == IPPROTO_IP) && (cmsg->cmsg_type == IP_PKTINFO) && (remote->sa_family == AF_INET)) {
-                    const struct in_pktinfo* info = reinterpret_cast<const struct in_pktinfo*>CMSG_DATA(cmsg);
-                    interfaceId = info->ipi_ifindex;
-                    break;
+        if (static_cast<signed int>(result) != SOCKET_ERROR) {
+            PacketInfo(mh, remote, interfaceId);
+        }
+
+        return (result);
+    }
+
+    // The datagrams moved by a single recvmmsg/sendmmsg. Every datagram has its own slot in the buffer, its
+    // own address and, when received, its own control data for the packet info.
+    class SocketPort::Datagrams {
+    private:
+        static constexpr uint32_t ControlSize = 64;
+
+    public:
+        Datagrams() = delete;
+        Datagrams(const Datagrams&) = delete;
+        Datagrams& operator=(const Datagrams&) = delete;
+
+        Datagrams(const uint8_t count, const uint32_t sendSize, const uint32_t receiveSize)
+            : _count(count)
+            , _sendSize(static_cast<uint16_t>(std::min(sendSize, static_cast<uint32_t>(0xFFFF))))
+            , _receiveSize(static_cast<uint16_t>(std::min(receiveSize, static_cast<uint32_t>(0xFFFF))))
+            , _buffer(static_cast<size_t>(count) * (_sendSize + _receiveSize))
+            , _control(static_cast<size_t>(count) * ControlSize)
+            , _received(count)
+            , _receivedIO(count)
+            , _receivedFrom(count)
+            , _sent(count)
+            , _sentIO(count)
+            , _destinations(count)
+            , _loaded(0)
+            , _offset(0)
+        {
+            for (uint8_t index = 0; index < _count; index++) {
+                _receivedIO[index].iov_base = ReceiveSlot(index);
+                _receivedIO[index].iov_len = _receiveSize;
+                _sentIO[index].iov_base = &(_buffer[index * _sendSize]);
+            }
+        }
+        ~Datagrams() = default;
+
+    public:
+        inline uint8_t* ReceiveSlot(const uint8_t index)
+        {
+            return (&(_buffer[(_count * _sendSize) + (index * _receiveSize)]));
+        }
+        // Returns the number of datagrams received, or -1 (and errno).
+        int Receive(SOCKET socket)
+        {
+            for (uint8_t index = 0; index < _count; index++) {
+                struct msghdr& header(_received[index].msg_hdr);
+
+                header.msg_name = &(_receivedFrom[index]);
+                header.msg_namelen = sizeof(NodeId::SocketInfo);
+                header.msg_iov = &(_receivedIO[index]);
+                header.msg_iovlen = 1;
+                header.msg_control = &(_control[index * ControlSize]);
+                header.msg_controllen = ControlSize;
+                header.msg_flags = 0;
+                _received[index].msg_len = 0;
+            }
+
+            return (::recvmmsg(socket, _received.data(), _count, MSG_DONTWAIT, nullptr));
+        }
+        // The size of a received datagram, as far as it fit its slot, and where it came from.
+        uint16_t Received(const uint8_t index, NodeId& remote, uint32_t& interfaceId)
+        {
+            remote = _receivedFrom[index];
+            PacketInfo(_received[index].msg_hdr, reinterpret_cast<const struct sockaddr*>(&(_receivedFrom[index])), interfaceId);
+
+            return (static_cast<uint16_t>(std::min(_received[index].msg_len, static_cast<unsigned int>(_receiveSize))));
+        }
+
+        inline bool IsSent() const
+        {
+            return (_offset == _loaded);
+        }
+        inline bool IsFull() const
+        {
+            return (_loaded == _count);
+        }
+        inline uint8_t* SendSlot()
+        {
+            return (static_cast<uint8_t*>(_sentIO[_loaded].iov_base));
+        }
+        inline uint16_t SendSize() const
+        {
+            return (_sendSize);
+        }
+        void Load(const uint16_t size, const NodeId& destination)
+        {
+            ASSERT(IsFull() == false);
+
+            _sentIO[_loaded].iov_len = size;
+            _destinations[_loaded] = destination;
+            _loaded++;
+        }
+        // Returns the number of datagrams sent, or -1 (and errno), their bytes are added to bytes. What is not
+        // sent stays for the next call.
+        int Send(SOCKET socket, uint64_t& bytes)
+        {
+            for (uint8_t index = _offset; index < _loaded; index++) {
+                struct msghdr& header(_sent[index].msg_hdr);
+
+                header.msg_name = const_cast<struct sockaddr*>(static_cast<const struct sockaddr*>(static_cast<const NodeId&>(_destinations[index])));
+                header.msg_namelen = _destinations[index].Size();
+                header.msg_iov = &(_sentIO[index]);
+                header.msg_iovlen = 1;
+                header.msg_control = nullptr;
+                header.msg_controllen = 0;
+                header.msg_flags = 0;
+            }
+
+            int result = ::sendmmsg(socket, &(_sent[_offset]), _loaded - _offset, MSG_DONTWAIT);
+
+            if (result > 0) {
+                for (uint8_t index = 0; index < static_cast<uint8_t>(result); index++) {
+                    bytes += _sentIO[_offset + index].iov_len;
                 }
-                else if ((cmsg->cmsg_level == IPPROTO_IPV6) && (cmsg->cmsg_type == IPV6_PKTINFO) && (remote->sa_family == AF_INET6)) {
-                    const struct in6_pktinfo* info = reinterpret_cast<const struct in6_pktinfo*>CMSG_DATA(cmsg);
-                    interfaceId = info->ipi6_ifindex;
-                    break;
+
+                _offset += static_cast<uint8_t>(result);
+
+                if (_offset == _loaded) {
+                    _offset = 0;
+                    _loaded = 0;
                 }
             }
+
+            return (result);
         }
 
-        return (result);
-    }
+    private:
+        const uint8_t _count;
+        const uint16_t _sendSize;
+        const uint16_t _receiveSize;
+        std::vector<uint8_t> _buffer;
+        std::vector<uint8_t> _control;
+        std::vector<struct mmsghdr> _received;
+        std::vector<struct iovec> _receivedIO;
+        std::vector<NodeId::SocketInfo> _receivedFrom;
+        std::vector<struct mmsghdr> _sent;
+        std::vector<struct iovec> _sentIO;
+        std::vector<NodeId> _destinations;
+        uint8_t _loaded;
+        uint8_t _offset;
+    };
 
 #endif
 
@@ -258,6 +408,110 @@ namespace Core {
 
     static constexpr uint32_t MAX_LISTEN_QUEUE = 64;
     static constexpr uint32_t SLEEPSLOT_TIME = 100;
+    static constexpr int FILE_SEND_BUFFER_SIZE = 256 * 1024;
+    static constexpr uint32_t INITIAL_BUFFER_SIZE = 1024;
+    static constexpr uint32_t BUFFER_POOL_SIZE = 4 * 1024 * 1024;
+
+    namespace {
+
+        // The monitor of the listening port that is accepting connections on this thread, if it has one.
+        thread_local ResourceMonitorBase* g_AcceptingMonitor = nullptr;
+
+        // Grown stream buffers are only held while a burst is handled, in between they wait here for
+        // the next connection that needs them, so a busy reactor does not hit the heap every cycle.
+        class BufferPool {
+        public:
+            BufferPool(const BufferPool&) = delete;
+            BufferPool& operator=(const BufferPool&) = delete;
+
+            BufferPool()
+                : _adminLock()
+                , _buffers()
+                , _pooled(0)
+            {
+            }
+            ~BufferPool()
+            {
+                for (std::pair<const uint32_t, std::vector<uint8_t*>>& entry : _buffers) {
+                    for (uint8_t* buffer : entry.second) {
+                        ::free(buffer);
+                    }
+                }
+            }
+
+            static BufferPool& Instance()
+            {
+                static BufferPool pool;
+                return (pool);
+            }
+
+        public:
+            uint8_t* Acquire(const uint32_t size)
+            {
+                uint8_t* result = nullptr;
+
+                _adminLock.Lock();
+
+                std::map<uint32_t, std::vector<uint8_t*>>::iterator index(_buffers.find(size));
+
+                if ((index != _buffers.end()) && (index->second.empty() == false)) {
+                    result = index->second.back();
+                    index->second.pop_back();
+                    _pooled -= size;
+                }
+
+                _adminLock.Unlock();
+
+                return (result != nullptr ? result : static_cast<uint8_t*>(::malloc(size)));
+            }
+            void Release(uint8_t* buffer, const uint32_t size)
+            {
+                _adminLock.Lock();
+
+                if ((_pooled + size) <= BUFFER_POOL_SIZE) {
+                    _buffers[size].push_back(buffer);
+                    _pooled += size;
+                    buffer = nullptr;
+                }
+
+                _adminLock.Unlock();
+
+                ::free(buffer);
+            }
+
+        private:
+            CriticalSection _adminLock;
+            std::map<uint32_t, std::vector<uint8_t*>> _buffers;
+            uint32_t _pooled;
+        };
+
+        // Swap the buffer for one of the requested size, the first bytes (keep) move along. Up to the
+        // initial size the port's own buffer is used, a larger one comes from (and goes back to) the pool.
+        void Resize(uint8_t*& buffer, uint32_t& size, uint8_t initial[], const uint32_t initialSize, const uint32_t requested, const uint32_t keep)
+        {
+            uint8_t* replacement = (requested <= initialSize ? initial : BufferPool::Instance().Acquire(requested));
+
+            ASSERT(keep <= std::min(size, std::max(requested, initialSize)));
+
+            if ((replacement != nullptr) && (replacement != buffer)) {
+                if (keep != 0) {
+                    ::memcpy(replacement, buffer, keep);
+                }
+                if (buffer != initial) {
+                    BufferPool::Instance().Release(buffer, size);
+                }
+
+                buffer = replacement;
+                size = (requested <= initialSize ? initialSize : requested);
+            }
+        }
+
+        // The old interface passes at most 16 bits worth of data at once.
+        inline uint16_t Slice(const uint32_t length)
+        {
+            return (static_cast<uint16_t>(std::min(length, static_cast<uint32_t>(0xFFFF))));
+        }
+    }
 
     inline void DestroySocket(SOCKET& socket)
     {
@@ -307,8 +561,8 @@ namespace Core {
         const enumType socketType,
         const NodeId& refLocalNode,
         const NodeId& refremoteNode,
-        const uint16_t nSendBufferSize,
-        const uint16_t nReceiveBufferSize)
+        const uint32_t nSendBufferSize,
+        const uint32_t nReceiveBufferSize)
         : m_LocalNode(refLocalNode)
         , m_RemoteNode(refremoteNode)
         , m_ReceiveBufferSize(nReceiveBufferSize)
@@ -318,9 +572,33 @@ namespace Core {
         , m_syncAdmin()
         , m_State(0)
         , m_ReceivedNode()
+        , m_Buffers(nullptr)
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_SendSize(0)
+        , m_ReceiveSize(0)
+        , m_SendLimit(0)
+        , m_ReceiveLimit(0)
+        , m_SendHint(0)
+        , m_ReceiveHint(0)
+        , m_ReadBytes(0)
+        , m_SendBytes(0)
+        , m_SendOffset(0)
+        , m_SendFile(INVALID_HANDLE_VALUE)
+        , m_SendFileOffset(0)
+        , m_SendFileSize(0)
+        , m_SendFileBuffer(0)
 	, m_Interface(~0)
+        , m_Monitor(nullptr)
+        , m_SharePort(false)
+        , m_Batch(0)
+        , m_Datagrams(nullptr)
+        , m_Statistics()
+        , m_BlockedSince(0)
+        , m_Accepted(nullptr)
+        , m_AcceptedCount(0)
+        , m_Transfers(false)
+        , m_Queued(0)
     {
         TRACE_L5("Constructor SocketPort (NodeId&) <%p>", (this));
     }
@@ -329,8 +607,8 @@ namespace Core {
         const enumType socketType,
         const SOCKET& refConnector,
         const NodeId& remoteNode,
-        const uint16_t nSendBufferSize,
-        const uint16_t nReceiveBufferSize)
+        const uint32_t nSendBufferSize,
+        const uint32_t nReceiveBufferSize)
         : m_LocalNode(remoteNode.AnyInterface())
         , m_RemoteNode(remoteNode)
         , m_ReceiveBufferSize(nReceiveBufferSize)
@@ -340,9 +618,33 @@ namespace Core {
         , m_syncAdmin()
         , m_State(0)
         , m_ReceivedNode()
+        , m_Buffers(nullptr)
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_SendSize(0)
+        , m_ReceiveSize(0)
+        , m_SendLimit(0)
+        , m_ReceiveLimit(0)
+        , m_SendHint(0)
+        , m_ReceiveHint(0)
+        , m_ReadBytes(0)
+        , m_SendBytes(0)
+        , m_SendOffset(0)
+        , m_SendFile(INVALID_HANDLE_VALUE)
+        , m_SendFileOffset(0)
+        , m_SendFileSize(0)
+        , m_SendFileBuffer(0)
 	, m_Interface(~0)
+        , m_Monitor(g_AcceptingMonitor)
+        , m_SharePort(false)
+        , m_Batch(0)
+        , m_Datagrams(nullptr)
+        , m_Statistics()
+        , m_BlockedSince(0)
+        , m_Accepted(nullptr)
+        , m_AcceptedCount(0)
+        , m_Transfers(false)
+        , m_Queued(0)
     {
         NodeId::SocketInfo localAddress;
         socklen_t localSize = sizeof(localAddress);
@@ -371,11 +673,22 @@ namespace Core {
         ASSERT((m_Socket == INVALID_SOCKET) &&(m_State == 0));
 
         if (m_Socket != INVALID_SOCKET) {
-            ResourceMonitor::Instance().Unregister(*this);
+            Monitor().Unregister(*this);
             DestroySocket(m_Socket);
         }
 
-        ::free(m_SendBuffer);
+        // At this point the pool might be gone already (static destruction), hand it to the heap.
+        if ((m_SendBuffer != nullptr) && (m_SendBuffer != m_Buffers)) {
+            ::free(m_SendBuffer);
+        }
+        if ((m_ReceiveBuffer != nullptr) && (m_ReceiveBuffer != &(m_Buffers[InitialSize(m_SendLimit)]))) {
+            ::free(m_ReceiveBuffer);
+        }
+        ::free(m_Buffers);
+
+#ifdef __LINUX__
+        delete m_Datagrams;
+#endif
     }
 
     //////////////////////////////////////////////////////////////////////
@@ -426,6 +739,63 @@ namespace Core {
         return (true);
     }
 
+    void SocketPort::Monitor(ResourceMonitorBase& monitor)
+    {
+        ASSERT((m_Socket == INVALID_SOCKET) && (m_State == 0));
+
+        m_Monitor = &monitor;
+    }
+
+    void SocketPort::SharePort(const bool enabled)
+    {
+        ASSERT((m_Socket == INVALID_SOCKET) && (m_State == 0));
+
+        m_SharePort = enabled;
+    }
+
+    void SocketPort::Batch(const uint8_t count)
+    {
+        ASSERT((m_Socket == INVALID_SOCKET) && (m_State == 0));
+
+        m_Batch = count;
+    }
+
+    void SocketPort::Transfers(const bool enabled)
+    {
+        ASSERT((m_State & SocketPort::MONITOR) == 0);
+
+        m_Transfers = enabled;
+    }
+
+    SocketPort::Statistics SocketPort::Metrics() const
+    {
+        m_syncAdmin.Lock();
+
+        Statistics result(m_Statistics);
+
+        if (m_BlockedSince != 0) {
+            // Still waiting for room, what it waited so far counts as well.
+            result.Blocked += Time::Now().Ticks() - m_BlockedSince;
+        }
+
+#ifdef __LINUX__
+        if (((m_State & SocketPort::LINK) != 0) && (SocketMode() == SOCK_STREAM) && (m_Socket != INVALID_SOCKET)) {
+            struct tcp_info info;
+            socklen_t length = sizeof(info);
+
+            // Fails on anything but TCP (a domain socket), that keeps them at 0.
+            if (::getsockopt(m_Socket, IPPROTO_TCP, TCP_INFO, &info, &length) == 0) {
+                result.RoundTrip = info.tcpi_rtt;
+                result.Retransmits = info.tcpi_total_retrans;
+            }
+        }
+#endif
+
+        m_syncAdmin.Unlock();
+
+        return (result);
+    }
+
     /* virtual */ uint32_t SocketPort::Initialize()
     {
         return (Core::ERROR_NONE);
@@ -438,6 +808,8 @@ namespace Core {
         m_ReadBytes = 0;
         m_SendBytes = 0;
         m_SendOffset = 0;
+        m_SendFileSize = 0;
+        m_SendFileBuffer = 0;
 
         if ((m_State & (SocketPort::LINK | SocketPort::OPEN | SocketPort::MONITOR)) == (SocketPort::LINK | SocketPort::OPEN)) {
             // Open up an accepted socket, but not yet added to the monitor.
@@ -497,7 +869,7 @@ namespace Core {
 
         if ((nStatus == Core::ERROR_NONE) || (nStatus == Core::ERROR_INPROGRESS)) {
             m_State |= SocketPort::UPDATE;
-            ResourceMonitor::Instance().Register(*this);
+            Monitor().Register(*this);
 
             if (nStatus == Core::ERROR_INPROGRESS) {
                 if (waitTime > 0) {
@@ -546,7 +918,7 @@ namespace Core {
 #endif
                 }
 
-                ResourceMonitor::Instance().Break();
+                Monitor().Break();
             }
 
             if (waitTime > 0) {
@@ -558,7 +930,7 @@ namespace Core {
 
                     // We probably did not get a response from the otherside on the close
                     // sloppy but let's forcefully close it
-                    ResourceMonitor::Instance().Break();
+                    Monitor().Break();
 
                     closed = (WaitForClosure(Core::infinite) == Core::ERROR_NONE);
 
@@ -579,8 +951,23 @@ namespace Core {
         if ((m_State & (SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) {
 
             m_State |= SocketPort::WRITESLOT;
-            ResourceMonitor::Instance().Break();
+            Monitor().Break();
+        }
+        m_syncAdmin.Unlock();
+    }
+
+    void SocketPort::Throttle(const bool enabled)
+    {
+        m_syncAdmin.Lock();
+
+        if (enabled == true) {
+            m_State |= SocketPort::THROTTLED;
+        } else if ((m_State & SocketPort::THROTTLED) != 0) {
+            // Pick up reading again, select the events again where they are edge triggered.
+            m_State = ((m_State & (~SocketPort::THROTTLED)) | SocketPort::UPDATE);
+            Monitor().Break();
         }
+
         m_syncAdmin.Unlock();
     }
 
@@ -588,12 +975,23 @@ namespace Core {
     // PRIVATE SocketPort interface
     //////////////////////////////////////////////////////////////////////
 
+    uint32_t SocketPort::InitialSize(const uint32_t limit) const
+    {
+        return (IsAdaptive() == true ? std::min(limit, INITIAL_BUFFER_SIZE) : limit);
+    }
+
     void SocketPort::BufferAlignment(SOCKET socket)
     {
         socklen_t valueLength = sizeof(int);
         int value;
         uint32_t receiveBuffer = m_ReceiveBufferSize;
         uint32_t sendBuffer = m_SendBufferSize;
+#ifdef __LINUX__
+        // A batch of datagrams should fit the kernel buffers at once.
+        const uint32_t slots = (((m_Batch > 1) && (m_SocketType == DATAGRAM)) ? m_Batch : 1);
+#else
+        const uint32_t slots = 1;
+#endif
 
         if (m_ReceiveBufferSize == static_cast<uint16_t>(~0)) {
             ::getsockopt(socket, SOL_SOCKET, SO_RCVBUF, (char*)&value, &valueLength);
@@ -601,8 +999,12 @@ namespace Core {
             receiveBuffer = static_cast<uint32_t>(value);
 
             TRACE_L1("Receive buffer size. %d", receiveBuffer);
-        } else if ((receiveBuffer != 0) && (::setsockopt(socket, SOL_SOCKET, SO_RCVBUF, (const char*)&receiveBuffer, sizeof(receiveBuffer)) == SOCKET_ERROR)) {
-            TRACE_L1("Error could not set Receive buffer size (%d).", receiveBuffer);
+        } else if (receiveBuffer != 0) {
+            const uint32_t kernelBuffer = receiveBuffer * slots;
+
+            if (::setsockopt(socket, SOL_SOCKET, SO_RCVBUF, (const char*)&kernelBuffer, sizeof(kernelBuffer)) == SOCKET_ERROR) {
+                TRACE_L1("Error could not set Receive buffer size (%d).", kernelBuffer);
+            }
         }
 
         if (m_SendBufferSize == static_cast<uint16_t>(~0)) {
@@ -611,22 +1013,40 @@ namespace Core {
             sendBuffer = static_cast<uint32_t>(value);
 
             TRACE_L1("Send buffer size. %d", sendBuffer);
-        } else if ((sendBuffer != 0) && (::setsockopt(socket, SOL_SOCKET, SO_SNDBUF, (const char*)&sendBuffer, sizeof(sendBuffer)) == SOCKET_ERROR)) {
-            TRACE_L1("Error could not set Send buffer size (%d).", sendBuffer);
+        } else if (sendBuffer != 0) {
+            const uint32_t kernelBuffer = sendBuffer * slots;
+
+            if (::setsockopt(socket, SOL_SOCKET, SO_SNDBUF, (const char*)&kernelBuffer, sizeof(kernelBuffer)) == SOCKET_ERROR) {
+                TRACE_L1("Error could not set Send buffer size (%d).", kernelBuffer);
+            }
         }
 
         if ((receiveBuffer != 0) || (sendBuffer != 0)) {
-            uint8_t* allocatedMemory = static_cast<uint8_t*>(::calloc(sendBuffer + receiveBuffer, 1));
-            if (sendBuffer != 0) {
-                if (m_SendBuffer != nullptr) {
-                    free(m_SendBuffer);
-                }
-                m_SendBuffer = allocatedMemory;
+            // Only the initial buffers are allocated here, a grown one is given back first.
+            if ((m_SendBuffer != nullptr) && (m_SendBuffer != m_Buffers)) {
+                BufferPool::Instance().Release(m_SendBuffer, m_SendSize);
             }
-            if (receiveBuffer != 0) {
-                m_ReceiveBuffer = &(allocatedMemory[sendBuffer]);
+            if ((m_ReceiveBuffer != nullptr) && (m_ReceiveBuffer != &(m_Buffers[InitialSize(m_SendLimit)]))) {
+                BufferPool::Instance().Release(m_ReceiveBuffer, m_ReceiveSize);
             }
+            ::free(m_Buffers);
+
+            m_SendLimit = sendBuffer;
+            m_ReceiveLimit = receiveBuffer;
+            m_SendSize = InitialSize(sendBuffer);
+            m_ReceiveSize = InitialSize(receiveBuffer);
+            m_SendHint = m_SendSize;
+            m_ReceiveHint = m_ReceiveSize;
+
+            m_Buffers = static_cast<uint8_t*>(::calloc(m_SendSize + m_ReceiveSize, 1));
+            m_SendBuffer = (m_SendSize != 0 ? m_Buffers : nullptr);
+            m_ReceiveBuffer = (m_ReceiveSize != 0 ? &(m_Buffers[m_SendSize]) : nullptr);
         }
+
+#ifdef __LINUX__
+        delete m_Datagrams;
+        m_Datagrams = (slots > 1 ? new Datagrams(static_cast<uint8_t>(slots), sendBuffer, receiveBuffer) : nullptr);
+#endif
     }
 
     SOCKET SocketPort::ConstructSocket(NodeId& localNode, const string& specificInterface)
@@ -666,6 +1086,11 @@ namespace Core {
             if (::setsockopt(l_Result, SOL_SOCKET, SO_REUSEADDR, (const char*)&optval, optionLength) < 0) {
                 TRACE_L1("Error on setting SO_REUSEADDR option. Error %d: %s", __ERRORRESULT__, strerror(__ERRORRESULT__));
             }
+#ifdef SO_REUSEPORT
+            if ((m_SharePort == true) && (::setsockopt(l_Result, SOL_SOCKET, SO_REUSEPORT, (const char*)&optval, optionLength) < 0)) {
+                TRACE_L1("Error on setting SO_REUSEPORT option. Error %d: %s", __ERRORRESULT__, strerror(__ERRORRESULT__));
+            }
+#endif
         }
 
 #ifndef __WINDOWS__
@@ -769,7 +1194,7 @@ namespace Core {
         // Right, a wait till connection is closed is requested..
         while ((waiting > 0) && (IsOpen() == false)) {
             // Make sure we aren't in the monitor thread waiting for close completion.
-            ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+            ASSERT(Core::Thread::ThreadId() != Monitor().Id());
 
             uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -804,7 +1229,7 @@ namespace Core {
                 break;
             }
             // Make sure we aren't in the monitor thread waiting for close completion.
-            ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+            ASSERT(Core::Thread::ThreadId() != Monitor().Id());
 
             uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -833,7 +1258,7 @@ namespace Core {
         // Right, a wait till connection is closed is requested..
         while ((waiting > 0) && (IsClosed() == false)) {
             // Make sure we aren't in the monitor thread waiting for close completion.
-            ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+            ASSERT(Core::Thread::ThreadId() != Monitor().Id());
 
             uint32_t sleepSlot = (waiting > SLEEPSLOT_TIME ? SLEEPSLOT_TIME : waiting);
 
@@ -864,7 +1289,7 @@ namespace Core {
 #ifdef __WINDOWS__
             result = FD_CLOSE;
 #else
-            result = POLLIN;
+            result = (((m_State & (SocketPort::LINK | SocketPort::THROTTLED)) == (SocketPort::LINK | SocketPort::THROTTLED)) ? 0 : POLLIN);
 #endif
 
             // It is the first time we are going to pick this one up..
@@ -920,7 +1345,7 @@ namespace Core {
                 if (((flagsSet & FD_WRITE) != 0) || (breakIssued == true)) {
                     Write();
                 }
-                if ((flagsSet & FD_READ) != 0) {
+                if (((flagsSet & FD_READ) != 0) && ((m_State & SocketPort::THROTTLED) == 0)) {
                     Read();
                 }
             } else if ((flagsSet & FD_CONNECT) != 0) {
@@ -950,11 +1375,11 @@ namespace Core {
         }
     }
 
-    /* virtual */ int32_t SocketPort::Read(uint8_t buffer[], const uint16_t length) const {
+    /* virtual */ int32_t SocketPort::Read(uint8_t buffer[], const uint32_t length) const {
         return (::recv(m_Socket, reinterpret_cast<char*>(buffer), length, 0));
     }
 
-    /* virtual */ int32_t SocketPort::Write(const uint8_t buffer[], const uint16_t length) {
+    /* virtual */ int32_t SocketPort::Write(const uint8_t buffer[], const uint32_t length) {
         return (::send(m_Socket, reinterpret_cast<const char*>(buffer), length, 0));
     }
 
@@ -962,25 +1387,71 @@ namespace Core {
     {
         bool dataLeftToSend = true;
 
+#ifdef __LINUX__
+        if (m_Datagrams != nullptr) {
+            WriteBatch();
+            return;
+        }
+#endif
+
         m_syncAdmin.Lock();
 
         m_State &= (~(SocketPort::WRITE | SocketPort::WRITESLOT));
 
-        while (((m_State & (SocketPort::WRITE | SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) && (dataLeftToSend == true)) {
-            if (m_SendOffset == m_SendBytes) {
-                m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
+        Unblocked();
+
+        // What the monitor sends for this port goes first, the rest follows once it is Sent().
+        while (((m_State & (SocketPort::WRITE | SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) && (dataLeftToSend == true) && (m_Queued == 0)) {
+            if ((m_SendOffset == m_SendBytes) && (m_SendFileSize == 0)) {
+                const uint32_t initialSize = InitialSize(m_SendLimit);
+
+                if (m_SendHint != m_SendSize) {
+                    Resize(m_SendBuffer, m_SendSize, m_Buffers, initialSize, m_SendHint, 0);
+                }
+
+                m_SendBytes = SendData(m_SendBuffer, Slice(m_SendSize));
                 m_SendOffset = 0;
-                dataLeftToSend = (m_SendOffset != m_SendBytes);
 
-                ASSERT(m_SendBytes <= m_SendBufferSize);
+                if (IsAdaptive() == true) {
+                    uint16_t loaded = static_cast<uint16_t>(m_SendBytes);
+
+                    // A stream has no boundaries, keep loading till the buffer is full so it goes out in one
+                    // send. The slices never get smaller than what SendData got before the buffers grew.
+                    while ((loaded != 0) && (m_SendFileSize == 0) && ((m_SendSize - m_SendBytes) >= initialSize)) {
+                        loaded = SendData(&(m_SendBuffer[m_SendBytes]), Slice(m_SendSize - m_SendBytes));
+                        m_SendBytes += loaded;
+                    }
+
+                    // A full buffer means more is waiting, the next one is larger. One that was not even
+                    // half used makes the next one smaller, down to the initial buffer.
+                    if ((m_SendBytes + initialSize) > m_SendSize) {
+                        m_SendHint = std::min(m_SendLimit, m_SendSize * 2);
+                    } else if ((m_SendBytes * 2) <= m_SendSize) {
+                        m_SendHint = std::max(initialSize, m_SendSize / 2);
+                    }
+                }
+
+                dataLeftToSend = ((m_SendOffset != m_SendBytes) || (m_SendFileSize != 0));
+                m_Statistics.Queue = std::max(m_Statistics.Queue, m_SendBytes + m_SendFileSize);
+
+                ASSERT(m_SendBytes <= m_SendSize);
             }
 
-            if (dataLeftToSend == true) {
+            if ((dataLeftToSend == true) && (m_SendFileSize == 0) && (IsTransferring() == true) && (Monitor().Send(*this, Descriptor(), &(m_SendBuffer[m_SendOffset]), m_SendBytes - m_SendOffset) == true)) {
+                // The monitor took a copy, it is counted once it is Sent().
+                m_Queued = m_SendBytes - m_SendOffset;
+                m_SendOffset = m_SendBytes;
+            } else if (dataLeftToSend == true) {
+                const uint32_t offered = (m_SendOffset == m_SendBytes ? m_SendFileSize : m_SendBytes - m_SendOffset);
                 int32_t sendSize;
 
+                if (m_SendOffset == m_SendBytes) {
+                    // The buffer is out, what is left is a file, that goes without passing the buffer.
+                    sendSize = Splice();
+                }
                 // Sockets are non blocking the Send buffer size is equal to the buffer size. We only send
                 // if the buffer free (SEND flag) is active, so the buffer should always fit.
-                if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
+                else if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
                     ASSERT(m_RemoteNode.IsValid() == true);
 
                     sendSize = ::sendto(m_Socket,
@@ -989,17 +1460,39 @@ namespace Core {
                         static_cast<const NodeId&>(m_RemoteNode),
                         m_RemoteNode.Size());
 
+                    if (sendSize >= 0) {
+                        m_SendOffset = m_SendBytes;
+                    }
                 } else {
-                    sendSize = Write(&(m_SendBuffer[m_SendOffset]), m_SendBytes - m_SendOffset);
+#ifdef __LINUX__
+                    if (m_SendFileSize != 0) {
+                        // The headers in front of a file, tell the stack more is coming so they share a segment.
+                        sendSize = ::send(m_Socket, reinterpret_cast<const char*>(&(m_SendBuffer[m_SendOffset])), m_SendBytes - m_SendOffset, MSG_MORE);
+                    } else
+#endif
+                    {
+                        sendSize = Write(&(m_SendBuffer[m_SendOffset]), m_SendBytes - m_SendOffset);
+                    }
+
+                    if (sendSize >= 0) {
+                        m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
+                    }
                 }
 
+                m_Statistics.Writes++;
+
                 if (sendSize >= 0) {
-                    m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
+                    m_Statistics.Sent += sendSize;
+
+                    if (static_cast<uint32_t>(sendSize) < offered) {
+                        m_Statistics.Partial++;
+                    }
                 } else {
                     uint32_t l_Result = __ERRORRESULT__;
 
                     if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__)) {
                         m_State |= SocketPort::WRITE;
+                        m_BlockedSince = Time::Now().Ticks();
                     } else {
                         printf("Write exception %d: %s\n", l_Result, strerror(__ERRORRESULT__));
                         m_State |= SocketPort::EXCEPTION;
@@ -1009,22 +1502,125 @@ namespace Core {
             }
         }
 
+        if ((m_SendOffset == m_SendBytes) && (m_SendSize > InitialSize(m_SendLimit))) {
+            // Nothing left in a grown buffer, it waits in the pool for the next burst.
+            Resize(m_SendBuffer, m_SendSize, m_Buffers, InitialSize(m_SendLimit), 0, 0);
+        }
+
         m_syncAdmin.Unlock();
     }
 
+    /* virtual */ bool SocketPort::SendFile(const File::Handle file, const uint64_t offset, const uint32_t length)
+    {
+        bool result = false;
+
+#ifdef __LINUX__
+        ASSERT(m_SendFileSize == 0);
+
+        // Only a connected stream takes it, a datagram would loose its boundaries.
+        if (((m_State & SocketPort::LINK) != 0) && (file != INVALID_HANDLE_VALUE)) {
+            int value = 0;
+            socklen_t valueLength = sizeof(value);
+
+            // The kernel send buffer was sized after the user space buffer, a file does not pass that buffer. With
+            // room for a single segment every segment waits for a (delayed) acknowledge, give it room for a few.
+            // It is only widened for as long as the file goes out, see FileSent().
+            if ((m_SendFileBuffer == 0) && (::getsockopt(m_Socket, SOL_SOCKET, SO_SNDBUF, &value, &valueLength) == 0) && (value < FILE_SEND_BUFFER_SIZE)) {
+                const int widened = FILE_SEND_BUFFER_SIZE;
+
+                if (::setsockopt(m_Socket, SOL_SOCKET, SO_SNDBUF, &widened, sizeof(widened)) == 0) {
+                    m_SendFileBuffer = value;
+                }
+            }
+
+            m_SendFile = file;
+            m_SendFileOffset = offset;
+            m_SendFileSize = length;
+            result = true;
+        }
+#else
+        DEBUG_VARIABLE(file);
+        DEBUG_VARIABLE(offset);
+        DEBUG_VARIABLE(length);
+#endif
+
+        return (result);
+    }
+
+    int32_t SocketPort::Splice()
+    {
+        int32_t result = 0;
+
+#ifdef __LINUX__
+        off_t offset = static_cast<off_t>(m_SendFileOffset);
+        ssize_t sent = ::sendfile(m_Socket, m_SendFile, &offset, (m_SendFileSize > 0x7FFF0000 ? 0x7FFF0000 : m_SendFileSize));
+
+        if (sent > 0) {
+            m_SendFileOffset = static_cast<uint64_t>(offset);
+            m_SendFileSize -= static_cast<uint32_t>(sent);
+            result = static_cast<int32_t>(sent);
+        } else if (sent == 0) {
+            // The file is shorter than it was announced, nothing more to give.
+            m_SendFileSize = 0;
+        } else {
+            result = SOCKET_ERROR;
+        }
+
+        if (m_SendFileSize == 0) {
+            FileSent();
+        }
+#else
+        m_SendFileSize = 0;
+#endif
+
+        return (result);
+    }
+
+    // Called with the lock taken, once the file is out (or dropped). A connection that is kept alive goes back to
+    // the send buffer it had, the kernel doubles what is set, so half of what it reported is set again.
+    void SocketPort::FileSent()
+    {
+#ifdef __LINUX__
+        if (m_SendFileBuffer != 0) {
+            const int value = m_SendFileBuffer / 2;
+
+            ::setsockopt(m_Socket, SOL_SOCKET, SO_SNDBUF, &value, sizeof(value));
+            m_SendFileBuffer = 0;
+        }
+#endif
+    }
+
     void SocketPort::Read()
     {
+#ifdef __LINUX__
+        if (m_Datagrams != nullptr) {
+            ReadBatch();
+            return;
+        }
+#endif
+
         m_syncAdmin.Lock();
 
+        const uint32_t initialSize = InitialSize(m_ReceiveLimit);
+        uint8_t* initialBuffer = (m_Buffers != nullptr ? &(m_Buffers[InitialSize(m_SendLimit)]) : nullptr);
+        uint32_t peak = 0;
+
+        if (m_ReceiveHint > m_ReceiveSize) {
+            Resize(m_ReceiveBuffer, m_ReceiveSize, initialBuffer, initialSize, m_ReceiveHint, m_ReadBytes);
+        }
+
         m_State &= (~SocketPort::READ);
 
         while ((m_State & (SocketPort::READ | SocketPort::EXCEPTION | SocketPort::OPEN)) == SocketPort::OPEN) {
             uint32_t l_Size;
+            uint32_t room;
 
-            if (m_ReadBytes == m_ReceiveBufferSize) {
+            if (m_ReadBytes == m_ReceiveSize) {
                 m_ReadBytes = 0;
             }
 
+            room = m_ReceiveSize - m_ReadBytes;
+
             // Read the actual data from the port.
             if (((m_State & SocketPort::LINK) == 0) && (m_LocalNode.Type() != NodeId::TYPE_NETLINK)) {
                 NodeId::SocketInfo l_Remote;
@@ -1032,23 +1628,29 @@ namespace Core {
 
                 l_Size = ReceiveFrom(m_Socket,
                     reinterpret_cast<char*>(&m_ReceiveBuffer[m_ReadBytes]),
-                    m_ReceiveBufferSize - m_ReadBytes, (struct sockaddr*)&l_Remote,
+                    room, (struct sockaddr*)&l_Remote,
                     &l_Address, m_Interface);
 
                 m_ReceivedNode = l_Remote;
             } else {
-                l_Size = Read(&(m_ReceiveBuffer[m_ReadBytes]), m_ReceiveBufferSize - m_ReadBytes);
+                l_Size = Read(&(m_ReceiveBuffer[m_ReadBytes]), room);
             }
 
+            m_Statistics.Reads++;
+
             if (l_Size == 0) {
                 if ((m_State & SocketPort::LINK) != 0) {
                     m_State = ((m_State & (~SocketPort::OPEN)) | SocketPort::EXCEPTION);
                 }
             } else if (l_Size != static_cast<uint32_t>(SOCKET_ERROR)) {
+                m_Statistics.Received += l_Size;
                 m_ReadBytes += l_Size;
+                peak = std::max(peak, m_ReadBytes);
             } else {
                 uint32_t l_Result = __ERRORRESULT__;
 
+                l_Size = 0;
+
                 if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__) || (l_Result == 0)) {
                     m_State |= SocketPort::READ;
                 } else if (l_Result == __ERROR_CONNRESET__) {
@@ -1060,22 +1662,226 @@ namespace Core {
             }
 
             if (m_ReadBytes != 0) {
-                uint16_t handledBytes = ReceiveData(m_ReceiveBuffer, m_ReadBytes);
-
-                ASSERT(m_ReadBytes >= handledBytes);
+                const uint32_t handledBytes = Offer(m_ReceiveBuffer, m_ReadBytes);
 
                 m_ReadBytes -= handledBytes;
 
                 if ((m_ReadBytes != 0) && (handledBytes != 0)) {
                     // Oops not all data was consumed, Lets remove the read data
-                    ::memcpy(m_ReceiveBuffer, &m_ReceiveBuffer[handledBytes], m_ReadBytes);
+                    ::memmove(m_ReceiveBuffer, &m_ReceiveBuffer[handledBytes], m_ReadBytes);
                 }
             }
+
+            if ((l_Size == room) && (m_ReceiveSize < m_ReceiveLimit)) {
+                // The data filled all there was, more is waiting. Continue with a larger buffer.
+                m_ReceiveHint = std::min(m_ReceiveLimit, m_ReceiveSize * 2);
+
+                Resize(m_ReceiveBuffer, m_ReceiveSize, initialBuffer, initialSize, m_ReceiveHint, m_ReadBytes);
+            }
+        }
+
+        if (m_ReceiveSize > initialSize) {
+            // A burst that did not use half of the buffer makes the next one start smaller.
+            if ((peak * 2) <= m_ReceiveSize) {
+                m_ReceiveHint = std::max(initialSize, m_ReceiveSize / 2);
+            }
+            if (m_ReadBytes == 0) {
+                // Idle again, the grown buffer waits in the pool for the next burst.
+                Resize(m_ReceiveBuffer, m_ReceiveSize, initialBuffer, initialSize, 0, 0);
+            }
         }
 
         m_syncAdmin.Unlock();
     }
 
+    // Returns what ReceiveData took of it, a stream is offered all of it, in slices, as long as it is taken.
+    uint32_t SocketPort::Offer(uint8_t data[], const uint32_t length)
+    {
+        uint32_t handledBytes = 0;
+        uint16_t handled;
+
+        do {
+            handled = ReceiveData(&(data[handledBytes]), Slice(length - handledBytes));
+            handledBytes += handled;
+
+            ASSERT(length >= handledBytes);
+
+        } while ((handled != 0) && (handledBytes < length) && (IsAdaptive() == true));
+
+        return (handledBytes);
+    }
+
+    /* virtual */ bool SocketPort::IsTransferring() const
+    {
+        return ((m_Transfers == true) && (m_Datagrams == nullptr) && ((m_State & (SocketPort::LINK | SocketPort::OPEN | SocketPort::SHUTDOWN | SocketPort::EXCEPTION | SocketPort::THROTTLED)) == (SocketPort::LINK | SocketPort::OPEN)));
+    }
+
+    // Received by the monitor, in its buffer. Nothing waiting here, it is offered straight from there, what
+    // is not taken goes into the receive buffer, as if it was read into it.
+    /* virtual */ void SocketPort::Received(uint8_t data[], const int32_t length)
+    {
+        m_syncAdmin.Lock();
+
+        m_Statistics.Reads++;
+
+        if (length > 0) {
+            uint32_t offset = (m_ReadBytes == 0 ? Offer(data, length) : 0);
+
+            m_Statistics.Received += length;
+
+            while ((offset < static_cast<uint32_t>(length)) && ((m_State & (SocketPort::EXCEPTION | SocketPort::OPEN)) == SocketPort::OPEN)) {
+                if (m_ReadBytes == m_ReceiveSize) {
+                    m_ReadBytes = 0;
+                }
+
+                const uint32_t size = std::min(m_ReceiveSize - m_ReadBytes, static_cast<uint32_t>(length) - offset);
+
+                ::memcpy(&(m_ReceiveBuffer[m_ReadBytes]), &(data[offset]), size);
+                m_ReadBytes += size;
+                offset += size;
+
+                const uint32_t handledBytes = Offer(m_ReceiveBuffer, m_ReadBytes);
+
+                m_ReadBytes -= handledBytes;
+
+                if ((m_ReadBytes != 0) && (handledBytes != 0)) {
+                    ::memmove(m_ReceiveBuffer, &m_ReceiveBuffer[handledBytes], m_ReadBytes);
+                }
+            }
+        } else if ((length == 0) || (length == -ECONNRESET)) {
+            m_State = ((m_State & (~SocketPort::OPEN)) | SocketPort::EXCEPTION);
+        } else if (length != -EAGAIN) {
+            m_State |= SocketPort::EXCEPTION;
+            StateChange();
+        }
+
+        m_syncAdmin.Unlock();
+    }
+
+    // What the monitor sent for this port is out, the next part is loaded right away.
+    /* virtual */ void SocketPort::Sent(const int32_t result)
+    {
+        m_syncAdmin.Lock();
+
+        m_Statistics.Writes++;
+
+        if (result >= 0) {
+            m_Statistics.Sent += result;
+        }
+
+        if (static_cast<uint32_t>(result) != m_Queued) {
+            // Only an error (or a send the monitor could not finish) leaves a part behind.
+            TRACE_L1("Write exception %d", -result);
+            m_State |= SocketPort::EXCEPTION;
+            StateChange();
+        }
+
+        m_Queued = 0;
+
+        Write();
+
+        m_syncAdmin.Unlock();
+    }
+
+    void SocketPort::WriteBatch()
+    {
+#ifdef __LINUX__
+        bool dataLeftToSend = true;
+
+        m_syncAdmin.Lock();
+
+        m_State &= (~(SocketPort::WRITE | SocketPort::WRITESLOT));
+
+        Unblocked();
+
+        while (((m_State & (SocketPort::WRITE | SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) && (dataLeftToSend == true)) {
+            if (m_Datagrams->IsSent() == true) {
+                uint32_t loaded = 0;
+                uint16_t size;
+
+                // Each datagram goes to where the RemoteNode points once it is loaded, as it would with a sendto.
+                while ((m_Datagrams->IsFull() == false) && ((size = SendData(m_Datagrams->SendSlot(), m_Datagrams->SendSize())) != 0)) {
+                    m_Datagrams->Load(size, m_RemoteNode);
+                    loaded += size;
+                }
+
+                dataLeftToSend = (m_Datagrams->IsSent() == false);
+                m_Statistics.Queue = std::max(m_Statistics.Queue, loaded);
+            }
+
+            if (dataLeftToSend == true) {
+                m_Statistics.Writes++;
+            }
+
+            if ((dataLeftToSend == true) && (m_Datagrams->Send(m_Socket, m_Statistics.Sent) < 0)) {
+                uint32_t l_Result = __ERRORRESULT__;
+
+                if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__)) {
+                    m_State |= SocketPort::WRITE;
+                    m_BlockedSince = Time::Now().Ticks();
+                } else {
+                    TRACE_L1("Write exception %d: %s", l_Result, strerror(l_Result));
+                    m_State |= SocketPort::EXCEPTION;
+                    StateChange();
+                }
+            }
+        }
+
+        m_syncAdmin.Unlock();
+#endif
+    }
+
+    void SocketPort::ReadBatch()
+    {
+#ifdef __LINUX__
+        m_syncAdmin.Lock();
+
+        m_State &= (~SocketPort::READ);
+
+        while ((m_State & (SocketPort::READ | SocketPort::EXCEPTION | SocketPort::OPEN)) == SocketPort::OPEN) {
+            int count = m_Datagrams->Receive(m_Socket);
+
+            m_Statistics.Reads++;
+
+            if (count > 0) {
+                for (uint8_t index = 0; index < static_cast<uint8_t>(count); index++) {
+                    const uint16_t size = m_Datagrams->Received(index, m_ReceivedNode, m_Interface);
+
+                    m_Statistics.Received += size;
+
+                    if (size != 0) {
+                        ReceiveData(m_Datagrams->ReceiveSlot(index), size);
+                    }
+                }
+            } else if (count == 0) {
+                // Nothing was received, wait for the next readable report, like on EAGAIN.
+                m_State |= SocketPort::READ;
+            } else {
+                uint32_t l_Result = __ERRORRESULT__;
+
+                if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__) || (l_Result == 0)) {
+                    m_State |= SocketPort::READ;
+                } else {
+                    m_State |= SocketPort::EXCEPTION;
+                    StateChange();
+                }
+            }
+        }
+
+        m_syncAdmin.Unlock();
+#endif
+    }
+
+    // Called with the lock taken, on every write attempt. The time waited for room ends here, a write that
+    // finds no room again starts a new wait.
+    void SocketPort::Unblocked()
+    {
+        if (m_BlockedSince != 0) {
+            m_Statistics.Blocked += Time::Now().Ticks() - m_BlockedSince;
+            m_BlockedSince = 0;
+        }
+    }
+
     bool SocketPort::Closed()
     {
         bool result = true;
@@ -1087,6 +1893,10 @@ namespace Core {
         // Turn them all off, except for the SHUTDOWN bit, to show whether this was
         // done on our request, or closed from the other side...
         m_State &= SHUTDOWN;
+        // A send the monitor still has, is cancelled as the port leaves it.
+        m_Queued = 0;
+
+        Unblocked();
 
         StateChange();
 
@@ -1096,7 +1906,7 @@ namespace Core {
             result = false;
         } else {
             DestroySocket(m_Socket);
-            ResourceMonitor::Instance().Unregister(*this);
+            Monitor().Unregister(*this);
             // Remove socket descriptor for UNIX domain datagram socket.
             if ((m_LocalNode.Type() == NodeId::TYPE_DOMAIN) && ((m_SocketType == SocketPort::LISTEN) || (SocketMode() != SOCK_STREAM))) {
                 TRACE_L1("CLOSED: Remove socket descriptor %s", m_LocalNode.HostName().c_str());
@@ -1124,7 +1934,31 @@ namespace Core {
     void SocketPort::Accepted()
     {
         m_syncAdmin.Lock();
+        // The ports created for the accepted connections are handled by the same monitor as this one.
+        g_AcceptingMonitor = m_Monitor;
+        StateChange();
+        g_AcceptingMonitor = nullptr;
+        m_syncAdmin.Unlock();
+    }
+
+    void SocketPort::Accepted(const IResource::handle connections[], const uint32_t count)
+    {
+        m_syncAdmin.Lock();
+        // Accept() takes them from here, instead of from the listening socket.
+        m_Accepted = connections;
+        m_AcceptedCount = count;
+        g_AcceptingMonitor = m_Monitor;
         StateChange();
+        g_AcceptingMonitor = nullptr;
+
+        // Whatever was not taken, is not taken by anyone.
+        while (m_AcceptedCount > 0) {
+            SOCKET connection = static_cast<SOCKET>(*m_Accepted);
+            DestroySocket(connection);
+            m_Accepted++;
+            m_AcceptedCount--;
+        }
+        m_Accepted = nullptr;
         m_syncAdmin.Unlock();
     }
 
@@ -1134,10 +1968,26 @@ namespace Core {
         socklen_t size = sizeof(address);
         SOCKET result;
 
+        if (m_Accepted != nullptr) {
+            // Accepted by the monitor already, it only lacks the remote address.
+            result = INVALID_SOCKET;
+
+            if (m_AcceptedCount > 0) {
+                result = static_cast<SOCKET>(*m_Accepted);
+                m_Accepted++;
+                m_AcceptedCount--;
+
+                if (::getpeername(result, (struct sockaddr*)&address, &size) != SOCKET_ERROR) {
+                    remoteId = address;
+                }
+
+                BufferAlignment(result);
+            }
+        }
         #ifdef __WINDOWS__
-        if ((result = ::accept(m_Socket, (struct sockaddr*)&address, &size)) != SOCKET_ERROR) {
+        else if ((result = ::accept(m_Socket, (struct sockaddr*)&address, &size)) != SOCKET_ERROR) {
         #else
-        if ((result = ::accept4(m_Socket, (struct sockaddr*)&address, &size, SOCK_CLOEXEC)) != SOCKET_ERROR) {
+        else if ((result = ::accept4(m_Socket, (struct sockaddr*)&address, &size, SOCK_CLOEXEC)) != SOCKET_ERROR) {
         #endif  
             // Align the buffer to what is requested
             BufferAlignment(result);
@@ -1297,8 +2147,8 @@ namespace Core {
     SocketDatagram::SocketDatagram(const bool rawSocket,
         const NodeId& localNode,
         const NodeId& remoteNode,
-        const uint16_t sendBufferSize,
-        const uint16_t receiveBufferSize)
+        const uint32_t sendBufferSize,
+        const uint32_t receiveBufferSize)
         : SocketPort((rawSocket ? SocketPort::RAW : SocketPort::DATAGRAM), localNode, remoteNode, sendBufferSize, receiveBufferSize)
     {
     }
@@ -24,6 +24,7 @@
 #ifndef __SOCKETPORT_H
 #define __SOCKETPORT_H
 
+#include "FileSystem.h"
 #include "Module.h"
 #include "NodeId.h"
 #include "Portability.h"
@@ -47,7 +48,7 @@
 
 namespace WPEFramework {
 namespace Core {
-    class EXTERNAL SocketPort : public IResource {
+    class EXTERNAL SocketPort : public IResource, public ITransfer {
     private:
         // -------------------------------------------------------------------------
         // This object should not be copied, assigned or created with a default
@@ -68,6 +69,7 @@ namespace Core {
             LINK = 0x040,
             MONITOR = 0x080,
             WRITESLOT = 0x100,
+            THROTTLED = 0x200,
             UPDATE = 0x8000
 
         } enumState;
@@ -82,20 +84,38 @@ namespace Core {
         } enumType;
 
     public:
+        // The buffer sizes are the most a connected stream will hold, it starts with a small buffer and
+        // grows towards them under load, between bursts the grown buffers go back to a shared pool.
+        // Other sockets keep message boundaries, they get the full size from the start. A size of
+        // 0xFFFF takes the size of the kernel socket buffer.
         SocketPort(const enumType socketType,
             const NodeId& localNode,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize);
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize);
 
         SocketPort(const enumType socketType,
             const SOCKET& connector,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize);
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize);
 
         virtual ~SocketPort();
 
+    public:
+        // Counted over the life of the port, each under the lock the data moves with, so they come for free.
+        struct Statistics {
+            uint64_t Received; // Bytes read.
+            uint64_t Sent; // Bytes written, files included.
+            uint32_t Reads; // Read system calls, also those that found nothing.
+            uint32_t Writes; // Write system calls, also those that found no room.
+            uint32_t Partial; // Writes that took less than offered.
+            uint32_t Queue; // Most bytes that were waiting to be written.
+            uint64_t Blocked; // Microseconds spent waiting for room to write (POLLOUT).
+            uint32_t RoundTrip; // Smoothed round trip time in microseconds, TCP on Linux only.
+            uint32_t Retransmits; // Segments sent again, TCP on Linux only.
+        };
+
     public:
         inline uint16_t State() const
         {
@@ -141,6 +161,10 @@ namespace Core {
         {
             return ((m_State & (SocketPort::SHUTDOWN | SocketPort::EXCEPTION)) == SocketPort::EXCEPTION);
         }
+        inline bool IsThrottled() const
+        {
+            return ((m_State & SocketPort::THROTTLED) != 0);
+        }
         inline bool operator==(const SocketPort& RHS) const
         {
             return (m_Socket == RHS.m_Socket);
@@ -176,20 +200,29 @@ namespace Core {
         inline uint32_t ReceivedInterface() const {
             return (m_Interface);
         }
-        inline uint16_t SendBufferSize() const
+        inline uint32_t SendBufferSize() const
         {
             return (m_SendBufferSize);
         }
-        inline uint16_t ReceiveBufferSize() const
+        inline uint32_t ReceiveBufferSize() const
         {
             return (m_ReceiveBufferSize);
         }
+        // The bytes of send and receive buffer this port holds right now.
+        inline uint32_t Allocated() const
+        {
+            return (m_SendSize + m_ReceiveSize);
+        }
+        // The counters so far, the round trip and retransmits are taken from the kernel on the call.
+        Statistics Metrics() const;
         inline void Flush()
         {
             m_syncAdmin.Lock();
             m_ReadBytes = 0;
             m_SendBytes = 0;
             m_SendOffset = 0;
+            m_SendFileSize = 0;
+            FileSent();
             m_syncAdmin.Unlock();
         }
 
@@ -209,11 +242,52 @@ namespace Core {
         uint32_t Open(const uint32_t waitTime, const string& specificInterface);
         uint32_t Close(const uint32_t waitTime);
         void Trigger();
+        // While throttled, nothing is read from a connected peer, the transport holds it back.
+        void Throttle(const bool enabled);
+
+        // Handle this port on the given monitor, instead of the process wide ResourceMonitor. The monitor
+        // must outlive the port. Connections accepted on a listening port are handled by the same monitor.
+        // Only allowed while the port is closed.
+        void Monitor(ResourceMonitorBase& monitor);
+        inline ResourceMonitorBase& Monitor() const
+        {
+            return (m_Monitor != nullptr ? *m_Monitor : ResourceMonitor::Instance());
+        }
+        // Let more listening sockets bind the same address (SO_REUSEPORT), the kernel spreads the new
+        // connections over them. Only allowed while the port is closed.
+        void SharePort(const bool enabled);
+        // Move up to count datagrams per system call (recvmmsg/sendmmsg) instead of one, the kernel buffers
+        // are sized to hold that many. Every datagram is still handed to ReceiveData on its own, with the
+        // ReceivedNode() and ReceivedInterface() of that datagram, what ReceiveData does not take of it is
+        // dropped. SendData is called till it returns 0 or count datagrams are loaded, each goes to the
+        // RemoteNode() as it was when SendData returned. Only for DATAGRAM ports on Linux, elsewhere it is
+        // one at a time, as with a count of 0 or 1. Only allowed while the port is closed.
+        void Batch(const uint8_t count);
+        inline uint8_t Batch() const
+        {
+            return (m_Batch);
+        }
+        // Let the monitor move the data of a connected stream on the io_uring engine (see ITransfer): it is
+        // received into buffers the monitor provides, and sent with the sends of all other ports in the one
+        // system call the monitor waits in. ReceiveData and SendData are called as before, from the monitor.
+        // Without the engine (or the kernel support) it reads and writes for itself. Not for ports that
+        // override Read() or Write(), the data does not pass them. Only allowed before the monitor picked the
+        // port up, for an accepted connection that is in its constructor.
+        void Transfers(const bool enabled);
+        inline bool Transfers() const
+        {
+            return (m_Transfers);
+        }
 
         // Methods to extract and insert data into the socket buffers
         virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
         virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
 
+        // From within SendData, a part of a file can be queued to go out after the data returned. It is
+        // sent straight from the file (sendfile), SendData is not called again before it is out, so the
+        // file must stay open till then. Returns false if this link can not, the data should be copied.
+        virtual bool SendFile(const File::Handle file, const uint64_t offset, const uint32_t length);
+
         // Signal a state change, Opened, Closed or Accepted
         virtual void StateChange() = 0;
 
@@ -228,10 +302,16 @@ namespace Core {
 
     protected:
         virtual uint32_t Initialize();
-        virtual int32_t Read(uint8_t buffer[], const uint16_t length) const;
-        virtual int32_t Write(const uint8_t buffer[], const uint16_t length);
+        virtual int32_t Read(uint8_t buffer[], const uint32_t length) const;
+        virtual int32_t Write(const uint8_t buffer[], const uint32_t length);
+
+        // Connections the monitor accepted on this listening socket, handed to StateChange() as if they were
+        // accepted there (Accept() returns them and nothing more). What is not taken is closed.
+        void Accepted(const IResource::handle connections[], const uint32_t count);
 
     private:
+        class Datagrams;
+
         virtual IResource::handle Descriptor() const override
         {
             return (static_cast<IResource::handle>(m_Socket));
@@ -240,13 +320,27 @@ namespace Core {
         {
             return (((m_SocketType == LISTEN) || (m_SocketType == STREAM)) ? SOCK_STREAM : ((m_SocketType == DATAGRAM) ? SOCK_DGRAM : (m_SocketType == SEQUENCED ? SOCK_SEQPACKET : SOCK_RAW)));
         }
+        inline bool IsAdaptive() const
+        {
+            return (SocketMode() == SOCK_STREAM);
+        }
         virtual uint16_t Events() override;
         virtual void Handle(const uint16_t events) override;
+        virtual bool IsTransferring() const override;
+        virtual void Received(uint8_t data[], const int32_t length) override;
+        virtual void Sent(const int32_t result) override;
+        uint32_t Offer(uint8_t data[], const uint32_t length);
         bool Closed();
         void Opened();
         void Accepted();
         void Read();
         void Write();
+        void ReadBatch();
+        void WriteBatch();
+        void Unblocked();
+        int32_t Splice();
+        void FileSent();
+        uint32_t InitialSize(const uint32_t limit) const;
         void BufferAlignment(SOCKET socket);
         SOCKET ConstructSocket(NodeId& localNode, const string& interfaceName);
         uint32_t WaitForOpen(const uint32_t time) const;
@@ -256,19 +350,40 @@ namespace Core {
     private:
         NodeId m_LocalNode;
         NodeId m_RemoteNode;
-        uint16_t m_ReceiveBufferSize;
-        uint16_t m_SendBufferSize;
+        uint32_t m_ReceiveBufferSize;
+        uint32_t m_SendBufferSize;
         enumType m_SocketType;
         SOCKET m_Socket;
         mutable CriticalSection m_syncAdmin;
         volatile uint16_t m_State;
         NodeId m_ReceivedNode;
+        uint8_t* m_Buffers;
         uint8_t* m_SendBuffer;
         uint8_t* m_ReceiveBuffer;
-        uint16_t m_ReadBytes;
-        uint16_t m_SendBytes;
-        uint16_t m_SendOffset;
+        uint32_t m_SendSize;
+        uint32_t m_ReceiveSize;
+        uint32_t m_SendLimit;
+        uint32_t m_ReceiveLimit;
+        uint32_t m_SendHint;
+        uint32_t m_ReceiveHint;
+        uint32_t m_ReadBytes;
+        uint32_t m_SendBytes;
+        uint32_t m_SendOffset;
+        File::Handle m_SendFile;
+        uint64_t m_SendFileOffset;
+        uint32_t m_SendFileSize;
+        int m_SendFileBuffer;
         uint32_t m_Interface;
+        ResourceMonitorBase* m_Monitor;
+        bool m_SharePort;
+        uint8_t m_Batch;
+        Datagrams* m_Datagrams;
+        Statistics m_Statistics;
+        uint64_t m_BlockedSince;
+        const IResource::handle* m_Accepted;
+        uint32_t m_AcceptedCount;
+        bool m_Transfers;
+        uint32_t m_Queued;
     };
 
     class EXTERNAL SocketStream : public SocketPort {
@@ -281,8 +396,8 @@ namespace Core {
         SocketStream(const bool rawSocket,
             const NodeId& localNode,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize)
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize)
             : SocketPort((rawSocket ? SocketPort::RAW : SocketPort::STREAM), localNode, remoteNode, sendBufferSize, receiveBufferSize)
         {
         }
@@ -290,8 +405,8 @@ namespace Core {
         SocketStream(const bool rawSocket,
             const SOCKET& connector,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize)
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize)
             : SocketPort((rawSocket ? SocketPort::RAW : SocketPort::STREAM),
                   connector, remoteNode, sendBufferSize, receiveBufferSize)
         {
@@ -320,8 +435,8 @@ namespace Core {
         SocketDatagram(const bool rawSocket,
             const NodeId& localNode,
             const NodeId& remoteNode,
-            const uint16_t sendBufferSize,
-            const uint16_t receiveBufferSize);
+            const uint32_t sendBufferSize,
+            const uint32_t receiveBufferSize);
         virtual ~SocketDatagram();
 
     public:
@@ -335,7 +450,7 @@ namespace Core {
 
     class EXTERNAL SocketListner {
     private:
-        class EXTERNAL Handler : public SocketPort {
+        class EXTERNAL Handler : public SocketPort, public IAcceptor {
         private:
             Handler() = delete;
             Handler(const Handler&) = delete;
@@ -384,6 +499,10 @@ namespace Core {
                     _parent.Accept(newClient, remoteId);
                 }
             }
+            void Accepted(const IResource::handle connections[], const uint32_t count) override
+            {
+                SocketPort::Accepted(connections, count);
+            }
 
         private:
             SocketListner& _parent;
@@ -437,6 +556,14 @@ namespace Core {
         {
             return (_socket.Close(waitTime));
         }
+        inline void Monitor(ResourceMonitorBase& monitor)
+        {
+            _socket.Monitor(monitor);
+        }
+        inline void SharePort(const bool enabled)
+        {
+            _socket.SharePort(enabled);
+        }
         inline bool operator==(const SocketListner& RHS) const
         {
             return (RHS._socket == _socket);
@@ -56,6 +56,12 @@ namespace Core {
                 }
                 _iterator = _clients.begin();
             }
+            IteratorType(const std::list<HANDLECLIENT>& clients)
+                : _atHead(true)
+                , _clients(clients)
+                , _iterator(_clients.begin())
+            {
+            }
             IteratorType(const IteratorType<HANDLECLIENT>& copy)
                 : _atHead(true)
                 , _clients(copy._clients)
@@ -82,7 +88,7 @@ namespace Core {
             inline void Reset()
             {
                 _atHead = true;
-                _iterator = _clients->begin();
+                _iterator = _clients.begin();
             }
             inline bool Next()
             {
@@ -97,7 +103,7 @@ namespace Core {
             }
             inline uint32_t Count() const
             {
-                return (_clients->size());
+                return (static_cast<uint32_t>(_clients.size()));
             }
             HANDLECLIENT Client()
             {
@@ -124,9 +130,11 @@ namespace Core {
             SocketHandler<HANDLECLIENT>& operator=(const SocketHandler<HANDLECLIENT>&) = delete;
 
         public:
-            SocketHandler(SocketServerType<CLIENT>* parent)
+            // The client ids handed out start at first and go up by step, so the ids of the acceptors interleave.
+            SocketHandler(SocketServerType<CLIENT>* parent, const uint32_t first, const uint32_t step)
                 : SocketListner()
-                , _nextClient(1)
+                , _nextClient(first)
+                , _step(step)
                 , _lock()
                 , _clients()
                 , _parent(*parent)
@@ -134,9 +142,10 @@ namespace Core {
 
                 ASSERT(parent != nullptr);
             }
-            SocketHandler(const NodeId& listenNode, SocketServerType<CLIENT>* parent)
+            SocketHandler(const NodeId& listenNode, SocketServerType<CLIENT>* parent, const uint32_t first, const uint32_t step)
                 : SocketListner(listenNode)
-                , _nextClient(1)
+                , _nextClient(first)
+                , _step(step)
                 , _lock()
                 , _clients()
                 , _parent(*parent)
@@ -196,13 +205,15 @@ namespace Core {
 
                 return (result);
             }
-            inline Iterator Clients() const
+            inline void Clients(std::list<ProxyType<HANDLECLIENT>>& clients) const
             {
                 _lock.Lock();
-                Iterator result(_clients);
-                _lock.Unlock();
 
-                return (result);
+                for (const std::pair<const uint32_t, ProxyType<HANDLECLIENT>>& entry : _clients) {
+                    clients.push_back(entry.second);
+                }
+
+                _lock.Unlock();
             }
             inline void LocalNode(const Core::NodeId& localNode)
             {
@@ -286,7 +297,8 @@ namespace Core {
                     __Id<HANDLECLIENT>(*client, _nextClient);
 
                     // A new connection is available, open up a new client
-                    _clients.insert(std::pair<uint32_t, ProxyType<HANDLECLIENT>>(_nextClient++, client));
+                    _clients.insert(std::pair<uint32_t, ProxyType<HANDLECLIENT>>(_nextClient, client));
+                    _nextClient += _step;
 
                     _lock.Unlock();
                 }
@@ -323,6 +335,7 @@ namespace Core {
 
         private:
             uint32_t _nextClient;
+            uint32_t _step;
             mutable Core::CriticalSection _lock;
             std::map<uint32_t, ProxyType<HANDLECLIENT>> _clients;
             SocketServerType<CLIENT>& _parent;
@@ -332,75 +345,159 @@ namespace Core {
         SocketServerType<CLIENT>& operator=(const SocketServerType<CLIENT>&) = delete;
 
     public:
-#ifdef __WINDOWS__
-#pragma warning(disable : 4355)
-#endif
         SocketServerType()
-            : _handler(this)
+            : _monitors()
+            , _handlers()
         {
+            _handlers.push_back(new SocketHandler<CLIENT>(this, 1, 1));
         }
         SocketServerType(const NodeId& listeningNode)
-            : _handler(listeningNode, this)
+            : _monitors()
+            , _handlers()
         {
+            _handlers.push_back(new SocketHandler<CLIENT>(listeningNode, this, 1, 1));
+        }
+        // More acceptors each listen on the same address (SO_REUSEPORT) and have a monitor of their own, the
+        // kernel spreads the new connections over them. The first acceptor, and the clients it accepts, are
+        // on the process wide ResourceMonitor. Each acceptor keeps (and locks) the clients it accepted, so
+        // the callbacks of clients of different acceptors run concurrently. IP addresses only, any other
+        // address gets a single acceptor.
+        SocketServerType(const NodeId& listeningNode, const uint8_t acceptors)
+            : _monitors()
+            , _handlers()
+        {
+            const uint8_t count = (((acceptors > 1) && ((listeningNode.Type() == NodeId::TYPE_IPV4) || (listeningNode.Type() == NodeId::TYPE_IPV6))) ? acceptors : 1);
+
+            for (uint8_t index = 0; index < count; index++) {
+                SocketHandler<CLIENT>* handler = new SocketHandler<CLIENT>(listeningNode, this, index + 1, count);
+
+                if (count > 1) {
+                    handler->SharePort(true);
+                }
+                if (index > 0) {
+                    _monitors.push_back(new ResourceMonitorBase());
+                    handler->Monitor(*(_monitors.back()));
+                }
+
+                _handlers.push_back(handler);
+            }
         }
-#ifdef __WINDOWS__
-#pragma warning(default : 4355)
-#endif
         ~SocketServerType()
         {
+            for (SocketHandler<CLIENT>* handler : _handlers) {
+                delete handler;
+            }
+            for (ResourceMonitorBase* monitor : _monitors) {
+                // Closed ports leave their monitor on its next run.
+                while (monitor->Count() != 0) {
+                    SleepMs(10);
+                }
+                delete monitor;
+            }
         }
 
     public:
+        inline uint8_t Acceptors() const
+        {
+            return (static_cast<uint8_t>(_handlers.size()));
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
-            return (_handler.Open(waitTime));
+            uint32_t result = Core::ERROR_NONE;
+
+            for (SocketHandler<CLIENT>* handler : _handlers) {
+                if (result == Core::ERROR_NONE) {
+                    result = handler->Open(waitTime);
+                }
+            }
+
+            return (result);
         }
         inline uint32_t Close(const uint32_t waitTime)
         {
-            uint32_t result = _handler.Close(waitTime);
-            _handler.CloseClients();
+            uint32_t result = Core::ERROR_NONE;
+
+            for (SocketHandler<CLIENT>* handler : _handlers) {
+                uint32_t closed = handler->Close(waitTime);
+
+                if (result == Core::ERROR_NONE) {
+                    result = closed;
+                }
+            }
+            for (SocketHandler<CLIENT>* handler : _handlers) {
+                handler->CloseClients();
+            }
+
             return (result);
         }
         inline void Cleanup()
         {
-            _handler.Cleanup();
+            for (SocketHandler<CLIENT>* handler : _handlers) {
+                handler->Cleanup();
+            }
         }
         inline Core::ProxyType<CLIENT> Client(const uint32_t ID)
         {
-            return (_handler.Client(ID));
+            return (Handler(ID).Client(ID));
         }
         inline void Suspend(const uint32_t ID)
         {
-            return (_handler.Suspend(ID));
+            return (Handler(ID).Suspend(ID));
         }
         inline void LocalNode(const Core::NodeId& localNode)
         {
-            _handler.LocalNode(localNode);
+            for (SocketHandler<CLIENT>* handler : _handlers) {
+                handler->LocalNode(localNode);
+            }
         }
         template <typename PACKAGE>
         inline uint32_t Submit(const uint32_t ID, PACKAGE package)
         {
-            return (_handler.Submit(ID, package));
+            return (Handler(ID).Submit(ID, package));
         }
         inline Iterator Clients() const
         {
-            return (_handler.Clients());
+            std::list<ProxyType<CLIENT>> clients;
+
+            for (const SocketHandler<CLIENT>* handler : _handlers) {
+                handler->Clients(clients);
+            }
+
+            return (Iterator(clients));
         }
         inline uint32_t Count() const
         {
-            return (_handler.Count());
+            uint32_t result = 0;
+
+            for (const SocketHandler<CLIENT>* handler : _handlers) {
+                result += handler->Count();
+            }
+
+            return (result);
         }
         void Lock()
         {
-            _handler.Lock();
+            for (SocketHandler<CLIENT>* handler : _handlers) {
+                handler->Lock();
+            }
         }
         void Unlock()
         {
-            _handler.Unlock();
+            for (typename std::vector<SocketHandler<CLIENT>*>::reverse_iterator index = _handlers.rbegin(); index != _handlers.rend(); index++) {
+                (*index)->Unlock();
+            }
+        }
+
+    private:
+        inline SocketHandler<CLIENT>& Handler(const uint32_t ID)
+        {
+            // The ids of an acceptor start at its (1 based) position and step by the number of acceptors.
+            return (*(_handlers[(ID - 1) % _handlers.size()]));
         }
 
     private:
-        SocketHandler<CLIENT> _handler;
+        std::vector<ResourceMonitorBase*> _monitors;
+        std::vector<SocketHandler<CLIENT>*> _handlers;
     };
 }
 } // namespace Core
@@ -55,7 +55,9 @@
 #include "ISO639.h"
 #include "IPFrame.h"
 #include "JSON.h"
+#include "JSONReader.h"
 #include "JSONRPC.h"
+#include "JSONRPCPayload.h"
 #include "KeyValue.h"
 #include "Library.h"
 #include "Link.h"
@@ -44,6 +44,147 @@ namespace {
 }
 #endif
 
+namespace {
+
+    // All secure sockets share one client context, setting one up is far more work than the connection
+    // itself. The sessions the servers hand out are kept per remote end, the next connection to it offers
+    // the session and gets the abbreviated handshake: no certificate and no full key exchange.
+    class Context {
+    private:
+        static constexpr uint8_t MAX_SESSIONS = 64;
+
+    public:
+        Context(const Context&) = delete;
+        Context& operator=(const Context&) = delete;
+
+        ~Context()
+        {
+            for (std::pair<const string, SSL_SESSION*>& entry : _sessions) {
+                SSL_SESSION_free(entry.second);
+            }
+            if (_context != nullptr) {
+                SSL_CTX_free(_context);
+            }
+        }
+
+        static Context& Instance()
+        {
+            static Context singleton;
+
+            return (singleton);
+        }
+
+    public:
+        inline SSL_CTX* Handle() const
+        {
+            return (_context);
+        }
+        // Returns a reference the caller has to free, or nullptr if there is no session to resume.
+        SSL_SESSION* Session(const string& remote)
+        {
+            SSL_SESSION* result = nullptr;
+
+            _lock.Lock();
+
+            std::map<string, SSL_SESSION*>::iterator index(_sessions.find(remote));
+
+            if (index != _sessions.end()) {
+                result = index->second;
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+                SSL_SESSION_up_ref(result);
+#else
+                CRYPTO_add(&result->references, 1, CRYPTO_LOCK_SSL_SESSION);
+#endif
+            }
+
+            _lock.Unlock();
+
+            return (result);
+        }
+        // Takes over the reference of the session.
+        void Session(const string& remote, SSL_SESSION* session)
+        {
+            _lock.Lock();
+
+            std::map<string, SSL_SESSION*>::iterator index(_sessions.find(remote));
+
+            if (index != _sessions.end()) {
+                SSL_SESSION_free(index->second);
+                index->second = session;
+            } else {
+                if (_sessions.size() >= MAX_SESSIONS) {
+                    // Make room, the remote end that was added first goes.
+                    index = _sessions.find(_order.front());
+                    SSL_SESSION_free(index->second);
+                    _sessions.erase(index);
+                    _order.pop_front();
+                }
+                _sessions.emplace(remote, session);
+                _order.push_back(remote);
+            }
+
+            _lock.Unlock();
+        }
+        void Forget(const string& remote)
+        {
+            _lock.Lock();
+
+            std::map<string, SSL_SESSION*>::iterator index(_sessions.find(remote));
+
+            if (index != _sessions.end()) {
+                SSL_SESSION_free(index->second);
+                _sessions.erase(index);
+                _order.remove(remote);
+            }
+
+            _lock.Unlock();
+        }
+
+    private:
+        Context()
+            : _lock()
+            , _context(nullptr)
+            , _sessions()
+            , _order()
+        {
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+            _context = SSL_CTX_new(TLS_client_method());
+#else
+            _context = SSL_CTX_new(SSLv23_client_method());
+#endif
+
+            if (_context != nullptr) {
+                // The sessions are kept here, per remote end, OpenSSL only has to report them.
+                SSL_CTX_set_session_cache_mode(_context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+                SSL_CTX_sess_set_new_cb(_context, NewSession);
+
+#ifdef SSL_OP_ENABLE_KTLS
+                // Where the kernel (and OpenSSL) can, the records are encrypted by the kernel.
+                SSL_CTX_set_options(_context, SSL_OP_ENABLE_KTLS);
+#endif
+            }
+        }
+
+        static int NewSession(SSL* ssl, SSL_SESSION* session)
+        {
+            const WPEFramework::Core::SocketPort* port = static_cast<const WPEFramework::Core::SocketPort*>(SSL_get_app_data(ssl));
+
+            ASSERT(port != nullptr);
+
+            Instance().Session(port->RemoteId(), session);
+
+            // We hold on to the reference.
+            return (1);
+        }
+
+    private:
+        WPEFramework::Core::CriticalSection _lock;
+        SSL_CTX* _context;
+        std::map<string, SSL_SESSION*> _sessions;
+        std::list<string> _order;
+    };
+}
+
 namespace WPEFramework {
 
 namespace Crypto {
@@ -52,34 +193,69 @@ SecureSocketPort::Handler::~Handler() {
     if(_ssl != nullptr) {
         SSL_free(static_cast<SSL*>(_ssl));
     }
-    if(_context != nullptr) {
-        SSL_CTX_free(static_cast<SSL_CTX*>(_context));
-    }
 }
 
 uint32_t SecureSocketPort::Handler::Initialize() {
-    // _context = SSL_CTX_new(TLS_method());
-    _context = SSL_CTX_new(SSLv23_method());
-    
-    _ssl = SSL_new(static_cast<SSL_CTX*>(_context));
+    if (_ssl != nullptr) {
+        SSL_free(static_cast<SSL*>(_ssl));
+    }
+
+    _handShaking = IDLE;
+    _ssl = SSL_new(Context::Instance().Handle());
     SSL_set_fd(static_cast<SSL*>(_ssl), static_cast<Core::IResource&>(*this).Descriptor());
 
+    // Lets the context file the sessions it is handed under our remote end.
+    SSL_set_app_data(static_cast<SSL*>(_ssl), static_cast<Core::SocketPort*>(this));
+
+    SSL_SESSION* session = Context::Instance().Session(RemoteId());
+
+    if (session != nullptr) {
+        SSL_set_session(static_cast<SSL*>(_ssl), session);
+        SSL_SESSION_free(session);
+    }
+
     return (Core::SocketPort::Initialize());
 }
 
-int32_t SecureSocketPort::Handler::Read(uint8_t buffer[], const uint16_t length) const {
+int32_t SecureSocketPort::Handler::Read(uint8_t buffer[], const uint32_t length) const {
     int32_t result = SSL_read(static_cast<SSL*>(_ssl), buffer, length);
 
     if (_handShaking != CONNECTED) {
+        // The caller looks at the error of the read, not at what the handshake left behind.
+        const int error = errno;
+
         const_cast<Handler&>(*this).Update();
+
+        errno = error;
     }
     return (result);
 }
 
-int32_t SecureSocketPort::Handler::Write(const uint8_t buffer[], const uint16_t length) {
+int32_t SecureSocketPort::Handler::Write(const uint8_t buffer[], const uint32_t length) {
     return (SSL_write(static_cast<SSL*>(_ssl), buffer, length));
 }
 
+bool SecureSocketPort::Handler::SendFile(const Core::File::Handle file, const uint64_t offset, const uint32_t length) {
+    bool result = false;
+
+#ifdef BIO_get_ktls_send
+    // The kernel encrypts whatever is sent on the socket, the file can go straight from the file.
+    if ((_handShaking == CONNECTED) && (BIO_get_ktls_send(SSL_get_wbio(static_cast<SSL*>(_ssl))) != 0)) {
+        result = Core::SocketPort::SendFile(file, offset, length);
+    }
+#else
+    DEBUG_VARIABLE(file);
+    DEBUG_VARIABLE(offset);
+    DEBUG_VARIABLE(length);
+#endif
+
+    return (result);
+}
+
+bool SecureSocketPort::Handler::Resumed() const {
+    return ((_ssl != nullptr) && (SSL_session_reused(static_cast<SSL*>(_ssl)) == 1));
+}
+
 void SecureSocketPort::Handler::Update() {
     if (IsOpen() == true) {
         int result;
@@ -87,28 +263,48 @@ void SecureSocketPort::Handler::Update() {
         if (_handShaking == IDLE) {
             result = SSL_connect(static_cast<SSL*>(_ssl));
             if (result == 1) {
-                _handShaking = CONNECTED;
-                _parent.StateChange();
+                Connected();
             }
             else {
                 result = SSL_get_error(static_cast<SSL*>(_ssl), result);
                 if ((result == SSL_ERROR_WANT_READ) || (result == SSL_ERROR_WANT_WRITE)) {
                     _handShaking = EXCHANGE;
                 }
+                else {
+                    // Whatever the session was, it did not help, the next attempt starts from scratch.
+                    Context::Instance().Forget(RemoteId());
+                }
             }
         }
         else if (_handShaking == EXCHANGE) {
-            if (SSL_do_handshake(static_cast<SSL*>(_ssl)) == 1) {
-                _handShaking = CONNECTED;
-                _parent.StateChange();
+            result = SSL_do_handshake(static_cast<SSL*>(_ssl));
+            if (result == 1) {
+                Connected();
+            }
+            else {
+                result = SSL_get_error(static_cast<SSL*>(_ssl), result);
+                if ((result != SSL_ERROR_WANT_READ) && (result != SSL_ERROR_WANT_WRITE)) {
+                    Context::Instance().Forget(RemoteId());
+                }
             }
         }
     }
     else if (_ssl != nullptr) {
         _handShaking = IDLE;
+        // The socket is shut down by now, the close notification can not go out anymore (and writing it
+        // would raise a SIGPIPE), only the administration of the SSL connection is closed.
+        SSL_set_quiet_shutdown(static_cast<SSL*>(_ssl), 1);
         SSL_shutdown(static_cast<SSL*>(_ssl));
         _parent.StateChange();
     }
 }
 
+void SecureSocketPort::Handler::Connected() {
+    _handShaking = CONNECTED;
+    _parent.StateChange();
+
+    // Nothing was taken from the parent during the handshake, whatever it has waiting can go now.
+    Trigger();
+}
+
 } } // namespace WPEFramework::Crypto
@@ -42,7 +42,6 @@ namespace Crypto {
             Handler(SecureSocketPort& parent, Args&&... args)
                 : Core::SocketPort(args...) 
                 , _parent(parent)
-                , _context(nullptr)
                 , _ssl(nullptr)
                 , _handShaking(IDLE) {
             }
@@ -51,31 +50,39 @@ namespace Crypto {
         public:
             uint32_t Initialize() override;
 
-            int32_t Read(uint8_t buffer[], const uint16_t length) const override;
-            int32_t Write(const uint8_t buffer[], const uint16_t length) override;
+            int32_t Read(uint8_t buffer[], const uint32_t length) const override;
+            int32_t Write(const uint8_t buffer[], const uint32_t length) override;
 
-            // Methods to extract and insert data into the socket buffers
+            // Methods to extract and insert data into the socket buffers. Till the handshake is done, anything
+            // written would only poll the socket for room to write, while the handshake waits for a read.
             uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override {
-                return (_parent.SendData(dataFrame, maxSendSize));
+                return (_handShaking == CONNECTED ? _parent.SendData(dataFrame, maxSendSize) : 0);
             }
 
             uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
 
+            // All data has to pass the encryption, only if the kernel does the encryption (kTLS) a file can go
+            // straight from the file.
+            bool SendFile(const Core::File::Handle file, const uint64_t offset, const uint32_t length) override;
+
+            // Whether the handshake resumed an earlier session with the remote end.
+            bool Resumed() const;
+
             // Signal a state change, Opened, Closed or Accepted
             void StateChange() override {
 
-                ASSERT (_context != nullptr);
+                ASSERT (_ssl != nullptr);
                 Update();
             }
 
         private:
             void Update();
+            void Connected();
  
         private:
             SecureSocketPort& _parent;
-            void* _context;
             void* _ssl;
             mutable state _handShaking;
         };
@@ -112,6 +119,10 @@ namespace Crypto {
         {
             return (_handler.RemoteId());
         }
+        inline bool Resumed() const
+        {
+            return (_handler.Resumed());
+        }
 
         inline uint32_t Open(const uint32_t waitTime) {
             return(_handler.Open(waitTime));
@@ -0,0 +1,241 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+namespace WPEFramework {
+namespace PluginHost {
+
+    // Decides, before it is handed to the worker pool, whether a request of a client is taken on. A refused
+    // request is answered right away instead of waiting in a queue. The limits are checked without a common
+    // lock, the pending budget can be overrun by one request per thread that admits.
+    // A CLIENT offers InFlight(), Origin(), Admitted() and Completed(), it counts its own requests in flight.
+    class Admission {
+    public:
+        struct Limits {
+            // Requests of one client in progress, 0 is unlimited.
+            uint16_t InFlight;
+            // Requests of all clients in progress, 0 is unlimited.
+            uint32_t Pending;
+            // Requests per second of one remote address, 0 is unlimited.
+            uint32_t Rate;
+            // Requests a remote address can do at once, after it was quiet for a while.
+            uint32_t Burst;
+        };
+
+        // Token bucket of a remote address, it holds up to burst requests and refills at rate per second.
+        // The level is kept in millionths of a request, a microsecond adds rate of those.
+        class Bucket {
+        private:
+            static constexpr uint64_t Request = 1000000;
+
+        public:
+            Bucket()
+                : _level(0)
+                , _last(0)
+            {
+            }
+            ~Bucket() = default;
+
+        public:
+            bool Take(const uint32_t rate, const uint32_t burst, const uint64_t now)
+            {
+                bool result = false;
+
+                _level = Level(rate, burst, now);
+                _last = now;
+
+                if (_level >= Request) {
+                    _level -= Request;
+                    result = true;
+                }
+
+                return (result);
+            }
+            bool IsFull(const uint32_t rate, const uint32_t burst, const uint64_t now) const
+            {
+                return (Level(rate, burst, now) == (burst * Request));
+            }
+
+        private:
+            uint64_t Level(const uint32_t rate, const uint32_t burst, const uint64_t now) const
+            {
+                const uint64_t full = burst * Request;
+                const uint64_t elapsed = now - _last;
+
+                // A new address starts with a full bucket.
+                return ((_last == 0) || (elapsed >= (full / rate)) ? full : std::min(full, _level + (elapsed * rate)));
+            }
+
+        private:
+            uint64_t _level;
+            uint64_t _last;
+        };
+
+    public:
+        Admission(const Admission&) = delete;
+        Admission& operator=(const Admission&) = delete;
+
+        Admission()
+            : _bucketLock()
+            , _buckets()
+            , _pending(0)
+            , _shedRate(0)
+            , _shedInFlight(0)
+            , _shedPending(0)
+        {
+        }
+        ~Admission() = default;
+
+    public:
+        // How a refused request is answered, over HTTP.
+        static void Refused(Web::Response& response)
+        {
+            response.ErrorCode = Web::STATUS_SERVICE_UNAVAILABLE;
+            response.Message = _T("Too many requests, try again later.");
+        }
+        // Marks a JSONRPC message as refused, for a request in a batch that is its answer.
+        static void Refused(Core::JSONRPC::Message& message)
+        {
+            message.Error.SetError(Core::ERROR_UNAVAILABLE);
+            message.Error.Text = _T("Too many requests, try again later.");
+        }
+        // Notifications are not answered, a refused batch gets a single answer, it has no id. Returns
+        // false if there is nothing to answer.
+        static bool Refused(const Core::JSONRPC::Message& request, Core::JSONRPC::Message& response)
+        {
+            const bool result = ((request.IsBatch() == true) || (request.Id.IsSet() == true));
+
+            if (result == true) {
+                if (request.IsBatch() == false) {
+                    response.Id = request.Id;
+                }
+                Refused(response);
+            }
+
+            return (result);
+        }
+
+        inline uint32_t Pending() const
+        {
+            return (_pending);
+        }
+        inline uint32_t ShedRate() const
+        {
+            return (_shedRate);
+        }
+        inline uint32_t ShedInFlight() const
+        {
+            return (_shedInFlight);
+        }
+        inline uint32_t ShedPending() const
+        {
+            return (_shedPending);
+        }
+
+        // The limits are checked in order of cost, a refused request does not take from the bucket.
+        template <typename CLIENT>
+        bool Admit(const Limits& limits, CLIENT& client, const uint64_t now)
+        {
+            bool result = false;
+
+            if ((limits.InFlight != 0) && (client.InFlight() >= limits.InFlight)) {
+                _shedInFlight++;
+            } else if ((limits.Pending != 0) && (_pending >= limits.Pending)) {
+                _shedPending++;
+            } else if ((limits.Rate != 0) && (Take(client.Origin(), limits.Rate, limits.Burst, now) == false)) {
+                _shedRate++;
+            } else {
+                _pending++;
+
+                if (limits.InFlight != 0) {
+                    client.Admitted();
+                }
+
+                result = true;
+            }
+
+            return (result);
+        }
+        // An admitted request is handled, the client might be gone already (nullptr).
+        template <typename CLIENT>
+        void Completed(const Limits& limits, CLIENT* client)
+        {
+            ASSERT(_pending > 0);
+
+            _pending--;
+
+            if ((limits.InFlight != 0) && (client != nullptr)) {
+                client->Completed();
+            }
+        }
+        // An address that is back at a full bucket is as good as new, no need to remember it.
+        void Prune(const Limits& limits, const uint64_t now)
+        {
+            if (limits.Rate != 0) {
+                _bucketLock.Lock();
+
+                std::map<string, Bucket>::iterator index(_buckets.begin());
+
+                while (index != _buckets.end()) {
+                    if (index->second.IsFull(limits.Rate, limits.Burst, now) == true) {
+                        index = _buckets.erase(index);
+                    } else {
+                        index++;
+                    }
+                }
+
+                _bucketLock.Unlock();
+            }
+        }
+        uint32_t Origins() const
+        {
+            _bucketLock.Lock();
+
+            uint32_t result = static_cast<uint32_t>(_buckets.size());
+
+            _bucketLock.Unlock();
+
+            return (result);
+        }
+
+    private:
+        bool Take(const string& origin, const uint32_t rate, const uint32_t burst, const uint64_t now)
+        {
+            _bucketLock.Lock();
+
+            bool result = _buckets[origin].Take(rate, burst, now);
+
+            _bucketLock.Unlock();
+
+            return (result);
+        }
+
+    private:
+        mutable Core::CriticalSection _bucketLock;
+        std::map<string, Bucket> _buckets;
+        std::atomic<uint32_t> _pending;
+        std::atomic<uint32_t> _shedRate;
+        std::atomic<uint32_t> _shedInFlight;
+        std::atomic<uint32_t> _shedPending;
+    };
+}
+}
@@ -38,11 +38,13 @@ namespace PluginHost {
 
             explicit Package(const Core::ProxyType<Core::JSON::IElement>& json)
                 : _json(true)
+                , _notification(dynamic_cast<const Core::JSONRPC::Notification*>(&(*json)))
                 , _info(json)
             {
             }
             explicit Package(const string& text) 
                 : _json(false)
+                , _notification(nullptr)
                 , _info(text)
             {
             }
@@ -64,9 +66,21 @@ namespace PluginHost {
             {
                 return (_info.json);
             }
+            const Core::JSONRPC::Notification* Notification() const
+            {
+                return (_notification);
+            }
+            void Replace(const Core::ProxyType<Core::JSON::IElement>& json)
+            {
+                ASSERT(_json == true);
+
+                _info.json = json;
+                _notification = dynamic_cast<const Core::JSONRPC::Notification*>(&(*json));
+            }
 
         private:
             bool _json;
+            const Core::JSONRPC::Notification* _notification;
             union Info {
                 Info(const Core::ProxyType<Core::JSON::IElement>& value)
                     : json(value)
@@ -82,6 +96,63 @@ namespace PluginHost {
                 string text;
             } _info;
         };
+        class Trailer {
+        public:
+            Trailer() = delete;
+            Trailer(const Trailer&) = delete;
+            Trailer& operator=(const Trailer&) = delete;
+
+            Trailer(Channel& parent)
+                : _parent(parent)
+            {
+            }
+            ~Trailer()
+            {
+            }
+
+        public:
+            void Dispatch()
+            {
+                _parent.ReleaseHeld();
+            }
+
+        private:
+            Channel& _parent;
+        };
+        // The workerpool might be gone before the channel is, it is only revoked while it is still there.
+        class TrailerJob : public Core::ThreadPool::JobType<Trailer> {
+        public:
+            TrailerJob() = delete;
+            TrailerJob(const TrailerJob&) = delete;
+            TrailerJob& operator=(const TrailerJob&) = delete;
+
+            TrailerJob(Channel& parent)
+                : Core::ThreadPool::JobType<Trailer>(parent)
+            {
+            }
+            ~TrailerJob()
+            {
+                Core::ProxyType<Core::IDispatch> job(Reset());
+
+                if (Core::IWorkerPool::IsAvailable() == true) {
+                    Core::IWorkerPool::Instance().Revoke(job);
+                }
+            }
+
+        public:
+            void Schedule(const uint64_t time)
+            {
+                Core::ProxyType<Core::IDispatch> job(Aquire());
+
+                if (job.IsValid() == true) {
+                    Core::IWorkerPool::Instance().Schedule(Core::Time(time), job);
+                } else if (Core::IWorkerPool::Instance().Reschedule(Core::Time(time), Forced()) == false) {
+                    // Not waiting in the timer, but about to run. Running once more does no harm, never
+                    // running again would hold the notifications forever.
+                    Core::IWorkerPool::Instance().Schedule(Core::Time(time), Forced());
+                }
+            }
+        };
         class EXTERNAL SerializerImpl {
         public:
             SerializerImpl() = delete;
@@ -91,6 +162,7 @@ namespace PluginHost {
             SerializerImpl(Channel& parent)
                 : _parent(parent)
                 , _current()
+                , _pack(nullptr)
                 , _offset(0)
             {
             }
@@ -108,18 +180,29 @@ namespace PluginHost {
 
                 if (_current.IsValid() == false) {
                     _current = Core::ProxyType<const Core::JSON::IElement>(_parent.Element());
+                    _pack = (_current.IsValid() == true ? dynamic_cast<const Core::JSON::IMessagePack*>(&(*_current)) : nullptr);
                 }
 
                 if (_current.IsValid() == true) {
-                    loaded = _current->Serialize(stream, length, _offset);
+                    if (_parent.IsMessagePack() == false) {
+                        loaded = _current->Serialize(stream, length, _offset);
+                    } else if (_pack != nullptr) {
+                        loaded = _pack->Serialize(reinterpret_cast<uint8_t*>(stream), length, _offset);
+                    } else {
+                        // This element can not be send as MessagePack, drop it.
+                        ASSERT(_pack != nullptr);
+                        _offset = 0;
+                    }
                     if ( (_offset == 0) || (loaded != length) ) {
                         _current.Release();
                     }
 #if THUNDER_PERFORMANCE
                     else {
 			Core::ProxyType<const TrackingJSONRPC> tracking(Core::proxy_cast<const TrackingJSONRPC>(_current));
-                        ASSERT (tracking.IsValid() == true);
-                        const_cast<TrackingJSONRPC&>(*tracking).Out(loaded);
+                        // Notifications are fanned out without a tracking message.
+                        if (tracking.IsValid() == true) {
+                            const_cast<TrackingJSONRPC&>(*tracking).Out(loaded);
+                        }
                     }
 #endif
                 }
@@ -130,6 +213,7 @@ namespace PluginHost {
         private:
             Channel& _parent;
             mutable Core::ProxyType<const Core::JSON::IElement> _current;
+            mutable const Core::JSON::IMessagePack* _pack;
             mutable uint32_t _offset;
         };
         class EXTERNAL DeserializerImpl {
@@ -141,6 +225,7 @@ namespace PluginHost {
             DeserializerImpl(Channel& parent)
                 : _parent(parent)
                 , _current()
+                , _pack(nullptr)
                 , _offset(0)
             {
             }
@@ -160,11 +245,21 @@ namespace PluginHost {
                 if (_current.IsValid() == false) {
                     if (_parent.IsOpen() == true) {
                         _current = _parent.Element(EMPTY_STRING);
+                        _pack = (_current.IsValid() == true ? dynamic_cast<Core::JSON::IMessagePack*>(&(*_current)) : nullptr);
                         _offset = 0;
                     }
                 } 
                 if (_current.IsValid() == true) {
-                    loaded = _current->Deserialize(stream, length, _offset);
+                    if (_parent.IsMessagePack() == false) {
+                        loaded = _current->Deserialize(stream, length, _offset);
+                    } else if (_pack != nullptr) {
+                        loaded = _pack->Deserialize(reinterpret_cast<const uint8_t*>(stream), length, _offset);
+                    } else {
+                        // There is no way to unpack this, just swallow it.
+                        ASSERT(_pack != nullptr);
+                        loaded = length;
+                        _offset = 0;
+                    }
 #if THUNDER_PERFORMANCE
 		    Core::ProxyType<TrackingJSONRPC> tracking (Core::proxy_cast<TrackingJSONRPC>(_current));
                     ASSERT (tracking.IsValid() == true);
@@ -187,6 +282,7 @@ namespace PluginHost {
         private:
             Channel& _parent;
             Core::ProxyType<Core::JSON::IElement> _current;
+            Core::JSON::IMessagePack* _pack;
             uint32_t _offset;
         };
 
@@ -198,10 +294,204 @@ namespace PluginHost {
             RAW = 0x08,
             TEXT = 0x10,
             JSONRPC = 0x20,
+            MESSAGEPACK = 0x2000,
             PINGED = 0x4000,
             NOTIFIED = 0x8000
         };
 
+        // Pending messages at which reading from the client stops, and at which it is resumed.
+        static constexpr uint16_t HighWatermark = 64;
+        static constexpr uint16_t LowWatermark = 16;
+
+        // The messages waiting to be send. Notifications that were subscribed with a delivery policy are
+        // coalesced, limited in depth or rate limited on the way in. The front of the queue might be in the
+        // process of being send, so it is left alone. Not thread safe, the channel holds its lock.
+        class EXTERNAL SendQueue {
+        private:
+            struct Throttle {
+                uint64_t Next;
+                Core::ProxyType<Core::JSON::IElement> Held;
+            };
+
+        public:
+            SendQueue(const SendQueue&) = delete;
+            SendQueue& operator=(const SendQueue&) = delete;
+
+            SendQueue()
+                : _queue()
+                , _throttle()
+                , _dropped(0)
+                , _coalesced(0)
+            {
+            }
+            ~SendQueue()
+            {
+            }
+
+        public:
+            inline uint32_t Size() const
+            {
+                return (static_cast<uint32_t>(_queue.size()));
+            }
+            inline Package& Front()
+            {
+                return (_queue.front());
+            }
+            inline void Pop()
+            {
+                _queue.pop_front();
+            }
+            inline uint32_t Dropped() const
+            {
+                return (_dropped);
+            }
+            inline uint32_t Coalesced() const
+            {
+                return (_coalesced);
+            }
+            inline void Push(const string& text)
+            {
+                _queue.emplace_back(text);
+            }
+            // Returns true if the entry was appended. Within the rate interval of its method, a notification
+            // is held instead, a newer one takes its place, till ReleaseHeld() sends the latest (trailing edge).
+            bool Push(const Core::ProxyType<Core::JSON::IElement>& entry, const uint64_t now)
+            {
+                const Core::JSONRPC::Notification* notification = dynamic_cast<const Core::JSONRPC::Notification*>(&(*entry));
+                bool result = true;
+
+                if ((notification == nullptr) || (notification->Policy().IsSet() == false)) {
+                    _queue.emplace_back(entry);
+                } else {
+                    const Core::JSONRPC::Policy& policy(notification->Policy());
+
+                    if (policy.Interval != 0) {
+                        Throttle& throttle(_throttle[notification->Method()]);
+
+                        if (throttle.Held.IsValid() == true) {
+                            // Whatever is held is outdated by now.
+                            throttle.Held.Release();
+                            _coalesced++;
+                        }
+
+                        if (now < throttle.Next) {
+                            throttle.Held = entry;
+                            result = false;
+                        } else {
+                            throttle.Next = now + (static_cast<uint64_t>(policy.Interval) * Core::Time::TicksPerMillisecond);
+                        }
+                    }
+
+                    if (result == true) {
+                        result = Append(*notification, entry);
+                    }
+                }
+
+                return (result);
+            }
+            // Appends the held notifications of which the interval expired. Returns the time the next held
+            // one expires, 0 if nothing is held anymore.
+            uint64_t ReleaseHeld(const uint64_t now)
+            {
+                uint64_t result = 0;
+                std::map<string, Throttle>::iterator index(_throttle.begin());
+
+                while (index != _throttle.end()) {
+                    if (index->second.Held.IsValid() == false) {
+                        if (index->second.Next <= now) {
+                            // Nothing held, nothing to wait for, a next one can go straight out.
+                            index = _throttle.erase(index);
+                        } else {
+                            index++;
+                        }
+                    } else if (index->second.Next <= now) {
+                        Core::ProxyType<Core::JSON::IElement> entry(index->second.Held);
+                        const Core::JSONRPC::Notification& notification(*dynamic_cast<const Core::JSONRPC::Notification*>(&(*entry)));
+
+                        index->second.Held.Release();
+                        index->second.Next = now + (static_cast<uint64_t>(notification.Policy().Interval) * Core::Time::TicksPerMillisecond);
+
+                        Append(notification, entry);
+                        index++;
+                    } else {
+                        if ((result == 0) || (index->second.Next < result)) {
+                            result = index->second.Next;
+                        }
+                        index++;
+                    }
+                }
+
+                return (result);
+            }
+            // The time the first held notification is due, 0 if nothing is held.
+            uint64_t Due() const
+            {
+                uint64_t result = 0;
+
+                for (const std::pair<const string, Throttle>& entry : _throttle) {
+                    if ((entry.second.Held.IsValid() == true) && ((result == 0) || (entry.second.Next < result))) {
+                        result = entry.second.Next;
+                    }
+                }
+
+                return (result);
+            }
+
+        private:
+            // Returns true if the notification was appended, false if it took the place of one still waiting.
+            bool Append(const Core::JSONRPC::Notification& notification, const Core::ProxyType<Core::JSON::IElement>& entry)
+            {
+                const Core::JSONRPC::Policy& policy(notification.Policy());
+                bool result = true;
+
+                if ((policy.Coalesce == true) && (_queue.size() > 1)) {
+                    std::list<Package>::iterator index(std::next(_queue.begin()));
+
+                    while ((index != _queue.end()) && ((index->Notification() == nullptr) || (index->Notification()->Method() != notification.Method()))) {
+                        index++;
+                    }
+
+                    if (index != _queue.end()) {
+                        // The newer value takes the place of the one that is still waiting.
+                        index->Replace(entry);
+                        _coalesced++;
+                        result = false;
+                    }
+                }
+
+                if (result == true) {
+                    if ((policy.Depth != 0) && (_queue.size() > 1)) {
+                        std::list<Package>::iterator oldest(_queue.end());
+                        uint32_t count = 1;
+
+                        for (std::list<Package>::iterator index(std::next(_queue.begin())); index != _queue.end(); index++) {
+                            if ((index->Notification() != nullptr) && (index->Notification()->Method() == notification.Method())) {
+                                if (oldest == _queue.end()) {
+                                    oldest = index;
+                                }
+                                count++;
+                            }
+                        }
+
+                        if (count > policy.Depth) {
+                            _queue.erase(oldest);
+                            _dropped++;
+                        }
+                    }
+
+                    _queue.emplace_back(entry);
+                }
+
+                return (result);
+            }
+
+        private:
+            std::list<Package> _queue;
+            std::map<string, Throttle> _throttle;
+            uint32_t _dropped;
+            uint32_t _coalesced;
+        };
+
     public:
         Channel() = delete;
         Channel(const Channel& copy) = delete;
@@ -252,40 +542,69 @@ namespace PluginHost {
         {
             return ((_state & NOTIFIED) != 0);
         }
+        inline bool IsMessagePack() const
+        {
+            return ((_state & MESSAGEPACK) != 0);
+        }
         inline void Submit(const string& text)
         {
             if (IsOpen() == true) {
 
                 _adminLock.Lock();
 
-                _sendQueue.emplace_back(text);
+                _sendQueue.Push(text);
 
-                bool trigger = (_sendQueue.size() == 1);
+                bool trigger = (_sendQueue.Size() == 1);
+                bool throttle = Watermark();
 
                 _adminLock.Unlock();
 
                 if (trigger == true) {
                     BaseClass::Trigger();
                 }
+                if (throttle == true) {
+                    Backpressure();
+                }
             }
         }
         inline void Submit(const Core::ProxyType<Core::JSON::IElement>& entry)
         {
             if (IsOpen() == true) {
 
-                _adminLock.Lock();
+                bool trigger = false;
+                bool throttle = false;
+                uint64_t release = 0;
 
-                _sendQueue.emplace_back(entry);
+                _adminLock.Lock();
 
-                bool trigger = (_sendQueue.size() == 1);
+                if (_sendQueue.Push(entry, Core::Time::Now().Ticks()) == true) {
+                    trigger = (_sendQueue.Size() == 1);
+                    throttle = Watermark();
+                } else {
+                    release = Due();
+                }
 
                 _adminLock.Unlock();
 
                 if (trigger == true) {
                     BaseClass::Trigger();
                 }
+                if (throttle == true) {
+                    Backpressure();
+                }
+                if (release != 0) {
+                    _trailer.Schedule(release);
+                }
             }
         }
+        inline uint32_t Dropped() const
+        {
+            return (_sendQueue.Dropped());
+        }
+        inline uint32_t Coalesced() const
+        {
+            return (_sendQueue.Coalesced());
+        }
         inline void Submit(const Core::ProxyType<Web::Response>& entry)
         {
             BaseClass::Submit(entry);
@@ -312,16 +631,19 @@ namespace PluginHost {
         {
             _nameOffset = offset;
         }
-        inline void State(const ChannelState state, const bool notification)
+        inline void State(const ChannelState state, const bool notification, const bool messagePack = false)
         {
-            Binary(state == RAW);
-            _state = state | (notification ? NOTIFIED : 0x0000);
+            // MessagePack is only supported on the channels that exchange JSON structs.
+            ASSERT((messagePack == false) || (state == JSON) || (state == JSONRPC));
+
+            Binary((state == RAW) || (messagePack == true));
+            _state = state | (notification ? NOTIFIED : 0x0000) | (messagePack ? MESSAGEPACK : 0x0000);
         }
         inline uint16_t Serialize(uint8_t* dataFrame, const uint16_t maxSendSize)
         {
             uint16_t size = 0;
 
-            if (_sendQueue.size() != 0) {
+            if (_sendQueue.Size() != 0) {
 
                 switch (State()) {
                 case JSON:
@@ -333,13 +655,17 @@ namespace PluginHost {
 
                         // See if there is more to do..
                         _adminLock.Lock();
-                        _sendQueue.pop_front();
-                        bool trigger(_sendQueue.size() > 0);
+                        _sendQueue.Pop();
+                        bool trigger(_sendQueue.Size() > 0);
+                        bool resume = Watermark();
                         _adminLock.Unlock();
 
                         if (trigger == true) {
                             BaseClass::Trigger();
                         }
+                        if (resume == true) {
+                            Backpressure();
+                        }
                     } else {
                         ASSERT(size != 0);
                     }
@@ -349,7 +675,7 @@ namespace PluginHost {
                 case TEXT: {
                     // Seems we need to send plain strings...
                     _adminLock.Lock();
-                    Package& data(_sendQueue.front());
+                    Package& data(_sendQueue.Front());
                     uint16_t neededBytes(static_cast<uint16_t>(data.Text().length() - _offset));
 
                     if (neededBytes <= maxSendSize) {
@@ -358,15 +684,20 @@ namespace PluginHost {
                         _offset = 0;
 
                         // See if there is more to do..
-                        _sendQueue.pop_front();
+                        _sendQueue.Pop();
                     } else {
                         uint16_t addedBytes = maxSendSize - size;
                         ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), addedBytes);
                         _offset += addedBytes;
                         size = addedBytes;
                     }
+                    bool resume = Watermark();
                     _adminLock.Unlock();
 
+                    if (resume == true) {
+                        Backpressure();
+                    }
+
                     ASSERT(size != 0);
 
                     break;
@@ -423,6 +754,90 @@ namespace PluginHost {
         }
 
     private:
+        // A client that does not read what it gets, should not be able to queue up more work. Once
+        // the queue reaches the high watermark, nothing is read from it until it drained to the low one.
+        // Returns true if the reading side has to follow, call with the _adminLock taken.
+        bool Watermark()
+        {
+            bool result = false;
+
+            if ((_throttled == false) && (_sendQueue.Size() >= HighWatermark)) {
+                _throttled = true;
+                result = true;
+            } else if ((_throttled == true) && (_sendQueue.Size() <= LowWatermark)) {
+                _throttled = false;
+                result = true;
+            }
+
+            return (result);
+        }
+        // The socket locks are not to be taken with the _adminLock held, so the state might change in
+        // between. Whoever applied it last, checks that it still holds.
+        void Backpressure()
+        {
+            bool throttled;
+            bool applied;
+
+            do {
+                _adminLock.Lock();
+                throttled = _throttled;
+                _adminLock.Unlock();
+
+                BaseClass::Throttle(throttled);
+
+                _adminLock.Lock();
+                applied = (throttled == _throttled);
+                _adminLock.Unlock();
+
+            } while (applied == false);
+        }
+
+        // Returns the time to release the held notifications at, if that is before what is already
+        // planned. Call with the _adminLock taken.
+        uint64_t Due()
+        {
+            uint64_t result = _sendQueue.Due();
+
+            if ((result != 0) && ((_due == 0) || (result < _due))) {
+                _due = result;
+            } else {
+                result = 0;
+            }
+
+            return (result);
+        }
+        void ReleaseHeld()
+        {
+            bool trigger = false;
+            bool throttle = false;
+            uint64_t release = 0;
+
+            _adminLock.Lock();
+
+            if (IsOpen() == true) {
+                const uint32_t pending = _sendQueue.Size();
+
+                _due = 0;
+                _sendQueue.ReleaseHeld(Core::Time::Now().Ticks());
+
+                trigger = ((pending == 0) && (_sendQueue.Size() > 0));
+                throttle = Watermark();
+                release = Due();
+            }
+
+            _adminLock.Unlock();
+
+            if (trigger == true) {
+                BaseClass::Trigger();
+            }
+            if (throttle == true) {
+                Backpressure();
+            }
+            if (release != 0) {
+                _trailer.Schedule(release);
+            }
+        }
+
         // Handle the WebRequest coming in.
         virtual void LinkBody(Core::ProxyType<Request>& request) = 0;
         virtual void Received(Core::ProxyType<Request>& request) = 0;
@@ -455,8 +870,8 @@ namespace PluginHost {
 
             _adminLock.Lock();
 
-            if (_sendQueue.size() > 0) {
-                result = _sendQueue.front().JSON();
+            if (_sendQueue.Size() > 0) {
+                result = _sendQueue.Front().JSON();
 
             }
             _adminLock.Unlock();
@@ -473,7 +888,10 @@ namespace PluginHost {
         DeserializerImpl _deserializer;
         string _text;
         uint32_t _offset;
-        std::list<Package> _sendQueue;
+        SendQueue _sendQueue;
+        bool _throttled;
+        uint64_t _due;
+        TrailerJob _trailer;
 
         // All requests needed by any instance of this webserver are coming from this web server. They are extracted
         // from a pool. If the request is nolonger needed, the request returns to this pool.
@@ -23,16 +23,19 @@ namespace WPEFramework {
 
 namespace PluginHost {
 
+    /* static */ Core::ProxyPoolType<Core::JSONRPC::Notification> JSONRPC::_notificationFactory(4);
+
     JSONRPC::JSONRPC()
         : _adminLock()
         , _handlers()
         , _service(nullptr)
         , _callsign()
         , _validate()
+        , _routes()
     {
         std::vector<uint8_t> versions = { 1 };
 
-        _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+        _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::JSONRPC::Policy& policy, const Core::ProxyType<Core::JSONRPC::Notification::Body>& body) { Notify(id, designator, policy, body); }, versions);
     }
 
     JSONRPC::JSONRPC(const std::vector<uint8_t>& versions)
@@ -41,8 +44,9 @@ namespace PluginHost {
         , _service(nullptr)
         , _callsign()
         , _validate()
+        , _routes()
     {
-        _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+        _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::JSONRPC::Policy& policy, const Core::ProxyType<Core::JSONRPC::Notification::Body>& body) { Notify(id, designator, policy, body); }, versions);
     }
 
     JSONRPC::JSONRPC(const TokenCheckFunction& validation)
@@ -51,10 +55,11 @@ namespace PluginHost {
         , _service(nullptr)
         , _callsign()
         , _validate(validation)
+        , _routes()
     {
         std::vector<uint8_t> versions = { 1 };
 
-        _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+        _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::JSONRPC::Policy& policy, const Core::ProxyType<Core::JSONRPC::Notification::Body>& body) { Notify(id, designator, policy, body); }, versions);
     }
 
     JSONRPC::JSONRPC(const std::vector<uint8_t>& versions, const TokenCheckFunction& validation)
@@ -63,8 +68,9 @@ namespace PluginHost {
         , _service(nullptr)
         , _callsign()
         , _validate(validation)
+        , _routes()
     {
-        _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+        _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::JSONRPC::Policy& policy, const Core::ProxyType<Core::JSONRPC::Notification::Body>& body) { Notify(id, designator, policy, body); }, versions);
     }
 
     /* virtual */ JSONRPC::~JSONRPC()
@@ -39,6 +39,13 @@ namespace PluginHost {
         // There should be no need to call these methods from the implementation directly.
         virtual void Activate(IShell* service) = 0;
         virtual void Deactivate() = 0;
+
+        // Returns the response if it was kept in the response cache, no method is invoked to get it.
+        // Added last, with a default, so dispatchers built against the previous interface keep working.
+        virtual Core::ProxyType<Core::JSONRPC::Message> Cached(const string& /* token */, const uint32_t /* channelId */, const Core::JSONRPC::Message& /* message */)
+        {
+            return (Core::ProxyType<Core::JSONRPC::Message>());
+        }
     };
 
     class EXTERNAL JSONRPC : public IDispatcher {
@@ -55,17 +62,38 @@ namespace PluginHost {
                 : Core::JSON::Container()
                 , Event()
                 , Callsign()
+                , Coalesce(false)
+                , Rate(0)
+                , Depth(0)
             {
                 Add(_T("event"), &Event);
                 Add(_T("id"), &Callsign);
+                Add(_T("coalesce"), &Coalesce);
+                Add(_T("rate"), &Rate);
+                Add(_T("depth"), &Depth);
             }
             ~Registration()
             {
             }
 
+        public:
+            Core::JSONRPC::Policy Policy() const
+            {
+                Core::JSONRPC::Policy result;
+
+                result.Coalesce = Coalesce.Value();
+                result.Interval = (Rate.Value() != 0 ? ((1000 + Rate.Value() - 1) / Rate.Value()) : 0);
+                result.Depth = Depth.Value();
+
+                return (result);
+            }
+
         public:
             Core::JSON::String Event;
             Core::JSON::String Callsign;
+            Core::JSON::Boolean Coalesce;
+            Core::JSON::DecUInt16 Rate; // Maximum number of notifications per second
+            Core::JSON::DecUInt16 Depth;
         };
 
         enum state {
@@ -78,6 +106,18 @@ namespace PluginHost {
             STATE_CUSTOM
         };
 
+        struct Route {
+            Core::JSONRPC::Handler* Handler;
+            Core::JSONRPC::Handler::Entry* Entry;
+            state State;
+        };
+
+        // Immutable once published, keyed by the designator without index: "[callsign.][version.]method".
+        struct RouteTable {
+            uint32_t Generation;
+            std::unordered_map<string, Route> Routes;
+        };
+
     public:
         typedef std::function<bool(const string& token, const string& method, const string& parameters)> TokenCheckFunction;
 
@@ -119,12 +159,12 @@ namespace PluginHost {
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::JSONRPC::Policy& policy, const Core::ProxyType<Core::JSONRPC::Notification::Body>& body) { Notify(id, designator, policy, body); }, versions);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions, const Core::JSONRPC::Handler& source)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions, source);
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::JSONRPC::Policy& policy, const Core::ProxyType<Core::JSONRPC::Notification::Body>& body) { Notify(id, designator, policy, body); }, versions, source);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler* GetHandler(uint8_t version)
@@ -185,11 +225,52 @@ namespace PluginHost {
         { 
             _handlers.front().Register(methodName, lambda);
         } 
+        void Register(const string& methodName, const Core::JSONRPC::StreamFunction& lambda)
+        {
+            _handlers.front().Register(methodName, lambda);
+        }
+        template <typename PARAMETER, typename GET_METHOD, typename REALOBJECT>
+        void Stream(const string& methodName, GET_METHOD getter, REALOBJECT* objectPtr)
+        {
+            _handlers.front().Stream<PARAMETER>(methodName, getter, objectPtr);
+        }
         void Unregister(const string& methodName)
         {
             _handlers.front().Unregister(methodName);
         }
 
+        //
+        // Response cache for methods that answer the same, until the plugin invalidates it or sends the given event.
+        // ------------------------------------------------------------------------------------------------------------------------------
+        void Cache(const string& methodName, const string& event = EMPTY_STRING)
+        {
+            _handlers.front().Cache(methodName, event);
+        }
+        void Invalidate(const string& methodName)
+        {
+            _handlers.front().Invalidate(methodName);
+        }
+        uint32_t CacheHits() const
+        {
+            uint32_t result = 0;
+
+            for (const Core::JSONRPC::Handler& handler : _handlers) {
+                result += handler.Hits();
+            }
+
+            return (result);
+        }
+        uint32_t CacheMisses() const
+        {
+            uint32_t result = 0;
+
+            for (const Core::JSONRPC::Handler& handler : _handlers) {
+                result += handler.Misses();
+            }
+
+            return (result);
+        }
+
         //
         // Methods to send outbound event messages
         // ------------------------------------------------------------------------------------------------------------------------------
@@ -256,12 +337,23 @@ namespace PluginHost {
         {
             handler.Unsubscribe(channelId, eventName, callsign, response);
         }
+        // A subscription with a delivery policy. Without one it ends up in the Subscribe above, so overrides of
+        // that one keep being called. Declared after the existing ones, to keep their place in the vtable.
+        virtual void Subscribe(Core::JSONRPC::Handler& handler, const uint32_t channelId, const string& eventName, const string& callsign, const Core::JSONRPC::Policy& policy, Core::JSONRPC::Message& response)
+        {
+            if (policy.IsSet() == false) {
+                Subscribe(handler, channelId, eventName, callsign, response);
+            } else {
+                handler.Subscribe(channelId, eventName, callsign, policy, response);
+            }
+        }
         Core::ProxyType<Core::JSONRPC::Message> Invoke(const string& token, const uint32_t channelId, const Core::JSONRPC::Message& inbound) override
         {
             Registration info;
             Core::ProxyType<Core::JSONRPC::Message> response(Message());
             Core::JSONRPC::Handler* source = nullptr;
-            string method(inbound.Designator.Value());
+            Core::JSONRPC::Handler::Entry* entry = nullptr;
+            const string& method(inbound.Designator.Value());
 
             if (inbound.Id.IsSet() == true) {
                 response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
@@ -273,7 +365,7 @@ namespace PluginHost {
                 response->Error.Text = _T("method invokation not allowed.");
             } 
             else {
-                switch (Destination(method, source)) {
+                switch (Destination(method, source, entry)) {
                 case STATE_INCORRECT_HANDLER:
                     response->Error.SetError(Core::ERROR_INVALID_DESIGNATOR);
                     response->Error.Text = _T("Destined invoke failed.");
@@ -288,7 +380,7 @@ namespace PluginHost {
                     break;
                 case STATE_REGISTRATION:
                     info.FromString(inbound.Parameters.Value());
-                    Subscribe(*source, channelId, info.Event.Value(), info.Callsign.Value(), *response);
+                    Subscribe(*source, channelId, info.Event.Value(), info.Callsign.Value(), info.Policy(), *response);
                     break;
                 case STATE_UNREGISTRATION:
                     info.FromString(inbound.Parameters.Value());
@@ -303,12 +395,31 @@ namespace PluginHost {
                     break;
                 case STATE_CUSTOM:
                     string result;
-                    uint32_t code = source->Invoke(Core::JSONRPC::Connection(channelId, inbound.Id.Value()), inbound.FullMethod(), inbound.Parameters.Value(), result);
+                    Core::ProxyType<Core::JSON::IElement> element;
+                    const string fullMethod(inbound.FullMethod());
+                    const uint32_t revision(source->Revision());
+                    uint32_t code = Core::ERROR_NONE;
+
+                    if (source->Cached(fullMethod, inbound.Parameters.Value(), result) == false) {
+                        const Core::JSONRPC::Connection connection(channelId, inbound.Id.Value());
+
+                        code = (entry != nullptr ? entry->Invoke(connection, fullMethod, inbound.Parameters.Value(), result, element)
+                                                 : source->Invoke(connection, fullMethod, inbound.Parameters.Value(), result));
+
+                        // Streamed results are large by nature, those are not kept.
+                        if ((code == Core::ERROR_NONE) && (element.IsValid() == false)) {
+                            source->Store(fullMethod, inbound.Parameters.Value(), result, revision);
+                        }
+                    }
                     if (response.IsValid() == true) {
                         if (code == static_cast<uint32_t>(~0)) {
                             response.Release();
                         } else if (code == Core::ERROR_NONE) {
-                            response->Result = result;
+                            if (element.IsValid() == true) {
+                                response->Stream(element);
+                            } else {
+                                response->Result = result;
+                            }
                         } else {
                             response->Error.Code = code;
                             response->Error.Text = Core::ErrorToString(code);
@@ -319,8 +430,115 @@ namespace PluginHost {
 
             return response;
         }
+        Core::ProxyType<Core::JSONRPC::Message> Cached(const string& token, const uint32_t /* channelId */, const Core::JSONRPC::Message& inbound) override
+        {
+            Core::ProxyType<Core::JSONRPC::Message> response;
+            Core::JSONRPC::Handler* source = nullptr;
+            Core::JSONRPC::Handler::Entry* entry = nullptr;
+            const string& method(inbound.Designator.Value());
+            string result;
+
+            // Only requests that expect an answer and are allowed, anything else takes the long way.
+            if ((inbound.Id.IsSet() == true) &&
+                ((_validate == nullptr) || (_validate(token, Core::JSONRPC::Message::Method(method), inbound.Parameters.Value()) == true)) &&
+                (Destination(method, source, entry) == STATE_CUSTOM) &&
+                (source->Cached(inbound.FullMethod(), inbound.Parameters.Value(), result) == true)) {
+
+                response = Message();
+                response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+                response->Id = inbound.Id.Value();
+                response->Result = result;
+            }
+
+            return (response);
+        }
 
     private:
+        // The hot path, one lookup in the published routing table without taking a lock. What is
+        // not in there is evaluated the long way, which also produces the proper error state.
+        state Destination(const string& designator, Core::JSONRPC::Handler*& source, Core::JSONRPC::Handler::Entry*& entry)
+        {
+            state result;
+            std::shared_ptr<const RouteTable> table(std::atomic_load(&_routes));
+
+            if ((table == nullptr) || (table->Generation != Generation())) {
+                // Methods were (un)registered since the table was published.
+                table = Publish();
+            }
+
+            size_t index = designator.find('@');
+            std::unordered_map<string, Route>::const_iterator route(index == string::npos ? table->Routes.find(designator) : table->Routes.find(designator.substr(0, index)));
+
+            if (route != table->Routes.cend()) {
+                source = route->second.Handler;
+                entry = route->second.Entry;
+                result = route->second.State;
+            } else {
+                result = Destination(designator, source);
+            }
+
+            return (result);
+        }
+        uint32_t Generation() const
+        {
+            uint32_t result = static_cast<uint32_t>(_handlers.size());
+
+            for (const Core::JSONRPC::Handler& handler : _handlers) {
+                result += handler.Generation();
+            }
+
+            return (result);
+        }
+        std::shared_ptr<const RouteTable> Publish()
+        {
+            std::shared_ptr<RouteTable> table(std::make_shared<RouteTable>());
+            std::list<string> prefixes;
+
+            _adminLock.Lock();
+
+            table->Generation = Generation();
+
+            for (Core::JSONRPC::Handler& handler : _handlers) {
+
+                if (&handler == &_handlers.front()) {
+                    // Without a version, the first handler is addressed.
+                    prefixes.push_back(EMPTY_STRING);
+                    if (_callsign.empty() == false) {
+                        prefixes.push_back(_callsign + '.');
+                    }
+                }
+                for (const uint8_t version : handler.Versions()) {
+                    const string number(Core::NumberType<uint8_t>(version).Text() + '.');
+
+                    // A version is served by the first handler supporting it.
+                    if (table->Routes.find(number + _T("register")) == table->Routes.end()) {
+                        prefixes.push_back(number);
+                        if (_callsign.empty() == false) {
+                            prefixes.push_back(_callsign + '.' + number);
+                        }
+                    }
+                }
+
+                for (const string& prefix : prefixes) {
+                    Core::JSONRPC::Handler::EventIterator index(handler.Events());
+
+                    table->Routes.emplace(prefix + _T("register"), Route { &handler, nullptr, STATE_REGISTRATION });
+                    table->Routes.emplace(prefix + _T("unregister"), Route { &handler, nullptr, STATE_UNREGISTRATION });
+                    table->Routes.emplace(prefix + _T("exists"), Route { &handler, nullptr, STATE_EXISTS });
+
+                    while (index.Next() == true) {
+                        table->Routes.emplace(prefix + index.Event(), Route { &handler, handler.Find(index.Event()), STATE_CUSTOM });
+                    }
+                }
+                prefixes.clear();
+            }
+
+            std::atomic_store(&_routes, std::shared_ptr<const RouteTable>(table));
+
+            _adminLock.Unlock();
+
+            return (table);
+        }
         state Destination(const string& designator, Core::JSONRPC::Handler*& source)
         {
             state result = STATE_INCORRECT_HANDLER;
@@ -362,18 +580,15 @@ namespace PluginHost {
             }
             return (result);
         }
-        void Notify(const uint32_t id, const string& designator, const string& parameters)
+        void Notify(const uint32_t id, const string& designator, const Core::JSONRPC::Policy& policy, const Core::ProxyType<Core::JSONRPC::Notification::Body>& body)
         {
-            Core::ProxyType<Core::JSONRPC::Message> message(Message());
+            // All subscribers share the body, only the method is specific to this channel. The
+            // channel applies the delivery policy of the subscription on its send queue.
+            Core::ProxyType<Core::JSONRPC::Notification> message(_notificationFactory.Element());
 
             ASSERT(_service != nullptr);
 
-            if (!parameters.empty()) {
-                message->Parameters = parameters;
-            }
-
-            message->Designator = designator;
-            message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+            message->Set(body, designator, policy);
 
             _service->Submit(id, Core::ProxyType<Core::JSON::IElement>(message));
         }
@@ -384,6 +599,8 @@ namespace PluginHost {
 
             _service = service;
             _callsign = _service->Callsign();
+
+            Publish();
         }
         void Deactivate() override
         {
@@ -396,6 +613,8 @@ namespace PluginHost {
 
             _handlers.front().Close();
             _service = nullptr;
+
+            std::atomic_store(&_routes, std::shared_ptr<const RouteTable>());
         }
 
     private:
@@ -404,6 +623,9 @@ namespace PluginHost {
         IShell* _service;
         string _callsign;
         TokenCheckFunction _validate;
+        std::shared_ptr<const RouteTable> _routes;
+
+        static Core::ProxyPoolType<Core::JSONRPC::Notification> _notificationFactory;
     };
 
     class EXTERNAL JSONRPCSupportsEventStatus : public JSONRPC {
@@ -465,6 +687,15 @@ namespace PluginHost {
             NotifyObservers(eventName, callsign, Status::unregistered);
             JSONRPC::Unsubscribe(handler, channelId, eventName, callsign, response);
         }
+        virtual void Subscribe(Core::JSONRPC::Handler& handler, const uint32_t channelId, const string& eventName, const string& callsign, const Core::JSONRPC::Policy& policy, Core::JSONRPC::Message& response)
+        {
+            JSONRPC::Subscribe(handler, channelId, eventName, callsign, policy, response);
+
+            // Without a policy, the Subscribe above was called and notified already.
+            if (policy.IsSet() == true) {
+                NotifyObservers(eventName, callsign, Status::registered);
+            }
+        }
 
     private:
         using EventStatusCallback = std::function<void(const string&, Status status)>;
@@ -123,6 +123,8 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 #endif
         Add(_T("module"), &Module);
         Add(_T("hash"), &Hash);
+        Add(_T("cachehits"), &CacheHits);
+        Add(_T("cachemisses"), &CacheMisses);
     }
     MetaData::Service::Service(const MetaData::Service& copy)
         : Plugin::Config(copy)
@@ -136,6 +138,8 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 #endif
         , Module(copy.Module)
         , Hash(copy.Hash)
+        , CacheHits(copy.CacheHits)
+        , CacheMisses(copy.CacheMisses)
     {
         Add(_T("state"), &JSONState);
 #if THUNDER_RUNTIME_STATISTICS
@@ -147,6 +151,8 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
 #endif
         Add(_T("module"), &Module);
         Add(_T("hash"), &Hash);
+        Add(_T("cachehits"), &CacheHits);
+        Add(_T("cachemisses"), &CacheMisses);
     }
     MetaData::Service::~Service()
     {
@@ -166,6 +172,19 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("dropped"), &Dropped);
+        Core::JSON::Container::Add(_T("coalesced"), &Coalesced);
+        Core::JSON::Container::Add(_T("buffers"), &Buffers);
+        Core::JSON::Container::Add(_T("received"), &Received);
+        Core::JSON::Container::Add(_T("sent"), &Sent);
+        Core::JSON::Container::Add(_T("reads"), &Reads);
+        Core::JSON::Container::Add(_T("writes"), &Writes);
+        Core::JSON::Container::Add(_T("partial"), &Partial);
+        Core::JSON::Container::Add(_T("queue"), &Queue);
+        Core::JSON::Container::Add(_T("blocked"), &Blocked);
+        Core::JSON::Container::Add(_T("rtt"), &RoundTrip);
+        Core::JSON::Container::Add(_T("retransmits"), &Retransmits);
+        Core::JSON::Container::Add(_T("shed"), &Shed);
     }
     MetaData::Channel::Channel(const MetaData::Channel& copy)
         : Core::JSON::Container()
@@ -174,12 +193,38 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         , Activity(copy.Activity)
         , ID(copy.ID)
         , Name(copy.Name)
+        , Dropped(copy.Dropped)
+        , Coalesced(copy.Coalesced)
+        , Buffers(copy.Buffers)
+        , Received(copy.Received)
+        , Sent(copy.Sent)
+        , Reads(copy.Reads)
+        , Writes(copy.Writes)
+        , Partial(copy.Partial)
+        , Queue(copy.Queue)
+        , Blocked(copy.Blocked)
+        , RoundTrip(copy.RoundTrip)
+        , Retransmits(copy.Retransmits)
+        , Shed(copy.Shed)
     {
         Core::JSON::Container::Add(_T("remote"), &Remote);
         Core::JSON::Container::Add(_T("state"), &JSONState);
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("dropped"), &Dropped);
+        Core::JSON::Container::Add(_T("coalesced"), &Coalesced);
+        Core::JSON::Container::Add(_T("buffers"), &Buffers);
+        Core::JSON::Container::Add(_T("received"), &Received);
+        Core::JSON::Container::Add(_T("sent"), &Sent);
+        Core::JSON::Container::Add(_T("reads"), &Reads);
+        Core::JSON::Container::Add(_T("writes"), &Writes);
+        Core::JSON::Container::Add(_T("partial"), &Partial);
+        Core::JSON::Container::Add(_T("queue"), &Queue);
+        Core::JSON::Container::Add(_T("blocked"), &Blocked);
+        Core::JSON::Container::Add(_T("rtt"), &RoundTrip);
+        Core::JSON::Container::Add(_T("retransmits"), &Retransmits);
+        Core::JSON::Container::Add(_T("shed"), &Shed);
     }
     MetaData::Channel::~Channel()
     {
@@ -192,6 +237,19 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Activity = RHS.Activity;
         ID = RHS.ID;
         Name = RHS.Name;
+        Dropped = RHS.Dropped;
+        Coalesced = RHS.Coalesced;
+        Buffers = RHS.Buffers;
+        Received = RHS.Received;
+        Sent = RHS.Sent;
+        Reads = RHS.Reads;
+        Writes = RHS.Writes;
+        Partial = RHS.Partial;
+        Queue = RHS.Queue;
+        Blocked = RHS.Blocked;
+        RoundTrip = RHS.RoundTrip;
+        Retransmits = RHS.Retransmits;
+        Shed = RHS.Shed;
 
         return (*this);
     }
@@ -240,6 +298,9 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Core::JSON::Container::Add(_T("threads"), &ThreadPoolRuns);
         Core::JSON::Container::Add(_T("pending"), &PendingRequests);
         Core::JSON::Container::Add(_T("occupation"), &PoolOccupation);
+        Core::JSON::Container::Add(_T("shedrate"), &ShedRate);
+        Core::JSON::Container::Add(_T("shedinflight"), &ShedInFlight);
+        Core::JSON::Container::Add(_T("shedpending"), &ShedPending);
     }
     MetaData::Server::~Server()
     {
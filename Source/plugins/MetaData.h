@@ -89,6 +89,8 @@ namespace PluginHost {
 #endif
             Core::JSON::String Module;
             Core::JSON::String Hash;
+            Core::JSON::DecUInt32 CacheHits;
+            Core::JSON::DecUInt32 CacheMisses;
         };
 
         class EXTERNAL Channel : public Core::JSON::Container {
@@ -134,6 +136,19 @@ namespace PluginHost {
             Core::JSON::Boolean Activity;
             Core::JSON::DecUInt32 ID;
             Core::JSON::String Name;
+            Core::JSON::DecUInt32 Dropped;
+            Core::JSON::DecUInt32 Coalesced;
+            Core::JSON::DecUInt32 Buffers;
+            Core::JSON::DecUInt64 Received;
+            Core::JSON::DecUInt64 Sent;
+            Core::JSON::DecUInt32 Reads;
+            Core::JSON::DecUInt32 Writes;
+            Core::JSON::DecUInt32 Partial;
+            Core::JSON::DecUInt32 Queue;
+            Core::JSON::DecUInt64 Blocked;
+            Core::JSON::DecUInt32 RoundTrip;
+            Core::JSON::DecUInt32 Retransmits;
+            Core::JSON::DecUInt32 Shed;
         };
 
         class EXTERNAL Bridge : public Core::JSON::Container {
@@ -171,6 +186,9 @@ namespace PluginHost {
             Core::JSON::ArrayType<Core::JSON::DecUInt32> ThreadPoolRuns;
             Core::JSON::DecUInt32 PendingRequests;
             Core::JSON::DecUInt32 PoolOccupation;
+            Core::JSON::DecUInt32 ShedRate;
+            Core::JSON::DecUInt32 ShedInFlight;
+            Core::JSON::DecUInt32 ShedPending;
         };
 
         class EXTERNAL SubSystem : public Core::JSON::Container {
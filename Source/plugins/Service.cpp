@@ -86,23 +86,40 @@ namespace PluginHost {
     }
 #endif
 
-    void Service::FileToServe(const string& webServiceRequest, Web::Response& response)
+    void Service::FileToServe(const Web::Request& request, Web::Response& response)
     {
+        const string& webServiceRequest(request.Path);
         Web::MIMETypes result;
         uint16_t offset = static_cast<uint16_t>(_config.WebPrefix().length()) + (_webURLPath.empty() ? 1 : static_cast<uint16_t>(_webURLPath.length()) + 2);
         string fileToService = _webServerFilePath;
+        Core::ProxyType<Web::FileBody> fileBody(IFactories::Instance().FileBody());
 
         if ((webServiceRequest.length() <= offset) || (Web::MIMETypeForFile(webServiceRequest.substr(offset, -1), fileToService, result) == false)) {
-            Core::ProxyType<Web::FileBody> fileBody(IFactories::Instance().FileBody());
-
             // No filename gives, be default, we go for the index.html page..
             *fileBody = fileToService + _T("index.html");
             response.ContentType = Web::MIME_HTML;
-            response.Body<Web::FileBody>(fileBody);
         } else {
-            Core::ProxyType<Web::FileBody> fileBody(IFactories::Instance().FileBody());
             *fileBody = fileToService;
             response.ContentType = result;
+        }
+
+        response.AcceptRange = _T("bytes");
+
+        if ((request.Range.IsSet() == true) && (fileBody->Exists() == true)) {
+            const string size(Core::NumberType<uint64_t>(fileBody->Size()).Text());
+            uint64_t first;
+            uint64_t length;
+
+            if ((fileBody->Size() <= static_cast<uint64_t>(Core::NumberType<int32_t>::Max())) && (request.ByteRange(fileBody->Size(), first, length) == true)) {
+                fileBody->Range(static_cast<uint32_t>(first), static_cast<uint32_t>(length));
+                response.ErrorCode = Web::STATUS_PARTIAL_CONTENT;
+                response.ContentRange = _T("bytes ") + Core::NumberType<uint64_t>(first).Text() + '-' + Core::NumberType<uint64_t>(first + length - 1).Text() + '/' + size;
+                response.Body<Web::FileBody>(fileBody);
+            } else {
+                response.ErrorCode = Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE;
+                response.ContentRange = _T("bytes */") + size;
+            }
+        } else {
             response.Body<Web::FileBody>(fileBody);
         }
     }
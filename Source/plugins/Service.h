@@ -404,7 +404,7 @@ namespace PluginHost {
             _processedObjects++;
         }
 #endif
-        void FileToServe(const string& webServiceRequest, Web::Response& response);
+        void FileToServe(const Web::Request& request, Web::Response& response);
 
     private:
         mutable Core::CriticalSection _adminLock;
@@ -25,6 +25,7 @@
 #define CORE_TRACE_NOT_ALLOWED
 
 #include "Module.h"
+#include "Admission.h"
 #include "Config.h"
 #include "Channel.h"
 #include "Configuration.h"
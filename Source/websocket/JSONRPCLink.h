@@ -131,10 +131,18 @@ namespace JSONRPC {
                 typedef Core::StreamJSONType<Web::WebSocketClientType<Core::SocketStream>, FactoryImpl&, INTERFACE> BaseClass;
     
             public:
+                // Links on the IMessagePack interface negotiate the binary MessagePack encoding of the messages.
                 ChannelImpl(CommunicationChannel* parent, const Core::NodeId& remoteNode, const string& callsign, const string& query)
-                    : BaseClass(5, FactoryImpl::Instance(), callsign, _T("JSON"), query, "", false, false, false, remoteNode.AnyInterface(), remoteNode, 256, 256)
+                    : BaseClass(5, FactoryImpl::Instance(), callsign, (std::is_same<INTERFACE, Core::JSON::IMessagePack>::value ? _T("jsonrpc.msgpack") : _T("JSON")), query, "", std::is_same<INTERFACE, Core::JSON::IMessagePack>::value, false, false, remoteNode.AnyInterface(), remoteNode, 256, 256)
                     , _parent(*parent)
                 {
+                    // Opt in to compressed messages (permessage-deflate) with the zlib level, e.g. THUNDER_COMPRESSION=6.
+                    string level;
+                    if ((Core::SystemInfo::GetEnvironment(_T("THUNDER_COMPRESSION"), level) == true) && (level.empty() == false)) {
+                        uint8_t value = Core::NumberType<uint8_t>(level.c_str(), static_cast<uint32_t>(level.length())).Value();
+
+                        BaseClass::Link().MessageCompression((value > 9 ? 9 : value), 1024, MAX_WBITS, true);
+                    }
                 }
                 virtual ~ChannelImpl()
                 {
@@ -182,13 +190,10 @@ namespace JSONRPC {
                 {
                     Core::ProxyType<Core::JSONRPC::Message> inbound(Core::proxy_cast<Core::JSONRPC::Message>(jsonObject));
 
+                    // What is packed on the wire, is traced as its JSON text.
                     ASSERT(inbound.IsValid() == true);
                     if (inbound.IsValid() == true) {
-                        std::vector<uint8_t> values;
-                        inbound->ToBuffer(values);
-                        if (values.empty() != true) {
-                            Core::ToString(values.data(), static_cast<uint16_t>(values.size()), false, message);
-                        }
+                        inbound->ToString(message);
                     }
                 }
 
@@ -1186,11 +1191,14 @@ namespace JSONRPC {
         }
         void ToMessage(Core::JSON::IMessagePack* parameters, Core::ProxyType<Core::JSONRPC::Message>& message) const
         {
-             std::vector<uint8_t> values;
-             parameters->ToBuffer(values);
-             if (values.empty() != true) {
-                 string strValues(values.begin(), values.end());
-                 message->Parameters = strValues;
+             // The message holds the parameters as JSON text, as the handlers on the other
+             // side expect them, it packs them natively when it is send.
+             Core::JSON::IElement* element = dynamic_cast<Core::JSON::IElement*>(parameters);
+
+             ASSERT(element != nullptr);
+
+             if (element != nullptr) {
+                 ToMessage(element, message);
              }
              return;
         }
@@ -1209,9 +1217,13 @@ namespace JSONRPC {
         }
         void FromMessage(Core::JSON::IMessagePack* response, const Core::JSONRPC::Message& message)
         {
-            string value = message.Result.Value();
-            std::vector<uint8_t> result(value.begin(), value.end());
-            response->FromBuffer(result);
+            Core::JSON::IElement* element = dynamic_cast<Core::JSON::IElement*>(response);
+
+            ASSERT(element != nullptr);
+
+            if (element != nullptr) {
+                FromMessage(element, message);
+            }
         }
 
     private:
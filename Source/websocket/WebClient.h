@@ -0,0 +1,484 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __WEBCLIENT_H
+#define __WEBCLIENT_H
+
+#include "Module.h"
+#include "WebLink.h"
+#include "WebRequest.h"
+#include "WebResponse.h"
+
+namespace WPEFramework {
+namespace Web {
+
+    // Whether the connection a response came in on can carry the next request. Besides what HTTP says
+    // (1.1, or 1.0 with keep-alive, and nobody asked to close), the response must have been read up to
+    // its last byte: a HEAD response announces content that never comes and content without a body to
+    // go into is not read, both leave the stream at an unknown position.
+    inline bool KeepAlive(const Web::Request& request, const Web::Response& response)
+    {
+        const bool content = ((response.TransferEncoding.IsSet() == true) || ((response.ContentLength.IsSet() == true) && (response.ContentLength.Value() > 0)));
+
+        return ((request.Verb != Web::Request::HTTP_HEAD) &&
+                ((request.Connection.IsSet() == false) || (request.Connection.Value() != Web::Request::CONNECTION_CLOSE)) &&
+                ((response.Connection.IsSet() == false) ? ((response.MajorVersion > 1) || ((response.MajorVersion == 1) && (response.MinorVersion >= 1))) : (response.Connection.Value() == Web::Response::CONNECTION_KEEPALIVE)) &&
+                ((content == false) || (response.HasBody() == true)));
+    }
+
+    // Asynchronous HTTP client. Requests are sent over connections that are kept open, per remote end,
+    // once their response is in. A request goes out on an idle connection to its remote end, if there
+    // is one, else on a new one. With a pipeline larger than 1, GET requests also go out on a connection
+    // that still waits for (at most pipeline - 1) earlier GET responses. Connections idle for longer
+    // than the idle time are closed on the next Submit or Cleanup. Connections are deleted by Cleanup,
+    // call it every now and then, but not from the callbacks.
+    template <typename LINK>
+    class ClientType {
+    public:
+        struct ICallback {
+            virtual ~ICallback() = default;
+
+            // The response headers are in, attach the body for the content.
+            virtual void LinkBody(const Core::ProxyType<Web::Request>& request, Core::ProxyType<Web::Response>& response) = 0;
+
+            // The request is done. The response is not valid if the connection failed or closed before it was in.
+            virtual void Completed(const Core::ProxyType<Web::Request>& request, const Core::ProxyType<Web::Response>& response) = 0;
+        };
+
+        struct Statistics {
+            uint32_t Connections; // Connections opened.
+            uint32_t Reused; // Requests sent on a connection that was kept open.
+            uint32_t Pipelined; // Requests sent while an earlier response was still to come.
+            uint32_t Expired; // Connections closed after being idle for the idle time.
+            uint32_t Failed; // Requests that never got a response.
+        };
+
+    private:
+        typedef ClientType<LINK> ThisClass;
+
+        // Requests wait in _pending till the link serialized them (Send), from then on in _inflight, the order
+        // in which their responses come in. The link is never called with the lock of the parent taken, it
+        // calls back into this with its own locks taken.
+        class Connection : public WebLinkType<LINK, Web::Response, Web::Request, Core::ProxyPoolType<Web::Response>&> {
+        private:
+            typedef WebLinkType<LINK, Web::Response, Web::Request, Core::ProxyPoolType<Web::Response>&> BaseClass;
+
+            struct Entry {
+                Core::ProxyType<Web::Request> Request;
+                ICallback* Callback;
+                bool Submitted;
+            };
+
+        public:
+            Connection() = delete;
+            Connection(const Connection&) = delete;
+            Connection& operator=(const Connection&) = delete;
+
+            template <typename... Args>
+            Connection(ThisClass& parent, const Core::NodeId& remote, Args&&... args)
+                : BaseClass(parent._pipeline, parent._responses, std::forward<Args>(args)...)
+                , _parent(parent)
+                , _remote(remote)
+                , _pending()
+                , _inflight()
+                , _idleSince(0)
+                , _reusable(true)
+                , _used(false)
+            {
+                BaseClass::Link().RemoteNode(remote);
+            }
+            ~Connection() override
+            {
+                BaseClass::Close(Core::infinite);
+            }
+
+        public:
+            // The methods below are called with the lock of the parent taken.
+            inline const Core::NodeId& Remote() const
+            {
+                return (_remote);
+            }
+            inline bool IsIdle() const
+            {
+                return ((_pending.empty() == true) && (_inflight.empty() == true));
+            }
+            inline uint32_t Load() const
+            {
+                return (static_cast<uint32_t>(_pending.size() + _inflight.size()));
+            }
+            inline bool IsUsable() const
+            {
+                return ((_reusable == true) && (BaseClass::IsClosed() == false));
+            }
+            // Whether the request can be queued behind what this connection is already waiting for.
+            inline bool Accepts(const Web::Request& request) const
+            {
+                bool result = (Load() < _parent._pipeline) && (request.Verb == Web::Request::HTTP_GET);
+
+                for (typename std::list<Entry>::const_iterator index = _pending.cbegin(); (result == true) && (index != _pending.cend()); index++) {
+                    result = (index->Request->Verb == Web::Request::HTTP_GET);
+                }
+                for (typename std::list<Entry>::const_iterator index = _inflight.cbegin(); (result == true) && (index != _inflight.cend()); index++) {
+                    result = (index->Request->Verb == Web::Request::HTTP_GET);
+                }
+
+                return (result);
+            }
+            inline bool IsExpired(const uint64_t now) const
+            {
+                return ((IsIdle() == true) && (_reusable == true) && (BaseClass::IsOpen() == true) && ((now - _idleSince) >= (static_cast<uint64_t>(_parent._idleTime) * Core::Time::TicksPerMillisecond)));
+            }
+            inline bool IsDone() const
+            {
+                return ((IsIdle() == true) && (BaseClass::IsClosed() == true));
+            }
+            void Add(const Core::ProxyType<Web::Request>& request, ICallback* callback)
+            {
+                if (IsIdle() == false) {
+                    _parent._statistics.Pipelined++;
+                } else if (_used == true) {
+                    _parent._statistics.Reused++;
+                }
+
+                _pending.push_back({ request, callback, false });
+            }
+            // The link could not be opened, take back what was queued on it.
+            void Abort(std::list<std::pair<Core::ProxyType<Web::Request>, ICallback*>>& requests)
+            {
+                for (const Entry& entry : _pending) {
+                    requests.emplace_back(entry.Request, entry.Callback);
+                }
+
+                _pending.clear();
+            }
+            inline void Retire()
+            {
+                _reusable = false;
+            }
+
+        public:
+            // Hand what is not handed yet to the link, if it is open. Called without the lock of the parent.
+            void Flush()
+            {
+                std::list<Core::ProxyType<Web::Request>> outbound;
+
+                _parent._lock.Lock();
+
+                if (BaseClass::IsOpen() == true) {
+                    for (Entry& entry : _pending) {
+                        if (entry.Submitted == false) {
+                            entry.Submitted = true;
+                            outbound.push_back(entry.Request);
+                        }
+                    }
+                }
+
+                _parent._lock.Unlock();
+
+                for (const Core::ProxyType<Web::Request>& request : outbound) {
+                    BaseClass::Submit(request);
+                }
+            }
+
+        private:
+            void LinkBody(Core::ProxyType<Web::Response>& element) override
+            {
+                _parent._lock.Lock();
+
+                ASSERT(_inflight.empty() == false);
+
+                Entry entry(_inflight.front());
+
+                _parent._lock.Unlock();
+
+                entry.Callback->LinkBody(entry.Request, element);
+            }
+            void Received(Core::ProxyType<Web::Response>& response) override
+            {
+                _parent._lock.Lock();
+
+                ASSERT(_inflight.empty() == false);
+
+                Entry entry(_inflight.front());
+
+                _inflight.pop_front();
+                _used = true;
+
+                if (Web::KeepAlive(*(entry.Request), *response) == false) {
+                    // Anything pipelined behind it fails when the connection closes.
+                    _reusable = false;
+                } else if (IsIdle() == true) {
+                    _idleSince = Core::Time::Now().Ticks();
+                }
+
+                const bool reusable = _reusable;
+
+                _parent._lock.Unlock();
+
+                entry.Callback->Completed(entry.Request, response);
+
+                if (reusable == false) {
+                    BaseClass::Close(0);
+                }
+            }
+            void Send(const Core::ProxyType<Web::Request>& request) override
+            {
+                _parent._lock.Lock();
+
+                typename std::list<Entry>::iterator index(_pending.begin());
+
+                while ((index != _pending.end()) && (index->Request != request)) {
+                    index++;
+                }
+
+                ASSERT(index != _pending.end());
+
+                if (index != _pending.end()) {
+                    _inflight.splice(_inflight.end(), _pending, index);
+                }
+
+                _parent._lock.Unlock();
+            }
+            void StateChange() override
+            {
+                if (BaseClass::IsOpen() == true) {
+                    // What was queued while opening goes out now.
+                    Flush();
+                } else {
+                    std::list<Entry> failed;
+
+                    _parent._lock.Lock();
+
+                    _reusable = false;
+                    failed.splice(failed.end(), _inflight);
+                    failed.splice(failed.end(), _pending);
+                    _parent._statistics.Failed += static_cast<uint32_t>(failed.size());
+
+                    _parent._lock.Unlock();
+
+                    for (Entry& entry : failed) {
+                        entry.Callback->Completed(entry.Request, Core::ProxyType<Web::Response>());
+                    }
+                }
+            }
+
+        private:
+            ThisClass& _parent;
+            const Core::NodeId _remote;
+            std::list<Entry> _pending;
+            std::list<Entry> _inflight;
+            uint64_t _idleSince;
+            bool _reusable;
+            bool _used;
+        };
+
+    public:
+        ClientType() = delete;
+        ClientType(const ClientType<LINK>&) = delete;
+        ClientType<LINK>& operator=(const ClientType<LINK>&) = delete;
+
+        // The arguments construct the LINK of every connection, its remote node is set per connection. An
+        // idle time of 0 closes every connection after its response.
+        template <typename... Args>
+        ClientType(const uint8_t pipeline, const uint32_t idleTime, Args&&... args)
+            : _lock()
+            , _pipeline(pipeline == 0 ? 1 : pipeline)
+            , _idleTime(idleTime)
+            , _responses(2)
+            , _connections()
+            , _statistics()
+            , _factory([this, args...](const Core::NodeId& remote) { return (new Connection(*this, remote, args...)); })
+        {
+            ::memset(&_statistics, 0, sizeof(_statistics));
+        }
+        ~ClientType()
+        {
+            for (Connection* connection : _connections) {
+                connection->Close(Core::infinite);
+            }
+            for (Connection* connection : _connections) {
+                delete connection;
+            }
+        }
+
+    public:
+        // Returns ERROR_UNAVAILABLE, without calling back, if no connection could be opened to the remote.
+        uint32_t Submit(const Core::NodeId& remote, const Core::ProxyType<Web::Request>& request, ICallback* callback)
+        {
+            ASSERT(callback != nullptr);
+            ASSERT(request.IsValid() == true);
+
+            uint32_t result = Core::ERROR_NONE;
+            std::list<Connection*> expired;
+            Connection* selected = nullptr;
+            Connection* pipeline = nullptr;
+            bool created = false;
+
+            if (_idleTime == 0) {
+                // Nothing is kept, let the server know so it does not wait for more either.
+                request->Connection = Web::Request::CONNECTION_CLOSE;
+            }
+
+            _lock.Lock();
+
+            Expire(expired);
+
+            for (Connection* connection : _connections) {
+                if ((connection->IsUsable() == true) && (connection->Remote() == remote)) {
+                    if (connection->IsIdle() == true) {
+                        selected = connection;
+                        break;
+                    } else if ((connection->Accepts(*request) == true) && ((pipeline == nullptr) || (connection->Load() < pipeline->Load()))) {
+                        pipeline = connection;
+                    }
+                }
+            }
+
+            if (selected == nullptr) {
+                selected = pipeline;
+            }
+
+            if (selected == nullptr) {
+                selected = _factory(remote);
+                created = true;
+                _statistics.Connections++;
+                _connections.push_back(selected);
+            }
+
+            selected->Add(request, callback);
+
+            _lock.Unlock();
+
+            Close(expired);
+
+            if (created == true) {
+                const uint32_t opened = selected->Open(0);
+
+                if ((opened != Core::ERROR_NONE) && (opened != Core::ERROR_INPROGRESS)) {
+                    std::list<std::pair<Core::ProxyType<Web::Request>, ICallback*>> aborted;
+
+                    _lock.Lock();
+                    _statistics.Connections--;
+                    _connections.remove(selected);
+                    selected->Abort(aborted);
+                    _lock.Unlock();
+
+                    delete selected;
+                    selected = nullptr;
+                    result = Core::ERROR_UNAVAILABLE;
+
+                    // Others might have queued behind this request in the mean time, those are called back.
+                    for (const std::pair<Core::ProxyType<Web::Request>, ICallback*>& entry : aborted) {
+                        if (entry.first != request) {
+                            _lock.Lock();
+                            _statistics.Failed++;
+                            _lock.Unlock();
+
+                            entry.second->Completed(entry.first, Core::ProxyType<Web::Response>());
+                        }
+                    }
+                }
+            }
+
+            if (selected != nullptr) {
+                selected->Flush();
+            }
+
+            return (result);
+        }
+        // Closes the connections that are idle for too long and deletes the ones that are closed.
+        void Cleanup()
+        {
+            std::list<Connection*> expired;
+            std::list<Connection*> done;
+
+            _lock.Lock();
+
+            Expire(expired);
+
+            typename std::list<Connection*>::iterator index(_connections.begin());
+
+            while (index != _connections.end()) {
+                if ((*index)->IsDone() == true) {
+                    done.push_back(*index);
+                    index = _connections.erase(index);
+                } else {
+                    index++;
+                }
+            }
+
+            _lock.Unlock();
+
+            Close(expired);
+
+            for (Connection* connection : done) {
+                delete connection;
+            }
+        }
+        inline uint32_t Count() const
+        {
+            _lock.Lock();
+            uint32_t result = static_cast<uint32_t>(_connections.size());
+            _lock.Unlock();
+
+            return (result);
+        }
+        inline Statistics Metrics() const
+        {
+            _lock.Lock();
+            Statistics result(_statistics);
+            _lock.Unlock();
+
+            return (result);
+        }
+
+    private:
+        // Called with the lock taken, the connections are closed after it is released.
+        void Expire(std::list<Connection*>& expired)
+        {
+            const uint64_t now = Core::Time::Now().Ticks();
+
+            for (Connection* connection : _connections) {
+                if (connection->IsExpired(now) == true) {
+                    _statistics.Expired++;
+                    connection->Retire();
+                    expired.push_back(connection);
+                }
+            }
+        }
+        void Close(const std::list<Connection*>& connections)
+        {
+            for (Connection* connection : connections) {
+                connection->Close(0);
+            }
+        }
+
+    private:
+        mutable Core::CriticalSection _lock;
+        const uint8_t _pipeline;
+        const uint32_t _idleTime;
+        Core::ProxyPoolType<Web::Response> _responses;
+        std::list<Connection*> _connections;
+        Statistics _statistics;
+        std::function<Connection*(const Core::NodeId&)> _factory;
+    };
+}
+} // namespace WPEFramework::Web
+
+#endif // __WEBCLIENT_H
@@ -95,6 +95,10 @@ namespace Web {
                     _lock.Unlock();
                 }
             }
+            virtual bool SendFile(const Core::File::Handle file, const uint64_t offset, const uint32_t length)
+            {
+                return (_parent.SendFile(_parent, file, offset, length));
+            }
 
         private:
             ThisClass& _parent;
@@ -280,6 +284,11 @@ namespace Web {
             _serializerImpl.Flush();
             _deserialiserImpl.Flush();
         }
+        // Only for links with an OUTBOUND that can compress, e.g. Web::Response.
+        inline void Compression(const uint8_t level, const uint32_t threshold)
+        {
+            _serializerImpl.Compression(level, threshold);
+        }
         inline bool IsOpen() const
         {
             return (_channel.IsOpen());
@@ -354,6 +363,21 @@ namespace Web {
             return (_serializerImpl.Serialize(dataFrame, receivedSize));
         }
 
+        // A file goes straight from the file into a plain socket, as long as nothing transforms what is sent.
+        template <typename CLASSNAME>
+        inline typename Core::TypeTraits::enable_if<(!CLASSNAME::TraitSerializer::value) && (std::is_base_of<Core::SocketPort, LINK>::value), bool>::type
+        SendFile(const CLASSNAME&, const Core::File::Handle file, const uint64_t offset, const uint32_t length)
+        {
+            return (_channel.SendFile(file, offset, length));
+        }
+
+        template <typename CLASSNAME>
+        inline typename Core::TypeTraits::enable_if<(CLASSNAME::TraitSerializer::value) || (!std::is_base_of<Core::SocketPort, LINK>::value), bool>::type
+        SendFile(const CLASSNAME&, const Core::File::Handle, const uint64_t, const uint32_t)
+        {
+            return (false);
+        }
+
     private:
         SerializerImpl _serializerImpl;
         DeserializerImpl _deserialiserImpl;
@@ -66,6 +66,7 @@ namespace Web {
 
     enum EncodingTypes {
         ENCODING_GZIP,
+        ENCODING_DEFLATE,
         ENCODING_UNKNOWN
     };
 
@@ -86,6 +87,8 @@ namespace Web {
         // of the object. These methods allow for preparation of content to be Serialised or Deserialized.
         // The return value is of the Serialization inidcateds the number of bytes required for the body
         // The reurn value of the Deserialize indicate the number of byes that could by loaded as max.
+        // A response body that does not know its size up front returns ~0 on Serialize, it is then sent
+        // in chunks until the Serialize of the content has nothing more to give.
         virtual uint32_t Serialize() const = 0;
         virtual uint32_t Deserialize() = 0;
 
@@ -246,7 +249,8 @@ namespace Web {
             MAN,
             M_X,
             S_T,
-			AUTHORIZATION
+			AUTHORIZATION,
+            RANGE
         };
 
         enum type {
@@ -312,6 +316,12 @@ namespace Web {
 
         public:
             virtual void Serialized(const Web::Request& element) = 0;
+            // A file body can be handed to the link to go out straight from the file, behind the data that
+            // is serialized. Links that can not, or transform the data, copy it through the stream instead.
+            virtual bool SendFile(const Core::File::Handle /* file */, const uint64_t /* offset */, const uint32_t /* length */)
+            {
+                return (false);
+            }
 
             void Flush()
             {
@@ -636,6 +646,10 @@ namespace Web {
         {
             return (_body.IsValid());
         }
+        // The single range asked for in the Range header ("bytes=first-last", "bytes=first-" or "bytes=-suffix")
+        // of a resource of size bytes. Returns false if there is none, or it does not fit the resource.
+        bool ByteRange(const uint64_t size, uint64_t& offset, uint64_t& length) const;
+
         template <typename BODYTYPE>
         inline void Body(const Core::ProxyType<BODYTYPE>& body)
         {
@@ -23,6 +23,7 @@
 #include "Module.h"
 #include "URL.h"
 #include "WebRequest.h"
+#include "WebTransform.h"
 
 namespace WPEFramework {
 namespace Web {
@@ -95,12 +96,14 @@ namespace Web {
             ALLOW,
             WEBSOCKET_ACCEPT,
             WEBSOCKET_PROTOCOL,
+            WEBSOCKET_EXTENSIONS,
             LOCATION,
             WAKEUP,
             U_S_N,
             S_T,
             CACHE_CONTROL,
-            APPLICATION_URL
+            APPLICATION_URL,
+            CONTENT_RANGE
         };
 
         enum upgrade {
@@ -142,6 +145,9 @@ namespace Web {
                 , _buffer(nullptr)
                 , _lock()
                 , _current()
+                , _level(0)
+                , _threshold(0)
+                , _deflate()
             {
             }
             ~Serializer()
@@ -150,10 +156,28 @@ namespace Web {
 
         public:
             virtual void Serialized(const Web::Response& element) = 0;
+            // A file body can be handed to the link to go out straight from the file, behind the data that
+            // is serialized. Links that can not, or transform the data, copy it through the stream instead.
+            virtual bool SendFile(const Core::File::Handle /* file */, const uint64_t /* offset */, const uint32_t /* length */)
+            {
+                return (false);
+            }
+
+            // Bodies of at least threshold bytes are compressed, if the response allows for it.
+            // Level 0 turns compression off, 9 spends the most CPU on the smallest result.
+            void Compression(const uint8_t level, const uint32_t threshold)
+            {
+                ASSERT(level <= 9);
 
+                _lock.Lock();
+                _level = level;
+                _threshold = threshold;
+                _lock.Unlock();
+            }
             void Flush()
             {
                 _lock.Lock();
+                _deflate.Close();
                 _state = VERSION;
                 Web::Response* backup = _current;
                 _current = nullptr;
@@ -176,6 +200,9 @@ namespace Web {
 
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength);
 
+        private:
+            uint16_t Compress(uint8_t stream[], const uint16_t maxLength);
+
         private:
             uint16_t _state;
             uint16_t _offset;
@@ -185,6 +212,9 @@ namespace Web {
             const TCHAR* _buffer;
             Core::CriticalSection _lock;
             Response* _current;
+            uint8_t _level;
+            uint32_t _threshold;
+            Deflate _deflate;
         };
         class EXTERNAL Deserializer {
         private:
@@ -387,6 +417,7 @@ namespace Web {
         void Clear()
         {
             _marshalMode = MARSHAL_RAW;
+            _compression = ENCODING_UNKNOWN;
             ErrorCode = Web::STATUS_OK;
             Message.clear();
             MajorVersion = Web::MajorVersion;
@@ -402,6 +433,8 @@ namespace Web {
             ContentLength.Clear();
             ContentEncoding.Clear();
             WebSocketAccept.Clear();
+            WebSocketProtocol.Clear();
+            WebSocketExtensions.Clear();
             AccessControlOrigin.Clear();
             AccessControlMethod.Clear();
             AccessControlHeaders.Clear();
@@ -416,6 +449,7 @@ namespace Web {
             WakeUp.Clear();
             CacheControl.Clear();
             ApplicationURL.Clear();
+            ContentRange.Clear();
 
             if (_body.IsValid() == true) {
                 _body.Release();
@@ -443,6 +477,7 @@ namespace Web {
         Core::OptionalType<string> AccessControlHeaders;
         Core::OptionalType<uint32_t> AccessControlMaxAge;
         Core::OptionalType<string> AcceptRange;
+        Core::OptionalType<string> ContentRange;
         Core::OptionalType<connection> Connection;
         Core::OptionalType<string> ST;
         Core::OptionalType<string> USN;
@@ -450,6 +485,7 @@ namespace Web {
         Core::OptionalType<string> WakeUp;
         Core::OptionalType<string> ETag;
         Core::OptionalType<string> WebSocketProtocol;
+        Core::OptionalType<string> WebSocketExtensions;
         Core::OptionalType<string> CacheControl;
         Core::OptionalType<Core::URL> ApplicationURL;
 
@@ -484,10 +520,20 @@ namespace Web {
         {
             return (_marshalMode);
         }
+        // The encoding the requester accepts, the serializer may use it to compress the body.
+        inline void Compression(const EncodingTypes encoding)
+        {
+            _compression = encoding;
+        }
+        inline EncodingTypes Compression() const
+        {
+            return (_compression);
+        }
 
     private:
         Core::ProxyType<IBody> _body;
         MarshalType _marshalMode;
+        EncodingTypes _compression;
     };
 }
 }
@@ -42,6 +42,7 @@ static const TCHAR __CONNECTION_UPGRADE[] = _T("UPGRADE");
 static const TCHAR __CONNECTION_CLOSE[] = _T("CLOSE");
 static const TCHAR __CONNECTION_KEEPALIVE[] = _T("KEEP-ALIVE");
 static const TCHAR __ENCODING_GZIP[] = _T("GZIP");
+static const TCHAR __ENCODING_DEFLATE[] = _T("DEFLATE");
 
 static const TCHAR __HOST[] = _T("HOST:");
 static const TCHAR __UPGRADE[] = _T("UPGRADE:");
@@ -69,6 +70,7 @@ static const TCHAR __SERVER[] = _T("SERVER:");
 static const TCHAR __MODIFIED[] = _T("LAST-MODIFIED:");
 static const TCHAR __ACCEPT_RANGE[] = _T("ACCEPT-RANGES:");
 static const TCHAR __RANGE[] = _T("RANGE:");
+static const TCHAR __CONTENT_RANGE[] = _T("CONTENT-RANGE:");
 static const TCHAR __ETAG[] = _T("ETAG:");
 static const TCHAR __ALLOW[] = _T("ALLOW:");
 static const TCHAR __WEBSOCKET_KEY[] = _T("SEC-WEBSOCKET-KEY:");
@@ -88,6 +90,9 @@ static const TCHAR __APPLICATION_URL[] = _T("APPLICATION-URL:");
 
 static const TCHAR __CHARACTER_SET[] = _T("CHARSET=");
 
+// A chunk of a chunked body: four hex digits for the size, CRLF, the data, CRLF.
+static constexpr uint16_t ChunkFraming = 8;
+
 #define __TXT(KeyWord) KeyWord, (sizeof(KeyWord) / sizeof(TCHAR)) - 1
 
 namespace WPEFramework {
@@ -126,6 +131,7 @@ ENUM_CONVERSION_END(Web::MIMETypes)
 ENUM_CONVERSION_BEGIN(Web::EncodingTypes)
 
     { Web::ENCODING_GZIP, _TXT(__ENCODING_GZIP) },
+    { Web::ENCODING_DEFLATE, _TXT(__ENCODING_DEFLATE) },
     { Web::ENCODING_UNKNOWN, _TXT(__UNKNOWN) },
 
 ENUM_CONVERSION_END(Web::EncodingTypes)
@@ -228,10 +234,12 @@ ENUM_CONVERSION_BEGIN(Web::Request::keywords)
     { Web::Request::WEBSOCKET_KEY, __TXT(__WEBSOCKET_KEY) },
     { Web::Request::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
     { Web::Request::WEBSOCKET_VERSION, __TXT(__WEBSOCKET_VERSION) },
+    { Web::Request::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Request::MAN, __TXT(__MAN) },
     { Web::Request::M_X, __TXT(__MX) },
     { Web::Request::S_T, __TXT(__ST) },
     { Web::Request::AUTHORIZATION, __TXT(__AUTHORIZATION) },
+    { Web::Request::RANGE, __TXT(__RANGE) },
 
 ENUM_CONVERSION_END(Web::Request::keywords)
 
@@ -272,12 +280,14 @@ ENUM_CONVERSION_BEGIN(Web::Response::keywords)
     { Web::Response::ACCESS_CONTROL_MAX_AGE, __TXT(__ACCESS_CONTROL_MAX_AGE) },
     { Web::Response::WEBSOCKET_ACCEPT, __TXT(__WEBSOCKET_ACCEPT) },
     { Web::Response::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
+    { Web::Response::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Response::LOCATION, __TXT(__LOCATION) },
     { Web::Response::WAKEUP, __TXT(__WAKEUP) },
     { Web::Response::U_S_N, __TXT(__USN) },
     { Web::Response::S_T, __TXT(__ST) },
     { Web::Response::CACHE_CONTROL, __TXT(__CACHE_CONTROL) },
     { Web::Response::APPLICATION_URL, __TXT(__APPLICATION_URL) },
+    { Web::Response::CONTENT_RANGE, __TXT(__CONTENT_RANGE) },
 
 ENUM_CONVERSION_END(Web::Response::keywords)
 
@@ -353,6 +363,86 @@ namespace Web
         { Web::MIME_APPLICATION_RSS_XML, _TXT("rss") }
     };
 
+    // Header names arrive uppercased and including the colon. Walking the keyword table for
+    // every header line costs a compare per entry, so the table is hashed once into a fixed
+    // set of slots. A lookup is a single pass over the name and, typically, one compare.
+    template <typename KEYWORDS>
+    class KeywordIndex {
+    private:
+        static constexpr uint8_t Slots = 64;
+
+        KeywordIndex(const KeywordIndex<KEYWORDS>&) = delete;
+        KeywordIndex<KEYWORDS>& operator=(const KeywordIndex<KEYWORDS>&) = delete;
+
+        KeywordIndex()
+        {
+            uint16_t index = 0;
+            const Core::EnumerateConversion<KEYWORDS>* entry;
+
+            ::memset(_slots, 0, sizeof(_slots));
+
+            while ((entry = Core::EnumerateType<KEYWORDS>::Entry(index)) != nullptr) {
+                uint8_t slot = Hash(entry->name, entry->length);
+
+                // Keep the first entry of a duplicate name, just like the table walk did.
+                while ((_slots[slot] != nullptr) && (Equal(*_slots[slot], entry->name, entry->length) == false)) {
+                    slot = (slot + 1) & (Slots - 1);
+                }
+                if (_slots[slot] == nullptr) {
+                    _slots[slot] = entry;
+                }
+
+                index++;
+            }
+
+            // Leave enough empty slots to end every probe early.
+            ASSERT(index < (Slots / 2));
+        }
+
+    public:
+        static const KeywordIndex<KEYWORDS>& Instance()
+        {
+            static const KeywordIndex<KEYWORDS> singleton;
+
+            return (singleton);
+        }
+        bool Find(const string& name, KEYWORDS& value) const
+        {
+            const uint32_t length = static_cast<uint32_t>(name.length());
+            uint8_t slot = Hash(name.c_str(), length);
+
+            while ((_slots[slot] != nullptr) && (Equal(*_slots[slot], name.c_str(), length) == false)) {
+                slot = (slot + 1) & (Slots - 1);
+            }
+
+            if (_slots[slot] != nullptr) {
+                value = _slots[slot]->value;
+            }
+
+            return (_slots[slot] != nullptr);
+        }
+
+    private:
+        static uint8_t Hash(const TCHAR text[], const uint32_t length)
+        {
+            // FNV-1a, folded into the slot range.
+            uint32_t hash = 2166136261u;
+
+            for (uint32_t index = 0; index < length; index++) {
+                hash = (hash ^ static_cast<uint32_t>(text[index])) * 16777619u;
+            }
+
+            return (static_cast<uint8_t>((hash ^ (hash >> 16)) & (Slots - 1)));
+        }
+        static bool Equal(const Core::EnumerateConversion<KEYWORDS>& entry, const TCHAR text[], const uint32_t length)
+        {
+            return ((entry.length == length) && (::memcmp(entry.name, text, length * sizeof(TCHAR)) == 0));
+        }
+
+    private:
+        const Core::EnumerateConversion<KEYWORDS>* _slots[Slots];
+    };
+
     /* static */ const TCHAR* Request::ToString(const type value)
     {
         return (Core::EnumerateType<type>(value).Data());
@@ -506,6 +596,40 @@ namespace Web
         }
     }
 
+    bool Request::ByteRange(const uint64_t size, uint64_t& offset, uint64_t& length) const
+    {
+        static const TCHAR Unit[] = _T("bytes=");
+
+        bool result = false;
+
+        if ((Range.IsSet() == true) && (size > 0)) {
+            const string& range(Range.Value());
+            const size_t dash = range.find('-');
+
+            if ((range.compare(0, (sizeof(Unit) / sizeof(TCHAR)) - 1, Unit) == 0) && (dash != string::npos) && (range.find(',') == string::npos)) {
+                const string first(range, (sizeof(Unit) / sizeof(TCHAR)) - 1, dash - ((sizeof(Unit) / sizeof(TCHAR)) - 1));
+                const string last(range, dash + 1);
+                uint64_t from = 0;
+                uint64_t to = size - 1;
+
+                if (first.empty() == true) {
+                    // Only a suffix, the last bytes of the resource.
+                    if ((Core::FromString(last, to) == true) && (to > 0)) {
+                        offset = (to < size ? size - to : 0);
+                        length = size - offset;
+                        result = true;
+                    }
+                } else if ((Core::FromString(first, from) == true) && (from < size) && ((last.empty() == true) || ((Core::FromString(last, to) == true) && (to >= from)))) {
+                    offset = from;
+                    length = (to < size ? to : size - 1) - from + 1;
+                    result = true;
+                }
+            }
+        }
+
+        return (result);
+    }
+
     uint16_t Request::Serializer::Serialize(uint8_t stream[], const uint16_t maxLength)
     {
         uint16_t current = 0;
@@ -870,15 +994,21 @@ namespace Web
                 }
                 case BODY: {
                     if (_bodyLength != 0) {
-                        ASSERT(maxLength >= current);
-                        uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
+                        ASSERT(_current->_body.IsValid() == true);
 
-                        if (size > 0) {
-                            ASSERT(_current->_body.IsValid() == true);
+                        const FileBody* file = dynamic_cast<const FileBody*>(&(*(_current->_body)));
 
-                            _current->_body->Serialize(&(stream[current]), size);
-                            _bodyLength -= size;
-                            current += size;
+                        if ((file != nullptr) && (SendFile(file->Descriptor(), file->Position(), _bodyLength) == true)) {
+                            _bodyLength = 0;
+                        } else {
+                            ASSERT(maxLength >= current);
+                            uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
+
+                            if (size > 0) {
+                                _current->_body->Serialize(&(stream[current]), size);
+                                _bodyLength -= size;
+                                current += size;
+                            }
                         }
                     }
 
@@ -905,9 +1035,44 @@ namespace Web
         return (current);
     }
 
+    uint16_t Response::Serializer::Compress(uint8_t stream[], const uint16_t maxLength)
+    {
+        uint16_t size = 0;
+
+        // Feed the body to the compressor as it drains, until the room is filled or all is out.
+        while ((size < maxLength) && (_deflate.IsFinished() == false)) {
+            if ((_deflate.IsDrained() == true) && (_bodyLength != 0)) {
+                uint16_t length;
+                uint8_t* buffer = _deflate.Buffer(length);
+
+                if (_bodyLength == static_cast<uint32_t>(~0)) {
+                    length = _current->_body->Serialize(buffer, length);
+
+                    if (length == 0) {
+                        _bodyLength = 0;
+                    }
+                } else {
+                    if (length > _bodyLength) {
+                        length = static_cast<uint16_t>(_bodyLength);
+                    }
+
+                    _current->_body->Serialize(buffer, length);
+                    _bodyLength -= length;
+                }
+
+                _deflate.Load(buffer, length);
+            }
+
+            size += _deflate.Compress(&(stream[size]), maxLength - size, (_bodyLength == 0));
+        }
+
+        return (size);
+    }
+
     uint16_t Response::Serializer::Serialize(uint8_t stream[], const uint16_t maxLength)
     {
         uint16_t current = 0;
+        uint16_t limit = maxLength;
 
         _lock.Lock();
 
@@ -923,8 +1088,8 @@ namespace Web
         }
 
         if (_current != nullptr) {
-            while ((current < maxLength) && (_state != REPORT)) {
-                while ((current < maxLength) && ((_state & EOL_MARKER) == EOL_MARKER)) {
+            while ((current < limit) && (_state != REPORT)) {
+                while ((current < limit) && ((_state & EOL_MARKER) == EOL_MARKER)) {
                     if (_offset == 0) {
                         stream[current++] = '\r';
                         _offset++;
@@ -1026,6 +1191,13 @@ namespace Web
                             _offset = 0;
                             _state = PAIR_KEY | EOL_MARKER;
                             _keyIndex = static_cast<Response::keywords>(0);
+
+                            // The headers depend on whether the body is compressed, so decide that now.
+                            _bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0);
+
+                            if ((_level > 0) && (_bodyLength > 0) && (_bodyLength >= _threshold) && (_current->Compression() != ENCODING_UNKNOWN) && (_current->ContentEncoding.IsSet() == false)) {
+                                _deflate.Open((_current->Compression() == ENCODING_GZIP ? Deflate::GZIP : Deflate::ZLIB), _level);
+                            }
                         }
                     }
                     break;
@@ -1066,7 +1238,7 @@ namespace Web
                             _offset = 0;
                         } else if ((_keyIndex <= 6) && (_current->AcceptRange.IsSet() == true)) {
                             _keyIndex = 7;
-                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCEPT_RANGE : _T("Accept-Range:"));
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCEPT_RANGE : _T("Accept-Ranges:"));
                             _value = _current->AcceptRange.Value();
                             _offset = 0;
                         } else if ((_keyIndex <= 7) && (_current->ETag.IsSet() == true)) {
@@ -1079,8 +1251,13 @@ namespace Web
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __WEBSOCKET_PROTOCOL : _T("Sec-WebSocket-Protocol:"));
                             _value = _current->WebSocketProtocol.Value();
                             _offset = 0;
-                        } else if ((_keyIndex <= 9) && (_current->Allowed.IsSet() == true)) {
+                        } else if ((_keyIndex <= 9) && (_current->WebSocketExtensions.IsSet() == true)) {
                             _keyIndex = 10;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __WEBSOCKET_EXTENSIONS : _T("Sec-WebSocket-Extensions:"));
+                            _value = _current->WebSocketExtensions.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 10) && (_current->Allowed.IsSet() == true)) {
+                            _keyIndex = 11;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ALLOW : _T("Allow:"));
                             _value = _T("");
                             _offset = 0;
@@ -1099,18 +1276,18 @@ namespace Web
                                 }
                                 entry = Core::EnumerateType<Request::type>::Entry(++index);
                             }
-                        } else if ((_keyIndex <= 10) && (_current->AccessControlHeaders.IsSet() == true)) {
-                            _keyIndex = 11;
+                        } else if ((_keyIndex <= 11) && (_current->AccessControlHeaders.IsSet() == true)) {
+                            _keyIndex = 12;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCESS_CONTROL_ALLOW_HEADERS : _T("Access-Control-Allow-Headers:"));
                             _value = _current->AccessControlHeaders.Value();
                             _offset = 0;
-                        } else if ((_keyIndex <= 11) && (_current->AccessControlOrigin.IsSet() == true)) {
-                            _keyIndex = 12;
+                        } else if ((_keyIndex <= 12) && (_current->AccessControlOrigin.IsSet() == true)) {
+                            _keyIndex = 13;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCESS_CONTROL_ALLOW_ORIGIN : _T("Access-Control-Allow-Origin:"));
                             _value = _current->AccessControlOrigin.Value();
                             _offset = 0;
-                        } else if ((_keyIndex <= 12) && (_current->AccessControlMethod.IsSet() == true)) {
-                            _keyIndex = 13;
+                        } else if ((_keyIndex <= 13) && (_current->AccessControlMethod.IsSet() == true)) {
+                            _keyIndex = 14;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCESS_CONTROL_ALLOW_METHODS : _T("Access-Control-Allow-Methods:"));
                             _value = _T("");
                             _offset = 0;
@@ -1129,17 +1306,17 @@ namespace Web
                                 }
                                 entry = Core::EnumerateType<Request::type>::Entry(++index);
                             }
-                        } else if ((_keyIndex <= 13) && (_current->AccessControlMaxAge.IsSet() == true)) {
-                            _keyIndex = 14;
+                        } else if ((_keyIndex <= 14) && (_current->AccessControlMaxAge.IsSet() == true)) {
+                            _keyIndex = 15;
 
                             Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_current->AccessControlMaxAge.Value());
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCESS_CONTROL_MAX_AGE : _T("Access-Control-Max-Age:"));
                             number.Serialize(_value);
                             _offset = 0;
-                        } else if ((_keyIndex <= 14) && (_current->ContentType.IsSet() == true)) {
+                        } else if ((_keyIndex <= 15) && (_current->ContentType.IsSet() == true)) {
                             Core::EnumerateType<MIMETypes> enumValue(_current->ContentType.Value());
 
-                            _keyIndex = 15;
+                            _keyIndex = 16;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_TYPE : _T("Content-Type:"));
                             _value = enumValue.Data();
                             if (_current->ContentCharacterSet.IsSet() == true) {
@@ -1149,62 +1326,73 @@ namespace Web
                             }
 
                             _offset = 0;
-                        } else if ((_keyIndex <= 15) && (_current->ContentEncoding.IsSet() == true)) {
-                            Core::EnumerateType<EncodingTypes> enumValue(_current->ContentEncoding.Value());
+                        } else if ((_keyIndex <= 16) && ((_current->ContentEncoding.IsSet() == true) || (_deflate.IsOpen() == true))) {
+                            Core::EnumerateType<EncodingTypes> enumValue(_deflate.IsOpen() == true ? _current->Compression() : _current->ContentEncoding.Value());
 
-                            _keyIndex = 16;
+                            _keyIndex = 17;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_ENCODING : _T("Content-Encoding:"));
                             _value = enumValue.Data();
                             _offset = 0;
-                        } else if ((_keyIndex <= 16) && (_current->TransferEncoding.IsSet() == true)) {
+                        } else if ((_keyIndex <= 17) && (_current->TransferEncoding.IsSet() == true)) {
                             Core::EnumerateType<TransferTypes> enumValue(_current->TransferEncoding.Value());
 
-                            _keyIndex = 17;
+                            _keyIndex = 18;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __TRANSFER_ENCODING : _T("Transfer-Encoding:"));
                             _value = enumValue.Data();
                             _offset = 0;
-                        } else if ((_keyIndex <= 17) && (_current->Location.IsSet() == true)) {
-                            _keyIndex = 18;
+                        } else if ((_keyIndex <= 18) && (_current->Location.IsSet() == true)) {
+                            _keyIndex = 19;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __LOCATION : _T("Location:"));
                             _value = _current->Location.Value();
                             _offset = 0;
-                        } else if ((_keyIndex <= 18) && (_current->WakeUp.IsSet() == true)) {
-                            _keyIndex = 19;
+                        } else if ((_keyIndex <= 19) && (_current->WakeUp.IsSet() == true)) {
+                            _keyIndex = 20;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __WAKEUP : _T("Wakeup:"));
                             _value = _current->WakeUp.Value();
                             _offset = 0;
-                        } else if ((_keyIndex <= 19) && (_current->USN.IsSet() == true)) {
-                            _keyIndex = 20;
+                        } else if ((_keyIndex <= 20) && (_current->USN.IsSet() == true)) {
+                            _keyIndex = 21;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __USN : _T("USN:"));
                             _value = _current->USN.Value();
                             _offset = 0;
-                        } else if ((_keyIndex <= 20) && (_current->ST.IsSet() == true)) {
-                            _keyIndex = 21;
+                        } else if ((_keyIndex <= 21) && (_current->ST.IsSet() == true)) {
+                            _keyIndex = 22;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ST : _T("ST:"));
                             _value = _current->ST.Value();
                             _offset = 0;
-                        } else if ((_keyIndex <= 21) && (_current->CacheControl.IsSet() == true)) {
-                            _keyIndex = 22;
+                        } else if ((_keyIndex <= 22) && (_current->CacheControl.IsSet() == true)) {
+                            _keyIndex = 23;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CACHE_CONTROL : _T("Cache-Control:"));
                             _value = _current->CacheControl.Value();
                             _offset = 0;
-                        } else if ((_keyIndex <= 22) && (_current->ApplicationURL.IsSet() == true)) {
-                            _keyIndex = 23;
+                        } else if ((_keyIndex <= 23) && (_current->ApplicationURL.IsSet() == true)) {
+                            _keyIndex = 24;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __APPLICATION_URL : _T("Application-URL:"));
                             _value = _current->ApplicationURL.Value().Text();
                             _offset = 0;
-                        } else if ((_keyIndex <= 23) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Response::CONNECTION_CLOSE))) {
-                            _keyIndex = (_bodyLength > 0 ? 24 : 25);
+                        } else if ((_keyIndex <= 24) && ((_bodyLength > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Response::CONNECTION_CLOSE))) {
+                            _keyIndex = (_bodyLength > 0 ? 25 : 26);
 
-                            Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
-                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
-                            number.Serialize(_value);
+                            if ((_bodyLength == static_cast<uint32_t>(~0)) || (_deflate.IsOpen() == true)) {
+                                // The (compressed) body size is not known up front, it is sent in chunks.
+                                _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __TRANSFER_ENCODING : _T("Transfer-Encoding:"));
+                                _value = _T("chunked");
+                            } else {
+                                Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
+                                _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
+                                number.Serialize(_value);
+                            }
                             _offset = 0;
-                        } else if ((_keyIndex <= 24) && (_current->ContentSignature.IsSet() == true)) {
-                            _keyIndex = 25;
+                        } else if ((_keyIndex <= 25) && (_current->ContentSignature.IsSet() == true)) {
+                            _keyIndex = 26;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_SIGNATURE : _T("Content-HMAC:"));
                             FromSignature(_current->ContentSignature.Value(), _value);
                             _offset = 0;
+                        } else if ((_keyIndex <= 26) && (_current->ContentRange.IsSet() == true)) {
+                            _keyIndex = 27;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_RANGE : _T("Content-Range:"));
+                            _value = _current->ContentRange.Value();
+                            _offset = 0;
                         }
                     }
 
@@ -1248,21 +1436,59 @@ namespace Web
                     break;
                 }
                 case BODY: {
-                    if (_bodyLength != 0) {
-                        ASSERT(maxLength >= current);
-                        uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
+                    if ((_bodyLength == static_cast<uint32_t>(~0)) || (_deflate.IsOpen() == true)) {
+                        // Each chunk is its size in four hex digits, the data and a CRLF. The body is
+                        // done once it has nothing more to give, that is closed with an empty chunk.
+                        ASSERT(_current->_body.IsValid() == true);
+
+                        if ((maxLength - current) <= ChunkFraming) {
+                            // Not worth a chunk, continue in the next buffer.
+                            limit = current;
+                        } else {
+                            uint16_t size = (_deflate.IsOpen() == true ? Compress(&(stream[current + 6]), maxLength - current - ChunkFraming) : _current->_body->Serialize(&(stream[current + 6]), maxLength - current - ChunkFraming));
 
-                        if (size > 0) {
+                            if (size == 0) {
+                                ::memcpy(&(stream[current]), "0\r\n\r\n", 5);
+                                current += 5;
+                                _deflate.Close();
+                                _state = REPORT;
+                            } else {
+                                static const TCHAR hexDigits[] = _T("0123456789ABCDEF");
+
+                                stream[current + 0] = hexDigits[(size >> 12) & 0xF];
+                                stream[current + 1] = hexDigits[(size >> 8) & 0xF];
+                                stream[current + 2] = hexDigits[(size >> 4) & 0xF];
+                                stream[current + 3] = hexDigits[size & 0xF];
+                                stream[current + 4] = '\r';
+                                stream[current + 5] = '\n';
+                                stream[current + 6 + size] = '\r';
+                                stream[current + 7 + size] = '\n';
+                                current += size + ChunkFraming;
+                            }
+                        }
+                    } else {
+                        if (_bodyLength != 0) {
                             ASSERT(_current->_body.IsValid() == true);
 
-                            _current->_body->Serialize(&(stream[current]), size);
-                            _bodyLength -= size;
-                            current += size;
+                            const FileBody* file = dynamic_cast<const FileBody*>(&(*(_current->_body)));
+
+                            if ((file != nullptr) && (SendFile(file->Descriptor(), file->Position(), _bodyLength) == true)) {
+                                _bodyLength = 0;
+                            } else {
+                                ASSERT(maxLength >= current);
+                                uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
+
+                                if (size > 0) {
+                                    _current->_body->Serialize(&(stream[current]), size);
+                                    _bodyLength -= size;
+                                    current += size;
+                                }
+                            }
                         }
-                    }
 
-                    if (_bodyLength == 0) {
-                        _state = REPORT;
+                        if (_bodyLength == 0) {
+                            _state = REPORT;
+                        }
                     }
                     break;
                 }
@@ -1311,9 +1537,12 @@ namespace Web
                         _zlibResult = ret;
                     }
 
-                    parsed = _current->_body->Deserialize(out, static_cast<uint16_t>(sizeof(out) - _zlib.avail_out));
+                    _current->_body->Deserialize(out, static_cast<uint16_t>(sizeof(out) - _zlib.avail_out));
 
                 } while ((_zlib.avail_out == 0) && (_zlibResult == Z_OK));
+
+                // All input is taken, even if it did not inflate to anything (yet).
+                parsed = (_zlibResult == Z_OK ? maxLength : 0);
             } else if (_zlibResult == static_cast<uint32_t>(~0)) {
                 parsed = _current->_body->Deserialize(stream, maxLength);
             }
@@ -1409,13 +1638,13 @@ namespace Web
 
                     // Depending on the ContentEncoding, we need to prepare the data..
                     if ((_current->ContentEncoding.IsSet()) && (_current->ContentEncoding.Value() != EncodingTypes::ENCODING_UNKNOWN)) {
-                        /* allocate inflate state */
+                        /* allocate inflate state, gzip and zlib (deflate) wrapped data are both recognised */
                         _zlib.zalloc = nullptr;
                         _zlib.zfree = nullptr;
                         _zlib.opaque = nullptr;
                         _zlib.avail_in = 0;
                         _zlib.next_in = nullptr;
-                        _zlibResult = inflateInit2(&_zlib, 16 + MAX_WBITS);
+                        _zlibResult = inflateInit2(&_zlib, 32 + MAX_WBITS);
                     } else {
                         _zlibResult = static_cast<uint32_t>(~0);
                     }
@@ -1435,13 +1664,11 @@ namespace Web
                 }
             } else {
                 // See if we recognise this word...
-                Core::EnumerateType<Request::keywords> keyWord(buffer.c_str(), true);
-                if (keyWord.IsSet() == false) {
+                if (KeywordIndex<Request::keywords>::Instance().Find(buffer, _keyWord) == false) {
                     //TRACE_L1("Could not resolve keyword %s", buffer.c_str());
                     _parser.FlushLine();
                 } else {
                     // Seems like we have a hit. Collect a new entry and start setting it.
-                    _keyWord = keyWord.Value();
                     _parser.CollectLine();
                     _state = PAIR_VALUE;
                 }
@@ -1492,6 +1719,9 @@ namespace Web
             case Request::AUTHORIZATION:
                 _current->WebToken = ToAuthorization(buffer);
                 break;
+            case Request::RANGE:
+                _current->Range = buffer;
+                break;
             case Request::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1509,12 +1739,14 @@ namespace Web
                 break;
             }
             case Request::ACCEPT_ENCODING: {
-                // We only allow for GZIP, right now, so see if it is an allowed format, if so, use it.
+                // We allow for GZIP and DEFLATE, so see if it is an allowed format, if so, use it. GZIP is preferred.
                 Core::TextSegmentIterator entries(Core::TextFragment(buffer), true, ',');
 
                 while (entries.Next() != false) {
                     if (entries.Current().EqualText(__ENCODING_GZIP, 0, ((sizeof(__ENCODING_GZIP) / sizeof(TCHAR)) - 1), false) == true) {
                         _current->AcceptEncoding = ENCODING_GZIP;
+                    } else if ((entries.Current().EqualText(__ENCODING_DEFLATE, 0, ((sizeof(__ENCODING_DEFLATE) / sizeof(TCHAR)) - 1), false) == true) && (_current->AcceptEncoding.IsSet() == false)) {
+                        _current->AcceptEncoding = ENCODING_DEFLATE;
                     }
                 }
                 break;
@@ -1704,9 +1936,12 @@ namespace Web
                         _zlibResult = ret;
                     }
 
-                    parsed = _current->_body->Deserialize(out, static_cast<uint16_t>(sizeof(out) - _zlib.avail_out));
+                    _current->_body->Deserialize(out, static_cast<uint16_t>(sizeof(out) - _zlib.avail_out));
 
                 } while ((_zlib.avail_out == 0) && (_zlibResult == Z_OK));
+
+                // All input is taken, even if it did not inflate to anything (yet).
+                parsed = (_zlibResult == Z_OK ? maxLength : 0);
             } else if (_zlibResult == static_cast<uint32_t>(~0)) {
                 parsed = _current->_body->Deserialize(stream, maxLength);
             }
@@ -1773,13 +2008,13 @@ namespace Web
 
                     // Depending on the ContentEncoding, we need to prepare the data..
                     if ((_current->ContentEncoding.IsSet()) && (_current->ContentEncoding.Value() != EncodingTypes::ENCODING_UNKNOWN)) {
-                        /* allocate inflate state */
+                        /* allocate inflate state, gzip and zlib (deflate) wrapped data are both recognised */
                         _zlib.zalloc = nullptr;
                         _zlib.zfree = nullptr;
                         _zlib.opaque = nullptr;
                         _zlib.avail_in = 0;
                         _zlib.next_in = nullptr;
-                        _zlibResult = inflateInit2(&_zlib, 16 + MAX_WBITS);
+                        _zlibResult = inflateInit2(&_zlib, 32 + MAX_WBITS);
                     } else {
                         _zlibResult = static_cast<uint32_t>(~0);
                     }
@@ -1805,13 +2040,11 @@ namespace Web
                 break;
             } else {
                 // See if we recognise this word...
-                Core::EnumerateType<Response::keywords> keyWord(buffer.c_str(), true);
-                if (keyWord.IsSet() == false) {
+                if (KeywordIndex<Response::keywords>::Instance().Find(buffer, _keyWord) == false) {
                     //TRACE_L1("Could not resolve keyword %s", buffer.c_str());
                     _parser.FlushLine();
                 } else {
                     // Seems like we have a hit. Collect a new entry and start setting it.
-                    _keyWord = keyWord.Value();
                     _parser.CollectLine();
                     _state = PAIR_VALUE;
                 }
@@ -1841,6 +2074,9 @@ namespace Web
             case Response::WEBSOCKET_PROTOCOL:
                 _current->WebSocketProtocol = buffer;
                 break;
+            case Response::WEBSOCKET_EXTENSIONS:
+                _current->WebSocketExtensions = buffer;
+                break;
             case Response::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1859,6 +2095,9 @@ namespace Web
             case Response::APPLICATION_URL:
                 _current->ApplicationURL = Core::URL(buffer);
                 break;
+            case Response::CONTENT_RANGE:
+                _current->ContentRange = buffer;
+                break;
             case Response::CACHE_CONTROL:
                 _current->CacheControl = buffer;
                 break;
@@ -150,12 +150,14 @@ namespace Web {
             : Core::File()
             , _opened(false)
             , _startPosition(0)
+            , _length(~0)
         {
         }
         FileBody(const string& path)
             : Core::File(path)
             , _opened(false)
             , _startPosition(0)
+            , _length(~0)
         {
         }
         ~FileBody() override = default;
@@ -165,6 +167,7 @@ namespace Web {
         {
             Core::File::operator=(location);
             _startPosition = 0;
+            _length = ~0;
 
             return (*this);
         }
@@ -172,21 +175,42 @@ namespace Web {
         {
             Core::File::operator=(RHS);
             _startPosition = static_cast<int32_t>(Core::File::Position());
+            _length = ~0;
 
             return (*this);
         }
 
+        // Only length bytes from offset on are the body, e.g. for a range request.
+        inline void Range(const uint32_t offset, const uint32_t length)
+        {
+            _startPosition = static_cast<int32_t>(offset);
+            _length = length;
+        }
+        // While being serialized, the body is at Position() of the file with this handle, so a link
+        // can send it straight from the file.
+        inline Core::File::Handle Descriptor() const
+        {
+            return (const_cast<FileBody*>(this)->operator Core::File::Handle());
+        }
+
     protected:
         uint32_t Serialize() const override
         {
+            uint32_t result = 0;
+
             // Are we opening the file ?
             _opened = (Core::File::IsOpen() == false);
 
             if (_opened == false) {
                 const_cast<FileBody*>(this)->LoadFileInfo();
+            }
+            if (((_opened == false) || (Core::File::Open() == true)) && (static_cast<uint64_t>(_startPosition) <= Core::File::Size())) {
+                const uint64_t available = Core::File::Size() - _startPosition;
+
                 const_cast<FileBody*>(this)->Position(false, _startPosition);
+                result = static_cast<uint32_t>(available < _length ? available : _length);
             }
-            return (((_opened == false) || (Core::File::Open() == true)) ? static_cast<uint32_t>(Core::File::Size() - _startPosition) : 0);
+            return (result);
         }
         uint32_t Deserialize() override
         {
@@ -224,6 +248,7 @@ namespace Web {
     private:
         mutable bool _opened;
         mutable int32_t _startPosition;
+        uint32_t _length;
     };
 
     template <typename HASHALGORITHM>
@@ -334,6 +359,8 @@ namespace Web {
         JSONBodyType()
             : JSONOBJECT()
             , _offset(0)
+            , _chunked(false)
+            , _streaming(false)
         {
         }
         ~JSONBodyType() override = default;
@@ -349,6 +376,13 @@ namespace Web {
         {
             JSONOBJECT::Clear();
             _offset = 0;
+            _chunked = false;
+        }
+        // Large bodies are serialized while they are sent, in chunks, instead of being converted
+        // to text before the headers go out.
+        inline void Chunked(const bool enabled)
+        {
+            _chunked = enabled;
         }
 
     protected:
@@ -357,6 +391,11 @@ namespace Web {
             _lastPosition = 0;
             _body.clear();
 
+            if (_chunked == true) {
+                _streaming = true;
+                return (static_cast<uint32_t>(~0));
+            }
+
             JSONOBJECT::ToString(_body);
 
             if (_body.length() <= 2) {
@@ -371,11 +410,21 @@ namespace Web {
         }
         uint16_t Serialize(uint8_t stream[], const uint16_t maxLength) const override
         {
-            uint16_t size = static_cast<uint16_t>(maxLength > (_body.length() * sizeof(TCHAR)) ? (_body.length() * sizeof(TCHAR)) : (sizeof(TCHAR) == 1 ? maxLength : (maxLength & 0xFFFE)));
+            uint16_t size = 0;
 
-            if (size > 0) {
-                ::memcpy(stream, &(reinterpret_cast<const uint8_t*>(_body.c_str())[_lastPosition]), size);
-                _lastPosition += size;
+            if (_chunked == true) {
+                // The position is the offset of the ongoing serialization, until it completes.
+                if (_streaming == true) {
+                    size = static_cast<const Core::JSON::IElement&>(*this).Serialize(reinterpret_cast<char*>(stream), maxLength, _lastPosition);
+                    _streaming = (_lastPosition != 0);
+                }
+            } else {
+                size = static_cast<uint16_t>(maxLength > (_body.length() * sizeof(TCHAR)) ? (_body.length() * sizeof(TCHAR)) : (sizeof(TCHAR) == 1 ? maxLength : (maxLength & 0xFFFE)));
+
+                if (size > 0) {
+                    ::memcpy(stream, &(reinterpret_cast<const uint8_t*>(_body.c_str())[_lastPosition]), size);
+                    _lastPosition += size;
+                }
             }
             return size;
         }
@@ -391,6 +440,8 @@ namespace Web {
         mutable uint32_t _lastPosition;
         mutable string _body;
         uint32_t _offset;
+        bool _chunked;
+        mutable bool _streaming;
     };
 
     template <typename JSONOBJECT, typename HASHALGORITHM>
@@ -19,6 +19,12 @@
 
 #include "WebSocketLink.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 namespace WPEFramework {
 namespace Web {
     namespace WebSocket {
@@ -40,8 +46,389 @@ namespace Web {
         static const uint8_t TYPE_FRAME = 0x0F;
         static const uint8_t MASKING_FRAME = 0x80;
         static const uint8_t CONTROL_FRAME = 0x08;
+        static const uint8_t RESERVED_FRAME = 0x70;
+        static const uint8_t COMPRESSED_FRAME = 0x40;
         static const uint8_t HandShakeKey[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 
+        // XOR the 4 byte key over the data, starting with key byte phase, 16 (SIMD) or 8 bytes at the time.
+        // The destination may be the source or lie before it, as the data is read ahead of being written.
+        static void Mask(uint8_t destination[], const uint8_t source[], const uint32_t length, const uint8_t key[4], const uint8_t phase)
+        {
+            uint8_t pattern[16];
+            uint64_t word;
+            uint64_t wordPattern;
+            uint32_t index = 0;
+
+            for (uint8_t position = 0; position < sizeof(pattern); position++) {
+                pattern[position] = key[(phase + position) & 0x3];
+            }
+
+#if defined(__SSE2__)
+            const __m128i widePattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+
+            for (; (index + 16) <= length; index += 16) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&(destination[index])), _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&(source[index]))), widePattern));
+            }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+            const uint8x16_t widePattern = vld1q_u8(pattern);
+
+            for (; (index + 16) <= length; index += 16) {
+                vst1q_u8(&(destination[index]), veorq_u8(vld1q_u8(&(source[index])), widePattern));
+            }
+#endif
+            ::memcpy(&wordPattern, pattern, sizeof(wordPattern));
+
+            for (; (index + sizeof(word)) <= length; index += sizeof(word)) {
+                ::memcpy(&word, &(source[index]), sizeof(word));
+                word ^= wordPattern;
+                ::memcpy(&(destination[index]), &word, sizeof(word));
+            }
+
+            for (; index < length; index++) {
+                destination[index] = (source[index] ^ pattern[index & 0x3]);
+            }
+        }
+
+        // The empty stored block a flush ends with, stripped from, and appended to, each message.
+        static const uint8_t FlushTrailer[] = { 0x00, 0x00, 0xFF, 0xFF };
+        static const TCHAR PerMessageDeflateName[] = _T("permessage-deflate");
+
+        PerMessageDeflate::PerMessageDeflate(const uint8_t level, const uint32_t threshold, const uint8_t deflateBits, const bool deflateReset, const uint8_t inflateBits, const bool inflateReset)
+            : _threshold(threshold)
+            , _send(IDLE)
+            , _compressed(false)
+            , _deflateReset(deflateReset)
+            , _inflateReset(inflateReset)
+            , _last(false)
+            , _trailer(false)
+            , _full(false)
+            , _tailSize(0)
+            , _loaded(0)
+            , _offset(0)
+        {
+            ::memset(&_deflater, 0, sizeof(_deflater));
+            ::memset(&_inflater, 0, sizeof(_inflater));
+
+            if (deflateBits == 0) {
+                // Nothing goes out compressed, everything is handed out as is.
+                _threshold = ~0;
+            } else {
+                // Scale the hash chains with the window, at 15 bits this is the zlib default.
+                int memLevel = (deflateBits > (8 + 7) ? 8 : deflateBits - 7);
+
+                if (deflateInit2(&_deflater, level, Z_DEFLATED, -deflateBits, memLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+                    _threshold = ~0;
+                }
+            }
+
+            // A window of 8 bits is not supported by all zlib versions, a larger one can always inflate it.
+            inflateInit2(&_inflater, -(inflateBits < 9 ? 9 : inflateBits));
+        }
+
+        PerMessageDeflate::~PerMessageDeflate()
+        {
+            // Safe on a stream that failed, or never had, its init.
+            deflateEnd(&_deflater);
+            inflateEnd(&_inflater);
+        }
+
+        uint8_t* PerMessageDeflate::Input(uint16_t& size)
+        {
+            uint8_t* result = nullptr;
+
+            if ((_send == IDLE) || ((_send == LOADING) && (_deflater.avail_in == 0)) || ((_send == PLAIN) && (_offset == _loaded))) {
+                size = sizeof(_input);
+                result = _input;
+            }
+
+            return (result);
+        }
+
+        void PerMessageDeflate::Load(const uint16_t length)
+        {
+            ASSERT((_send == IDLE) || (_send == LOADING) || (_send == PLAIN));
+
+            if ((_send == IDLE) && (length != 0)) {
+                // Only if the first piece holds the complete message, we know its size.
+                _compressed = ((_threshold != static_cast<uint32_t>(~0)) && ((length == sizeof(_input)) || (length >= _threshold)));
+                _send = (_compressed == true ? LOADING : PLAIN);
+            }
+
+            if (_send == PLAIN) {
+                // A full piece means there is more to come, an empty one that the previous completed it.
+                _send = (length == 0 ? IDLE : PLAIN);
+                _loaded = length;
+                _offset = 0;
+            } else if (_send == LOADING) {
+                _send = (length < sizeof(_input) ? FLUSHING : LOADING);
+                _deflater.next_in = _input;
+                _deflater.avail_in = length;
+            }
+        }
+
+        uint16_t PerMessageDeflate::Deflate(uint8_t stream[], const uint16_t maxLength)
+        {
+            uint16_t result = 0;
+
+            if (_send == PLAIN) {
+                result = std::min(static_cast<uint16_t>(_loaded - _offset), maxLength);
+
+                ::memcpy(stream, &(_input[_offset]), result);
+                _offset += result;
+
+                if ((_offset == _loaded) && (_loaded < sizeof(_input))) {
+                    _send = IDLE;
+                }
+            } else if (_send != IDLE) {
+                // The output trails 4 bytes behind. If the message turns out to be complete, they are
+                // the flush trailer, which is not send.
+                ASSERT(maxLength > sizeof(_tail));
+
+                ::memcpy(stream, _tail, _tailSize);
+
+                _deflater.next_out = &(stream[_tailSize]);
+                _deflater.avail_out = maxLength - _tailSize;
+
+                int outcome = deflate(&_deflater, (_send == FLUSHING ? Z_SYNC_FLUSH : Z_NO_FLUSH));
+
+                ASSERT(outcome != Z_STREAM_ERROR);
+                DEBUG_VARIABLE(outcome);
+
+                uint16_t produced = maxLength - static_cast<uint16_t>(_deflater.avail_out);
+
+                if ((_send == FLUSHING) && (_deflater.avail_in == 0) && (_deflater.avail_out != 0)) {
+                    ASSERT(produced >= sizeof(FlushTrailer));
+                    ASSERT(::memcmp(&(stream[produced - sizeof(FlushTrailer)]), FlushTrailer, sizeof(FlushTrailer)) == 0);
+
+                    result = produced - sizeof(FlushTrailer);
+                    _tailSize = 0;
+                    _send = IDLE;
+
+                    if (_deflateReset == true) {
+                        deflateReset(&_deflater);
+                    }
+                } else {
+                    _tailSize = static_cast<uint8_t>(std::min(produced, static_cast<uint16_t>(sizeof(_tail))));
+                    result = produced - _tailSize;
+                    ::memcpy(_tail, &(stream[result]), _tailSize);
+                }
+            }
+
+            return (result);
+        }
+
+        void PerMessageDeflate::Load(const uint8_t data[], const uint16_t length, const bool last)
+        {
+            ASSERT(_inflater.avail_in == 0);
+
+            _inflater.next_in = const_cast<uint8_t*>(data);
+            _inflater.avail_in = length;
+            _last = last;
+        }
+
+        uint16_t PerMessageDeflate::Inflate(uint8_t*& stream)
+        {
+            uint16_t result = 0;
+
+            stream = _output;
+
+            while ((result == 0) && ((_inflater.avail_in != 0) || (_last == true) || (_full == true))) {
+                if ((_inflater.avail_in == 0) && (_last == true)) {
+                    _inflater.next_in = const_cast<uint8_t*>(FlushTrailer);
+                    _inflater.avail_in = sizeof(FlushTrailer);
+                    _last = false;
+                    _trailer = true;
+                }
+
+                _inflater.next_out = _output;
+                _inflater.avail_out = sizeof(_output);
+
+                int outcome = inflate(&_inflater, Z_SYNC_FLUSH);
+
+                result = sizeof(_output) - static_cast<uint16_t>(_inflater.avail_out);
+                _full = (_inflater.avail_out == 0);
+
+                if ((outcome != Z_OK) && (outcome != Z_BUF_ERROR)) {
+                    if (outcome != Z_STREAM_END) {
+                        TRACE_L1("Inflating a WebSocket message failed (%d)", outcome);
+                    }
+
+                    // The message ended here (or is lost), what is left of it is dropped.
+                    inflateReset(&_inflater);
+                    _inflater.avail_in = 0;
+                    _full = false;
+                }
+            }
+
+            if ((result == 0) && (_trailer == true)) {
+                _trailer = false;
+
+                if (_inflateReset == true) {
+                    inflateReset(&_inflater);
+                }
+            }
+
+            return (result);
+        }
+
+        namespace {
+
+            // The permessage-deflate parameters of one extension entry, window bits of 0 mean not
+            // present, ~0 present without a value.
+            struct Parameters {
+                bool serverNoContextTakeover;
+                bool clientNoContextTakeover;
+                uint8_t serverMaxWindowBits;
+                uint8_t clientMaxWindowBits;
+            };
+
+            bool WindowBits(const Core::TextFragment& value, uint8_t& bits)
+            {
+                Core::TextFragment number(value);
+
+                number.TrimBegin(_T(" \t\""));
+                number.TrimEnd(_T(" \t\""));
+
+                bits = 0;
+
+                if ((number.Length() > 0) && (number.Length() <= 2)) {
+                    Core::NumberType<uint8_t>::Convert(number.Data(), number.Length(), bits, BASE_DECIMAL);
+                }
+
+                return ((bits >= 8) && (bits <= MAX_WBITS));
+            }
+
+            bool Parse(const Core::TextFragment& extension, Parameters& parameters)
+            {
+                Core::TextSegmentIterator elements(extension, true, ';');
+                bool result = false;
+
+                ::memset(&parameters, 0, sizeof(parameters));
+
+                if (elements.Next() == true) {
+                    Core::TextFragment name(elements.Current());
+
+                    name.TrimBegin(_T(" \t"));
+                    name.TrimEnd(_T(" \t"));
+
+                    result = name.EqualText(Core::TextFragment(PerMessageDeflateName), false);
+
+                    while ((result == true) && (elements.Next() == true)) {
+                        Core::TextFragment element(elements.Current());
+                        uint32_t assign = element.ForwardFind('=');
+                        Core::TextFragment key(element, 0, (assign < element.Length() ? assign : element.Length()));
+
+                        key.TrimBegin(_T(" \t"));
+                        key.TrimEnd(_T(" \t"));
+
+                        // Unknown or repeated parameters, make the whole entry invalid.
+                        if (key.EqualText(_T("server_no_context_takeover"), 0, 0, false) == true) {
+                            result = ((assign >= element.Length()) && (parameters.serverNoContextTakeover == false));
+                            parameters.serverNoContextTakeover = true;
+                        } else if (key.EqualText(_T("client_no_context_takeover"), 0, 0, false) == true) {
+                            result = ((assign >= element.Length()) && (parameters.clientNoContextTakeover == false));
+                            parameters.clientNoContextTakeover = true;
+                        } else if (key.EqualText(_T("server_max_window_bits"), 0, 0, false) == true) {
+                            result = ((assign < element.Length()) && (parameters.serverMaxWindowBits == 0) && (WindowBits(Core::TextFragment(element, assign + 1, element.Length() - assign - 1), parameters.serverMaxWindowBits) == true));
+                        } else if (key.EqualText(_T("client_max_window_bits"), 0, 0, false) == true) {
+                            if (parameters.clientMaxWindowBits != 0) {
+                                result = false;
+                            } else if (assign >= element.Length()) {
+                                parameters.clientMaxWindowBits = static_cast<uint8_t>(~0);
+                            } else {
+                                result = WindowBits(Core::TextFragment(element, assign + 1, element.Length() - assign - 1), parameters.clientMaxWindowBits);
+                            }
+                        } else {
+                            result = false;
+                        }
+                    }
+                }
+
+                return (result);
+            }
+        }
+
+        string Protocol::Offer() const
+        {
+            string result;
+
+            if (_level != 0) {
+                result = string(PerMessageDeflateName) + _T("; client_max_window_bits");
+
+                if (_windowBits < MAX_WBITS) {
+                    result += '=' + Core::NumberType<uint8_t>(_windowBits).Text() + _T("; server_max_window_bits=") + Core::NumberType<uint8_t>(_windowBits).Text();
+                }
+                if (_contextTakeover == false) {
+                    result += _T("; client_no_context_takeover; server_no_context_takeover");
+                }
+            }
+
+            return (result);
+        }
+
+        bool Protocol::Confirm(const string& response)
+        {
+            Core::TextSegmentIterator extensions(Core::TextFragment(response), true, ',');
+            Parameters parameters;
+
+            ASSERT(_extension == nullptr);
+
+            while ((_extension == nullptr) && (_level != 0) && (extensions.Next() == true)) {
+                if ((Parse(extensions.Current(), parameters) == true) && (parameters.clientMaxWindowBits != static_cast<uint8_t>(~0))) {
+                    uint8_t inflateBits = (parameters.serverMaxWindowBits == 0 ? MAX_WBITS : parameters.serverMaxWindowBits);
+                    uint8_t deflateBits = (parameters.clientMaxWindowBits == 0 ? _windowBits : std::min(_windowBits, parameters.clientMaxWindowBits));
+
+                    // The server must stay within the window it was asked for.
+                    if (inflateBits <= _windowBits) {
+                        // zlib can not deflate with a window of 8 bits, send uncompressed then.
+                        _extension = new PerMessageDeflate(_level, _threshold, (deflateBits < 9 ? 0 : deflateBits), ((parameters.clientNoContextTakeover == true) || (_contextTakeover == false)), inflateBits, parameters.serverNoContextTakeover);
+                    }
+                }
+            }
+
+            return (_extension != nullptr);
+        }
+
+        bool Protocol::Accept(const string& offers, string& response)
+        {
+            Core::TextSegmentIterator extensions(Core::TextFragment(offers), true, ',');
+            Parameters parameters;
+
+            ASSERT(_extension == nullptr);
+
+            while ((_extension == nullptr) && (_level != 0) && (extensions.Next() == true)) {
+                if (Parse(extensions.Current(), parameters) == true) {
+                    uint8_t deflateBits = (parameters.serverMaxWindowBits == 0 ? _windowBits : std::min(_windowBits, parameters.serverMaxWindowBits));
+                    uint8_t inflateBits = (parameters.clientMaxWindowBits == 0 ? MAX_WBITS : (parameters.clientMaxWindowBits == static_cast<uint8_t>(~0) ? _windowBits : std::min(_windowBits, parameters.clientMaxWindowBits)));
+
+                    // Skip offers that need a window zlib can not deflate with, or one larger than allowed.
+                    if ((deflateBits >= 9) && (inflateBits <= _windowBits)) {
+                        bool deflateReset = ((parameters.serverNoContextTakeover == true) || (_contextTakeover == false));
+                        bool inflateReset = ((parameters.clientNoContextTakeover == true) || (_contextTakeover == false));
+
+                        response = PerMessageDeflateName;
+
+                        if (deflateReset == true) {
+                            response += _T("; server_no_context_takeover");
+                        }
+                        if (inflateReset == true) {
+                            response += _T("; client_no_context_takeover");
+                        }
+                        if ((parameters.serverMaxWindowBits != 0) || (deflateBits < MAX_WBITS)) {
+                            response += _T("; server_max_window_bits=") + Core::NumberType<uint8_t>(deflateBits).Text();
+                        }
+                        if ((parameters.clientMaxWindowBits != 0) && (inflateBits < MAX_WBITS)) {
+                            response += _T("; client_max_window_bits=") + Core::NumberType<uint8_t>(inflateBits).Text();
+                        }
+
+                        _extension = new PerMessageDeflate(_level, _threshold, deflateBits, deflateReset, inflateBits, inflateReset);
+                    }
+                }
+            }
+
+            return (_extension != nullptr);
+        }
+
         std::string Protocol::RequestKey() const
         {
             string baseEncodedKey;
@@ -84,10 +471,10 @@ namespace Web {
             if ((usedSize != 0) || (SendInProgress() == true)) {
                 result = (usedSize <= 125 ? 2 : 4);
 
+                // The payload is at HeaderSpace(), that fits the largest header. Only a small frame, with its
+                // 2 bytes shorter header, needs to move its payload (at most 125 bytes) up front.
                 if ((_setFlags & MASKING_FRAME) == 0) {
-                    // Only if this is a smallFrame, we need to "flush" 2 bytes..
                     if ((result == 2) && (usedSize != 0)) {
-                        // No masking, so just move and insert the header up front..
                         ::memmove(&dataFrame[2], &(dataFrame[4]), usedSize);
                     }
                 } else {
@@ -100,18 +487,8 @@ namespace Web {
                     maskKey[2] = (value >> 16) & 0xFF;
                     maskKey[3] = (value >> 24) & 0xFF;
 
-                    // Mask and insert the bytes on the right spots
-                    uint8_t* source = &dataFrame[usedSize - 1 + 4];
-                    uint8_t* destination = &dataFrame[usedSize - 1 + 4 + result];
-                    uint32_t bytesToMove = usedSize;
+                    Mask(&(dataFrame[result + 4]), &(dataFrame[8]), usedSize, maskKey, 0);
 
-                    while (bytesToMove != 0) {
-                        bytesToMove--;
-                        *destination-- = (*source ^ maskKey[(bytesToMove & 0x3)]);
-                        source--;
-                    }
-
-                    // Now there is space again, write down the encryption key.
                     ::memcpy(&dataFrame[result], &maskKey, 4);
                     result += 4;
                 }
@@ -125,13 +502,17 @@ namespace Web {
                     dataFrame[3] = (usedSize & 0xFF);
                 }
 
-                if (usedSize < maxSendSize) {
+                // A compressed message is done once flushed out, its size does not tell.
+                uint8_t compressed = ((_extension != nullptr) && (_extension->IsCompressed() == true) ? COMPRESSED_FRAME : 0);
+                bool finished = (_extension != nullptr ? (_extension->IsSending() == false) : (usedSize < maxSendSize));
+
+                if (finished == true) {
                     // Seems like not all available space is used, so I guess we are ready..
-                    dataFrame[0] = FINISHING_FRAME | (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                    dataFrame[0] = FINISHING_FRAME | (SendInProgress() == true ? CONTINUATION_FRAME : (TYPE_FRAME & _setFlags) | compressed);
                     _progressInfo &= (~0x40);
                 } else {
                     // There is more to come, this is just part of a bigger picture
-                    dataFrame[0] = (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                    dataFrame[0] = (SendInProgress() == true ? CONTINUATION_FRAME : (TYPE_FRAME & _setFlags) | compressed);
                     _progressInfo |= (0x40);
                 }
 
@@ -175,12 +556,10 @@ namespace Web {
                         receivedSize = _pendingReceiveBytes;
                     }
 
-                    for (uint16_t tmp = receivedSize; _pendingReceiveBytes != 0 && tmp != 0; --tmp) {
-                        *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                        source++;
-                        _progressInfo = ((_progressInfo + 1) & 0x03) | (_progressInfo & 0xFC);
-                        _pendingReceiveBytes--;
-                    }
+                    Mask(source, source, receivedSize, _scrambleKey, (_progressInfo & 0x3));
+
+                    _progressInfo = ((_progressInfo + receivedSize) & 0x03) | (_progressInfo & 0xFC);
+                    _pendingReceiveBytes -= receivedSize;
                 } else {
                     if (_pendingReceiveBytes > receivedSize) {
                         _pendingReceiveBytes -= receivedSize;
@@ -197,14 +576,22 @@ namespace Web {
                 uint32_t bytesToMove = (dataFrame[1] & 0x7F);
 
                 // check if the full header is present..
-                actualHeader = 2 + (bytesToMove == 127 ? 4 : (bytesToMove == 126 ? 2 : 0)) + ((dataFrame[1] & MASKING_FRAME) ? 4 : 0);
+                actualHeader = 2 + (bytesToMove == 127 ? 8 : (bytesToMove == 126 ? 2 : 0)) + ((dataFrame[1] & MASKING_FRAME) ? 4 : 0);
 
                 if (actualHeader > receivedSize) {
                     // Frame too small to identify the content yet !!
                     receivedSize = 0;
                     actualHeader = 0;
                 } else {
-                    _frameType = static_cast<frameType>(dataFrame[0] & TYPE_FRAME);
+                    const uint8_t opCode = (dataFrame[0] & TYPE_FRAME);
+
+                    _frameType = static_cast<frameType>(opCode);
+
+                    // The first frame of a data message tells if it is compressed, only RSV1 can be set
+                    // on it and only if permessage-deflate is negotiated.
+                    if ((opCode != 0) && ((opCode & CONTROL_FRAME) == 0)) {
+                        _deflated = ((dataFrame[0] & COMPRESSED_FRAME) != 0);
+                    }
 
                     // Continuation frame is only allowed if a receive is in progress...
                     if (ReceiveInProgress() == true) {
@@ -231,12 +618,20 @@ namespace Web {
                         _frameType = INCONSISTENT;
                     }
 
+                    if (((dataFrame[0] & RESERVED_FRAME) != 0) && (((dataFrame[0] & RESERVED_FRAME) != COMPRESSED_FRAME) || (_extension == nullptr) || (opCode == 0) || ((opCode & CONTROL_FRAME) != 0))) {
+                        _frameType = VIOLATION;
+                    }
+                    // Frames are limited to 4GB, the upper half of a 64 bits length must be 0.
+                    else if ((bytesToMove == 127) && ((dataFrame[2] | dataFrame[3] | dataFrame[4] | dataFrame[5]) != 0)) {
+                        _frameType = TOO_BIG;
+                    }
+
                     // If the frame is not an error, unpack/move what is required..
                     if ((_frameType & 0xF8) == 0) {
                         if (bytesToMove == 126) {
                             bytesToMove = ((dataFrame[2] << 8) + dataFrame[3]);
                         } else if (bytesToMove == 127) {
-                            bytesToMove = ((dataFrame[2] << 24) + (dataFrame[3] << 16) + (dataFrame[4] << 8) + dataFrame[5]);
+                            bytesToMove = ((static_cast<uint32_t>(dataFrame[6]) << 24) + (dataFrame[7] << 16) + (dataFrame[8] << 8) + dataFrame[9]);
                         }
 
                         // We might not have the full body yet...
@@ -260,14 +655,9 @@ namespace Web {
                             _progressInfo |= 0x20;
                             _progressInfo &= (~0x03);
 
-                            uint8_t* source = &dataFrame[actualHeader];
+                            Mask(&(dataFrame[actualHeader]), &(dataFrame[actualHeader]), bytesToMove, _scrambleKey, 0);
 
-                            while (bytesToMove != 0) {
-                                *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                                source++;
-                                bytesToMove--;
-                                _progressInfo = ((_progressInfo + 1) & 0xF3);
-                            }
+                            _progressInfo |= (bytesToMove & 0x03);
                         }
                     }
                 }
@@ -28,6 +28,71 @@
 namespace WPEFramework {
 namespace Web {
     namespace WebSocket {
+        // RFC 7692, permessage-deflate. Created once the extension is negotiated during the upgrade,
+        // the zlib state is not cheap: the window (2^windowBits) plus, for deflate, hash chains that
+        // are scaled down with the window.
+        class EXTERNAL PerMessageDeflate {
+        private:
+            enum state : uint8_t {
+                IDLE,
+                LOADING,
+                FLUSHING,
+                PLAIN
+            };
+
+            PerMessageDeflate() = delete;
+            PerMessageDeflate(const PerMessageDeflate&) = delete;
+            PerMessageDeflate& operator=(const PerMessageDeflate&) = delete;
+
+        public:
+            static constexpr uint16_t BufferSize = 1024;
+
+            // A deflateBits of 0, means no outgoing message is compressed.
+            PerMessageDeflate(const uint8_t level, const uint32_t threshold, const uint8_t deflateBits, const bool deflateReset, const uint8_t inflateBits, const bool inflateReset);
+            ~PerMessageDeflate();
+
+        public:
+            // Is a message being send?
+            inline bool IsSending() const
+            {
+                return (_send != IDLE);
+            }
+            // Is the message being send (or the last one send) compressed?
+            inline bool IsCompressed() const
+            {
+                return (_compressed);
+            }
+
+            // Sending, a message is loaded in pieces of at most BufferSize, a smaller piece completes it.
+            // Input returns nullptr as long as the previous piece is not consumed.
+            uint8_t* Input(uint16_t& size);
+            void Load(const uint16_t length);
+            uint16_t Deflate(uint8_t stream[], const uint16_t maxLength);
+
+            // Receiving, the payload of the frames is loaded as it comes in, Inflate returns 0 if all
+            // loaded data is handed out.
+            void Load(const uint8_t data[], const uint16_t length, const bool last);
+            uint16_t Inflate(uint8_t*& stream);
+
+        private:
+            uint32_t _threshold;
+            state _send;
+            bool _compressed;
+            bool _deflateReset;
+            bool _inflateReset;
+            bool _last;
+            bool _trailer;
+            bool _full;
+            uint8_t _tailSize;
+            uint8_t _tail[4];
+            uint16_t _loaded;
+            uint16_t _offset;
+            z_stream _deflater;
+            z_stream _inflater;
+            uint8_t _input[BufferSize];
+            uint8_t _output[BufferSize];
+        };
+
         class EXTERNAL Protocol {
         public:
             enum frameType {
@@ -60,10 +125,19 @@ namespace Web {
                 , _pendingReceiveBytes(0)
                 , _frameType(TEXT)
                 , _controlStatus(0)
+                , _level(0)
+                , _threshold(0)
+                , _windowBits(MAX_WBITS)
+                , _contextTakeover(true)
+                , _deflated(false)
+                , _extension(nullptr)
             {
             }
             ~Protocol()
             {
+                if (_extension != nullptr) {
+                    delete _extension;
+                }
             }
 
         public:
@@ -118,6 +192,79 @@ namespace Web {
             {
                 return ((_setFlags & 0x80) != 0);
             }
+            // Room to keep in front of the payload for the largest header of a frame with a 16 bits length,
+            // so the header is inserted (and the payload masked) without moving the payload.
+            inline uint8_t HeaderSpace() const
+            {
+                return (Masking() == true ? 8 : 4);
+            }
+
+            // permessage-deflate is offered/accepted during the upgrade if the level is not 0. Messages
+            // with a first piece that completes it below the threshold are not compressed. The window
+            // bits [9..15] and context takeover are the memory (and ratio) knobs.
+            inline void Compression(const uint8_t level, const uint32_t threshold, const uint8_t windowBits, const bool contextTakeover)
+            {
+                ASSERT(level <= 9);
+                ASSERT((windowBits >= 9) && (windowBits <= MAX_WBITS));
+
+                _level = level;
+                _threshold = threshold;
+                _windowBits = windowBits;
+                _contextTakeover = contextTakeover;
+            }
+            inline bool IsCompressed() const
+            {
+                return (_extension != nullptr);
+            }
+            // Is the message being received compressed?
+            inline bool IsDeflated() const
+            {
+                return (_deflated);
+            }
+
+            // Client side, the Sec-WebSocket-Extensions to send and the check of what the server replied.
+            string Offer() const;
+            bool Confirm(const string& response);
+            // Server side, pick the first acceptable offer and report what was accepted.
+            bool Accept(const string& offers, string& response);
+
+            // Fill the payload of a frame with the compressed message the SOURCE delivers through a
+            // SendData(uint8_t*, uint16_t) like the uncompressed payload is delivered.
+            template <typename SOURCE>
+            uint16_t Deflate(SOURCE& source, uint8_t stream[], const uint16_t maxLength)
+            {
+                ASSERT(_extension != nullptr);
+
+                uint16_t result = 0;
+                uint16_t size;
+                uint8_t* input;
+
+                do {
+                    if ((input = _extension->Input(size)) != nullptr) {
+                        _extension->Load(source.SendData(input, size));
+                    }
+
+                    result += _extension->Deflate(&(stream[result]), (maxLength - result));
+
+                } while ((_extension->IsSending() == true) && (static_cast<uint32_t>(maxLength - result) > sizeof(uint32_t)));
+
+                return (result);
+            }
+            // Hand the inflated payload to the SINK through its ReceiveData(uint8_t*, uint16_t).
+            template <typename SINK>
+            void Inflate(SINK& sink, const uint8_t data[], const uint16_t length)
+            {
+                ASSERT(_extension != nullptr);
+
+                uint8_t* output;
+                uint16_t size;
+
+                _extension->Load(data, length, ((ReceiveInProgress() == false) && (IsCompleteMessage() == true)));
+
+                while ((size = _extension->Inflate(output)) != 0) {
+                    sink.ReceiveData(output, size);
+                }
+            }
 
             uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize);
             uint16_t Decoder(uint8_t* dataFrame, uint16_t& receivedSize);
@@ -129,6 +276,12 @@ namespace Web {
             frameType _frameType;
             uint8_t _scrambleKey[4];
             uint8_t _controlStatus;
+            uint8_t _level;
+            uint32_t _threshold;
+            uint8_t _windowBits;
+            bool _contextTakeover;
+            bool _deflated;
+            PerMessageDeflate* _extension;
         };
 
         class EXTERNAL RequestAllocator : public Core::ProxyPoolType<Web::Request> {
@@ -289,6 +442,10 @@ namespace Web {
 
                     // TRACE_L1("Released the ref object %s [%p]\n", typeid(typename OUTBOUND::BaseElement).name(), &static_cast<typename OUTBOUND::BaseElement&>(*realItem));
                 }
+                virtual bool SendFile(const Core::File::Handle file, const uint64_t offset, const uint32_t length)
+                {
+                    return (_parent.Splice(TemplateIntToType<std::is_base_of<Core::SocketPort, ACTUALLINK>::value>(), file, offset, length));
+                }
 
             private:
                 ThisClass& _parent;
@@ -686,6 +843,14 @@ namespace Web {
             {
                 return (_handler.Masking());
             }
+            inline void Compression(const uint8_t level, const uint32_t threshold)
+            {
+                _serializerImpl.Compression(level, threshold);
+            }
+            inline void MessageCompression(const uint8_t level, const uint32_t threshold, const uint8_t windowBits, const bool contextTakeover)
+            {
+                _handler.Compression(level, threshold, windowBits, contextTakeover);
+            }
             inline bool Upgrade(const string& protocol, const string& path)
             {
                 string empty;
@@ -750,10 +915,26 @@ namespace Web {
                 _state = static_cast<EnumlinkState>(_state | ACTIVITY);
 
                 if ((_state & WEBSOCKET) != 0) {
-                    if (maxSendSize > 4) {
-                        result = _parent.SendData(&(dataFrame[4]), (maxSendSize - 4));
+                    const uint8_t headerSpace = _handler.HeaderSpace();
+
+                    if (maxSendSize > headerSpace) {
+                        result = Payload(&(dataFrame[headerSpace]), (maxSendSize - headerSpace));
 
-                        result = _handler.Encoder(dataFrame, (maxSendSize - 4), result);
+                        result = _handler.Encoder(dataFrame, (maxSendSize - headerSpace), result);
+
+                        // Messages waiting behind a completed one join the same write, each in a frame of
+                        // its own, as long as a small frame still fits. One send for a burst of messages.
+                        if (_handler.Masking() == false) {
+                            uint16_t loaded = result;
+
+                            while ((loaded != 0) && (_handler.SendInProgress() == false) && ((maxSendSize - result) > (4 + 125))) {
+                                loaded = Payload(&(dataFrame[result + 4]), (maxSendSize - result - 4));
+
+                                if (loaded != 0) {
+                                    result += _handler.Encoder(&(dataFrame[result]), (maxSendSize - result - 4), loaded);
+                                }
+                            }
+                        }
                     }
                 } else {
                     result = _serializerImpl.Serialize(dataFrame, maxSendSize);
@@ -826,6 +1007,10 @@ namespace Web {
                                 }
 
                                 result += headerSize; // actualDataSize
+                            } else if (_handler.IsDeflated() == true) {
+                                _handler.Inflate(_parent, &(dataFrame[result + headerSize]), actualDataSize);
+
+                                result += (headerSize + actualDataSize);
                             } else {
                                 _parent.ReceiveData(&(dataFrame[result + headerSize]), actualDataSize);
 
@@ -872,6 +1057,10 @@ namespace Web {
             }
 
         private:
+            inline uint16_t Payload(uint8_t* stream, const uint16_t maxLength)
+            {
+                return (_handler.IsCompressed() == true ? _handler.Deflate(_parent, stream, maxLength) : _parent.SendData(stream, maxLength));
+            }
             inline uint32_t CheckForClose(uint32_t waitTime)
             {
                 uint32_t result = 0;
@@ -918,6 +1107,16 @@ namespace Web {
                 UpgradeCompleted(TemplateIntToType<Core::TypeTraits::same_or_inherits<Web::Request, INBOUND>::value>());
             }
 
+            // Only a plain socket can send a (HTTP) file body straight from the file.
+            inline bool Splice(const TemplateIntToType<1>& /* For compile time diffrentiation */, const Core::File::Handle file, const uint64_t offset, const uint32_t length)
+            {
+                return (ACTUALLINK::SendFile(file, offset, length));
+            }
+            inline bool Splice(const TemplateIntToType<0>& /* For compile time diffrentiation */, const Core::File::Handle, const uint64_t, const uint32_t)
+            {
+                return (false);
+            }
+
             // ----------------------------------------------------------------------------------------------
             // SERVER upgrade to WebSocket, Diffrentiation via compiletime type: const TemplateIntToType<1>&
             // ----------------------------------------------------------------------------------------------
@@ -965,6 +1164,11 @@ namespace Web {
                             if (_protocol.empty() == false) {
                                 _webSocketMessage->WebSocketProtocol = _protocol;
                             }
+
+                            string extensions;
+                            if ((element->WebSocketExtensions.IsSet() == true) && (_handler.Accept(element->WebSocketExtensions.Value(), extensions) == true)) {
+                                _webSocketMessage->WebSocketExtensions = extensions;
+                            }
                         }
                     }
 
@@ -1027,6 +1231,11 @@ namespace Web {
                         _webSocketMessage->WebSocketProtocol = protocol;
                     }
 
+                    string extensions(_handler.Offer());
+                    if (extensions.empty() == false) {
+                        _webSocketMessage->WebSocketExtensions = extensions;
+                    }
+
                     _query = query;
                     _path = path;
                     _protocol = protocol;
@@ -1051,6 +1260,10 @@ namespace Web {
 
                     _adminLock.Lock();
 
+                    if ((element->WebSocketExtensions.IsSet() == true) && (_handler.Confirm(element->WebSocketExtensions.Value()) == false)) {
+                        TRACE_L1("Unsupported WebSocket extension [%s]", element->WebSocketExtensions.Value().c_str());
+                    }
+
                     // Seems like we succeeded, turn on the link..
                     _state = static_cast<EnumlinkState>((_state & 0xF0) | WEBSOCKET);
 
@@ -1266,6 +1479,19 @@ namespace Web {
         {
             _channel.Trigger();
         }
+        inline void Throttle(const bool enabled)
+        {
+            _channel.Throttle(enabled);
+        }
+        // Only for links with an OUTBOUND that can compress, e.g. Web::Response.
+        inline void Compression(const uint8_t level, const uint32_t threshold)
+        {
+            _channel.Compression(level, threshold);
+        }
+        inline void MessageCompression(const uint8_t level, const uint32_t threshold, const uint8_t windowBits, const bool contextTakeover)
+        {
+            _channel.MessageCompression(level, threshold, windowBits, contextTakeover);
+        }
         inline void Flush()
         {
             _channel.Flush();
@@ -1541,6 +1767,10 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void MessageCompression(const uint8_t level, const uint32_t threshold, const uint8_t windowBits, const bool contextTakeover)
+        {
+            _channel.MessageCompression(level, threshold, windowBits, contextTakeover);
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -1779,6 +2009,10 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void MessageCompression(const uint8_t level, const uint32_t threshold, const uint8_t windowBits, const bool contextTakeover)
+        {
+            _channel.MessageCompression(level, threshold, windowBits, contextTakeover);
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
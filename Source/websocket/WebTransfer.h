@@ -22,6 +22,7 @@
 
 #include "Module.h"
 #include "URL.h"
+#include "WebClient.h"
 #include "WebLink.h"
 #include "WebSerializer.h"
 
@@ -77,6 +78,8 @@ namespace Web {
                 : BaseClass(ELEMENTFACTORY_QUEUESIZE, std::forward<Args>(args)...)
                 , _parent(parent)
                 , _request()
+                , _idleSince(0)
+                , _reusable(false)
             {
             }
             ~Channel() override
@@ -84,6 +87,11 @@ namespace Web {
             }
 
         public:
+            // Whether the connection is still open after the previous transfer, and not for longer than idleTime.
+            inline bool IsReusable(const uint32_t idleTime) const
+            {
+                return ((_reusable == true) && (BaseClass::IsOpen() == true) && ((Core::Time::Now().Ticks() - _idleSince) < (static_cast<uint64_t>(idleTime) * Core::Time::TicksPerMillisecond)));
+            }
             uint32_t StartTransfer(const Core::ProxyType<Web::Request>& request)
             {
                 ASSERT(_request.IsValid() == false);
@@ -91,15 +99,18 @@ namespace Web {
 
                 uint32_t result = Core::ERROR_NONE;
 
+                _request = request;
+                _reusable = false;
+
                 if (BaseClass::IsOpen() == true) {
                     BaseClass::Submit(request);
                 } else {
-                    _request = request;
                     result = BaseClass::Open(0);
                 }
                 return result;
             }
             void Close() {
+                _reusable = false;
                 BaseClass::Close(Core::infinite);
                 BaseClass::Flush();
                 Clear();
@@ -124,9 +135,16 @@ namespace Web {
             void Received(Core::ProxyType<Web::Response>& response) override
             {
                 // Right we got what we wanted, process it..
-                _response = response;
+                if ((_parent._keepAlive != 0) && (Web::KeepAlive(*_request, *response) == true)) {
+                    // Leave the connection open for the next transfer to the same remote.
+                    _idleSince = Core::Time::Now().Ticks();
+                    _reusable = true;
+                    _parent.EndTransfer(Core::ProxyType<Web::Response>(response));
+                } else {
+                    _response = response;
 
-                BaseClass::Close(0);
+                    BaseClass::Close(0);
+                }
             }
 
             // Notification of a Response send.
@@ -145,7 +163,7 @@ namespace Web {
                     ASSERT(_request->IsValid() == true);
 
                     BaseClass::Submit(_request);
-                } else if ((_response.IsValid() == true) || (BaseClass::IsClosed() == true) || (BaseClass::IsSuspended() == true)) {
+                } else if ((_request.IsValid() == true) && ((_response.IsValid() == true) || (BaseClass::IsClosed() == true) || (BaseClass::IsSuspended() == true))) {
                     // Close the link and thus the transfer..
                     _parent.EndTransfer(_response);
                }
@@ -155,6 +173,8 @@ namespace Web {
             ThisClass& _parent;
             Core::ProxyType<Web::Request> _request;
             Core::ProxyType<Web::Response> _response;
+            uint64_t _idleSince;
+            bool _reusable;
         };
 
     public:
@@ -169,6 +189,8 @@ namespace Web {
         ClientTransferType(Args&&... args)
             : _adminLock()
             , _state(TRANSFER_IDLE)
+            , _keepAlive(0)
+            , _remote()
             , _request()
             , _fileBody()
             , _channel(*this, std::forward<Args>(args)...)
@@ -200,7 +222,7 @@ namespace Web {
                 if (source.IsValid() == true) {
                     result = Core::ERROR_COULD_NOT_SET_ADDRESS;
 
-                    if (Setup(source) == true) {
+                    if (Prepare(source) == true) {
                         result = Core::ERROR_NONE;
 
                         _state = TRANSFER_INFO;
@@ -234,7 +256,7 @@ namespace Web {
                 if (destination.IsValid() == true) {
                     result = Core::ERROR_COULD_NOT_SET_ADDRESS;
 
-                    if (Setup(destination) == true) {
+                    if (Prepare(destination) == true) {
                         result = Core::ERROR_NONE;
 
                         // See if we can create a file to store the upload in
@@ -274,7 +296,7 @@ namespace Web {
                 if (source.IsValid() == true) {
                     result = Core::ERROR_COULD_NOT_SET_ADDRESS;
 
-                    if (Setup(source) == true) {
+                    if (Prepare(source) == true) {
                         result = Core::ERROR_NONE;
 
                         // See if we can create a file to store the download in
@@ -310,7 +332,17 @@ namespace Web {
         {
             _channel.Close();
         }
+        // Keep the connection open for idleTime ms after a transfer, if the server allows it, so the next
+        // transfer to the same remote does not set up a new one. 0, the default, closes it after every transfer.
+        inline void KeepAlive(const uint32_t idleTime)
+        {
+            _adminLock.Lock();
+            _keepAlive = idleTime;
+            _adminLock.Unlock();
+        }
 
+        // Point the Link() to the remote of the URL. Not called if the transfer reuses the connection that is
+        // still open to that remote, see KeepAlive.
         virtual bool Setup(const Core::URL& remote) = 0;
         virtual void InfoCollected(const uint32_t result, const Core::ProxyType<Web::Response>& info) = 0;
         virtual void Transferred(const uint32_t result, const FILEBODY& file) = 0;
@@ -330,6 +362,28 @@ namespace Web {
 
         typedef hasHash<FILEBODY, typename FILEBODY::HashType& (FILEBODY::*)() const> TraitHasHash;
 
+        bool Prepare(const Core::URL& url)
+        {
+            const string remote(Core::NumberType<uint8_t>(static_cast<uint8_t>(url.Type())).Text() + '|' + url.Host().Value() + ':' +
+                Core::NumberType<uint16_t>(url.Port().IsSet() == true ? url.Port().Value() : 0).Text());
+            bool result = true;
+
+            if ((_keepAlive == 0) || (remote != _remote) || (_channel.IsReusable(_keepAlive) == false)) {
+                if (_channel.IsClosed() == false) {
+                    _channel.Close();
+                }
+
+                _remote.clear();
+                result = Setup(url);
+
+                if (result == true) {
+                    _remote = remote;
+                }
+            }
+
+            return (result);
+        }
+
         inline void EndTransfer(const Core::ProxyType<Web::Response>& response)
         {
             uint32_t errorCode = Core::ERROR_NONE;
@@ -426,6 +480,8 @@ namespace Web {
     private:
         Core::CriticalSection _adminLock;
         enumTransferState _state;
+        uint32_t _keepAlive;
+        string _remote;
         Core::ProxyObject<Web::Request> _request;
         Core::ProxyObject<FILEBODY> _fileBody;
         Channel _channel;
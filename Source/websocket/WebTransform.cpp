@@ -0,0 +1,67 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WebTransform.h"
+
+namespace WPEFramework {
+namespace Web {
+
+    Deflate::~Deflate()
+    {
+        Close();
+    }
+
+    bool Deflate::Open(const format type, const uint8_t level)
+    {
+        ASSERT(_open == false);
+        ASSERT((level >= 1) && (level <= 9));
+
+        ::memset(&_zlib, 0, sizeof(_zlib));
+
+        _open = (deflateInit2(&_zlib, level, Z_DEFLATED, (type == GZIP ? 16 + MAX_WBITS : MAX_WBITS), 8, Z_DEFAULT_STRATEGY) == Z_OK);
+        _finished = false;
+
+        return (_open);
+    }
+
+    void Deflate::Close()
+    {
+        if (_open == true) {
+            deflateEnd(&_zlib);
+            _open = false;
+        }
+    }
+
+    uint16_t Deflate::Compress(uint8_t stream[], const uint16_t maxLength, const bool last)
+    {
+        ASSERT(_open == true);
+
+        _zlib.next_out = stream;
+        _zlib.avail_out = maxLength;
+
+        int result = deflate(&_zlib, (last == true ? Z_FINISH : Z_NO_FLUSH));
+
+        ASSERT(result != Z_STREAM_ERROR);
+
+        _finished = (result == Z_STREAM_END);
+
+        return (maxLength - static_cast<uint16_t>(_zlib.avail_out));
+    }
+}
+}
@@ -37,6 +37,71 @@ namespace Web {
         {
         }
     };
+
+    // Streaming zlib compressor. Input is loaded in pieces and the compressed result is written
+    // to whatever room the caller has, so a body of any size is compressed with a fixed amount
+    // of memory. The zlib state only exists between Open() and Close().
+    class EXTERNAL Deflate {
+    public:
+        enum format : uint8_t {
+            GZIP,
+            ZLIB
+        };
+
+        Deflate(const Deflate&) = delete;
+        Deflate& operator=(const Deflate&) = delete;
+
+    public:
+        inline Deflate()
+            : _zlib()
+            , _open(false)
+            , _finished(false)
+        {
+        }
+        ~Deflate();
+
+    public:
+        inline bool IsOpen() const
+        {
+            return (_open);
+        }
+        // All loaded input is consumed, load more or finish.
+        inline bool IsDrained() const
+        {
+            return (_zlib.avail_in == 0);
+        }
+        // The last byte of the compressed stream has been handed out.
+        inline bool IsFinished() const
+        {
+            return (_finished);
+        }
+        // Space to copy input to, for sources that can not hand out their data in place.
+        inline uint8_t* Buffer(uint16_t& size)
+        {
+            size = sizeof(_buffer);
+            return (_buffer);
+        }
+        inline void Load(const uint8_t data[], const uint16_t length)
+        {
+            ASSERT(IsDrained() == true);
+
+            _zlib.next_in = const_cast<uint8_t*>(data);
+            _zlib.avail_in = length;
+        }
+
+        bool Open(const format type, const uint8_t level);
+        void Close();
+
+        // Compress what is loaded, last indicates no more input will follow. Returns the
+        // number of bytes written to the stream.
+        uint16_t Compress(uint8_t stream[], const uint16_t maxLength, const bool last);
+
+    private:
+        z_stream _zlib;
+        bool _open;
+        bool _finished;
+        uint8_t _buffer[512];
+    };
 }
 }
 
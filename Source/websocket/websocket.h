@@ -30,6 +30,7 @@
 #include "WebResponse.h"
 #include "WebSerializer.h"
 #include "WebSocketLink.h"
+#include "WebClient.h"
 #include "WebTransfer.h"
 #include "WebTransform.h"
 
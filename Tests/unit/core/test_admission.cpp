@@ -0,0 +1,268 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <plugins/Admission.h>
+
+using namespace WPEFramework;
+
+namespace {
+
+    static constexpr uint64_t Start = 1000 * Core::Time::TicksPerMillisecond;
+
+    uint64_t At(const uint32_t milliseconds)
+    {
+        return (Start + (static_cast<uint64_t>(milliseconds) * Core::Time::TicksPerMillisecond));
+    }
+
+    PluginHost::Admission::Limits Limits(const uint16_t inflight, const uint32_t pending, const uint32_t rate, const uint32_t burst)
+    {
+        PluginHost::Admission::Limits result;
+
+        result.InFlight = inflight;
+        result.Pending = pending;
+        result.Rate = rate;
+        result.Burst = burst;
+
+        return (result);
+    }
+
+    // Stands in for a channel, it only counts.
+    class Client {
+    public:
+        Client() = delete;
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+
+        Client(const string& origin)
+            : _origin(origin)
+            , _inflight(0)
+        {
+        }
+        ~Client() = default;
+
+    public:
+        const string& Origin() const
+        {
+            return (_origin);
+        }
+        uint16_t InFlight() const
+        {
+            return (_inflight);
+        }
+        void Admitted()
+        {
+            _inflight++;
+        }
+        void Completed()
+        {
+            ASSERT(_inflight > 0);
+            _inflight--;
+        }
+
+    private:
+        const string _origin;
+        uint16_t _inflight;
+    };
+
+}
+
+TEST(PluginHost_Admission, Bucket)
+{
+    PluginHost::Admission::Bucket bucket;
+
+    // A new address starts with a full bucket, it can burst.
+    for (uint8_t index = 0; index < 5; index++) {
+        EXPECT_TRUE(bucket.Take(10, 5, At(0)));
+    }
+    EXPECT_FALSE(bucket.Take(10, 5, At(0)));
+    EXPECT_FALSE(bucket.IsFull(10, 5, At(0)));
+
+    // At 10 per second, it takes 100ms for the next one.
+    EXPECT_FALSE(bucket.Take(10, 5, At(50)));
+    EXPECT_FALSE(bucket.Take(10, 5, At(99)));
+    EXPECT_TRUE(bucket.Take(10, 5, At(100)));
+    EXPECT_FALSE(bucket.Take(10, 5, At(100)));
+
+    // What is refused does not count, the refill goes on in parts.
+    EXPECT_FALSE(bucket.Take(10, 5, At(150)));
+    EXPECT_TRUE(bucket.Take(10, 5, At(200)));
+
+    // It never holds more than the burst.
+    EXPECT_TRUE(bucket.IsFull(10, 5, At(700)));
+    EXPECT_TRUE(bucket.IsFull(10, 5, At(10000)));
+
+    for (uint8_t index = 0; index < 5; index++) {
+        EXPECT_TRUE(bucket.Take(10, 5, At(10000)));
+    }
+    EXPECT_FALSE(bucket.Take(10, 5, At(10000)));
+}
+
+TEST(PluginHost_Admission, BucketFastRate)
+{
+    PluginHost::Admission::Bucket bucket;
+
+    // A burst of one, at 1000 per second, one every millisecond.
+    EXPECT_TRUE(bucket.Take(1000, 1, At(0)));
+    EXPECT_FALSE(bucket.Take(1000, 1, At(0)));
+    EXPECT_TRUE(bucket.Take(1000, 1, At(1)));
+
+    // Half a millisecond later, half a request.
+    EXPECT_FALSE(bucket.Take(1000, 1, At(1) + (Core::Time::TicksPerMillisecond / 2)));
+    EXPECT_TRUE(bucket.Take(1000, 1, At(2)));
+
+    // Quiet for a long time, still only one.
+    EXPECT_TRUE(bucket.Take(1000, 1, At(5000)));
+    EXPECT_FALSE(bucket.Take(1000, 1, At(5000)));
+}
+
+TEST(PluginHost_Admission, InFlight)
+{
+    PluginHost::Admission admission;
+    const PluginHost::Admission::Limits limits(Limits(2, 0, 0, 0));
+    Client first(_T("127.0.0.1"));
+    Client second(_T("127.0.0.1"));
+
+    EXPECT_TRUE(admission.Admit(limits, first, At(0)));
+    EXPECT_TRUE(admission.Admit(limits, first, At(0)));
+    EXPECT_EQ(first.InFlight(), 2u);
+
+    // One client at its limit, does not stop another.
+    EXPECT_FALSE(admission.Admit(limits, first, At(0)));
+    EXPECT_TRUE(admission.Admit(limits, second, At(0)));
+    EXPECT_EQ(admission.ShedInFlight(), 1u);
+    EXPECT_EQ(admission.Pending(), 3u);
+
+    // Once one is handled, there is room again.
+    admission.Completed(limits, &first);
+    EXPECT_EQ(first.InFlight(), 1u);
+    EXPECT_EQ(admission.Pending(), 2u);
+    EXPECT_TRUE(admission.Admit(limits, first, At(0)));
+
+    // A client that is gone, only leaves the pending count.
+    admission.Completed(limits, static_cast<Client*>(nullptr));
+    EXPECT_EQ(admission.Pending(), 2u);
+    EXPECT_EQ(first.InFlight(), 2u);
+    EXPECT_EQ(second.InFlight(), 1u);
+
+    EXPECT_EQ(admission.ShedPending(), 0u);
+    EXPECT_EQ(admission.ShedRate(), 0u);
+}
+
+TEST(PluginHost_Admission, Pending)
+{
+    PluginHost::Admission admission;
+    const PluginHost::Admission::Limits limits(Limits(0, 3, 0, 0));
+    Client first(_T("127.0.0.1"));
+    Client second(_T("127.0.0.2"));
+
+    EXPECT_TRUE(admission.Admit(limits, first, At(0)));
+    EXPECT_TRUE(admission.Admit(limits, first, At(0)));
+    EXPECT_TRUE(admission.Admit(limits, second, At(0)));
+
+    // The budget is shared by all clients.
+    EXPECT_FALSE(admission.Admit(limits, second, At(0)));
+    EXPECT_FALSE(admission.Admit(limits, first, At(0)));
+    EXPECT_EQ(admission.ShedPending(), 2u);
+    EXPECT_EQ(admission.Pending(), 3u);
+
+    // Without a limit on them, the clients do not count their requests.
+    EXPECT_EQ(first.InFlight(), 0u);
+
+    admission.Completed(limits, &first);
+    EXPECT_EQ(admission.Pending(), 2u);
+    EXPECT_EQ(first.InFlight(), 0u);
+    EXPECT_TRUE(admission.Admit(limits, second, At(0)));
+}
+
+TEST(PluginHost_Admission, Rate)
+{
+    PluginHost::Admission admission;
+    const PluginHost::Admission::Limits limits(Limits(0, 0, 2, 2));
+    Client first(_T("127.0.0.1"));
+    Client second(_T("127.0.0.1"));
+    Client other(_T("127.0.0.2"));
+
+    // Clients from the same address share the bucket.
+    EXPECT_TRUE(admission.Admit(limits, first, At(0)));
+    EXPECT_TRUE(admission.Admit(limits, second, At(0)));
+    EXPECT_FALSE(admission.Admit(limits, first, At(0)));
+    EXPECT_TRUE(admission.Admit(limits, other, At(0)));
+    EXPECT_EQ(admission.ShedRate(), 1u);
+    EXPECT_EQ(admission.Pending(), 3u);
+    EXPECT_EQ(admission.Origins(), 2u);
+
+    EXPECT_TRUE(admission.Admit(limits, first, At(500)));
+
+    // Addresses that are back at a full bucket are forgotten.
+    admission.Prune(limits, At(600));
+    EXPECT_EQ(admission.Origins(), 1u);
+    admission.Prune(limits, At(2000));
+    EXPECT_EQ(admission.Origins(), 0u);
+}
+
+TEST(PluginHost_Admission, Order)
+{
+    PluginHost::Admission admission;
+    const PluginHost::Admission::Limits limits(Limits(1, 0, 1, 1));
+    Client client(_T("127.0.0.1"));
+
+    EXPECT_TRUE(admission.Admit(limits, client, At(0)));
+
+    // Refused on what it has in flight, the bucket is left alone.
+    EXPECT_FALSE(admission.Admit(limits, client, At(1000)));
+    EXPECT_EQ(admission.ShedInFlight(), 1u);
+
+    admission.Completed(limits, &client);
+    EXPECT_TRUE(admission.Admit(limits, client, At(1000)));
+    EXPECT_EQ(admission.ShedRate(), 0u);
+}
+
+TEST(PluginHost_Admission, Refused)
+{
+    // Over HTTP, the service is unavailable.
+    Web::Response response;
+    PluginHost::Admission::Refused(response);
+    EXPECT_EQ(response.ErrorCode, Web::STATUS_SERVICE_UNAVAILABLE);
+
+    // A JSONRPC request is answered with its id.
+    Core::JSONRPC::Message request;
+    Core::JSONRPC::Message answer;
+    request.FromString(_T("{\"jsonrpc\":\"2.0\",\"id\":42,\"method\":\"Controller.1.status\"}"));
+    EXPECT_TRUE(PluginHost::Admission::Refused(request, answer));
+    EXPECT_EQ(answer.Id.Value(), 42u);
+    EXPECT_EQ(answer.Error.Code.Value(), static_cast<int32_t>(Core::ERROR_UNAVAILABLE));
+
+    // A notification has nobody waiting for an answer.
+    Core::JSONRPC::Message notification;
+    Core::JSONRPC::Message nothing;
+    notification.FromString(_T("{\"jsonrpc\":\"2.0\",\"method\":\"Controller.1.status\"}"));
+    EXPECT_FALSE(PluginHost::Admission::Refused(notification, nothing));
+    EXPECT_FALSE(nothing.Error.IsSet());
+
+    // A refused batch gets a single answer, without an id.
+    Core::JSONRPC::Message batch;
+    Core::JSONRPC::Message single;
+    batch.FromString(_T("[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"Controller.1.status\"},{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"Controller.1.links\"}]"));
+    ASSERT_TRUE(batch.IsBatch());
+    EXPECT_TRUE(PluginHost::Admission::Refused(batch, single));
+    EXPECT_FALSE(single.Id.IsSet());
+    EXPECT_TRUE(single.Error.IsSet());
+}
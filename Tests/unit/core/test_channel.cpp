@@ -0,0 +1,182 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <plugins/Channel.h>
+
+using namespace WPEFramework;
+
+namespace {
+
+    typedef PluginHost::Channel::SendQueue SendQueue;
+
+    static constexpr uint64_t Start = 1000 * Core::Time::TicksPerMillisecond;
+
+    uint64_t At(const uint32_t milliseconds)
+    {
+        return (Start + (static_cast<uint64_t>(milliseconds) * Core::Time::TicksPerMillisecond));
+    }
+
+    Core::ProxyType<Core::JSON::IElement> Event(const string& event, const string& parameters, const Core::JSONRPC::Policy& policy)
+    {
+        Core::ProxyType<Core::JSONRPC::Notification> notification(Core::ProxyType<Core::JSONRPC::Notification>::Create());
+
+        notification->Set(Core::ProxyType<Core::JSONRPC::Notification::Body>::Create(event, parameters), _T("client"), policy);
+
+        return (Core::ProxyType<Core::JSON::IElement>(notification));
+    }
+
+    Core::ProxyType<Core::JSON::IElement> Response()
+    {
+        return (Core::ProxyType<Core::JSON::IElement>(Core::ProxyType<Core::JSONRPC::Message>::Create()));
+    }
+
+    // Takes everything from the queue, a notification shows as its parameters, anything else as "-".
+    string Drain(SendQueue& queue)
+    {
+        string result;
+
+        while (queue.Size() != 0) {
+            const Core::JSONRPC::Notification* notification = queue.Front().Notification();
+
+            result += (notification != nullptr ? notification->Parameters() : string(_T("-")));
+            queue.Pop();
+        }
+
+        return (result);
+    }
+
+}
+
+TEST(PluginHost_Channel, Unrestricted)
+{
+    SendQueue queue;
+    const Core::JSONRPC::Policy policy;
+
+    EXPECT_TRUE(queue.Push(Event(_T("progress"), _T("1"), policy), At(0)));
+    EXPECT_TRUE(queue.Push(Event(_T("progress"), _T("2"), policy), At(0)));
+    EXPECT_TRUE(queue.Push(Response(), At(0)));
+
+    EXPECT_EQ(Drain(queue), _T("12-"));
+    EXPECT_EQ(queue.Dropped(), 0u);
+    EXPECT_EQ(queue.Coalesced(), 0u);
+    EXPECT_EQ(queue.Due(), 0u);
+}
+
+TEST(PluginHost_Channel, Coalesce)
+{
+    SendQueue queue;
+    Core::JSONRPC::Policy policy;
+    policy.Coalesce = true;
+
+    // The front might be on its way out already, it is never replaced.
+    EXPECT_TRUE(queue.Push(Event(_T("progress"), _T("1"), policy), At(0)));
+    EXPECT_TRUE(queue.Push(Event(_T("progress"), _T("2"), policy), At(0)));
+    EXPECT_TRUE(queue.Push(Response(), At(0)));
+    EXPECT_TRUE(queue.Push(Event(_T("other"), _T("a"), policy), At(0)));
+
+    // The newest takes the place of the waiting one, other methods are left alone.
+    EXPECT_FALSE(queue.Push(Event(_T("progress"), _T("3"), policy), At(0)));
+    EXPECT_FALSE(queue.Push(Event(_T("other"), _T("b"), policy), At(0)));
+
+    EXPECT_EQ(Drain(queue), _T("13-b"));
+    EXPECT_EQ(queue.Coalesced(), 2u);
+    EXPECT_EQ(queue.Dropped(), 0u);
+}
+
+TEST(PluginHost_Channel, Depth)
+{
+    SendQueue queue;
+    Core::JSONRPC::Policy policy;
+    policy.Depth = 2;
+
+    EXPECT_TRUE(queue.Push(Response(), At(0)));
+
+    for (uint8_t index = 1; index <= 4; index++) {
+        EXPECT_TRUE(queue.Push(Event(_T("progress"), Core::NumberType<uint8_t>(index).Text(), policy), At(0)));
+    }
+    EXPECT_TRUE(queue.Push(Event(_T("other"), _T("a"), policy), At(0)));
+
+    // Only the latest two of a method wait, the oldest ones made room.
+    EXPECT_EQ(Drain(queue), _T("-34a"));
+    EXPECT_EQ(queue.Dropped(), 2u);
+    EXPECT_EQ(queue.Coalesced(), 0u);
+}
+
+TEST(PluginHost_Channel, Interval)
+{
+    SendQueue queue;
+    Core::JSONRPC::Policy policy;
+    policy.Interval = 100;
+
+    // The first one goes straight out.
+    EXPECT_TRUE(queue.Push(Event(_T("progress"), _T("1"), policy), At(0)));
+    EXPECT_EQ(queue.Due(), 0u);
+
+    // Within the interval it is held, a newer one takes its place.
+    EXPECT_FALSE(queue.Push(Event(_T("progress"), _T("2"), policy), At(10)));
+    EXPECT_EQ(queue.Due(), At(100));
+    EXPECT_FALSE(queue.Push(Event(_T("progress"), _T("3"), policy), At(20)));
+    EXPECT_EQ(queue.Coalesced(), 1u);
+    EXPECT_EQ(queue.Size(), 1u);
+
+    // Other methods have an interval of their own.
+    EXPECT_TRUE(queue.Push(Event(_T("other"), _T("a"), policy), At(30)));
+
+    // Nothing is released before its time.
+    EXPECT_EQ(queue.ReleaseHeld(At(50)), At(100));
+    EXPECT_EQ(queue.Size(), 2u);
+
+    // The latest is not lost, it is send once the interval expired (trailing edge).
+    EXPECT_EQ(queue.ReleaseHeld(At(100)), 0u);
+    EXPECT_EQ(queue.Due(), 0u);
+    EXPECT_EQ(Drain(queue), _T("1a3"));
+
+    // Released, so it starts a new interval.
+    EXPECT_FALSE(queue.Push(Event(_T("progress"), _T("4"), policy), At(150)));
+    EXPECT_EQ(queue.Due(), At(200));
+
+    // Late in releasing it, a newer one that is due goes out and whatever was held is outdated.
+    EXPECT_TRUE(queue.Push(Event(_T("progress"), _T("5"), policy), At(250)));
+    EXPECT_EQ(queue.Due(), 0u);
+    EXPECT_EQ(queue.ReleaseHeld(At(250)), 0u);
+
+    EXPECT_EQ(Drain(queue), _T("5"));
+    EXPECT_EQ(queue.Coalesced(), 2u);
+    EXPECT_EQ(queue.Dropped(), 0u);
+}
+
+TEST(PluginHost_Channel, Combined)
+{
+    SendQueue queue;
+    Core::JSONRPC::Policy policy;
+    policy.Coalesce = true;
+    policy.Interval = 100;
+
+    EXPECT_TRUE(queue.Push(Response(), At(0)));
+    EXPECT_TRUE(queue.Push(Event(_T("progress"), _T("1"), policy), At(0)));
+    EXPECT_FALSE(queue.Push(Event(_T("progress"), _T("2"), policy), At(50)));
+
+    // The released one still replaces what waits in the queue.
+    EXPECT_EQ(queue.ReleaseHeld(At(100)), 0u);
+
+    EXPECT_EQ(Drain(queue), _T("-2"));
+    EXPECT_EQ(queue.Coalesced(), 1u);
+}
@@ -432,3 +432,88 @@ TEST(Core_JSON, simpleSet)
         EXPECT_STREQ(input.c_str(), output.c_str());
     }
 }
+
+class StaticCommandParameters : public WPEFramework::Core::JSON::Container {
+public:
+    StaticCommandParameters()
+        : Core::JSON::Container(Fields(), 4)
+        , G(00)
+        , H(0)
+        , I()
+        , J()
+    {
+    }
+    StaticCommandParameters(const StaticCommandParameters& copy)
+        : Core::JSON::Container(Fields(), 4)
+        , G(copy.G)
+        , H(copy.H)
+        , I(copy.I)
+        , J(copy.J)
+    {
+    }
+
+    ~StaticCommandParameters()
+    {
+    }
+
+private:
+    static const Core::JSON::Container::Field* Fields()
+    {
+        static const Core::JSON::Container::Field fields[] = {
+            { _T("g"), &Core::JSON::Container::Member<StaticCommandParameters, WPEFramework::Core::JSON::OctSInt16, &StaticCommandParameters::G> },
+            { _T("h"), &Core::JSON::Container::Member<StaticCommandParameters, WPEFramework::Core::JSON::DecSInt16, &StaticCommandParameters::H> },
+            { _T("i"), &Core::JSON::Container::Member<StaticCommandParameters, WPEFramework::Core::JSON::EnumType<CommandType>, &StaticCommandParameters::I> },
+            { _T("j"), &Core::JSON::Container::Member<StaticCommandParameters, WPEFramework::Core::JSON::ArrayType<WPEFramework::Core::JSON::DecUInt16>, &StaticCommandParameters::J> },
+        };
+
+        return (fields);
+    }
+
+public:
+    WPEFramework::Core::JSON::OctSInt16 G;
+    WPEFramework::Core::JSON::DecSInt16 H;
+    WPEFramework::Core::JSON::EnumType<CommandType> I;
+    WPEFramework::Core::JSON::ArrayType<WPEFramework::Core::JSON::DecUInt16> J;
+};
+
+TEST(Core_JSON, staticFields)
+{
+    const string input = _T("{\"g\":\"-014\",\"h\":-44,\"i\":\"enum_4\",\"j\":[1,2,3]}");
+
+    // A table driven container behaves exactly like one that registers its members.
+    CommandParameters dynamic;
+    StaticCommandParameters table;
+    string expected, output;
+
+    EXPECT_TRUE(dynamic.FromString(input));
+    EXPECT_TRUE(table.FromString(input));
+    dynamic.ToString(expected);
+    table.ToString(output);
+    EXPECT_STREQ(output.c_str(), expected.c_str());
+    EXPECT_EQ(table.H.Value(), -44);
+    EXPECT_EQ(table.I.Value(), CommandType::ENUM_4);
+    EXPECT_EQ(table.J.Length(), 3);
+
+    std::vector<uint8_t> packed;
+    table.ToBuffer(packed);
+    StaticCommandParameters unpacked;
+    EXPECT_TRUE(unpacked.FromBuffer(packed));
+    unpacked.ToString(output);
+    EXPECT_STREQ(output.c_str(), expected.c_str());
+
+    StaticCommandParameters copy(table);
+    copy.ToString(output);
+    EXPECT_STREQ(output.c_str(), expected.c_str());
+
+    EXPECT_TRUE(table.IsSet());
+    table.Clear();
+    EXPECT_FALSE(table.IsSet());
+    EXPECT_FALSE(table.H.IsSet());
+    table.ToString(output);
+    EXPECT_STREQ(output.c_str(), _T("{}"));
+
+    // Unknown labels are skipped, just like they are for registered members.
+    EXPECT_TRUE(table.FromString(_T("{\"x\":{\"y\":[1]},\"h\":5}")));
+    EXPECT_EQ(table.H.Value(), 5);
+    EXPECT_FALSE(table.G.IsSet());
+}
@@ -1212,7 +1212,7 @@ namespace Tests {
         WPEFramework::Core::JSON::Variant variant5(true);
 
         //EXPECT_EQ(variant1.Number(), 0); //TODO
-        EXPECT_EQ(variant2.Number(), 0);
+        EXPECT_EQ(variant2.Number(), std::numeric_limits<int64_t>::min());
         EXPECT_EQ(variant3.Number(), 0);
         EXPECT_EQ(variant4.Number(), 0);
 
@@ -1442,6 +1442,79 @@ namespace Tests {
         it.Reset();
         EXPECT_FALSE(it.IsValid());
     }
+
+    TEST(JSONParser, VariantContainerArena)
+    {
+        WPEFramework::Core::JSON::VariantContainer container;
+        uint32_t count = 0;
+
+        // Reusing a container may not accumulate the elements of earlier documents.
+        for (uint8_t round = 0; round < 3; ++round) {
+            EXPECT_TRUE(container.FromString(_T("{\"number\":-42,\"flag\":true,\"text\":\"a longer string than fits locally\",\"object\":{\"a\":1}}")));
+        }
+
+        WPEFramework::Core::JSON::VariantContainer::Iterator index(container.Variants());
+        while (index.Next() == true) {
+            count++;
+        }
+        EXPECT_EQ(count, 4u);
+
+        EXPECT_EQ(container["number"].Content(), WPEFramework::Core::JSON::Variant::type::NUMBER);
+        EXPECT_EQ(container["number"].Number(), -42);
+        EXPECT_EQ(container["number"].Double(), -42.0);
+        EXPECT_TRUE(container["flag"].Boolean());
+        EXPECT_STREQ(container["text"].String().c_str(), "a longer string than fits locally");
+        EXPECT_EQ(container["object"].Object()["a"].Number(), 1);
+
+        container["real"] = 2.5;
+        EXPECT_EQ(container["real"].Double(), 2.5);
+        EXPECT_EQ(container["real"].Number(), 2);
+
+        WPEFramework::Core::JSON::VariantContainer copy(container);
+        container.Clear();
+        EXPECT_FALSE(container.HasLabel("number"));
+        EXPECT_EQ(copy["number"].Number(), -42);
+        WPEFramework::Core::JSON::VariantContainer::Iterator copied(copy.Variants());
+        EXPECT_TRUE(copied.Next());
+        EXPECT_STREQ(copied.Label(), "number");
+
+        // Assigning the same labels updates the values, other contents replace the container wholesale.
+        WPEFramework::Core::JSON::VariantContainer other;
+        other["number"] = 7;
+        other["extra"] = _T("value");
+        for (uint8_t round = 0; round < 3; ++round) {
+            container = copy;
+            container = other;
+        }
+        EXPECT_FALSE(container.HasLabel("flag"));
+        EXPECT_EQ(container["number"].Number(), 7);
+        EXPECT_STREQ(container["extra"].String().c_str(), "value");
+        other["number"] = 8;
+        container = other;
+        EXPECT_EQ(container["number"].Number(), 8);
+        count = 0;
+        WPEFramework::Core::JSON::VariantContainer::Iterator assigned(container.Variants());
+        while (assigned.Next() == true) {
+            count++;
+        }
+        EXPECT_EQ(count, 2u);
+        string text;
+        container.ToString(text);
+        EXPECT_STREQ(text.c_str(), "{\"number\":8,\"extra\":\"value\"}");
+
+        WPEFramework::Core::JSON::Arena arena(64);
+        void* first = arena.Allocate(3, 1);
+        void* aligned = arena.Allocate(sizeof(double), alignof(double));
+        void* large = arena.Allocate(1024, alignof(uint64_t));
+        void* next = arena.Allocate(8, 8);
+
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % alignof(double), 0u);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(large) % alignof(uint64_t), 0u);
+        EXPECT_EQ(reinterpret_cast<uint8_t*>(next), reinterpret_cast<uint8_t*>(aligned) + sizeof(double));
+        EXPECT_NE(first, nullptr);
+        EXPECT_STREQ(arena.Duplicate(_T("label")), _T("label"));
+        arena.Release();
+    }
 } // Tests
 
 ENUM_CONVERSION_BEGIN(Tests::JSONTestEnum)
@@ -0,0 +1,261 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+using namespace WPEFramework;
+
+namespace {
+
+    typedef Core::JSON::Reader::token token;
+
+    const string document = _T("{ \"name\": \"epg\", \"version\": 3, \"valid\": true, \"owner\": null,\n"
+                               "  \"channels\": [ { \"id\": 1, \"title\": \"One \\\"HD\\\"\" }, { \"id\": 2, \"title\": \"Two\" } ],\n"
+                               "  \"settings\": { \"region\": \"EU\", \"limits\": [ 1, 2, 3 ] } }");
+
+    class Channel : public Core::JSON::Container {
+    public:
+        Channel(const Channel&) = delete;
+        Channel& operator=(const Channel&) = delete;
+
+        Channel()
+            : Core::JSON::Container()
+            , Id(0)
+            , Title()
+        {
+            Add(_T("id"), &Id);
+            Add(_T("title"), &Title);
+        }
+        ~Channel() override
+        {
+        }
+
+    public:
+        Core::JSON::DecUInt32 Id;
+        Core::JSON::String Title;
+    };
+
+    class Settings : public Core::JSON::Container {
+    public:
+        Settings(const Settings&) = delete;
+        Settings& operator=(const Settings&) = delete;
+
+        Settings()
+            : Core::JSON::Container()
+            , Region()
+            , Limits()
+        {
+            Add(_T("region"), &Region);
+            Add(_T("limits"), &Limits);
+        }
+        ~Settings() override
+        {
+        }
+
+    public:
+        Core::JSON::String Region;
+        Core::JSON::ArrayType<Core::JSON::DecUInt16> Limits;
+    };
+
+    // Feeds the document in windows of the given size.
+    std::vector<std::pair<token, string>> Tokens(const string& text, const uint32_t window)
+    {
+        std::vector<std::pair<token, string>> result;
+        Core::JSON::Reader reader;
+        uint32_t fed = 0;
+        token current;
+
+        do {
+            current = reader.Next();
+
+            if (current == token::NONE) {
+                if (fed < text.length()) {
+                    uint32_t size = std::min(window, static_cast<uint32_t>(text.length() - fed));
+                    reader.Feed(&(text.c_str()[fed]), size);
+                    fed += size;
+                } else {
+                    reader.Close();
+                }
+            } else {
+                result.emplace_back(current, (current == token::KEY ? reader.Text() : reader.Path() + '=' + reader.Text()));
+            }
+        } while ((current != token::END) && (current != token::ERROR));
+
+        return (result);
+    }
+
+}
+
+TEST(Core_JSONReader, Tokens)
+{
+    std::vector<std::pair<token, string>> tokens = Tokens(document, static_cast<uint32_t>(document.length()));
+
+    ASSERT_EQ(tokens.size(), 37u);
+    EXPECT_EQ(tokens[0].first, token::BEGIN_OBJECT);
+    EXPECT_EQ(tokens[1], std::make_pair(token::KEY, string(_T("name"))));
+    EXPECT_EQ(tokens[2], std::make_pair(token::STRING, string(_T("name=epg"))));
+    EXPECT_EQ(tokens[4], std::make_pair(token::NUMBER, string(_T("version=3"))));
+    EXPECT_EQ(tokens[6], std::make_pair(token::BOOLEAN, string(_T("valid=true"))));
+    EXPECT_EQ(tokens[8].first, token::NULL_VALUE);
+    EXPECT_EQ(tokens[10].first, token::BEGIN_ARRAY);
+    EXPECT_EQ(tokens[11], std::make_pair(token::BEGIN_OBJECT, string(_T("channels.0="))));
+    EXPECT_EQ(tokens[15], std::make_pair(token::STRING, string(_T("channels.0.title=One \"HD\""))));
+    EXPECT_EQ(tokens[21], std::make_pair(token::STRING, string(_T("channels.1.title=Two"))));
+    EXPECT_EQ(tokens[23].first, token::END_ARRAY);
+    EXPECT_EQ(tokens[32], std::make_pair(token::NUMBER, string(_T("settings.limits.2=3"))));
+    EXPECT_EQ(tokens[35], std::make_pair(token::END_OBJECT, string(_T("="))));
+    EXPECT_EQ(tokens[36].first, token::END);
+
+    // The outcome may not depend on the size of the windows offered.
+    for (uint32_t window = 1; window < 16; ++window) {
+        EXPECT_EQ(Tokens(document, window), tokens);
+    }
+}
+
+TEST(Core_JSONReader, Errors)
+{
+    EXPECT_EQ(Tokens(_T("{ \"a\" 1 }"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("{ a: 1 }"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ 1, 2 }"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ 1, 2 "), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("{} {}"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ yes ]"), 4).back().first, token::ERROR);
+
+    // Only what the JSON number grammar allows is a number.
+    EXPECT_EQ(Tokens(_T("[ -abc ]"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ 1.2.3 ]"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ 01x ]"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ 01 ]"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ - ]"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ 1. ]"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ 1e ]"), 4).back().first, token::ERROR);
+    EXPECT_EQ(Tokens(_T("[ 0, -0.5, 12e3, -1.5E-2, 3e+1 ]"), 4).back().first, token::END);
+}
+
+TEST(Core_JSONReader, Skip)
+{
+    Core::JSON::Reader reader;
+    reader.Feed(document.c_str(), static_cast<uint32_t>(document.length()));
+    reader.Close();
+
+    std::vector<string> keys;
+    token current;
+
+    while (((current = reader.Next()) != token::END) && (current != token::ERROR)) {
+        if (current == token::KEY) {
+            keys.push_back(reader.Text());
+            if ((reader.Depth() == 1) && (reader.Text() != _T("settings"))) {
+                reader.Skip();
+            }
+        } else if ((current == token::BEGIN_ARRAY) && (reader.Path() == _T("settings.limits"))) {
+            reader.Skip();
+        }
+    }
+
+    EXPECT_EQ(current, token::END);
+    EXPECT_EQ(keys, std::vector<string>({ _T("name"), _T("version"), _T("valid"), _T("owner"), _T("channels"), _T("settings"), _T("region"), _T("limits") }));
+}
+
+TEST(Core_JSONReader, Bind)
+{
+    Channel channel;
+    Settings settings;
+    Core::JSON::String name;
+
+    Core::JSON::Reader reader;
+    reader.Bind(_T("channels.1"), channel);
+    reader.Bind(_T("settings"), settings);
+
+    uint32_t bound = 0;
+    token current = token::NONE;
+
+    for (uint32_t fed = 0; (current != token::END) && (current != token::ERROR); ) {
+        current = reader.Scan();
+
+        if (current == token::BOUND) {
+            bound++;
+        } else if (current == token::NONE) {
+            if (fed < document.length()) {
+                uint32_t size = std::min(7u, static_cast<uint32_t>(document.length() - fed));
+                reader.Feed(&(document.c_str()[fed]), size);
+                fed += size;
+            } else {
+                reader.Close();
+            }
+        }
+    }
+
+    EXPECT_EQ(current, token::END);
+    EXPECT_EQ(bound, 2u);
+    EXPECT_EQ(channel.Id.Value(), 2u);
+    EXPECT_STREQ(channel.Title.Value().c_str(), _T("Two"));
+    EXPECT_STREQ(settings.Region.Value().c_str(), _T("EU"));
+    EXPECT_EQ(settings.Limits.Length(), 3);
+
+    Core::JSON::Reader explicitReader;
+    explicitReader.Feed(document.c_str(), static_cast<uint32_t>(document.length()));
+    explicitReader.Close();
+
+    while (((current = explicitReader.Next()) != token::END) && (current != token::ERROR)) {
+        if ((current == token::KEY) && (explicitReader.Text() == _T("name"))) {
+            explicitReader.Load(name);
+        }
+    }
+    EXPECT_EQ(current, token::END);
+    EXPECT_STREQ(name.Value().c_str(), _T("epg"));
+}
+
+TEST(Core_JSONReader, Files)
+{
+    const string fileName = _T("/tmp/test_jsonreader.json");
+    Core::File file(fileName);
+    ASSERT_TRUE(file.Create());
+    file.Write(reinterpret_cast<const uint8_t*>(document.c_str()), static_cast<uint32_t>(document.length()));
+    file.Close();
+
+    {
+        Settings settings;
+        Core::File input(fileName);
+        ASSERT_TRUE(input.Open(true));
+
+        Core::JSON::FileReaderType<16> reader(input);
+        reader.Bind(_T("settings"), settings);
+
+        EXPECT_EQ(reader.Scan(), token::BOUND);
+        EXPECT_EQ(reader.Scan(), token::END);
+        EXPECT_STREQ(settings.Region.Value().c_str(), _T("EU"));
+        EXPECT_EQ(settings.Limits.Length(), 3);
+    }
+    {
+        Channel channel;
+        Core::JSON::MappedReader reader(fileName);
+        ASSERT_TRUE(reader.IsValid());
+        reader.Bind(_T("channels.0"), channel);
+
+        EXPECT_EQ(reader.Scan(), token::BOUND);
+        EXPECT_EQ(reader.Scan(), token::END);
+        EXPECT_EQ(channel.Id.Value(), 1u);
+        EXPECT_STREQ(channel.Title.Value().c_str(), _T("One \"HD\""));
+    }
+
+    file.Destroy();
+}
@@ -0,0 +1,548 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+using namespace WPEFramework;
+
+namespace {
+
+    typedef Core::ProxyType<Core::JSONRPC::Notification::Body> Body;
+
+    // Serializes the element in chunks of the given window.
+    template <typename INTERFACE, typename BUFFER>
+    BUFFER Chunks(const INTERFACE& element, const uint16_t window)
+    {
+        BUFFER result;
+        typename BUFFER::value_type buffer[64];
+        uint32_t offset = 0;
+        uint16_t loaded;
+
+        do {
+            loaded = element.Serialize(buffer, window, offset);
+            result.insert(result.end(), buffer, buffer + loaded);
+        } while ((offset != 0) && (loaded != 0));
+
+        return (result);
+    }
+
+    class Inventory {
+    public:
+        uint32_t Items(const string& index, Core::JSON::ArrayType<Core::JSON::DecUInt32>& items) const
+        {
+            const uint32_t count = (index.empty() == true ? 2000 : Core::NumberType<uint32_t>(index.c_str(), static_cast<uint32_t>(index.length())).Value());
+
+            for (uint32_t item = 0; item < count; item++) {
+                items.Add() = item;
+            }
+            return (Core::ERROR_NONE);
+        }
+    };
+
+    class ResponseSerializer : public Web::Response::Serializer {
+    public:
+        void Serialized(const Web::Response&) override
+        {
+        }
+    };
+
+    Core::ProxyType<Core::JSONRPC::Message> Expected(const string& method, const string& parameters)
+    {
+        Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>::Create());
+
+        message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        message->Designator = method;
+        if (parameters.empty() == false) {
+            message->Parameters = parameters;
+        }
+
+        return (message);
+    }
+
+}
+
+TEST(Core_JSONRPC, Notification)
+{
+    const string parameters(_T("{\"state\":\"activated\",\"callsign\":\"Netflix\",\"reason\":\"Requested\"}"));
+
+    for (const string& designator : { string(), string(_T("client.events")), string(_T("odd\"client")), string(40, 'x') }) {
+        for (const string& data : { string(), parameters }) {
+            Core::JSONRPC::Notification notification;
+            notification.Set(Body::Create(_T("statechange"), data), designator);
+
+            Core::ProxyType<Core::JSONRPC::Message> message(Expected(designator.empty() ? _T("statechange") : designator + _T(".statechange"), data));
+
+            string text;
+            std::vector<uint8_t> binary;
+            message->ToString(text);
+            message->ToBuffer(binary);
+
+            EXPECT_EQ(notification.Method(), message->Designator.Value());
+
+            for (const uint16_t window : { 1, 2, 7, 64 }) {
+                EXPECT_EQ((Chunks<Core::JSON::IElement, std::string>(notification, window)), text);
+                EXPECT_EQ((Chunks<Core::JSON::IMessagePack, std::vector<uint8_t>>(notification, window)), binary);
+            }
+
+            // What goes out must be understood by the other side.
+            Core::JSONRPC::Message received;
+            EXPECT_TRUE(received.FromString(text));
+            EXPECT_EQ(received.Designator.Value(), notification.Method());
+            EXPECT_EQ(received.Parameters.IsSet(), (data.empty() == false));
+        }
+    }
+}
+
+TEST(Core_JSONRPC, FanOut)
+{
+    std::vector<std::pair<uint32_t, string>> sent;
+    std::set<const Core::JSONRPC::Notification::Body*> bodies;
+    Core::JSONRPC::Handler* self = nullptr;
+
+    Core::JSONRPC::Handler handler([&](const uint32_t id, const string& designator, const Core::JSONRPC::Policy&, const Body& body) {
+        Core::JSONRPC::Message response;
+
+        sent.emplace_back(id, body->Method(designator));
+        bodies.insert(&(*body));
+
+        // The subscriptions are not locked while the subscribers are notified.
+        self->Unsubscribe(id, _T("statechange"), designator, response);
+        EXPECT_TRUE(response.Result.IsSet());
+    }, { 1 });
+
+    self = &handler;
+
+    for (uint32_t id = 1; id <= 50; ++id) {
+        Core::JSONRPC::Message response;
+        handler.Subscribe(id, _T("statechange"), (id & 1 ? string(_T("client")) : string()), response);
+        EXPECT_TRUE(response.Result.IsSet());
+    }
+
+    Core::JSON::String state;
+    state = _T("activated");
+
+    EXPECT_EQ(handler.Notify(_T("statechange"), state), Core::ERROR_NONE);
+    EXPECT_EQ(sent.size(), 50u);
+    EXPECT_EQ(bodies.size(), 1u);
+    EXPECT_EQ(sent[0], std::make_pair(1u, string(_T("client.statechange"))));
+    EXPECT_EQ(sent[1], std::make_pair(2u, string(_T("statechange"))));
+
+    // All unsubscribed during the dispatch.
+    EXPECT_EQ(handler.Observers(), 0u);
+    EXPECT_EQ(handler.Notify(_T("statechange"), state), Core::ERROR_UNKNOWN_KEY);
+
+    // The classic notification callback still receives the method and parameters.
+    std::vector<std::pair<string, string>> classic;
+    Core::JSONRPC::Handler legacy([&](const uint32_t, const string& designator, const string& data) {
+        classic.emplace_back(designator, data);
+    }, { 1 });
+
+    Core::JSONRPC::Message response;
+    legacy.Subscribe(7, _T("statechange"), _T("client"), response);
+    legacy.Notify(_T("statechange"), state);
+
+    ASSERT_EQ(classic.size(), 1u);
+    EXPECT_EQ(classic[0].first, string(_T("client.statechange")));
+    EXPECT_EQ(classic[0].second, string(_T("\"activated\"")));
+}
+
+TEST(Core_JSONRPC, Policy)
+{
+    std::map<uint32_t, Core::JSONRPC::Policy> policies;
+
+    Core::JSONRPC::Handler handler([&](const uint32_t id, const string&, const Core::JSONRPC::Policy& policy, const Body&) {
+        policies[id] = policy;
+    }, { 1 });
+
+    Core::JSONRPC::Policy policy;
+    policy.Coalesce = true;
+    policy.Interval = 100;
+    policy.Depth = 4;
+    EXPECT_TRUE(policy.IsSet());
+    EXPECT_FALSE(Core::JSONRPC::Policy().IsSet());
+
+    Core::JSONRPC::Message response;
+    handler.Subscribe(1, _T("progress"), _T("client"), policy, response);
+    handler.Subscribe(2, _T("progress"), _T("client"), response);
+
+    // A subscription is identified by the channel and designator, not by its policy.
+    Core::JSONRPC::Message duplicate;
+    handler.Subscribe(1, _T("progress"), _T("client"), duplicate);
+    EXPECT_TRUE(duplicate.Error.IsSet());
+
+    Core::JSON::DecUInt8 value;
+    value = 42;
+    handler.Notify(_T("progress"), value);
+
+    ASSERT_EQ(policies.size(), 2u);
+    EXPECT_TRUE(policies[1].Coalesce);
+    EXPECT_EQ(policies[1].Interval, 100u);
+    EXPECT_EQ(policies[1].Depth, 4u);
+    EXPECT_FALSE(policies[2].IsSet());
+
+    // The notification carries the policy to the channel it is submitted to.
+    Core::JSONRPC::Notification notification;
+    notification.Set(Body::Create(_T("progress"), _T("42")), _T("client"), policy);
+    EXPECT_TRUE(notification.Policy().Coalesce);
+    notification.Clear();
+    EXPECT_FALSE(notification.IsSet());
+    EXPECT_FALSE(notification.Policy().IsSet());
+}
+
+TEST(Core_JSONRPC, Routing)
+{
+    Core::JSONRPC::Handler handler([](const uint32_t, const string&, const Core::JSONRPC::Policy&, const Body&) {}, { 1, 2 });
+
+    const uint32_t initial = handler.Generation();
+    EXPECT_EQ(handler.Versions(), std::vector<uint8_t>({ 1, 2 }));
+    EXPECT_EQ(handler.Find(_T("echo")), nullptr);
+
+    handler.Register(_T("echo"), Core::JSONRPC::InvokeFunction([](const string&, const string& parameters, string& response) -> uint32_t {
+        response = parameters;
+        return (Core::ERROR_NONE);
+    }));
+
+    EXPECT_NE(handler.Generation(), initial);
+
+    // A routing table holds on to the entry and invokes it directly.
+    Core::JSONRPC::Handler::Entry* entry = handler.Find(_T("echo"));
+    ASSERT_NE(entry, nullptr);
+
+    string response;
+    EXPECT_EQ(entry->Invoke(Core::JSONRPC::Connection(1, 1), _T("echo"), _T("\"hello\""), response), Core::ERROR_NONE);
+    EXPECT_EQ(response, string(_T("\"hello\"")));
+
+    // Unregistering invalidates what was looked up before.
+    const uint32_t registered = handler.Generation();
+    handler.Unregister(_T("echo"));
+    EXPECT_NE(handler.Generation(), registered);
+    EXPECT_EQ(handler.Find(_T("echo")), nullptr);
+}
+
+TEST(Core_JSONRPC, Cache)
+{
+    Core::JSONRPC::Handler handler([](const uint32_t, const string&, const Core::JSONRPC::Policy&, const Body&) {}, { 1 });
+    uint32_t value = 1;
+    uint32_t calls = 0;
+
+    handler.Register(_T("value"), Core::JSONRPC::InvokeFunction([&](const string&, const string& parameters, string& response) -> uint32_t {
+        calls++;
+        if (parameters.empty() == true) {
+            response = Core::NumberType<uint32_t>(value).Text();
+        } else {
+            value = Core::NumberType<uint32_t>(parameters.c_str(), static_cast<uint32_t>(parameters.length())).Value();
+        }
+        return (Core::ERROR_NONE);
+    }));
+
+    auto call = [&](const string& method, const string& parameters) -> string {
+        string response;
+        const uint32_t revision = handler.Revision();
+
+        if (handler.Cached(method, parameters, response) == false) {
+            EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), method, parameters, response), Core::ERROR_NONE);
+            handler.Store(method, parameters, response, revision);
+        }
+        return (response);
+    };
+
+    // Nothing is kept for methods that did not opt in.
+    EXPECT_EQ(call(_T("value"), EMPTY_STRING), string(_T("1")));
+    EXPECT_EQ(call(_T("value"), EMPTY_STRING), string(_T("1")));
+    EXPECT_EQ(calls, 2u);
+    EXPECT_EQ(handler.Hits() + handler.Misses(), 0u);
+
+    handler.Cache(_T("value"), _T("valuechanged"));
+
+    EXPECT_EQ(call(_T("value"), EMPTY_STRING), string(_T("1")));
+    EXPECT_EQ(call(_T("value"), EMPTY_STRING), string(_T("1")));
+    EXPECT_EQ(call(_T("value@1"), EMPTY_STRING), string(_T("1")));
+    EXPECT_EQ(calls, 4u);
+    EXPECT_EQ(handler.Hits(), 1u);
+    EXPECT_EQ(handler.Misses(), 2u);
+
+    // Setting returns nothing, so it drops what was kept.
+    call(_T("value"), _T("2"));
+    EXPECT_EQ(call(_T("value"), EMPTY_STRING), string(_T("2")));
+    EXPECT_EQ(call(_T("value"), EMPTY_STRING), string(_T("2")));
+    EXPECT_EQ(calls, 6u);
+
+    // As does the associated event, or the plugin saying so.
+    value = 3;
+    handler.Notify(_T("valuechanged"));
+    EXPECT_EQ(call(_T("value"), EMPTY_STRING), string(_T("3")));
+
+    value = 4;
+    handler.Invalidate(_T("value"));
+    EXPECT_EQ(call(_T("value"), EMPTY_STRING), string(_T("4")));
+
+    // What was produced before an invalidation, is not kept.
+    string response;
+    const uint32_t revision = handler.Revision();
+    EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), _T("value@2"), EMPTY_STRING, response), Core::ERROR_NONE);
+    handler.Invalidate(_T("value"));
+    handler.Store(_T("value@2"), EMPTY_STRING, response, revision);
+    EXPECT_FALSE(handler.Cached(_T("value@2"), EMPTY_STRING, response));
+}
+
+TEST(Core_JSONRPC, Stream)
+{
+    Inventory inventory;
+    Core::JSONRPC::Handler handler([](const uint32_t, const string&, const Core::JSONRPC::Policy&, const Body&) {}, { 1 });
+
+    handler.Stream<Core::JSON::ArrayType<Core::JSON::DecUInt32>>(_T("items"), &Inventory::Items, &inventory);
+
+    // Asked for text, the result is still converted.
+    string text;
+    EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), _T("items@3"), EMPTY_STRING, text), Core::ERROR_NONE);
+    EXPECT_EQ(text, string(_T("[0,1,2]")));
+
+    // Otherwise the element is handed over, and serialized straight from there.
+    Core::JSONRPC::Handler::Entry* entry = handler.Find(_T("items"));
+    ASSERT_NE(entry, nullptr);
+
+    string response;
+    Core::ProxyType<Core::JSON::IElement> element;
+    EXPECT_EQ(entry->Invoke(Core::JSONRPC::Connection(1, 1), _T("items"), EMPTY_STRING, response, element), Core::ERROR_NONE);
+    EXPECT_TRUE(response.empty());
+    ASSERT_TRUE(element.IsValid());
+
+    string expected;
+    element->ToString(expected);
+
+    Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message(Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>>::Create());
+    message->Id = 1;
+    message->Stream(element);
+    EXPECT_TRUE(message->IsStreamed());
+
+    const string serialized(Chunks<Core::JSON::IElement, string>(*message, 64));
+    EXPECT_EQ(serialized, string(_T("{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":")) + expected + _T("}"));
+
+    // Inbound, the result is picked up as text.
+    Core::JSONRPC::Message inbound;
+    EXPECT_TRUE(inbound.FromString(serialized));
+    EXPECT_FALSE(inbound.IsStreamed());
+    EXPECT_EQ(inbound.Result.Value(), expected);
+
+    // Over HTTP it goes out in chunks, as the size is not known when the headers are sent.
+    Web::Response outbound;
+    ResponseSerializer serializer;
+    uint8_t buffer[128];
+    string http;
+    uint16_t loaded;
+
+    message->Chunked(true);
+    outbound.ErrorCode = Web::STATUS_OK;
+    outbound.Body(message);
+    serializer.Submit(outbound);
+
+    do {
+        loaded = serializer.Serialize(buffer, sizeof(buffer));
+        http.append(reinterpret_cast<const char*>(buffer), loaded);
+    } while (loaded != 0);
+
+    const size_t start = http.find(_T("\r\n\r\n"));
+    ASSERT_NE(start, string::npos);
+    EXPECT_NE(http.find(_T("Transfer-Encoding: chunked\r\n")), string::npos);
+    EXPECT_EQ(http.find(_T("Content-Length")), string::npos);
+
+    string body;
+    size_t position = start + 4;
+    uint32_t size;
+    do {
+        const size_t end = http.find(_T("\r\n"), position);
+        ASSERT_NE(end, string::npos);
+        size = Core::NumberType<uint32_t, false, BASE_HEXADECIMAL>(Core::TextFragment(http, static_cast<uint32_t>(position), static_cast<uint32_t>(end - position))).Value();
+        body.append(http, end + 2, size);
+        position = end + 2 + size + 2;
+    } while (size != 0);
+
+    EXPECT_EQ(position, http.length());
+    EXPECT_EQ(body, serialized);
+
+    message->Clear();
+    EXPECT_FALSE(message->IsStreamed());
+}
+
+TEST(Core_JSONRPC, Batch)
+{
+    const string requests(_T("[ {\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"Controller.1.status\"},\n")
+                          _T("{\"jsonrpc\":\"2.0\",\"method\":\"Controller.1.harakiri\"} ,")
+                          _T("{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"DeviceInfo.1.systeminfo\",\"params\":{\"full\":true}}]"));
+
+    for (const uint16_t window : { 1, 3, 64 }) {
+        Core::JSONRPC::Message batch;
+        uint32_t offset = 0;
+        uint16_t handled = 0;
+
+        do {
+            const uint16_t size = std::min(window, static_cast<uint16_t>(requests.length() - handled));
+            handled += static_cast<Core::JSON::IElement&>(batch).Deserialize(&(requests[handled]), size, offset);
+        } while ((offset != 0) && (handled < requests.length()));
+
+        EXPECT_EQ(handled, requests.length());
+        ASSERT_TRUE(batch.IsBatch());
+        ASSERT_EQ(batch.Batch().size(), 3u);
+        EXPECT_EQ(batch.Batch()[0]->Id.Value(), 1u);
+        EXPECT_EQ(batch.Batch()[0]->Designator.Value(), string(_T("Controller.1.status")));
+        EXPECT_FALSE(batch.Batch()[1]->Id.IsSet());
+        EXPECT_EQ(batch.Batch()[2]->Parameters.Value(), string(_T("{\"full\":true}")));
+    }
+
+    // An object is still a single request.
+    Core::JSONRPC::Message single;
+    EXPECT_TRUE(single.FromString(_T("{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"Controller.1.status\"}")));
+    EXPECT_FALSE(single.IsBatch());
+
+    // An empty batch is parsed, it is up to the receiver to refuse it.
+    Core::JSONRPC::Message empty;
+    EXPECT_TRUE(empty.FromString(_T("[ ]")));
+    EXPECT_TRUE(empty.IsBatch());
+    EXPECT_TRUE(empty.IsSet());
+    EXPECT_TRUE(empty.Batch().empty());
+
+    Core::JSONRPC::Message invalid;
+    EXPECT_FALSE(invalid.FromString(_T("[1,2]")));
+    EXPECT_FALSE(invalid.FromString(_T("[{\"id\":1},]")));
+
+    // Responses are sent in the order of the requests, the ones without an answer are left out.
+    Core::JSONRPC::Message response;
+    response.Batch(3);
+    response.Batch()[0] = Core::ProxyType<Core::JSONRPC::Message>::Create();
+    response.Batch()[0]->Id = 1;
+    response.Batch()[0]->Result = _T("\"ok\"");
+    response.Batch()[2] = Core::ProxyType<Core::JSONRPC::Message>::Create();
+    response.Batch()[2]->Id = 3;
+    response.Batch()[2]->Error.SetError(Core::ERROR_UNKNOWN_KEY);
+    EXPECT_EQ(response.Entries(), 2u);
+
+    const string expected(_T("[{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"ok\"},{\"jsonrpc\":\"2.0\",\"id\":3,\"error\":{\"code\":-32601}}]"));
+    for (const uint16_t window : { 1, 2, 7, 64 }) {
+        EXPECT_EQ((Chunks<Core::JSON::IElement, std::string>(response, window)), expected);
+    }
+
+    // The same over MessagePack, both ways.
+    std::vector<uint8_t> binary;
+    response.ToBuffer(binary);
+    EXPECT_EQ(binary[0], 0x92);
+    for (const uint16_t window : { 1, 2, 7, 64 }) {
+        EXPECT_EQ((Chunks<Core::JSON::IMessagePack, std::vector<uint8_t>>(response, window)), binary);
+    }
+
+    Core::JSONRPC::Message received;
+    EXPECT_TRUE(received.FromBuffer(binary));
+    ASSERT_TRUE(received.IsBatch());
+    ASSERT_EQ(received.Batch().size(), 2u);
+    EXPECT_EQ(received.Batch()[1]->Error.Code.Value(), -32601);
+
+    string text;
+    received.ToString(text);
+    EXPECT_EQ(text, expected);
+
+    received.Clear();
+    EXPECT_FALSE(received.IsBatch());
+    EXPECT_TRUE(received.Batch().empty());
+
+    // A batch larger than the limit fails to parse, it takes no more entries than allowed.
+    Core::JSONRPC::Message limited;
+    limited.BatchLimit(2);
+    EXPECT_FALSE(limited.FromString(requests));
+    EXPECT_FALSE(limited.IsBatch());
+    EXPECT_TRUE(limited.Batch().empty());
+    EXPECT_TRUE(limited.FromString(_T("[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"Controller.1.status\"},{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"Controller.1.status\"}]")));
+    EXPECT_EQ(limited.Batch().size(), 2u);
+
+    limited.BatchLimit(1);
+    EXPECT_TRUE(limited.FromBuffer(binary));
+    EXPECT_FALSE(limited.IsBatch());
+    EXPECT_TRUE(limited.Batch().empty());
+
+    Core::JSONRPC::Message refused;
+    refused.Error.InvalidRequest(_T("Batch holds no requests."));
+    EXPECT_EQ(refused.Error.Code.Value(), -32600);
+}
+
+TEST(Core_JSONRPC, DISABLED_BatchBenchmark)
+{
+    static constexpr uint16_t Requests = 32;
+    static constexpr uint32_t Rounds = 200;
+
+    Core::JSONRPC::Handler handler([](const uint32_t, const string&, const Core::JSONRPC::Policy&, const Body&) {}, { 1 });
+    handler.Register(_T("property"), Core::JSONRPC::InvokeFunction([](const string&, const string&, string& response) -> uint32_t {
+        response = _T("{\"value\":\"something a UI reads at startup\"}");
+        return (Core::ERROR_NONE);
+    }));
+
+    auto answer = [&handler](const Core::JSONRPC::Message& request) -> Core::ProxyType<Core::JSONRPC::Message> {
+        Core::ProxyType<Core::JSONRPC::Message> response(Core::ProxyType<Core::JSONRPC::Message>::Create());
+        string result;
+        response->Id = request.Id;
+        if (handler.Invoke(Core::JSONRPC::Connection(1, request.Id.Value()), request.Method(), request.Parameters.Value(), result) == Core::ERROR_NONE) {
+            response->Result = result;
+        }
+        return (response);
+    };
+
+    std::vector<string> singles;
+    string batched(_T("["));
+    for (uint16_t index = 0; index < Requests; index++) {
+        singles.push_back(_T("{\"jsonrpc\":\"2.0\",\"id\":") + Core::NumberType<uint16_t>(index + 1).Text() + _T(",\"method\":\"Service.1.property\"}"));
+        batched += (index == 0 ? _T("") : _T(",")) + singles.back();
+    }
+    batched += _T("]");
+
+    uint32_t sent = 0;
+    uint64_t start = Core::Time::Now().Ticks();
+    for (uint32_t round = 0; round < Rounds; ++round) {
+        for (const string& text : singles) {
+            Core::JSONRPC::Message request;
+            string output;
+            request.FromString(text);
+            answer(request)->ToString(output);
+            sent += static_cast<uint32_t>(output.length());
+        }
+    }
+    uint64_t single = Core::Time::Now().Ticks() - start;
+
+    uint32_t combined = 0;
+    start = Core::Time::Now().Ticks();
+    for (uint32_t round = 0; round < Rounds; ++round) {
+        Core::JSONRPC::Message request;
+        Core::JSONRPC::Message response;
+        string output;
+        request.FromString(batched);
+        response.Batch(static_cast<uint16_t>(request.Batch().size()));
+        for (uint16_t index = 0; index < request.Batch().size(); index++) {
+            response.Batch()[index] = answer(*request.Batch()[index]);
+        }
+        response.ToString(output);
+        combined += static_cast<uint32_t>(output.length());
+    }
+    uint64_t batch = Core::Time::Now().Ticks() - start;
+
+    printf("JSONRPC startup burst of %d requests, %d rounds: %d messages in %d us, one batch in %d us\n",
+        Requests, Rounds, Requests, static_cast<uint32_t>(single), static_cast<uint32_t>(batch));
+
+    // Same content, only the framing differs: the brackets and separators against the messages.
+    EXPECT_EQ(combined, sent + (Rounds * Requests) + Rounds);
+}
@@ -0,0 +1,341 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+using namespace WPEFramework;
+
+namespace {
+
+    // Packs the element in chunks of the given window.
+    template <typename ELEMENT>
+    std::vector<uint8_t> Pack(const ELEMENT& element, const uint16_t window)
+    {
+        std::vector<uint8_t> result;
+        uint8_t buffer[1024];
+        uint32_t offset = 0;
+        uint16_t loaded;
+
+        do {
+            loaded = static_cast<const Core::JSON::IMessagePack&>(element).Serialize(buffer, window, offset);
+            result.insert(result.end(), buffer, buffer + loaded);
+        } while ((offset != 0) && (loaded != 0));
+
+        return (result);
+    }
+
+    // Unpacks the stream in chunks of the given window, returns the number of bytes consumed.
+    template <typename ELEMENT>
+    uint32_t Unpack(const std::vector<uint8_t>& stream, ELEMENT& element, const uint16_t window)
+    {
+        uint32_t handled = 0;
+        uint32_t offset = 0;
+
+        do {
+            uint16_t size = static_cast<uint16_t>(std::min(static_cast<uint32_t>(window), static_cast<uint32_t>(stream.size() - handled)));
+            handled += static_cast<Core::JSON::IMessagePack&>(element).Deserialize(&(stream[handled]), size, offset);
+        } while ((offset != 0) && (handled < stream.size()));
+
+        return (offset == 0 ? handled : 0);
+    }
+
+    template <typename ELEMENT, typename TYPE>
+    void Numbers(const std::vector<TYPE>& values)
+    {
+        for (const TYPE value : values) {
+            ELEMENT input;
+            input = value;
+
+            for (uint16_t window = 1; window < 10; ++window) {
+                std::vector<uint8_t> stream(Pack(input, window));
+                ELEMENT output;
+
+                EXPECT_EQ(Unpack(stream, output, window), stream.size());
+                EXPECT_TRUE(output.IsSet());
+                EXPECT_EQ(output.Value(), value);
+            }
+        }
+    }
+
+    Core::ProxyType<Core::JSONRPC::Message> Response(const uint32_t entries)
+    {
+        Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>::Create());
+        string result(_T("["));
+
+        for (uint32_t index = 0; index < entries; ++index) {
+            if (index != 0) {
+                result += ',';
+            }
+            result += _T("{\"callsign\":\"Plugin") + Core::NumberType<uint32_t>(index).Text() + _T("\",\"state\":\"activated\",\"autostart\":true}");
+        }
+        result += ']';
+
+        message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        message->Id = 1234;
+        message->Result = result;
+
+        return (message);
+    }
+
+}
+
+TEST(Core_MessagePack, Numbers)
+{
+    Numbers<Core::JSON::DecUInt8>(std::vector<uint8_t>({ 0, 1, 127, 128, 255 }));
+    Numbers<Core::JSON::DecSInt8>(std::vector<int8_t>({ 0, 2, -1, -32, -33, 127, -128 }));
+    Numbers<Core::JSON::DecUInt32>(std::vector<uint32_t>({ 0, 42, 255, 256, 65535, 65536, 0xFFFFFFFF }));
+    Numbers<Core::JSON::DecSInt32>(std::vector<int32_t>({ 0, 2, -30, -32000, -32603, 40000, -40000, INT32_MAX, INT32_MIN }));
+    Numbers<Core::JSON::DecUInt64>(std::vector<uint64_t>({ 0, 0x100000000ull, UINT64_MAX }));
+    Numbers<Core::JSON::DecSInt64>(std::vector<int64_t>({ 0, -1, -0x100000000ll, INT64_MAX, INT64_MIN }));
+
+    // Small values fit in the header, negative ones as well.
+    Core::JSON::DecSInt32 value;
+    value = 2;
+    EXPECT_EQ(Pack(value, 16), std::vector<uint8_t>({ 0x02 }));
+    value = -30;
+    EXPECT_EQ(Pack(value, 16), std::vector<uint8_t>({ 0xE2 }));
+    value = -32603;
+    EXPECT_EQ(Pack(value, 16), std::vector<uint8_t>({ 0xD1, 0x80, 0xA5 }));
+
+    Core::JSON::DecUInt32 zero;
+    zero = 0;
+    EXPECT_EQ(Pack(zero, 16), std::vector<uint8_t>({ 0x00 }));
+}
+
+TEST(Core_MessagePack, Strings)
+{
+    for (const uint32_t length : { 0u, 31u, 32u, 255u, 256u, 65535u, 70000u }) {
+        Core::JSON::String input;
+        string text;
+
+        for (uint32_t index = 0; index < length; ++index) {
+            text += static_cast<TCHAR>('a' + (index % 26));
+        }
+        input = text;
+
+        for (const uint16_t window : { 1, 3, 7, 1024 }) {
+            std::vector<uint8_t> stream(Pack(input, window));
+            Core::JSON::String output;
+
+            EXPECT_EQ(stream.size(), length + (length <= 31 ? 1 : length <= 0xFF ? 2 : length <= 0xFFFF ? 3 : 5));
+            EXPECT_EQ(Unpack(stream, output, window), stream.size());
+            EXPECT_EQ(output.Value(), text);
+        }
+    }
+}
+
+TEST(Core_MessagePack, Arrays)
+{
+    for (const uint32_t length : { 0u, 1u, 15u, 16u, 300u }) {
+        Core::JSON::ArrayType<Core::JSON::DecUInt16> input;
+
+        for (uint32_t index = 0; index < length; ++index) {
+            input.Add(Core::JSON::DecUInt16(static_cast<uint16_t>(index * 7), true));
+        }
+
+        for (const uint16_t window : { 1, 2, 5, 1024 }) {
+            std::vector<uint8_t> stream(Pack(input, window));
+            Core::JSON::ArrayType<Core::JSON::DecUInt16> output;
+
+            EXPECT_EQ(Unpack(stream, output, window), stream.size());
+            ASSERT_EQ(output.Length(), static_cast<uint16_t>(length));
+            for (uint32_t index = 0; index < length; ++index) {
+                EXPECT_EQ(output[index].Value(), static_cast<uint16_t>(index * 7));
+            }
+        }
+    }
+}
+
+TEST(Core_MessagePack, JSONRPC)
+{
+    Core::JSONRPC::Message request;
+    request.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+    request.Id = 0;
+    request.Designator = _T("Controller.1.status@Netflix");
+    request.Parameters = _T("{\"callsign\":\"Netflix\",\"values\":[1,2,3]}");
+
+    Core::JSONRPC::Message failure;
+    failure.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+    failure.Id = 7;
+    failure.Error.SetError(Core::ERROR_UNKNOWN_KEY);
+    failure.Error.Text = _T("Unknown method.");
+
+    failure.Error.Data = _T("[\"Controller.1.status\",404]");
+
+    // The parameters travel as a string holding their text, it follows the key.
+    static const uint8_t params[] = { 0xA6, 'p', 'a', 'r', 'a', 'm', 's', 0xD9, 39, '{', '\"', 'c', 'a', 'l', 'l', 's', 'i', 'g', 'n' };
+    std::vector<uint8_t> packed(Pack(request, 1024));
+    EXPECT_NE(std::search(packed.begin(), packed.end(), std::begin(params), std::end(params)), packed.end());
+
+    for (const Core::JSONRPC::Message* input : { &request, &failure }) {
+        string expected;
+        input->ToString(expected);
+
+        for (uint16_t window = 1; window < 32; ++window) {
+            std::vector<uint8_t> stream(Pack(*input, window));
+            Core::JSONRPC::Message output;
+
+            EXPECT_EQ(Unpack(stream, output, window), stream.size());
+
+            string received;
+            output.ToString(received);
+            EXPECT_EQ(received, expected);
+        }
+    }
+}
+
+TEST(Core_MessagePack, Payload)
+{
+    // JSON text travels as a string holding the text, it is not parsed to pack it.
+    std::vector<uint8_t> stream;
+    Core::JSONRPC::Payload::Text(_T("{\"a\":"), stream);
+    EXPECT_EQ(stream, std::vector<uint8_t>({ 0xA5, '{', '\"', 'a', '\"', ':' }));
+
+    string array(_T("["));
+    string object(_T("{"));
+    for (uint32_t index = 0; index < 300; ++index) {
+        array += (index != 0 ? _T(",") : _T("")) + Core::NumberType<uint32_t>(index * 1000).Text();
+        object += (index != 0 ? _T(",\"") : _T("\"")) + Core::NumberType<uint32_t>(index).Text() + _T("\":\"") + string(index % 40, 'x') + _T("\"");
+    }
+    array += ']';
+    object += '}';
+
+    for (const string& text : { string(_T("42")), string(_T("\"text\"")), string(_T("[[],{},[[1]],{\"a\":{\"b\":[false]}}]")),
+             string(_T("{\"escaped\":\"\\\"quoted\\\" \\\\ \\n\\t\\r\\b\\f\",\"number\":-0.25}")), array, object }) {
+        Core::JSONRPC::Payload input;
+        input = text;
+        Core::JSONRPC::Payload::Text(text, stream);
+
+        for (const uint16_t window : { 1, 2, 7, 1024 }) {
+            std::vector<uint8_t> packed(Pack(input, window));
+            Core::JSONRPC::Payload output;
+
+            EXPECT_EQ(packed, stream);
+
+            // Whatever follows the value is left for the next element.
+            packed.push_back(0xC0);
+            EXPECT_EQ(Unpack(packed, output, window), packed.size() - 1);
+            EXPECT_EQ(output.Value(), text);
+        }
+    }
+
+    // A value a peer packs natively is taken as well, it is converted into text.
+    const std::vector<uint8_t> map({ 0x82, 0xA1, 'a', 0x94, 0x01, 0xFE, 0xC3, 0xC0, 0xA1, 'b', 0xA1, 'x' });
+    const std::vector<uint8_t> numbers({ 0x96, 0xCC, 0xC8, 0xD1, 0xFF, 0x38, 0xCE, 0x00, 0x01, 0x11, 0x70, 0xD2, 0xFF, 0xFF, 0x63, 0xC0,
+        0xCF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0xCB, 0x40, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 });
+
+    for (const uint16_t window : { 1, 2, 7, 1024 }) {
+        Core::JSONRPC::Payload output;
+
+        EXPECT_EQ(Unpack(map, output, window), map.size());
+        EXPECT_EQ(output.Value(), _T("{\"a\":[1,-2,true,null],\"b\":\"x\"}"));
+        EXPECT_EQ(Unpack(numbers, output, window), numbers.size());
+        EXPECT_EQ(output.Value(), _T("[200,-200,70000,-40000,4294967296,3.5]"));
+    }
+}
+
+TEST(Core_MessagePack, PayloadUnpack)
+{
+    string text;
+
+    // Keys are strings in JSON, binary data is shown in base64.
+    const uint8_t map[] = { 0x83, 0x01, 0xC3, 0xC3, 0xCA, 0x3F, 0xC0, 0x00, 0x00, 0xA3, 'b', 'i', 'n', 0xC4, 0x03, 'a', 'b', 'c' };
+    EXPECT_TRUE(Core::JSONRPC::Payload::Unpack(map, sizeof(map), text));
+    EXPECT_EQ(text, _T("{\"1\":true,\"true\":1.5,\"bin\":\"YWJj\"}"));
+
+    // Incomplete, followed by more data, an array as key or an extension type, is not JSON.
+    const uint8_t incomplete[] = { 0x92, 0x01 };
+    const uint8_t trailing[] = { 0x01, 0x02 };
+    const uint8_t key[] = { 0x81, 0x90, 0x01 };
+    const uint8_t extension[] = { 0xD4, 0x01, 0x01 };
+    EXPECT_FALSE(Core::JSONRPC::Payload::Unpack(incomplete, sizeof(incomplete), text));
+    EXPECT_FALSE(Core::JSONRPC::Payload::Unpack(trailing, sizeof(trailing), text));
+    EXPECT_FALSE(Core::JSONRPC::Payload::Unpack(key, sizeof(key), text));
+    EXPECT_FALSE(Core::JSONRPC::Payload::Unpack(extension, sizeof(extension), text));
+
+    // Nil is null, as it is for any other element.
+    Core::JSONRPC::Payload output;
+    EXPECT_EQ(Unpack(std::vector<uint8_t>({ 0xC0 }), output, 1), 1u);
+    EXPECT_TRUE(output.IsNull());
+}
+
+TEST(Core_MessagePack, Notification)
+{
+    Core::ProxyType<Core::JSONRPC::Notification::Body> body(Core::ProxyType<Core::JSONRPC::Notification::Body>::Create(_T("statechange"), _T("{\"callsign\":\"Netflix\",\"state\":1}")));
+    Core::JSONRPC::Notification notification;
+    notification.Set(body, _T("client.events"));
+
+    string expected;
+    notification.ToString(expected);
+
+    for (uint16_t window = 1; window < 32; ++window) {
+        std::vector<uint8_t> stream(Pack(notification, window));
+        Core::JSONRPC::Message output;
+
+        EXPECT_EQ(Unpack(stream, output, window), stream.size());
+        EXPECT_EQ(output.Parameters.Value(), _T("{\"callsign\":\"Netflix\",\"state\":1}"));
+
+        string received;
+        output.ToString(received);
+        EXPECT_EQ(received, expected);
+    }
+}
+
+TEST(Core_MessagePack, DISABLED_Benchmark)
+{
+    static constexpr uint32_t Rounds = 500;
+
+    Core::ProxyType<Core::JSONRPC::Message> message(Response(64));
+
+    string text;
+    std::vector<uint8_t> binary;
+    message->ToString(text);
+    message->ToBuffer(binary);
+
+    uint64_t start = Core::Time::Now().Ticks();
+    for (uint32_t round = 0; round < Rounds; ++round) {
+        Core::JSONRPC::Message copy;
+        string output;
+        copy.FromString(text);
+        copy.ToString(output);
+    }
+    uint64_t json = Core::Time::Now().Ticks() - start;
+
+    start = Core::Time::Now().Ticks();
+    for (uint32_t round = 0; round < Rounds; ++round) {
+        Core::JSONRPC::Message copy;
+        std::vector<uint8_t> output;
+        copy.FromBuffer(binary);
+        copy.ToBuffer(output);
+    }
+    uint64_t messagePack = Core::Time::Now().Ticks() - start;
+
+    printf("JSONRPC response round trip, %d rounds: JSON %d bytes in %d us, MessagePack %d bytes in %d us\n",
+        Rounds, static_cast<uint32_t>(text.length()), static_cast<uint32_t>(json), static_cast<uint32_t>(binary.size()), static_cast<uint32_t>(messagePack));
+
+    Core::JSONRPC::Message copy;
+    string output;
+    EXPECT_TRUE(copy.FromBuffer(binary));
+    copy.ToString(output);
+    EXPECT_EQ(output, text);
+    EXPECT_LT(binary.size(), text.length());
+}
@@ -247,5 +247,193 @@ namespace Tests {
         EXPECT_EQ(fractional3.Integer(),-2147483648);
         EXPECT_EQ(fractional3.Remainder(),4294967295);
     }
+    TEST(Core_NumberType, IntegerKernels)
+    {
+        char buffer[32];
+        char* end = &buffer[sizeof(buffer)];
+        char reference[32];
+
+        for (const uint64_t value : { 0ull, 9ull, 10ull, 99ull, 100ull, 12345678ull, 4294967295ull, 4294967296ull, 18446744073709551615ull }) {
+            snprintf(reference, sizeof(reference), "%llu", static_cast<unsigned long long>(value));
+            EXPECT_EQ(string(end - Core::ToDecimal(value, end), end), string(reference));
+            snprintf(reference, sizeof(reference), "%llX", static_cast<unsigned long long>(value));
+            EXPECT_EQ(string(end - Core::ToHexadecimal(value, end), end), string(reference));
+            snprintf(reference, sizeof(reference), "%llo", static_cast<unsigned long long>(value));
+            EXPECT_EQ(string(end - Core::ToOctal(value, end), end), string(reference));
+        }
+
+        uint32_t value = 0;
+        EXPECT_TRUE(Core::FromEightDigits("12345678", value));
+        EXPECT_EQ(value, 12345678u);
+        EXPECT_TRUE(Core::FromEightDigits("00000009", value));
+        EXPECT_EQ(value, 9u);
+        EXPECT_FALSE(Core::FromEightDigits("1234567a", value));
+        EXPECT_FALSE(Core::FromEightDigits("1234/678", value));
+        EXPECT_FALSE(Core::FromEightDigits("12 45678", value));
+
+        // Long numbers take the eight digits route, the limits must still hold.
+        string data = "18446744073709551615";
+        EXPECT_EQ(Core::NumberType<uint64_t>(data.c_str(), data.size()).Value(), 18446744073709551615ull);
+        uint64_t overflow = 0;
+        data = "18446744073709551616";
+        EXPECT_EQ(Core::NumberType<uint64_t>::Convert(data.c_str(), static_cast<uint32_t>(data.size()), overflow, BASE_UNKNOWN), 19u);
+        data = "-9223372036854775808";
+        Core::NumberType<int64_t> minimum(data.c_str(), data.size());
+        EXPECT_EQ(minimum.Value(), INT64_MIN);
+        EXPECT_STREQ(minimum.Text().c_str(), "-9223372036854775808");
+        data = "4294967295";
+        EXPECT_EQ(Core::NumberType<uint32_t>(data.c_str(), data.size()).Value(), 4294967295u);
+        data = "-2147483648";
+        EXPECT_EQ(Core::NumberType<int32_t>(data.c_str(), data.size()).Value(), INT32_MIN);
+
+        Core::NumberType<int64_t, true, BASE_HEXADECIMAL> hexadecimal(INT64_MIN);
+        EXPECT_STREQ(hexadecimal.Text().c_str(), "-0x8000000000000000");
+    }
+
+    TEST(Core_NumberType, FloatKernels)
+    {
+        char buffer[32];
+
+        const std::pair<double, const char*> doubles[] = {
+            { 0.0, "0" }, { 1.0, "1" }, { 0.1, "0.1" }, { 0.3, "0.3" }, { -326.545, "-326.545" },
+            { 1e-7, "1e-7" }, { 0.000001, "0.000001" }, { 1e21, "1e+21" }, { 1e20, "100000000000000000000" },
+            { 5e-324, "5e-324" }, { 1.7976931348623157e308, "1.7976931348623157e+308" }
+        };
+        for (const auto& entry : doubles) {
+            EXPECT_EQ(string(buffer, Core::ToShortest(entry.first, buffer)), string(entry.second));
+        }
+        EXPECT_EQ(string(buffer, Core::ToShortest(1.34f, buffer)), string("1.34"));
+        EXPECT_EQ(string(buffer, Core::ToShortest(3.4028235e38f, buffer)), string("3.4028235e+38"));
+
+        // Whatever comes out, must read back to exactly the same bits.
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        for (uint32_t index = 0; index < 100000; ++index) {
+            seed ^= (seed << 13);
+            seed ^= (seed >> 7);
+            seed ^= (seed << 17);
+
+            double input;
+            ::memcpy(&input, &seed, sizeof(input));
+            if ((std::isnan(input) == false) && (std::isinf(input) == false)) {
+                double output = 0;
+                uint8_t length = Core::ToShortest(input, buffer);
+                EXPECT_EQ(Core::FromText(buffer, length, output), length);
+                EXPECT_EQ(::memcmp(&input, &output, sizeof(input)), 0);
+            }
+
+            float single;
+            uint32_t bits = static_cast<uint32_t>(seed >> 16);
+            ::memcpy(&single, &bits, sizeof(single));
+            if ((std::isnan(single) == false) && (std::isinf(single) == false)) {
+                float output = 0;
+                uint8_t length = Core::ToShortest(single, buffer);
+                EXPECT_EQ(Core::FromText(buffer, length, output), length);
+                EXPECT_EQ(::memcmp(&single, &output, sizeof(single)), 0);
+            }
+        }
+
+        // Parsing follows strtod, also for the parts it leaves to the C library.
+        for (const char* text : { "1.34f", "-0", "1e", "1e+", "-.5", "5.", "0x1p3", ".", "-", "  2", "inf", "1e-400", "12345678901234567890", "123456789.123456789e-5" }) {
+            char* end;
+            double expected = ::strtod(text, &end);
+            double value = 0;
+            EXPECT_EQ(Core::FromText(text, static_cast<uint32_t>(strlen(text)), value), static_cast<uint32_t>(end - text));
+            if (end != text) {
+                EXPECT_EQ(::memcmp(&value, &expected, sizeof(value)), 0);
+            }
+        }
+
+        float single = 0;
+        double value = 0;
+        EXPECT_TRUE(Core::FromString(_T("2.5e-3"), value));
+        EXPECT_EQ(value, 2.5e-3);
+        EXPECT_FALSE(Core::FromString(_T("2.5x"), value));
+        EXPECT_TRUE(Core::FromString(Core::ToString(0.1f), single));
+        EXPECT_EQ(single, 0.1f);
+        EXPECT_STREQ(Core::ToString(-0.25).c_str(), _T("-0.25"));
+    }
+
+    TEST(Core_NumberType, JSONFloat)
+    {
+        const string input = _T("[0.1,-326.545,1e-7,12345.678,null]");
+
+        // The outcome may not depend on the size of the windows offered.
+        for (const uint16_t window : { 1, 2, 3, 7, 1024 }) {
+            Core::JSON::ArrayType<Core::JSON::Double> values;
+            string output;
+            uint32_t offset = 0;
+            uint32_t handled = 0;
+            Core::OptionalType<Core::JSON::Error> error;
+
+            while (handled <= input.length()) {
+                uint16_t size = static_cast<uint16_t>(std::min(static_cast<uint32_t>(window), static_cast<uint32_t>(input.length() + 1 - handled)));
+                uint16_t loaded = static_cast<Core::JSON::IElement&>(values).Deserialize(&(input.c_str()[handled]), size, offset, error);
+                handled += loaded;
+                if ((offset == 0) && (loaded != 0)) {
+                    break;
+                }
+            }
+
+            EXPECT_FALSE(error.IsSet());
+            ASSERT_EQ(values.Length(), 5);
+            EXPECT_EQ(values[1].Value(), -326.545);
+            EXPECT_TRUE(values[4].IsNull());
+
+            char buffer[8];
+            offset = 0;
+            do {
+                uint16_t loaded = static_cast<const Core::JSON::IElement&>(values).Serialize(buffer, window < sizeof(buffer) ? window : sizeof(buffer), offset);
+                output.append(buffer, loaded);
+            } while (offset != 0);
+
+            EXPECT_EQ(output, input);
+        }
+    }
+
+    TEST(Core_NumberType, DISABLED_Benchmark)
+    {
+        static constexpr uint32_t Rounds = 200000;
+
+        char buffer[32];
+        uint64_t checksum = 0;
+
+        uint64_t start = Core::Time::Now().Ticks();
+        for (uint32_t round = 0; round < Rounds; ++round) {
+            snprintf(buffer, sizeof(buffer), "%.17g", (round * 0.731) + 0.001);
+            checksum += static_cast<uint64_t>(::strtod(buffer, nullptr));
+        }
+        uint64_t library = Core::Time::Now().Ticks() - start;
+
+        start = Core::Time::Now().Ticks();
+        for (uint32_t round = 0; round < Rounds; ++round) {
+            double value;
+            uint8_t length = Core::ToShortest((round * 0.731) + 0.001, buffer);
+            Core::FromText(buffer, length, value);
+            checksum -= static_cast<uint64_t>(value);
+        }
+        uint64_t kernels = Core::Time::Now().Ticks() - start;
+
+        start = Core::Time::Now().Ticks();
+        for (uint32_t round = 0; round < Rounds; ++round) {
+            snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(round) * 2654435761ull);
+            checksum += ::strtoull(buffer, nullptr, 10);
+        }
+        uint64_t integerLibrary = Core::Time::Now().Ticks() - start;
+
+        start = Core::Time::Now().Ticks();
+        for (uint32_t round = 0; round < Rounds; ++round) {
+            uint64_t value;
+            uint8_t length = Core::ToDecimal(static_cast<uint64_t>(round) * 2654435761ull, &buffer[sizeof(buffer)]);
+            Core::NumberType<uint64_t>::Convert(&buffer[sizeof(buffer) - length], length, value, BASE_DECIMAL);
+            checksum -= value;
+        }
+        uint64_t integerKernels = Core::Time::Now().Ticks() - start;
+
+        printf("Number round trips, %d rounds: double printf/strtod %d us, kernels %d us, integer printf/strtoull %d us, kernels %d us\n",
+            Rounds, static_cast<uint32_t>(library), static_cast<uint32_t>(kernels), static_cast<uint32_t>(integerLibrary), static_cast<uint32_t>(integerKernels));
+
+        // Both sides convert the same values, so they should cancel out.
+        EXPECT_EQ(checksum, 0u);
+    }
 } // Tests
 } // WPEFramework
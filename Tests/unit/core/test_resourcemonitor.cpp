@@ -0,0 +1,492 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    typedef Core::ResourceMonitorType<Core::IResource, Core::Void> Monitor;
+
+    // One end of a socket pair is monitored and echoes whatever it receives, the test drives the other end.
+    // If it transfers, it echoes what the monitor received for it through the monitor, as long as it can.
+    class EchoResource : public Core::IResource, public Core::ITransfer {
+    public:
+        EchoResource() = delete;
+        EchoResource(const EchoResource&) = delete;
+        EchoResource& operator=(const EchoResource&) = delete;
+
+        EchoResource(Monitor& monitor, const bool transfer = false)
+            : _monitor(monitor)
+            , _transfer(transfer)
+            , _echoed(0)
+            , _transferred(0)
+            , _queued(0)
+            , _sent(0)
+        {
+            _descriptors[0] = -1;
+            _descriptors[1] = -1;
+
+            if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, _descriptors) == 0) {
+                ::fcntl(_descriptors[0], F_SETFL, ::fcntl(_descriptors[0], F_GETFL, 0) | O_NONBLOCK);
+                _monitor.Register(*this);
+            }
+        }
+        ~EchoResource() override
+        {
+            if (_descriptors[0] != -1) {
+                _monitor.Unregister(*this);
+                ::close(_descriptors[0]);
+                ::close(_descriptors[1]);
+            }
+        }
+
+    public:
+        bool IsValid() const
+        {
+            return (_descriptors[0] != -1);
+        }
+        uint32_t Echoed() const
+        {
+            return (_echoed);
+        }
+        // What the monitor received for it.
+        uint32_t Transferred() const
+        {
+            return (_transferred);
+        }
+        // What it queued on the monitor, and what the monitor reported sent of it.
+        uint32_t Queued() const
+        {
+            return (_queued);
+        }
+        uint32_t Sent() const
+        {
+            return (_sent);
+        }
+        // Send a message from the other end and wait for it to come back.
+        bool Ping(const uint8_t value)
+        {
+            return ((Send(value) == true) && (Receive(value) == true));
+        }
+        bool Send(const uint8_t value)
+        {
+            return (::send(_descriptors[1], &value, sizeof(value), 0) == sizeof(value));
+        }
+        bool Receive(const uint8_t value)
+        {
+            struct pollfd entry;
+            uint8_t buffer;
+            bool result = false;
+
+            entry.fd = _descriptors[1];
+            entry.events = POLLIN;
+            entry.revents = 0;
+
+            if ((::poll(&entry, 1, 2000) == 1) && (::recv(_descriptors[1], &buffer, sizeof(buffer), 0) == sizeof(buffer))) {
+                result = (buffer == value);
+            }
+
+            return (result);
+        }
+
+    private:
+        handle Descriptor() const override
+        {
+            return (_descriptors[0]);
+        }
+        uint16_t Events() override
+        {
+            return (POLLIN);
+        }
+        void Handle(const uint16_t events) override
+        {
+            if ((events & POLLIN) != 0) {
+                uint8_t buffer[64];
+                int size;
+
+                while ((size = ::recv(_descriptors[0], buffer, sizeof(buffer), 0)) > 0) {
+                    ::send(_descriptors[0], buffer, size, 0);
+                    _echoed += size;
+                }
+            }
+        }
+        bool IsTransferring() const override
+        {
+            return (_transfer);
+        }
+        void Received(uint8_t data[], const int32_t length) override
+        {
+            EXPECT_GE(length, 0);
+
+            if (length > 0) {
+                _transferred += length;
+                _echoed += length;
+
+                if (_monitor.Send(*this, _descriptors[0], data, length) == true) {
+                    _queued += length;
+                } else {
+                    ::send(_descriptors[0], data, length, 0);
+                }
+            }
+        }
+        void Sent(const int32_t result) override
+        {
+            EXPECT_GT(result, 0);
+
+            _sent += result;
+        }
+
+    private:
+        Monitor& _monitor;
+        const bool _transfer;
+        int _descriptors[2];
+        std::atomic<uint32_t> _echoed;
+        std::atomic<uint32_t> _transferred;
+        std::atomic<uint32_t> _queued;
+        std::atomic<uint32_t> _sent;
+    };
+
+    // A listening unix socket, the monitor either reports it readable and it accepts for itself, or (multishot
+    // accept on io_uring) hands it the connections it accepted.
+    class AcceptResource : public Core::IResource, public Core::IAcceptor {
+    public:
+        AcceptResource() = delete;
+        AcceptResource(const AcceptResource&) = delete;
+        AcceptResource& operator=(const AcceptResource&) = delete;
+
+        AcceptResource(Monitor& monitor, const string& path)
+            : _monitor(monitor)
+            , _path(path)
+            , _descriptor(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0))
+            , _accepted(0)
+            , _handedOver(0)
+        {
+            struct sockaddr_un address;
+
+            ::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            ::strncpy(address.sun_path, _path.c_str(), sizeof(address.sun_path) - 1);
+            ::unlink(_path.c_str());
+
+            if ((_descriptor != -1) && (::bind(_descriptor, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0) && (::listen(_descriptor, 64) == 0)) {
+                _monitor.Register(*this);
+            } else if (_descriptor != -1) {
+                ::close(_descriptor);
+                _descriptor = -1;
+            }
+        }
+        ~AcceptResource() override
+        {
+            if (_descriptor != -1) {
+                _monitor.Unregister(*this);
+                ::close(_descriptor);
+                ::unlink(_path.c_str());
+            }
+        }
+
+    public:
+        bool IsValid() const
+        {
+            return (_descriptor != -1);
+        }
+        uint32_t Accepted() const
+        {
+            return (_accepted);
+        }
+        uint32_t HandedOver() const
+        {
+            return (_handedOver);
+        }
+        int Connect() const
+        {
+            struct sockaddr_un address;
+            int result = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+            ::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            ::strncpy(address.sun_path, _path.c_str(), sizeof(address.sun_path) - 1);
+
+            if ((result != -1) && (::connect(result, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0)) {
+                ::close(result);
+                result = -1;
+            }
+
+            return (result);
+        }
+
+    private:
+        handle Descriptor() const override
+        {
+            return (_descriptor);
+        }
+        uint16_t Events() override
+        {
+            return (POLLIN);
+        }
+        void Handle(const uint16_t events) override
+        {
+            if ((events & POLLIN) != 0) {
+                int connection;
+
+                while ((connection = ::accept4(_descriptor, nullptr, nullptr, SOCK_CLOEXEC)) != -1) {
+                    ::close(connection);
+                    _accepted++;
+                }
+            }
+        }
+        void Accepted(const handle connections[], const uint32_t count) override
+        {
+            for (uint32_t index = 0; index < count; index++) {
+                EXPECT_EQ(::fcntl(connections[index], F_GETFD) & FD_CLOEXEC, FD_CLOEXEC);
+                ::close(connections[index]);
+            }
+            _handedOver += count;
+            _accepted += count;
+        }
+
+    private:
+        Monitor& _monitor;
+        const string _path;
+        int _descriptor;
+        std::atomic<uint32_t> _accepted;
+        std::atomic<uint32_t> _handedOver;
+    };
+
+    static const TCHAR* EngineName(const Monitor::engine engine)
+    {
+        return (engine == Monitor::IO_URING ? _T("io_uring") : _T("poll"));
+    }
+
+    static void WaitTillEmpty(const Monitor& monitor)
+    {
+        // Unregistered resources leave the monitor on its next run.
+        for (uint8_t retry = 0; (retry < 100) && (monitor.Count() != 0); retry++) {
+            ::SleepMs(10);
+        }
+        EXPECT_EQ(monitor.Count(), 0u);
+    }
+
+    TEST(Core_ResourceMonitor, Engines)
+    {
+        const Monitor::engine engines[] = { Monitor::POLL, Monitor::IO_URING };
+
+        for (const Monitor::engine engine : engines) {
+            Monitor monitor(engine);
+            std::list<EchoResource*> resources;
+
+            for (uint8_t index = 0; index < 32; index++) {
+                resources.push_back(new EchoResource(monitor));
+                EXPECT_TRUE(resources.back()->IsValid());
+            }
+
+            // Either the requested engine, or the kernel does not offer it.
+            EXPECT_TRUE((monitor.Engine() == engine) || (monitor.Engine() == Monitor::POLL));
+
+            for (uint8_t round = 0; round < 3; round++) {
+                for (EchoResource* resource : resources) {
+                    EXPECT_TRUE(resource->Ping(round));
+                }
+            }
+
+            // Resources leave and new ones (with recycled descriptors) join while the others keep being served.
+            for (uint8_t round = 0; round < 4; round++) {
+                for (uint8_t index = 0; index < 8; index++) {
+                    delete resources.front();
+                    resources.pop_front();
+                }
+                for (uint8_t index = 0; index < 8; index++) {
+                    resources.push_back(new EchoResource(monitor));
+                }
+                for (EchoResource* resource : resources) {
+                    EXPECT_TRUE(resource->Ping(round));
+                }
+            }
+
+            for (EchoResource* resource : resources) {
+                EXPECT_GE(resource->Echoed(), 1u);
+                delete resource;
+            }
+
+            WaitTillEmpty(monitor);
+        }
+    }
+
+    TEST(Core_ResourceMonitor, Accept)
+    {
+        const Monitor::engine engines[] = { Monitor::POLL, Monitor::IO_URING };
+
+        for (const Monitor::engine engine : engines) {
+            Monitor monitor(engine);
+
+            {
+                AcceptResource listener(monitor, _T("/tmp/resourcemonitor.accept"));
+                EchoResource other(monitor);
+                std::vector<int> connections;
+
+                ASSERT_TRUE(listener.IsValid());
+
+                // Bursts of connections, while the other resources keep being served.
+                for (uint8_t round = 0; round < 4; round++) {
+                    for (uint8_t index = 0; index < 32; index++) {
+                        connections.push_back(listener.Connect());
+                        EXPECT_NE(connections.back(), -1);
+                    }
+
+                    EXPECT_TRUE(other.Ping(round));
+
+                    for (uint8_t retry = 0; (retry < 200) && (listener.Accepted() != connections.size()); retry++) {
+                        ::SleepMs(10);
+                    }
+                    EXPECT_EQ(listener.Accepted(), connections.size());
+                }
+
+                // Only a monitor on io_uring accepts for its listeners, if the kernel offers multishot accept.
+                if (monitor.Engine() == Monitor::POLL) {
+                    EXPECT_EQ(listener.HandedOver(), 0u);
+                }
+                EXPECT_LE(listener.HandedOver(), listener.Accepted());
+
+                for (int connection : connections) {
+                    ::close(connection);
+                }
+            }
+
+            WaitTillEmpty(monitor);
+        }
+    }
+
+    TEST(Core_ResourceMonitor, Transfers)
+    {
+        const Monitor::engine engines[] = { Monitor::POLL, Monitor::IO_URING };
+
+        for (const Monitor::engine engine : engines) {
+            Monitor monitor(engine);
+            std::list<EchoResource*> resources;
+
+            for (uint8_t index = 0; index < 32; index++) {
+                resources.push_back(new EchoResource(monitor, true));
+                EXPECT_TRUE(resources.back()->IsValid());
+            }
+
+            // Only a monitor on io_uring moves the data, if the kernel lets it.
+            EXPECT_TRUE((monitor.Engine() == Monitor::IO_URING) || (monitor.Transfers() == false));
+
+            for (uint8_t round = 0; round < 3; round++) {
+                for (EchoResource* resource : resources) {
+                    EXPECT_TRUE(resource->Ping(round));
+                }
+            }
+
+            // Resources leave and join while the data of the others keeps moving.
+            for (uint8_t round = 0; round < 4; round++) {
+                for (uint8_t index = 0; index < 8; index++) {
+                    delete resources.front();
+                    resources.pop_front();
+                }
+                for (uint8_t index = 0; index < 8; index++) {
+                    resources.push_back(new EchoResource(monitor, true));
+                }
+                for (EchoResource* resource : resources) {
+                    EXPECT_TRUE(resource->Ping(round));
+                }
+            }
+
+            for (EchoResource* resource : resources) {
+                if (monitor.Transfers() == true) {
+                    // The peer can have the echo before the monitor reported the send done.
+                    for (uint8_t retry = 0; (retry < 100) && (resource->Sent() != resource->Queued()); retry++) {
+                        ::SleepMs(10);
+                    }
+                    EXPECT_EQ(resource->Transferred(), resource->Echoed());
+                    EXPECT_EQ(resource->Queued(), resource->Echoed());
+                    EXPECT_EQ(resource->Sent(), resource->Queued());
+                } else {
+                    EXPECT_EQ(resource->Transferred(), 0u);
+                    EXPECT_EQ(resource->Queued(), 0u);
+                }
+                delete resource;
+            }
+
+            WaitTillEmpty(monitor);
+        }
+    }
+
+    TEST(Core_ResourceMonitor, DISABLED_EngineBenchmark)
+    {
+        const Monitor::engine engines[] = { Monitor::POLL, Monitor::IO_URING };
+        const uint16_t connections[] = { 16, 128, 512 };
+        const uint32_t RoundTrips = 4000;
+        const uint32_t Bursts = 100;
+
+        for (const Monitor::engine engine : engines) {
+            for (const bool transfer : { false, true }) {
+                for (const uint16_t count : connections) {
+                    Monitor monitor(engine);
+                    std::vector<EchoResource*> resources;
+
+                    // Setting up connections: register and get the first message through.
+                    uint64_t start = Core::Time::Now().Ticks();
+                    for (uint16_t index = 0; index < count; index++) {
+                        resources.push_back(new EchoResource(monitor, transfer));
+                        EXPECT_TRUE(resources.back()->Ping(0));
+                    }
+                    uint64_t setup = Core::Time::Now().Ticks() - start;
+
+                    // Throughput: a few busy connections among idle ones, every message is a monitor run.
+                    start = Core::Time::Now().Ticks();
+                    for (uint32_t index = 0; index < RoundTrips; index++) {
+                        EXPECT_TRUE(resources[index % 4]->Ping(static_cast<uint8_t>(index)));
+                    }
+                    uint64_t duration = Core::Time::Now().Ticks() - start;
+
+                    // Bursts: all connections busy at once, the echoes of a monitor run go out together.
+                    start = Core::Time::Now().Ticks();
+                    for (uint32_t burst = 0; burst < Bursts; burst++) {
+                        for (EchoResource* resource : resources) {
+                            EXPECT_TRUE(resource->Send(static_cast<uint8_t>(burst)));
+                        }
+                        for (EchoResource* resource : resources) {
+                            EXPECT_TRUE(resource->Receive(static_cast<uint8_t>(burst)));
+                        }
+                    }
+                    uint64_t bursts = Core::Time::Now().Ticks() - start;
+
+                    printf("%-8s %-9s %4d connections: setup %6d us/connection, %7d round trips/s, %8d echoes/s in bursts\n",
+                        EngineName(monitor.Engine()), ((transfer == true) && (monitor.Transfers() == true) ? _T("transfer") : _T("")), count,
+                        static_cast<uint32_t>(setup / count),
+                        static_cast<uint32_t>((static_cast<uint64_t>(RoundTrips) * 1000000) / (duration != 0 ? duration : 1)),
+                        static_cast<uint32_t>((static_cast<uint64_t>(Bursts) * count * 1000000) / (bursts != 0 ? bursts : 1)));
+
+                    for (EchoResource* resource : resources) {
+                        delete resource;
+                    }
+
+                    WaitTillEmpty(monitor);
+                }
+            }
+        }
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,320 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // A plain OpenSSL server, one connection at a time. Every 4 byte (big endian) number it receives is
+    // answered with that many bytes.
+    class TLSServer {
+    public:
+        TLSServer() = delete;
+        TLSServer(const TLSServer&) = delete;
+        TLSServer& operator=(const TLSServer&) = delete;
+
+        TLSServer(const uint16_t port, const bool tickets)
+            : _context(SSL_CTX_new(TLS_server_method()))
+            , _listener(::socket(AF_INET, SOCK_STREAM, 0))
+            , _running(true)
+            , _thread()
+        {
+            EVP_PKEY* key = Key();
+            X509* certificate = Certificate(key);
+
+            SSL_CTX_use_certificate(_context, certificate);
+            SSL_CTX_use_PrivateKey(_context, key);
+
+            if (tickets == false) {
+                // Nothing to resume, every handshake is a full one.
+                SSL_CTX_set_num_tickets(_context, 0);
+                SSL_CTX_set_options(_context, SSL_OP_NO_TICKET);
+                SSL_CTX_set_session_cache_mode(_context, SSL_SESS_CACHE_OFF);
+            }
+
+            X509_free(certificate);
+            EVP_PKEY_free(key);
+
+            struct sockaddr_in address;
+            int value = 1;
+
+            ::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            ::setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &value, sizeof(value));
+            EXPECT_EQ(::bind(_listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+            EXPECT_EQ(::listen(_listener, 16), 0);
+
+            _thread = std::thread([this]() { Serve(); });
+        }
+        ~TLSServer()
+        {
+            _running = false;
+            ::shutdown(_listener, SHUT_RDWR);
+            _thread.join();
+            ::close(_listener);
+            SSL_CTX_free(_context);
+        }
+
+    private:
+        static EVP_PKEY* Key()
+        {
+            EVP_PKEY* result = nullptr;
+            EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+
+            EVP_PKEY_keygen_init(context);
+            EVP_PKEY_CTX_set_ec_paramgen_curve_nid(context, NID_X9_62_prime256v1);
+            EVP_PKEY_keygen(context, &result);
+            EVP_PKEY_CTX_free(context);
+
+            return (result);
+        }
+        static X509* Certificate(EVP_PKEY* key)
+        {
+            X509* result = X509_new();
+
+            X509_set_version(result, 2);
+            ASN1_INTEGER_set(X509_get_serialNumber(result), 1);
+            X509_gmtime_adj(X509_getm_notBefore(result), 0);
+            X509_gmtime_adj(X509_getm_notAfter(result), 3600);
+            X509_set_pubkey(result, key);
+            X509_NAME_add_entry_by_txt(X509_get_subject_name(result), "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+            X509_set_issuer_name(result, X509_get_subject_name(result));
+            X509_sign(result, key, EVP_sha256());
+
+            return (result);
+        }
+        void Serve()
+        {
+            int connection;
+
+            while ((_running == true) && ((connection = ::accept(_listener, nullptr, nullptr)) >= 0)) {
+                SSL* ssl = SSL_new(_context);
+
+                SSL_set_fd(ssl, connection);
+
+                if (SSL_accept(ssl) == 1) {
+                    uint8_t request[4];
+                    uint8_t block[16 * 1024];
+
+                    ::memset(block, 0xA5, sizeof(block));
+
+                    while (SSL_read(ssl, request, sizeof(request)) == sizeof(request)) {
+                        uint32_t size = (request[0] << 24) | (request[1] << 16) | (request[2] << 8) | request[3];
+
+                        while (size > 0) {
+                            int sent = SSL_write(ssl, block, std::min(size, static_cast<uint32_t>(sizeof(block))));
+
+                            size = (sent > 0 ? size - sent : 0);
+                        }
+                    }
+                }
+
+                SSL_free(ssl);
+                ::close(connection);
+            }
+        }
+
+    private:
+        SSL_CTX* _context;
+        int _listener;
+        std::atomic<bool> _running;
+        std::thread _thread;
+    };
+
+    class TLSClient : public Crypto::SecureSocketPort {
+    public:
+        TLSClient() = delete;
+        TLSClient(const TLSClient&) = delete;
+        TLSClient& operator=(const TLSClient&) = delete;
+
+        TLSClient(const Core::NodeId& remoteNode)
+            : Crypto::SecureSocketPort(Core::SocketPort::STREAM, remoteNode.AnyInterface(), remoteNode, 64 * 1024, 64 * 1024)
+            , _connected(false, true)
+            , _completed(false, true)
+            , _request(0)
+            , _expected(0)
+            , _received(0)
+        {
+        }
+        ~TLSClient() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        bool Connect()
+        {
+            const uint32_t result = Open(0);
+
+            return (((result == Core::ERROR_NONE) || (result == Core::ERROR_INPROGRESS)) && (_connected.Lock(2000) == Core::ERROR_NONE));
+        }
+        // Ask the server for size bytes and wait till they are all in.
+        bool Fetch(const uint32_t size)
+        {
+            _completed.ResetEvent();
+            _received = 0;
+            _expected = size;
+            _request = size;
+
+            Trigger();
+
+            return ((_completed.Lock(10000) == Core::ERROR_NONE) && (_received == size));
+        }
+
+    private:
+        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+        {
+            uint16_t result = 0;
+
+            if ((_request != 0) && (maxSendSize >= 4)) {
+                dataFrame[0] = static_cast<uint8_t>(_request >> 24);
+                dataFrame[1] = static_cast<uint8_t>(_request >> 16);
+                dataFrame[2] = static_cast<uint8_t>(_request >> 8);
+                dataFrame[3] = static_cast<uint8_t>(_request);
+                _request = 0;
+                result = 4;
+            }
+
+            return (result);
+        }
+        uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+        {
+            _received += receivedSize;
+
+            if (_received >= _expected) {
+                _completed.SetEvent();
+            }
+
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+            if (IsOpen() == true) {
+                _connected.SetEvent();
+            }
+        }
+
+    private:
+        Core::Event _connected;
+        Core::Event _completed;
+        std::atomic<uint32_t> _request;
+        std::atomic<uint32_t> _expected;
+        std::atomic<uint32_t> _received;
+    };
+
+    // Returns the microseconds it took to get the handshake done, 0 if it did not complete.
+    static uint64_t Handshake(const Core::NodeId& node, bool& resumed)
+    {
+        TLSClient client(node);
+        uint64_t start = Core::Time::Now().Ticks();
+        uint64_t duration = 0;
+
+        if (client.Connect() == true) {
+            duration = Core::Time::Now().Ticks() - start;
+            resumed = client.Resumed();
+
+            // The server sends its session tickets right after the handshake, they come in with the data.
+            EXPECT_TRUE(client.Fetch(1));
+        }
+
+        client.Close(Core::infinite);
+
+        return (duration);
+    }
+
+    TEST(Crypto_SecureSocketPort, Resumption)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), 12390);
+        TLSServer server(12390, true);
+        bool resumed = true;
+
+        EXPECT_NE(Handshake(node, resumed), 0u);
+        EXPECT_FALSE(resumed);
+
+        for (uint8_t index = 0; index < 3; index++) {
+            EXPECT_NE(Handshake(node, resumed), 0u);
+            EXPECT_TRUE(resumed);
+        }
+    }
+
+    TEST(Crypto_SecureSocketPort, FullHandshake)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), 12391);
+        TLSServer server(12391, false);
+        bool resumed = true;
+
+        for (uint8_t index = 0; index < 3; index++) {
+            EXPECT_NE(Handshake(node, resumed), 0u);
+            EXPECT_FALSE(resumed);
+        }
+    }
+
+    TEST(Crypto_SecureSocketPort, DISABLED_Benchmark)
+    {
+        static constexpr uint16_t Connections = 100;
+        static constexpr uint32_t Size = 64 * 1024 * 1024;
+
+        const bool tickets[] = { false, true };
+        uint16_t port = 12392;
+
+        for (const bool ticket : tickets) {
+            const Core::NodeId node(_T("127.0.0.1"), port);
+            TLSServer server(port++, ticket);
+            uint64_t total = 0;
+            uint16_t resumptions = 0;
+
+            for (uint16_t index = 0; index < Connections; index++) {
+                bool resumed = false;
+
+                total += Handshake(node, resumed);
+                resumptions += (resumed == true ? 1 : 0);
+            }
+
+            printf("%-7s handshakes: %5d us each, %3d of %d resumed\n", (ticket == true ? "resumed" : "full"),
+                static_cast<uint32_t>(total / Connections), resumptions, Connections);
+        }
+
+        const Core::NodeId node(_T("127.0.0.1"), port);
+        TLSServer server(port, true);
+        TLSClient client(node);
+
+        ASSERT_TRUE(client.Connect());
+
+        uint64_t start = Core::Time::Now().Ticks();
+        EXPECT_TRUE(client.Fetch(Size));
+        uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        printf("Bulk: %d MB/s\n", static_cast<uint32_t>(Size / (duration != 0 ? duration : 1)));
+
+        client.Close(Core::infinite);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,447 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static uint8_t Pattern(const uint32_t offset)
+    {
+        return (static_cast<uint8_t>((offset * 7) ^ (offset >> 9)));
+    }
+
+    // Accepted side, checks every byte that comes in against the pattern.
+    class SinkConnection : public Core::SocketStream {
+    public:
+        SinkConnection() = delete;
+        SinkConnection(const SinkConnection&) = delete;
+        SinkConnection& operator=(const SinkConnection&) = delete;
+
+        SinkConnection(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<SinkConnection>*)
+            : Core::SocketStream(false, connector, remoteId, BufferSize, BufferSize)
+            , _received(0)
+            , _corrupted(0)
+            , _largest(0)
+        {
+            // Accepted connections are picked up by the monitor after their constructor.
+            Transfers(Transferring);
+        }
+        ~SinkConnection() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        static uint32_t BufferSize;
+        static bool Transferring;
+
+        uint32_t Received() const
+        {
+            return (_received);
+        }
+        uint32_t Corrupted() const
+        {
+            return (_corrupted);
+        }
+        uint16_t Largest() const
+        {
+            return (_largest);
+        }
+
+    private:
+        uint16_t SendData(uint8_t*, const uint16_t) override
+        {
+            return (0);
+        }
+        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+        {
+            for (uint16_t index = 0; index < receivedSize; index++) {
+                if (dataFrame[index] != Pattern(_received + index)) {
+                    _corrupted++;
+                }
+            }
+
+            _received += receivedSize;
+            _largest = std::max(_largest, receivedSize);
+
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        std::atomic<uint32_t> _received;
+        uint32_t _corrupted;
+        uint16_t _largest;
+    };
+
+    uint32_t SinkConnection::BufferSize = 0;
+    bool SinkConnection::Transferring = false;
+
+    // Connecting side, sends the pattern till the requested amount is out.
+    class SourceConnection : public Core::SocketStream {
+    public:
+        SourceConnection() = delete;
+        SourceConnection(const SourceConnection&) = delete;
+        SourceConnection& operator=(const SourceConnection&) = delete;
+
+        SourceConnection(const Core::NodeId& remoteNode, const uint32_t bufferSize)
+            : Core::SocketStream(false, remoteNode.AnyInterface(), remoteNode, bufferSize, bufferSize)
+            , _adminLock()
+            , _sent(0)
+            , _size(0)
+            , _largest(0)
+        {
+        }
+        ~SourceConnection() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        void Send(const uint32_t size)
+        {
+            _adminLock.Lock();
+            _size += size;
+            _adminLock.Unlock();
+
+            Trigger();
+        }
+        uint16_t Largest() const
+        {
+            return (_largest);
+        }
+
+    private:
+        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+        {
+            _adminLock.Lock();
+
+            uint16_t result = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxSendSize), _size - _sent));
+
+            for (uint16_t index = 0; index < result; index++) {
+                dataFrame[index] = Pattern(_sent + index);
+            }
+
+            _sent += result;
+            _largest = std::max(_largest, result);
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        uint16_t ReceiveData(uint8_t*, const uint16_t) override
+        {
+            return (0);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        uint32_t _sent;
+        uint32_t _size;
+        uint16_t _largest;
+    };
+
+    static SinkConnection* Accepted(const Core::SocketServerType<SinkConnection>& server)
+    {
+        Core::SocketServerType<SinkConnection>::Iterator index(server.Clients());
+
+        return (index.Next() == true ? &(*(index.Client())) : nullptr);
+    }
+
+    static bool WaitFor(const SinkConnection& sink, const uint32_t size)
+    {
+        for (uint16_t retry = 0; (retry < 1000) && (sink.Received() < size); retry++) {
+            ::SleepMs(10);
+        }
+
+        return (sink.Received() == size);
+    }
+
+    // Returns the microseconds it took to move size bytes.
+    static uint64_t Transfer(const uint16_t port, const uint32_t bufferSize, const uint32_t size, const bool transfer = false)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), port);
+        Core::SocketServerType<SinkConnection> server(node);
+        uint64_t duration = 0;
+
+        SinkConnection::BufferSize = bufferSize;
+        SinkConnection::Transferring = transfer;
+
+        EXPECT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        {
+            SourceConnection source(node, bufferSize);
+
+            source.Transfers(transfer);
+            EXPECT_EQ(source.Open(1000), Core::ERROR_NONE);
+
+            uint64_t start = Core::Time::Now().Ticks();
+            source.Send(size);
+
+            for (uint16_t retry = 0; (retry < 100) && (Accepted(server) == nullptr); retry++) {
+                ::SleepMs(10);
+            }
+
+            SinkConnection* sink = Accepted(server);
+
+            EXPECT_NE(sink, nullptr);
+
+            if (sink != nullptr) {
+                EXPECT_TRUE(WaitFor(*sink, size));
+                duration = Core::Time::Now().Ticks() - start;
+                EXPECT_EQ(sink->Corrupted(), 0u);
+            }
+
+            source.Close(Core::infinite);
+        }
+        server.Close(Core::infinite);
+
+        SinkConnection::Transferring = false;
+
+        return (duration != 0 ? duration : 1);
+    }
+
+    TEST(Core_SocketBuffer, GrowAndShrink)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), 12370);
+        Core::SocketServerType<SinkConnection> server(node);
+
+        // Beyond what 16 bits could hold.
+        SinkConnection::BufferSize = 256 * 1024;
+
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        {
+            SourceConnection source(node, SinkConnection::BufferSize);
+
+            ASSERT_EQ(source.Open(1000), Core::ERROR_NONE);
+            EXPECT_EQ(source.SendBufferSize(), SinkConnection::BufferSize);
+
+            // A connection that did not move anything yet only holds the small buffers.
+            EXPECT_EQ(source.Allocated(), 2u * 1024u);
+
+            uint32_t total = 0;
+
+            // A trickle keeps the buffers small, a burst grows them.
+            for (uint8_t round = 0; round < 2; round++) {
+                for (uint8_t index = 0; index < 16; index++) {
+                    source.Send(100);
+                    total += 100;
+                    ::SleepMs(1);
+                }
+
+                source.Send(16 * 1024 * 1024);
+                total += 16 * 1024 * 1024;
+
+                for (uint16_t retry = 0; (retry < 100) && (Accepted(server) == nullptr); retry++) {
+                    ::SleepMs(10);
+                }
+
+                SinkConnection* sink = Accepted(server);
+                ASSERT_NE(sink, nullptr);
+                EXPECT_TRUE(WaitFor(*sink, total));
+                EXPECT_EQ(sink->Corrupted(), 0u);
+
+                // Slices of the grown buffers, far beyond the initial 1KB.
+                EXPECT_GT(sink->Largest(), 1024);
+                EXPECT_GT(source.Largest(), 1024);
+
+                // Idle again, all grown buffers went back to the pool.
+                ::SleepMs(50);
+                EXPECT_EQ(sink->Allocated(), 2u * 1024u);
+                EXPECT_EQ(source.Allocated(), 2u * 1024u);
+            }
+
+            source.Close(Core::infinite);
+        }
+        server.Close(Core::infinite);
+    }
+
+    TEST(Core_SocketBuffer, Small)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), 12371);
+        Core::SocketServerType<SinkConnection> server(node);
+
+        // Configured below the initial size, nothing to grow, nothing more allocated.
+        SinkConnection::BufferSize = 512;
+
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        {
+            SourceConnection source(node, SinkConnection::BufferSize);
+
+            ASSERT_EQ(source.Open(1000), Core::ERROR_NONE);
+
+            // Tiny kernel buffers make for a slow stream, keep it short.
+            source.Send(16 * 1024);
+
+            for (uint16_t retry = 0; (retry < 100) && (Accepted(server) == nullptr); retry++) {
+                ::SleepMs(10);
+            }
+
+            SinkConnection* sink = Accepted(server);
+            ASSERT_NE(sink, nullptr);
+            EXPECT_TRUE(WaitFor(*sink, 16 * 1024));
+            EXPECT_EQ(sink->Corrupted(), 0u);
+            EXPECT_LE(sink->Largest(), 512);
+            EXPECT_LE(source.Largest(), 512);
+            EXPECT_EQ(sink->Allocated(), 1024u);
+
+            source.Close(Core::infinite);
+        }
+        server.Close(Core::infinite);
+    }
+
+    TEST(Core_SocketBuffer, Metrics)
+    {
+        static constexpr uint32_t Size = 4 * 1024 * 1024;
+
+        const Core::NodeId node(_T("127.0.0.1"), 12375);
+        Core::SocketServerType<SinkConnection> server(node);
+
+        SinkConnection::BufferSize = 64 * 1024;
+
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        {
+            SourceConnection source(node, SinkConnection::BufferSize);
+
+            ASSERT_EQ(source.Open(1000), Core::ERROR_NONE);
+
+            for (uint16_t retry = 0; (retry < 100) && (Accepted(server) == nullptr); retry++) {
+                ::SleepMs(10);
+            }
+
+            SinkConnection* sink = Accepted(server);
+            ASSERT_NE(sink, nullptr);
+
+            // As long as the sink does not read, the kernel buffers (far less than Size) fill up and the
+            // source runs into EAGAIN. From then on it waits for room, and that counts while it waits.
+            sink->Throttle(true);
+            source.Send(Size);
+
+            for (uint16_t retry = 0; (retry < 500) && (source.Metrics().Blocked == 0); retry++) {
+                ::SleepMs(10);
+            }
+
+            const Core::SocketPort::Statistics blocked(source.Metrics());
+
+            ASSERT_GT(blocked.Blocked, 0u);
+            EXPECT_LT(blocked.Sent, Size);
+
+            sink->Throttle(false);
+            EXPECT_TRUE(WaitFor(*sink, Size));
+
+            const Core::SocketPort::Statistics sent(source.Metrics());
+            const Core::SocketPort::Statistics received(sink->Metrics());
+
+            EXPECT_EQ(sent.Sent, Size);
+            EXPECT_EQ(sent.Received, 0u);
+            EXPECT_EQ(received.Received, Size);
+            EXPECT_EQ(received.Sent, 0u);
+
+            // Never more waiting than the buffer holds, so never less calls than it takes to move it all.
+            EXPECT_GT(sent.Queue, 0u);
+            EXPECT_LE(sent.Queue, SinkConnection::BufferSize);
+            EXPECT_GE(sent.Writes, Size / SinkConnection::BufferSize);
+            EXPECT_GE(received.Reads, Size / SinkConnection::BufferSize);
+            EXPECT_GE(sent.Blocked, blocked.Blocked);
+
+            // Loopback can be too fast to measure, all that counts is that it is not made up.
+            EXPECT_LT(sent.RoundTrip, 1000000u);
+
+            source.Close(Core::infinite);
+        }
+        server.Close(Core::infinite);
+    }
+
+    TEST(Core_SocketBuffer, Transfers)
+    {
+        static constexpr uint32_t Size = 4 * 1024 * 1024;
+
+        const Core::NodeId node(_T("127.0.0.1"), 12376);
+        Core::SocketServerType<SinkConnection> server(node);
+
+        // Both ends leave their data to the monitor, where it can move it for them.
+        SinkConnection::BufferSize = 64 * 1024;
+        SinkConnection::Transferring = true;
+
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        {
+            SourceConnection source(node, SinkConnection::BufferSize);
+
+            source.Transfers(true);
+            EXPECT_TRUE(source.Transfers());
+
+            ASSERT_EQ(source.Open(1000), Core::ERROR_NONE);
+
+            source.Send(Size);
+
+            for (uint16_t retry = 0; (retry < 100) && (Accepted(server) == nullptr); retry++) {
+                ::SleepMs(10);
+            }
+
+            SinkConnection* sink = Accepted(server);
+            ASSERT_NE(sink, nullptr);
+            EXPECT_TRUE(sink->Transfers());
+            EXPECT_TRUE(WaitFor(*sink, Size));
+            EXPECT_EQ(sink->Corrupted(), 0u);
+
+            // Partial sends are completed by the monitor, nothing is counted twice or lost.
+            for (uint16_t retry = 0; (retry < 100) && (source.Metrics().Sent != Size); retry++) {
+                ::SleepMs(10);
+            }
+            EXPECT_EQ(source.Metrics().Sent, Size);
+            EXPECT_EQ(sink->Metrics().Received, Size);
+
+            // And a trickle after the burst, every message on its own.
+            for (uint8_t index = 0; index < 16; index++) {
+                source.Send(100);
+                EXPECT_TRUE(WaitFor(*sink, Size + ((index + 1) * 100)));
+            }
+            EXPECT_EQ(sink->Corrupted(), 0u);
+
+            source.Close(Core::infinite);
+        }
+        server.Close(Core::infinite);
+
+        SinkConnection::Transferring = false;
+    }
+
+    TEST(Core_SocketBuffer, DISABLED_Benchmark)
+    {
+        static constexpr uint32_t Size = 64 * 1024 * 1024;
+
+        const uint32_t sizes[] = { 64 * 1024, 256 * 1024, 1024 * 1024 };
+        uint16_t port = 12372;
+
+        for (const bool transfer : { false, true }) {
+            for (const uint32_t size : sizes) {
+                uint64_t duration = Transfer(port++, size, Size, transfer);
+
+                printf("Buffers of at most %7d bytes%s: %5d MB/s\n", size, (transfer == true ? _T(", transfers") : _T("")), static_cast<uint32_t>(Size / duration));
+            }
+        }
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,262 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <net/if.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static constexpr uint16_t DatagramSize = 64;
+
+    // Checks the datagrams that come in: numbered, in order, from the expected sender, on the loopback.
+    class DatagramSink : public Core::SocketDatagram {
+    public:
+        DatagramSink() = delete;
+        DatagramSink(const DatagramSink&) = delete;
+        DatagramSink& operator=(const DatagramSink&) = delete;
+
+        DatagramSink(const uint16_t port, const uint8_t batch)
+            : Core::SocketDatagram(false, Core::NodeId(_T("0.0.0.0"), port), Core::NodeId(), 1024, 1024)
+            , _sender(0)
+            , _received(0)
+            , _next(0)
+            , _misplaced(0)
+        {
+            Batch(batch);
+        }
+        ~DatagramSink() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        void Expect(const uint16_t sender, const uint32_t first)
+        {
+            _sender = sender;
+            _next = first;
+        }
+        uint32_t Received() const
+        {
+            return (_received);
+        }
+        uint32_t Misplaced() const
+        {
+            return (_misplaced);
+        }
+        bool WaitFor(const uint32_t count) const
+        {
+            for (uint16_t retry = 0; (retry < 500) && (_received < count); retry++) {
+                ::SleepMs(2);
+            }
+
+            return (_received == count);
+        }
+        // Wait till count came in, or nothing came in for a while (the rest was dropped).
+        void Settle(const uint32_t count) const
+        {
+            uint32_t last = ~0;
+
+            while ((_received < count) && (_received != last)) {
+                last = _received;
+                ::SleepMs(5);
+            }
+        }
+
+    private:
+        uint16_t SendData(uint8_t*, const uint16_t) override
+        {
+            return (0);
+        }
+        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+        {
+            uint32_t sequence;
+
+            ::memcpy(&sequence, dataFrame, sizeof(sequence));
+
+            if ((receivedSize != DatagramSize) || (ReceivedNode().PortNumber() != _sender) ||
+                (ReceivedInterface() != ::if_nametoindex("lo")) || ((_sender != 0) && (sequence != _next))) {
+                _misplaced++;
+            }
+
+            _next = sequence + 2;
+            _received++;
+
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        uint16_t _sender;
+        std::atomic<uint32_t> _received;
+        uint32_t _next;
+        uint32_t _misplaced;
+    };
+
+    // Sends numbered datagrams, alternating over two destinations.
+    class DatagramSource : public Core::SocketDatagram {
+    public:
+        DatagramSource() = delete;
+        DatagramSource(const DatagramSource&) = delete;
+        DatagramSource& operator=(const DatagramSource&) = delete;
+
+        DatagramSource(const uint16_t port, const Core::NodeId& first, const Core::NodeId& second, const uint8_t batch)
+            : Core::SocketDatagram(false, Core::NodeId(_T("127.0.0.1"), port), first, 1024, 1024)
+            , _adminLock()
+            , _first(first)
+            , _second(second)
+            , _sent(0)
+            , _size(0)
+        {
+            Batch(batch);
+        }
+        ~DatagramSource() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        void Send(const uint32_t count)
+        {
+            _adminLock.Lock();
+            _size += count;
+            _adminLock.Unlock();
+
+            Trigger();
+        }
+
+    private:
+        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+        {
+            uint16_t result = 0;
+
+            _adminLock.Lock();
+
+            if ((_sent < _size) && (maxSendSize >= DatagramSize)) {
+                ::memset(dataFrame, 0, DatagramSize);
+                ::memcpy(dataFrame, &_sent, sizeof(_sent));
+
+                RemoteNode((_sent & 1) == 0 ? _first : _second);
+
+                _sent++;
+                result = DatagramSize;
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+        {
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        const Core::NodeId _first;
+        const Core::NodeId _second;
+        uint32_t _sent;
+        uint32_t _size;
+    };
+
+    static void Exchange(const uint16_t port, const uint8_t batch)
+    {
+        DatagramSink first(port, batch);
+        DatagramSink second(port + 1, batch);
+        DatagramSource source(port + 2, Core::NodeId(_T("127.0.0.1"), port), Core::NodeId(_T("127.0.0.1"), port + 1), batch);
+
+        first.Expect(port + 2, 0);
+        second.Expect(port + 2, 1);
+
+        ASSERT_EQ(first.Open(0), Core::ERROR_NONE);
+        ASSERT_EQ(second.Open(0), Core::ERROR_NONE);
+        ASSERT_EQ(source.Open(0), Core::ERROR_NONE);
+
+        // In rounds that fit the kernel buffers, a datagram that does not fit is dropped. One at a time,
+        // those only hold a datagram or two.
+        const uint32_t burst = (batch > 1 ? batch : 1);
+
+        for (uint32_t round = 1; round <= 50; round++) {
+            source.Send(2 * burst);
+
+            EXPECT_TRUE(first.WaitFor(round * burst));
+            EXPECT_TRUE(second.WaitFor(round * burst));
+        }
+
+        // Each datagram went to the destination set when it was loaded, in order, and came in as sent.
+        EXPECT_EQ(first.Misplaced(), 0u);
+        EXPECT_EQ(second.Misplaced(), 0u);
+
+        source.Close(Core::infinite);
+        second.Close(Core::infinite);
+        first.Close(Core::infinite);
+    }
+
+    TEST(Core_SocketDatagram, Single)
+    {
+        Exchange(12390, 0);
+    }
+
+    TEST(Core_SocketDatagram, Batched)
+    {
+        Exchange(12393, 16);
+    }
+
+    TEST(Core_SocketDatagram, DISABLED_StormBenchmark)
+    {
+        static constexpr uint32_t Bursts = 100;
+        static constexpr uint32_t Burst = 64;
+
+        const uint8_t batches[] = { 1, 16, 64 };
+        uint16_t port = 12396;
+
+        for (const uint8_t batch : batches) {
+            DatagramSink sink(port, batch);
+            DatagramSource source(port + 1, Core::NodeId(_T("127.0.0.1"), port), Core::NodeId(_T("127.0.0.1"), port), batch);
+
+            port += 2;
+
+            ASSERT_EQ(sink.Open(0), Core::ERROR_NONE);
+            ASSERT_EQ(source.Open(0), Core::ERROR_NONE);
+
+            // Like answers to a discovery request, bursts of datagrams that all arrive at once. What does not
+            // fit the kernel buffers, before the sink takes it, is dropped.
+            uint64_t start = Core::Time::Now().Ticks();
+            for (uint32_t index = 1; index <= Bursts; index++) {
+                source.Send(Burst);
+                sink.Settle(sink.Received() + Burst);
+            }
+            uint64_t duration = Core::Time::Now().Ticks() - start;
+
+            printf("Batch %2d: received %5d of %d datagrams in %7d us\n", batch, sink.Received(), Bursts * Burst, static_cast<uint32_t>(duration));
+
+            source.Close(Core::infinite);
+            sink.Close(Core::infinite);
+        }
+    }
+
+} // Tests
+} // WPEFramework
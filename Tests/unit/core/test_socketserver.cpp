@@ -0,0 +1,275 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Accepted side, remembers its id and the thread that handles it.
+    class ShardConnection : public Core::SocketStream {
+    public:
+        ShardConnection() = delete;
+        ShardConnection(const ShardConnection&) = delete;
+        ShardConnection& operator=(const ShardConnection&) = delete;
+
+        ShardConnection(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<ShardConnection>*)
+            : Core::SocketStream(false, connector, remoteId, 1024, 1024)
+            , _id(0)
+            , _thread(0)
+        {
+        }
+        ~ShardConnection() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        void Id(uint32_t id)
+        {
+            _id = id;
+        }
+        uint32_t Id() const
+        {
+            return (_id);
+        }
+        ::ThreadId Thread() const
+        {
+            return (_thread);
+        }
+
+    private:
+        uint16_t SendData(uint8_t*, const uint16_t) override
+        {
+            return (0);
+        }
+        uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+        {
+            _thread = Core::Thread::ThreadId();
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        std::atomic<uint32_t> _id;
+        std::atomic<::ThreadId> _thread;
+    };
+
+    typedef Core::SocketServerType<ShardConnection> ShardServer;
+
+    // Connecting side, sends a single byte once it is open.
+    class ProbeConnection : public Core::SocketStream {
+    public:
+        ProbeConnection() = delete;
+        ProbeConnection(const ProbeConnection&) = delete;
+        ProbeConnection& operator=(const ProbeConnection&) = delete;
+
+        ProbeConnection(const Core::NodeId& remoteNode)
+            : Core::SocketStream(false, remoteNode.AnyInterface(), remoteNode, 1024, 1024)
+            , _pending(true)
+        {
+        }
+        ~ProbeConnection() override
+        {
+            Close(Core::infinite);
+        }
+
+    private:
+        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+        {
+            uint16_t result = 0;
+
+            if ((_pending == true) && (maxSendSize > 0)) {
+                dataFrame[0] = 0x55;
+                _pending = false;
+                result = 1;
+            }
+
+            return (result);
+        }
+        uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+        {
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        bool _pending;
+    };
+
+    static bool Connect(ProbeConnection& client)
+    {
+        const uint32_t result = client.Open(0);
+
+        return ((result == Core::ERROR_NONE) || (result == Core::ERROR_INPROGRESS));
+    }
+
+    static bool WaitForCount(const ShardServer& server, const uint32_t count)
+    {
+        for (uint16_t retry = 0; (retry < 500) && (server.Count() < count); retry++) {
+            ::SleepMs(10);
+        }
+
+        return (server.Count() == count);
+    }
+
+    // Connects count clients, returns the microseconds it took to get them all accepted.
+    static uint64_t Storm(ShardServer& server, const Core::NodeId& node, const uint16_t count)
+    {
+        std::vector<ProbeConnection*> clients;
+        uint64_t start = Core::Time::Now().Ticks();
+
+        for (uint16_t index = 0; index < count; index++) {
+            clients.push_back(new ProbeConnection(node));
+            // Not waiting for each connection, the acceptors are what is measured here.
+            EXPECT_TRUE(Connect(*(clients.back())));
+        }
+
+        EXPECT_TRUE(WaitForCount(server, count));
+
+        uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        for (ProbeConnection* client : clients) {
+            client->Close(0);
+        }
+        for (ProbeConnection* client : clients) {
+            delete client;
+        }
+
+        // Closed by the remote side, gone on the next cleanup.
+        for (uint16_t retry = 0; (retry < 500) && (server.Count() != 0); retry++) {
+            ::SleepMs(10);
+            server.Cleanup();
+        }
+
+        return (duration != 0 ? duration : 1);
+    }
+
+    TEST(Core_SocketServer, Acceptors)
+    {
+        static constexpr uint16_t Clients = 64;
+        static constexpr uint8_t Acceptors = 4;
+
+        const Core::NodeId node(_T("127.0.0.1"), 12380);
+        ShardServer server(node, Acceptors);
+
+        EXPECT_EQ(server.Acceptors(), Acceptors);
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+
+        std::vector<ProbeConnection*> clients;
+
+        for (uint16_t index = 0; index < Clients; index++) {
+            clients.push_back(new ProbeConnection(node));
+            EXPECT_TRUE(Connect(*(clients.back())));
+        }
+
+        ASSERT_TRUE(WaitForCount(server, Clients));
+
+        for (ProbeConnection* client : clients) {
+            for (uint16_t retry = 0; (retry < 100) && (client->IsOpen() == false); retry++) {
+                ::SleepMs(10);
+            }
+            client->Trigger();
+        }
+
+        std::set<uint32_t> ids;
+        std::set<uint32_t> shards;
+        ShardServer::Iterator index(server.Clients());
+
+        while (index.Next() == true) {
+            Core::ProxyType<ShardConnection> client(index.Client());
+
+            EXPECT_NE(client->Id(), 0u);
+            ids.insert(client->Id());
+            shards.insert((client->Id() - 1) % Acceptors);
+
+            // Every client is found back on the acceptor that handed out its id.
+            EXPECT_TRUE(server.Client(client->Id()) == client);
+        }
+
+        EXPECT_EQ(ids.size(), Clients);
+        EXPECT_EQ(index.Count(), Clients);
+
+        // The kernel spreads the connections, 64 in a single shard would be beyond unlucky.
+        EXPECT_GT(shards.size(), 1u);
+
+        // Clients of another acceptor are served by another thread than the ResourceMonitor.
+        std::set<::ThreadId> threads;
+        for (uint16_t retry = 0; (retry < 100) && (threads.size() < shards.size()); retry++) {
+            ::SleepMs(10);
+
+            threads.clear();
+            index.Reset();
+            while (index.Next() == true) {
+                if (index.Client()->Thread() != 0) {
+                    threads.insert(index.Client()->Thread());
+                }
+            }
+        }
+        EXPECT_EQ(threads.size(), shards.size());
+
+        EXPECT_FALSE(server.Client(Clients * Acceptors + 1).IsValid());
+
+        for (ProbeConnection* client : clients) {
+            client->Close(0);
+        }
+        for (ProbeConnection* client : clients) {
+            delete client;
+        }
+
+        server.Close(Core::infinite);
+    }
+
+    TEST(Core_SocketServer, DomainSingleAcceptor)
+    {
+        const Core::NodeId node(_T("/tmp/testsocketserver"));
+        ShardServer server(node, 4);
+
+        // Listeners on one path would unlink each other, no sharing there.
+        EXPECT_EQ(server.Acceptors(), 1);
+    }
+
+    TEST(Core_SocketServer, DISABLED_AcceptorBenchmark)
+    {
+        static constexpr uint16_t Clients = 256;
+
+        const uint8_t acceptors[] = { 1, 2, 4 };
+        uint16_t port = 12381;
+
+        for (const uint8_t count : acceptors) {
+            const Core::NodeId node(_T("127.0.0.1"), port++);
+            ShardServer server(node, count);
+
+            EXPECT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+
+            uint64_t duration = Storm(server, node, Clients);
+
+            printf("%d acceptor(s): %d connections in %6d us\n", count, Clients, static_cast<uint32_t>(duration));
+
+            server.Close(Core::infinite);
+        }
+    }
+
+} // Tests
+} // WPEFramework
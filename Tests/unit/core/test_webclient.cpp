@@ -0,0 +1,289 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Answers every request with its path as body, /close also closes the connection.
+    class PathServer : public Web::WebLinkType<Core::SocketStream, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>> {
+    private:
+        typedef Web::WebLinkType<Core::SocketStream, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>> BaseClass;
+
+    public:
+        PathServer() = delete;
+        PathServer(const PathServer&) = delete;
+        PathServer& operator=(const PathServer&) = delete;
+
+        PathServer(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<PathServer>*)
+            : BaseClass(8, false, connector, remoteId, 2048, 2048)
+        {
+            _accepted++;
+        }
+        ~PathServer() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        static std::atomic<uint32_t> _accepted;
+
+    private:
+        void LinkBody(Core::ProxyType<Web::Request>&) override
+        {
+        }
+        void Received(Core::ProxyType<Web::Request>& request) override
+        {
+            Core::ProxyType<Web::Response> response(Core::ProxyType<Web::Response>::Create());
+            Core::ProxyType<Web::TextBody> body(Core::ProxyType<Web::TextBody>::Create());
+
+            static_cast<string&>(*body) = request->Path;
+            response->ErrorCode = Web::STATUS_OK;
+            response->Body<Web::TextBody>(body);
+
+            if (request->Path == _T("/close")) {
+                response->Connection = Web::Response::CONNECTION_CLOSE;
+            }
+
+            Submit(response);
+        }
+        void Send(const Core::ProxyType<Web::Response>&) override
+        {
+        }
+        void StateChange() override
+        {
+        }
+    };
+
+    std::atomic<uint32_t> PathServer::_accepted(0);
+
+    typedef Web::ClientType<Core::SocketStream> Client;
+
+    class Collector : public Client::ICallback {
+    public:
+        Collector(const Collector&) = delete;
+        Collector& operator=(const Collector&) = delete;
+
+        Collector()
+            : _bodies(5)
+            , _signal(false, true)
+            , _completed(0)
+            , _failed(0)
+            , _mismatch(0)
+        {
+        }
+        ~Collector() override = default;
+
+    public:
+        bool Wait(const uint32_t count) const
+        {
+            uint8_t retry = 0;
+
+            // Reset before looking, so a completion in between is not missed.
+            do {
+                _signal.ResetEvent();
+            } while ((_completed < count) && (_signal.Lock(100) == Core::ERROR_NONE || ++retry < 50));
+
+            return (_completed == count);
+        }
+        uint32_t Failed() const
+        {
+            return (_failed);
+        }
+        uint32_t Mismatch() const
+        {
+            return (_mismatch);
+        }
+
+    private:
+        void LinkBody(const Core::ProxyType<Web::Request>&, Core::ProxyType<Web::Response>& response) override
+        {
+            response->Body(_bodies.Element());
+        }
+        void Completed(const Core::ProxyType<Web::Request>& request, const Core::ProxyType<Web::Response>& response) override
+        {
+            if (response.IsValid() == false) {
+                _failed++;
+            } else if ((response->HasBody() == false) || (static_cast<const string&>(*(response->Body<Web::TextBody>())) != request->Path)) {
+                // Each response must come back on the request that asked for it, also when pipelined.
+                _mismatch++;
+            }
+
+            _completed++;
+            _signal.SetEvent();
+        }
+
+    private:
+        Core::ProxyPoolType<Web::TextBody> _bodies;
+        mutable Core::Event _signal;
+        std::atomic<uint32_t> _completed;
+        std::atomic<uint32_t> _failed;
+        std::atomic<uint32_t> _mismatch;
+    };
+
+    static Core::ProxyType<Web::Request> Get(const string& path)
+    {
+        Core::ProxyType<Web::Request> request(Core::ProxyType<Web::Request>::Create());
+
+        request->Verb = Web::Request::HTTP_GET;
+        request->Path = path;
+        request->Host = _T("127.0.0.1");
+
+        return (request);
+    }
+
+    // Returns the microseconds it took to get count responses, one request after the other.
+    static uint64_t Sequential(Client& client, const Core::NodeId& node, const uint32_t count)
+    {
+        Collector collector;
+        uint64_t start = Core::Time::Now().Ticks();
+
+        for (uint32_t index = 0; index < count; index++) {
+            EXPECT_EQ(client.Submit(node, Get(_T("/") + Core::NumberType<uint32_t>(index).Text()), &collector), Core::ERROR_NONE);
+            EXPECT_TRUE(collector.Wait(index + 1));
+            client.Cleanup();
+        }
+
+        uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        EXPECT_EQ(collector.Failed(), 0u);
+        EXPECT_EQ(collector.Mismatch(), 0u);
+
+        return (duration != 0 ? duration : 1);
+    }
+
+    TEST(Core_WebClient, KeepAlive)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), 12380);
+        Core::SocketServerType<PathServer> server(node);
+
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        PathServer::_accepted = 0;
+        {
+            Client client(1, 5000, false, Core::NodeId(), Core::NodeId(), 1024, 1024);
+
+            Sequential(client, node, 20);
+
+            Client::Statistics metrics(client.Metrics());
+            EXPECT_EQ(metrics.Connections, 1u);
+            EXPECT_EQ(metrics.Reused, 19u);
+            EXPECT_EQ(metrics.Pipelined, 0u);
+            EXPECT_EQ(metrics.Failed, 0u);
+            EXPECT_EQ(PathServer::_accepted, 1u);
+            EXPECT_EQ(client.Count(), 1u);
+        }
+        server.Close(Core::infinite);
+    }
+
+    TEST(Core_WebClient, Pipeline)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), 12381);
+        Core::SocketServerType<PathServer> server(node);
+
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        PathServer::_accepted = 0;
+        {
+            Client client(4, 5000, false, Core::NodeId(), Core::NodeId(), 1024, 1024);
+            Collector collector;
+
+            // All at once: every connection takes up to 4 before the next one is opened.
+            for (uint32_t index = 0; index < 16; index++) {
+                EXPECT_EQ(client.Submit(node, Get(_T("/") + Core::NumberType<uint32_t>(index).Text()), &collector), Core::ERROR_NONE);
+            }
+
+            EXPECT_TRUE(collector.Wait(16));
+            EXPECT_EQ(collector.Failed(), 0u);
+            EXPECT_EQ(collector.Mismatch(), 0u);
+
+            Client::Statistics metrics(client.Metrics());
+            EXPECT_EQ(metrics.Connections, 4u);
+            EXPECT_EQ(metrics.Pipelined, 12u);
+            EXPECT_EQ(PathServer::_accepted, 4u);
+        }
+        server.Close(Core::infinite);
+    }
+
+    TEST(Core_WebClient, CloseAndExpire)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), 12382);
+        Core::SocketServerType<PathServer> server(node);
+
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        PathServer::_accepted = 0;
+        {
+            Client client(1, 200, false, Core::NodeId(), Core::NodeId(), 1024, 1024);
+            Collector collector;
+
+            // The server asks to close, the next request needs a new connection.
+            EXPECT_EQ(client.Submit(node, Get(_T("/close")), &collector), Core::ERROR_NONE);
+            EXPECT_TRUE(collector.Wait(1));
+            EXPECT_EQ(client.Submit(node, Get(_T("/one")), &collector), Core::ERROR_NONE);
+            EXPECT_TRUE(collector.Wait(2));
+            EXPECT_EQ(client.Metrics().Connections, 2u);
+
+            // Idle for longer than the idle time, closed on the next Cleanup.
+            ::SleepMs(300);
+            client.Cleanup();
+
+            for (uint8_t retry = 0; (retry < 100) && (client.Count() != 0); retry++) {
+                ::SleepMs(10);
+                client.Cleanup();
+            }
+
+            EXPECT_EQ(client.Count(), 0u);
+            EXPECT_EQ(client.Metrics().Expired, 1u);
+
+            EXPECT_EQ(client.Submit(node, Get(_T("/two")), &collector), Core::ERROR_NONE);
+            EXPECT_TRUE(collector.Wait(3));
+            EXPECT_EQ(client.Metrics().Connections, 3u);
+            EXPECT_EQ(collector.Failed(), 0u);
+            EXPECT_EQ(collector.Mismatch(), 0u);
+            EXPECT_EQ(PathServer::_accepted, 3u);
+        }
+        server.Close(Core::infinite);
+    }
+
+    TEST(Core_WebClient, DISABLED_Benchmark)
+    {
+        static constexpr uint32_t Requests = 500;
+
+        const Core::NodeId node(_T("127.0.0.1"), 12383);
+        Core::SocketServerType<PathServer> server(node);
+
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        {
+            Client pooled(1, 5000, false, Core::NodeId(), Core::NodeId(), 1024, 1024);
+            Client single(1, 0, false, Core::NodeId(), Core::NodeId(), 1024, 1024);
+
+            uint64_t reused = Sequential(pooled, node, Requests);
+            uint64_t opened = Sequential(single, node, Requests);
+
+            EXPECT_EQ(single.Metrics().Connections, Requests);
+
+            printf("Keep-alive:          %6d us/request\n", static_cast<uint32_t>(reused / Requests));
+            printf("Connection per call: %6d us/request\n", static_cast<uint32_t>(opened / Requests));
+        }
+        server.Close(Core::infinite);
+    }
+
+} // Tests
+} // WPEFramework
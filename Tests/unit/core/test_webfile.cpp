@@ -0,0 +1,417 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static string FileToServe;
+
+    uint64_t FileDigest(const uint8_t data[], const uint32_t length, uint64_t digest = 14695981039346656037ULL)
+    {
+        for (uint32_t index = 0; index < length; index++) {
+            digest = (digest ^ data[index]) * 1099511628211ULL;
+        }
+        return (digest);
+    }
+
+    // Does not keep what it receives, only its length and digest.
+    class DigestBody : public Web::IBody {
+    public:
+        DigestBody(const DigestBody&) = delete;
+        DigestBody& operator=(const DigestBody&) = delete;
+
+        DigestBody()
+            : _length(0)
+            , _digest(FileDigest(nullptr, 0))
+        {
+        }
+        ~DigestBody() override = default;
+
+    public:
+        uint32_t Length() const
+        {
+            return (_length);
+        }
+        uint64_t Digest() const
+        {
+            return (_digest);
+        }
+
+    protected:
+        uint32_t Serialize() const override
+        {
+            return (0);
+        }
+        uint32_t Deserialize() override
+        {
+            _length = 0;
+            _digest = FileDigest(nullptr, 0);
+            return (static_cast<uint32_t>(~0));
+        }
+        void End() const override
+        {
+        }
+        uint16_t Serialize(uint8_t[], const uint16_t) const override
+        {
+            return (0);
+        }
+        uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength) override
+        {
+            _digest = FileDigest(stream, maxLength, _digest);
+            _length += maxLength;
+            return (maxLength);
+        }
+
+    private:
+        uint32_t _length;
+        uint64_t _digest;
+    };
+
+    // A socket that can not send from a file, everything is copied through the send buffer.
+    class CopyingStream : public Core::SocketStream {
+    public:
+        template <typename... Args>
+        CopyingStream(Args&&... args)
+            : Core::SocketStream(std::forward<Args>(args)...)
+        {
+        }
+        ~CopyingStream() override = default;
+
+    public:
+        bool SendFile(const Core::File::Handle, const uint64_t, const uint32_t) override
+        {
+            return (false);
+        }
+    };
+
+    template <typename LINK>
+    class FileServerType : public Web::WebLinkType<LINK, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>> {
+    private:
+        typedef Web::WebLinkType<LINK, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>> BaseClass;
+
+    public:
+        FileServerType() = delete;
+        FileServerType(const FileServerType<LINK>& copy) = delete;
+        FileServerType<LINK>& operator=(const FileServerType<LINK>&) = delete;
+
+        FileServerType(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<FileServerType<LINK>>*)
+            : BaseClass(2, false, connector, remoteId, 4096, 2048)
+            , _socket(connector)
+            , _sendBuffer(SendBuffer())
+        {
+        }
+        ~FileServerType() override
+        {
+            BaseClass::Close(Core::infinite);
+        }
+
+    public:
+        void LinkBody(Core::ProxyType<Web::Request>&) override
+        {
+        }
+        void Received(Core::ProxyType<Web::Request>& request) override
+        {
+            Core::ProxyType<Web::Response> response(Core::ProxyType<Web::Response>::Create());
+            Core::ProxyType<Web::FileBody> body(Core::ProxyType<Web::FileBody>::Create());
+            uint64_t offset;
+            uint64_t length;
+
+            // Whatever a previous file needed, the connection is back at its own send buffer.
+            EXPECT_EQ(SendBuffer(), _sendBuffer);
+
+            *body = FileToServe;
+
+            if (request->ByteRange(body->Size(), offset, length) == true) {
+                body->Range(static_cast<uint32_t>(offset), static_cast<uint32_t>(length));
+                response->ErrorCode = Web::STATUS_PARTIAL_CONTENT;
+                response->ContentRange = _T("bytes ") + Core::NumberType<uint64_t>(offset).Text() + '-' + Core::NumberType<uint64_t>(offset + length - 1).Text() + '/' + Core::NumberType<uint64_t>(body->Size()).Text();
+            } else {
+                response->ErrorCode = Web::STATUS_OK;
+            }
+
+            response->Body<Web::FileBody>(body);
+            BaseClass::Submit(response);
+        }
+        void Send(const Core::ProxyType<Web::Response>&) override
+        {
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        int SendBuffer() const
+        {
+            int value = 0;
+            socklen_t length = sizeof(value);
+
+            ::getsockopt(_socket, SOL_SOCKET, SO_SNDBUF, &value, &length);
+
+            return (value);
+        }
+
+    private:
+        const SOCKET _socket;
+        const int _sendBuffer;
+    };
+
+    class FileClient : public Web::WebLinkType<Core::SocketStream, Web::Response, Web::Request, Core::ProxyPoolType<Web::Response>&> {
+    private:
+        typedef Web::WebLinkType<Core::SocketStream, Web::Response, Web::Request, Core::ProxyPoolType<Web::Response>&> BaseClass;
+
+    public:
+        FileClient() = delete;
+        FileClient(const FileClient& copy) = delete;
+        FileClient& operator=(const FileClient&) = delete;
+
+        FileClient(const Core::NodeId& remoteNode)
+            : BaseClass(2, _responseFactory, false, remoteNode.AnyInterface(), remoteNode, 2048, 0xFFFF)
+            , _received(false, true)
+            , _response()
+        {
+        }
+        ~FileClient() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        Core::ProxyType<Web::Response> Fetch(const string& range)
+        {
+            Core::ProxyType<Web::Request> request(Core::ProxyType<Web::Request>::Create());
+
+            request->Verb = Web::Request::HTTP_GET;
+            request->Path = _T("/file");
+            if (range.empty() == false) {
+                request->Range = range;
+            }
+
+            _received.ResetEvent();
+            if (_response.IsValid() == true) {
+                _response.Release();
+            }
+            Submit(request);
+
+            EXPECT_EQ(_received.Lock(10000), Core::ERROR_NONE);
+
+            return (_response);
+        }
+
+        void LinkBody(Core::ProxyType<Web::Response>& element) override
+        {
+            element->Body(Core::ProxyType<DigestBody>::Create());
+        }
+        void Received(Core::ProxyType<Web::Response>& response) override
+        {
+            _response = response;
+            _received.SetEvent();
+        }
+        void Send(const Core::ProxyType<Web::Request>&) override
+        {
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        Core::Event _received;
+        Core::ProxyType<Web::Response> _response;
+        static Core::ProxyPoolType<Web::Response> _responseFactory;
+    };
+
+    Core::ProxyPoolType<Web::Response> FileClient::_responseFactory(2);
+
+    void CreateFile(const string& name, const uint32_t size, std::vector<uint8_t>& content)
+    {
+        content.resize(size);
+
+        for (uint32_t index = 0; index < size; index++) {
+            content[index] = static_cast<uint8_t>((index * 13) ^ (index >> 11));
+        }
+
+        Core::File file(name);
+        ASSERT_TRUE(file.Create());
+        ASSERT_EQ(file.Write(content.data(), size), size);
+        file.Close();
+    }
+
+    template <typename LINK>
+    void ServeFile(const uint16_t port, const std::vector<uint8_t>& content)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), port);
+        Core::SocketServerType<FileServerType<LINK>> server(node);
+
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+        {
+            FileClient client(node);
+            ASSERT_EQ(client.Open(1000), Core::ERROR_NONE);
+
+            const uint32_t size = static_cast<uint32_t>(content.size());
+            const struct {
+                const TCHAR* range;
+                uint32_t offset;
+                uint32_t length;
+            } requests[] = {
+                { _T(""), 0, size },
+                { _T("bytes=100-199"), 100, 100 },
+                { _T("bytes=1000-"), 1000, size - 1000 },
+                { _T("bytes=-500"), size - 500, 500 },
+                { _T("bytes=0-"), 0, size }
+            };
+
+            for (const auto& entry : requests) {
+                Core::ProxyType<Web::Response> response(client.Fetch(entry.range));
+
+                ASSERT_TRUE(response.IsValid());
+                EXPECT_EQ(response->ErrorCode, (entry.range[0] == '\0' ? Web::STATUS_OK : Web::STATUS_PARTIAL_CONTENT));
+                ASSERT_TRUE(response->HasBody());
+
+                Core::ProxyType<const DigestBody> body(response->Body<const DigestBody>());
+                EXPECT_EQ(body->Length(), entry.length);
+                EXPECT_EQ(body->Digest(), FileDigest(&(content[entry.offset]), entry.length));
+            }
+
+            client.Close(Core::infinite);
+        }
+        server.Close(Core::infinite);
+    }
+
+    TEST(WebFile, ByteRange)
+    {
+        Web::Request request;
+        uint64_t offset;
+        uint64_t length;
+
+        EXPECT_FALSE(request.ByteRange(1000, offset, length));
+
+        request.Range = _T("bytes=0-499");
+        EXPECT_TRUE(request.ByteRange(1000, offset, length));
+        EXPECT_EQ(offset, 0u);
+        EXPECT_EQ(length, 500u);
+
+        request.Range = _T("bytes=500-");
+        EXPECT_TRUE(request.ByteRange(1000, offset, length));
+        EXPECT_EQ(offset, 500u);
+        EXPECT_EQ(length, 500u);
+
+        request.Range = _T("bytes=-100");
+        EXPECT_TRUE(request.ByteRange(1000, offset, length));
+        EXPECT_EQ(offset, 900u);
+        EXPECT_EQ(length, 100u);
+
+        // An end past the resource, or a suffix longer than it, is clipped.
+        request.Range = _T("bytes=900-2000");
+        EXPECT_TRUE(request.ByteRange(1000, offset, length));
+        EXPECT_EQ(offset, 900u);
+        EXPECT_EQ(length, 100u);
+
+        request.Range = _T("bytes=-5000");
+        EXPECT_TRUE(request.ByteRange(1000, offset, length));
+        EXPECT_EQ(offset, 0u);
+        EXPECT_EQ(length, 1000u);
+
+        // Not satisfiable, or not supported.
+        request.Range = _T("bytes=1000-");
+        EXPECT_FALSE(request.ByteRange(1000, offset, length));
+        request.Range = _T("bytes=500-100");
+        EXPECT_FALSE(request.ByteRange(1000, offset, length));
+        request.Range = _T("bytes=-0");
+        EXPECT_FALSE(request.ByteRange(1000, offset, length));
+        request.Range = _T("bytes=0-10,20-30");
+        EXPECT_FALSE(request.ByteRange(1000, offset, length));
+        request.Range = _T("lines=0-10");
+        EXPECT_FALSE(request.ByteRange(1000, offset, length));
+    }
+
+    TEST(WebFile, SendFile)
+    {
+        std::vector<uint8_t> content;
+
+        FileToServe = _T("/tmp/webfile.bin");
+        CreateFile(FileToServe, (1024 * 1024) + 17, content);
+
+        ServeFile<Core::SocketStream>(12360, content);
+
+        Core::File(FileToServe).Destroy();
+    }
+
+    TEST(WebFile, Copy)
+    {
+        std::vector<uint8_t> content;
+
+        FileToServe = _T("/tmp/webfile.bin");
+        CreateFile(FileToServe, (1024 * 1024) + 17, content);
+
+        ServeFile<CopyingStream>(12361, content);
+
+        Core::File(FileToServe).Destroy();
+    }
+
+    template <typename LINK>
+    uint64_t Download(const uint16_t port, const uint32_t size)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), port);
+        Core::SocketServerType<FileServerType<LINK>> server(node);
+        uint64_t duration = 0;
+
+        server.Open(Core::infinite);
+        {
+            FileClient client(node);
+            client.Open(1000);
+
+            uint64_t start = Core::Time::Now().Ticks();
+            Core::ProxyType<Web::Response> response(client.Fetch(string()));
+            duration = Core::Time::Now().Ticks() - start;
+
+            EXPECT_TRUE(response.IsValid());
+            if (response.IsValid() == true) {
+                EXPECT_EQ(response->Body<const DigestBody>()->Length(), size);
+            }
+
+            client.Close(Core::infinite);
+        }
+        server.Close(Core::infinite);
+
+        return (duration != 0 ? duration : 1);
+    }
+
+    TEST(WebFile, DISABLED_SendFileBenchmark)
+    {
+        static constexpr uint32_t Size = 64 * 1024 * 1024;
+
+        std::vector<uint8_t> content;
+
+        FileToServe = _T("/tmp/webfile.bin");
+        CreateFile(FileToServe, Size, content);
+
+        uint64_t copied = Download<CopyingStream>(12362, Size);
+        uint64_t spliced = Download<Core::SocketStream>(12363, Size);
+
+        printf("Serving %d MB: copied %d MB/s, sendfile %d MB/s\n", Size / (1024 * 1024),
+            static_cast<uint32_t>(Size / copied), static_cast<uint32_t>(Size / spliced));
+
+        Core::File(FileToServe).Destroy();
+    }
+
+} // Tests
+} // WPEFramework
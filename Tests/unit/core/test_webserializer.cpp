@@ -0,0 +1,277 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class RequestParser : public Web::Request::Deserializer {
+    public:
+        RequestParser(const RequestParser&) = delete;
+        RequestParser& operator=(const RequestParser&) = delete;
+
+        RequestParser()
+            : _request()
+            , _parsed(0)
+        {
+        }
+        ~RequestParser() = default;
+
+    public:
+        const Web::Request& Request() const
+        {
+            return (_request);
+        }
+        uint32_t Parsed() const
+        {
+            return (_parsed);
+        }
+        void Submit(const string& text)
+        {
+            uint16_t offset = 0;
+
+            while (offset < text.length()) {
+                offset += Deserialize(reinterpret_cast<const uint8_t*>(&(text.c_str()[offset])), static_cast<uint16_t>(text.length() - offset));
+            }
+        }
+
+    private:
+        void Deserialized(Web::Request&) override
+        {
+            _parsed++;
+        }
+        Web::Request* Element() override
+        {
+            _request.Clear();
+            return (&_request);
+        }
+        bool LinkBody(Web::Request&) override
+        {
+            return (false);
+        }
+
+    private:
+        Web::Request _request;
+        uint32_t _parsed;
+    };
+
+    class ResponseParser : public Web::Response::Deserializer {
+    public:
+        ResponseParser(const ResponseParser&) = delete;
+        ResponseParser& operator=(const ResponseParser&) = delete;
+
+        ResponseParser()
+            : _response()
+            , _body(Core::ProxyType<Web::TextBody>::Create())
+            , _parsed(0)
+        {
+        }
+        ~ResponseParser() = default;
+
+    public:
+        const Web::Response& Response() const
+        {
+            return (_response);
+        }
+        const string& Body() const
+        {
+            return (*_body);
+        }
+        uint32_t Parsed() const
+        {
+            return (_parsed);
+        }
+        void Submit(const string& text)
+        {
+            uint16_t offset = 0;
+
+            while (offset < text.length()) {
+                offset += Deserialize(reinterpret_cast<const uint8_t*>(&(text.c_str()[offset])), static_cast<uint16_t>(text.length() - offset));
+            }
+        }
+
+    private:
+        void Deserialized(Web::Response&) override
+        {
+            _parsed++;
+        }
+        Web::Response* Element() override
+        {
+            _response.Clear();
+            return (&_response);
+        }
+        bool LinkBody(Web::Response& element) override
+        {
+            element.Body(_body);
+            return (true);
+        }
+
+    private:
+        Web::Response _response;
+        Core::ProxyType<Web::TextBody> _body;
+        uint32_t _parsed;
+    };
+
+    class ResponseSerializer : public Web::Response::Serializer {
+    public:
+        string Serialize(const Web::Response& response)
+        {
+            uint8_t buffer[128];
+            uint16_t loaded;
+            string result;
+
+            Submit(response);
+
+            do {
+                loaded = Web::Response::Serializer::Serialize(buffer, sizeof(buffer));
+                result.append(reinterpret_cast<const char*>(buffer), loaded);
+            } while (loaded != 0);
+
+            return (result);
+        }
+
+    private:
+        void Serialized(const Web::Response&) override
+        {
+        }
+    };
+
+    static const TCHAR HandshakeRequest[] = _T("GET /Service/Controller?callsign=Netflix HTTP/1.1\r\n")
+                                            _T("Host: 127.0.0.1:80\r\n")
+                                            _T("User-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n")
+                                            _T("Accept: */*\r\n")
+                                            _T("X-Not-A-Keyword: ignored\r\n")
+                                            _T("origin: http://127.0.0.1\r\n")
+                                            _T("Sec-WebSocket-Version: 13\r\n")
+                                            _T("Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n")
+                                            _T("Sec-WebSocket-Protocol: json\r\n")
+                                            _T("Connection: Upgrade\r\n")
+                                            _T("Upgrade: websocket\r\n")
+                                            _T("\r\n");
+
+    TEST(Web_Serializer, RequestHeaders)
+    {
+        RequestParser parser;
+
+        parser.Submit(HandshakeRequest);
+
+        ASSERT_EQ(parser.Parsed(), 1u);
+
+        const Web::Request& request(parser.Request());
+
+        EXPECT_EQ(request.Verb, Web::Request::HTTP_GET);
+        EXPECT_EQ(request.Path, _T("/Service/Controller"));
+        EXPECT_EQ(request.Query.Value(), _T("callsign=Netflix"));
+        EXPECT_EQ(request.Host.Value(), _T("127.0.0.1:80"));
+        EXPECT_EQ(request.UserAgent.Value(), _T("Mozilla/5.0 (X11; Linux x86_64)"));
+        EXPECT_EQ(request.Accept.Value(), _T("*/*"));
+        EXPECT_EQ(request.Origin.Value(), _T("http://127.0.0.1"));
+        EXPECT_EQ(request.WebSocketVersion.Value(), 13u);
+        EXPECT_EQ(request.WebSocketKey.Value(), _T("dGhlIHNhbXBsZSBub25jZQ=="));
+        EXPECT_EQ(request.WebSocketProtocol.Value(), _T("json"));
+        EXPECT_EQ(request.Connection.Value(), Web::Request::CONNECTION_UPGRADE);
+        EXPECT_EQ(request.Upgrade.Value(), Web::Request::UPGRADE_WEBSOCKET);
+        EXPECT_FALSE(request.ContentLength.IsSet());
+
+        // Every keyword in the table should still be accepted as a header.
+        uint16_t index = 0;
+        const Core::EnumerateConversion<Web::Request::keywords>* entry;
+        while ((entry = Core::EnumerateType<Web::Request::keywords>::Entry(index++)) != nullptr) {
+            const string header(string(entry->name) + _T(" 0\r\n"));
+
+            parser.Submit(string(_T("GET / HTTP/1.1\r\n")) + header + _T("\r\n"));
+        }
+
+        EXPECT_EQ(parser.Parsed(), static_cast<uint32_t>(index));
+    }
+
+    TEST(Web_Serializer, ResponseCompression)
+    {
+        string text;
+        for (uint16_t index = 0; index < 200; index++) {
+            text += _T("{\"callsign\":\"Plugin") + Core::NumberType<uint16_t>(index).Text() + _T("\",\"state\":\"activated\"},");
+        }
+
+        ResponseSerializer serializer;
+        serializer.Compression(6, 1024);
+
+        for (const Web::EncodingTypes encoding : { Web::ENCODING_GZIP, Web::ENCODING_DEFLATE }) {
+            Core::ProxyType<Web::TextBody> body(Core::ProxyType<Web::TextBody>::Create());
+            *body = text;
+
+            Web::Response response;
+            response.ErrorCode = Web::STATUS_OK;
+            response.Body(body);
+            response.Compression(encoding);
+
+            const string http(serializer.Serialize(response));
+
+            EXPECT_NE(http.find(_T("Transfer-Encoding: chunked\r\n")), string::npos);
+            EXPECT_NE(http.find(encoding == Web::ENCODING_GZIP ? _T("Content-Encoding: GZIP\r\n") : _T("Content-Encoding: DEFLATE\r\n")), string::npos);
+            EXPECT_EQ(http.find(_T("Content-Length")), string::npos);
+            EXPECT_LT(http.length(), text.length() / 4);
+
+            ResponseParser parser;
+            parser.Submit(http);
+
+            ASSERT_EQ(parser.Parsed(), 1u);
+            EXPECT_EQ(parser.Response().ContentEncoding.Value(), encoding);
+            EXPECT_EQ(parser.Body(), text);
+        }
+
+        // Too small to bother, or not accepted by the requester, it goes out as is.
+        for (const uint32_t length : { 512u, 4096u }) {
+            Core::ProxyType<Web::TextBody> body(Core::ProxyType<Web::TextBody>::Create());
+            *body = text.substr(0, length);
+
+            Web::Response response;
+            response.ErrorCode = Web::STATUS_OK;
+            response.Body(body);
+            response.Compression(length < 1024 ? Web::ENCODING_GZIP : Web::ENCODING_UNKNOWN);
+
+            const string http(serializer.Serialize(response));
+
+            EXPECT_NE(http.find(_T("Content-Length: ") + Core::NumberType<uint32_t>(length).Text() + _T("\r\n")), string::npos);
+            EXPECT_EQ(http.find(_T("Content-Encoding")), string::npos);
+            EXPECT_EQ(http.substr(http.length() - length), text.substr(0, length));
+        }
+    }
+
+    TEST(Web_Serializer, DISABLED_RequestBenchmark)
+    {
+        static constexpr uint32_t Rounds = 100000;
+
+        RequestParser parser;
+
+        uint64_t start = Core::Time::Now().Ticks();
+        for (uint32_t round = 0; round < Rounds; ++round) {
+            parser.Submit(HandshakeRequest);
+        }
+        uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        printf("Request parsing, %d rounds: %d us, %d requests/s\n",
+            Rounds, static_cast<uint32_t>(duration), static_cast<uint32_t>((static_cast<uint64_t>(Rounds) * 1000000) / (duration + 1)));
+
+        EXPECT_EQ(parser.Parsed(), Rounds);
+    }
+} // Tests
+} // WPEFramework
@@ -0,0 +1,350 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Hands out queued messages the way a link does: in pieces, a piece smaller than asked for ends the message.
+    class MessageSource {
+    public:
+        MessageSource(const MessageSource&) = delete;
+        MessageSource& operator=(const MessageSource&) = delete;
+
+        MessageSource()
+            : _queue()
+            , _offset(0)
+        {
+        }
+        ~MessageSource() = default;
+
+    public:
+        void Add(const string& message)
+        {
+            _queue.push_back(message);
+        }
+        uint16_t SendData(uint8_t* stream, const uint16_t maxLength)
+        {
+            uint16_t result = 0;
+
+            if (_queue.empty() == false) {
+                const string& message(_queue.front());
+
+                result = static_cast<uint16_t>(std::min(message.length() - _offset, static_cast<size_t>(maxLength)));
+                ::memcpy(stream, &(message.c_str()[_offset]), result);
+                _offset += result;
+
+                if (result < maxLength) {
+                    _queue.pop_front();
+                    _offset = 0;
+                }
+            }
+
+            return (result);
+        }
+
+    private:
+        std::list<string> _queue;
+        size_t _offset;
+    };
+
+    class MessageSink {
+    public:
+        MessageSink(const MessageSink&) = delete;
+        MessageSink& operator=(const MessageSink&) = delete;
+
+        MessageSink()
+            : _current()
+            , _messages()
+        {
+        }
+        ~MessageSink() = default;
+
+    public:
+        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+        {
+            _current.append(reinterpret_cast<const char*>(dataFrame), receivedSize);
+            return (receivedSize);
+        }
+        void Completed()
+        {
+            _messages.push_back(_current);
+            _current.clear();
+        }
+        const std::vector<string>& Messages() const
+        {
+            return (_messages);
+        }
+        void Clear()
+        {
+            _messages.clear();
+        }
+
+    private:
+        string _current;
+        std::vector<string> _messages;
+    };
+
+    // Moves all pending messages from the sender to the receiver in writes of at most frameSize, the way
+    // the WebSocketLinkType does. Returns the number of bytes that were put on the wire.
+    uint32_t Transfer(Web::WebSocket::Protocol& sender, MessageSource& source, Web::WebSocket::Protocol& receiver, MessageSink& sink, const uint16_t frameSize)
+    {
+        const uint8_t headerSpace = sender.HeaderSpace();
+        const uint16_t room = frameSize - headerSpace;
+        std::vector<uint8_t> buffer(frameSize);
+        uint32_t wire = 0;
+        uint16_t size;
+
+        do {
+            size = (sender.IsCompressed() == true ? sender.Deflate(source, &(buffer[headerSpace]), room) : source.SendData(&(buffer[headerSpace]), room));
+            size = sender.Encoder(buffer.data(), room, size);
+            wire += size;
+
+            uint16_t offset = 0;
+
+            while (offset < size) {
+                uint16_t length = size - offset;
+                uint16_t header = receiver.Decoder(&(buffer[offset]), length);
+
+                EXPECT_NE(header, 0);
+                EXPECT_EQ(receiver.FrameType() & 0xF0, 0);
+
+                if (receiver.IsDeflated() == true) {
+                    receiver.Inflate(sink, &(buffer[offset + header]), length);
+                } else {
+                    sink.ReceiveData(&(buffer[offset + header]), length);
+                }
+
+                offset += (header + length);
+
+                if ((receiver.ReceiveInProgress() == false) && (receiver.IsCompleteMessage() == true)) {
+                    sink.Completed();
+                }
+            }
+        } while ((size != 0) && (wire < (64 * 1024 * 1024)));
+
+        return (wire);
+    }
+
+    bool Negotiate(Web::WebSocket::Protocol& server, Web::WebSocket::Protocol& client, string& response)
+    {
+        return ((server.Accept(client.Offer(), response) == true) && (client.Confirm(response) == true));
+    }
+
+    string Event(const uint32_t sequence)
+    {
+        static const TCHAR* callsigns[] = { _T("WebKitBrowser"), _T("Netflix"), _T("DeviceInfo"), _T("Monitor"), _T("LocationSync") };
+        static const TCHAR* states[] = { _T("activated"), _T("deactivated"), _T("resumed"), _T("suspended") };
+
+        const TCHAR* callsign = callsigns[sequence % (sizeof(callsigns) / sizeof(callsigns[0]))];
+
+        if ((sequence % 16) == 15) {
+            // Now and then a large one, a measurement report.
+            string result(_T("{\"jsonrpc\":\"2.0\",\"method\":\"client.events.") + Core::NumberType<uint32_t>(sequence % 7).Text() + _T(".measurement\",\"params\":{\"callsign\":\"Monitor\",\"samples\":["));
+
+            for (uint32_t index = 0; index < 64; index++) {
+                result += (index == 0 ? _T("{\"resident\":") : _T(",{\"resident\":")) + Core::NumberType<uint32_t>(40000 + ((sequence * 31 + index * 17) % 5000)).Text() + _T(",\"allocated\":") + Core::NumberType<uint32_t>(120000 + ((sequence * 7 + index * 13) % 9000)).Text() + _T(",\"shared\":") + Core::NumberType<uint32_t>(1024 + index).Text() + _T(",\"process\":\"") + callsign + _T("\"}");
+            }
+            return (result + _T("]}}"));
+        }
+
+        return (_T("{\"jsonrpc\":\"2.0\",\"method\":\"client.events.") + Core::NumberType<uint32_t>(sequence % 7).Text() + _T(".statechange\",\"params\":{\"callsign\":\"") + callsign + _T("\",\"state\":\"") + states[(sequence / 5) % 4] + _T("\",\"reason\":\"requested\",\"sequence\":") + Core::NumberType<uint32_t>(sequence).Text() + _T("}}"));
+    }
+
+    TEST(WebSocket_Deflate, Negotiation)
+    {
+        string response;
+
+        {
+            Web::WebSocket::Protocol server(false, false);
+            Web::WebSocket::Protocol client(false, true);
+
+            server.Compression(6, 0, 15, true);
+            client.Compression(6, 0, 15, true);
+
+            EXPECT_STREQ(client.Offer().c_str(), _T("permessage-deflate; client_max_window_bits"));
+            EXPECT_TRUE(Negotiate(server, client, response));
+            EXPECT_STREQ(response.c_str(), _T("permessage-deflate"));
+            EXPECT_TRUE(server.IsCompressed());
+            EXPECT_TRUE(client.IsCompressed());
+        }
+        {
+            // Smaller windows and no context takeover, to save memory, are asked for by both sides.
+            Web::WebSocket::Protocol server(false, false);
+            Web::WebSocket::Protocol client(false, true);
+
+            server.Compression(6, 0, 10, false);
+            client.Compression(6, 0, 12, true);
+
+            EXPECT_TRUE(Negotiate(server, client, response));
+            EXPECT_STREQ(response.c_str(), _T("permessage-deflate; server_no_context_takeover; client_no_context_takeover; server_max_window_bits=10; client_max_window_bits=10"));
+        }
+        {
+            // The window of a client that can not be limited, does not fit.
+            Web::WebSocket::Protocol server(false, false);
+
+            server.Compression(6, 0, 10, true);
+
+            EXPECT_FALSE(server.Accept(_T("permessage-deflate"), response));
+            EXPECT_FALSE(server.IsCompressed());
+        }
+        {
+            // Unknown extensions, parameters or invalid values are skipped, the next offer is taken.
+            Web::WebSocket::Protocol server(false, false);
+
+            server.Compression(6, 0, 15, true);
+
+            EXPECT_TRUE(server.Accept(_T("x-webkit-deflate-frame, permessage-deflate; unknown, permessage-deflate; server_max_window_bits=16, permessage-deflate; server_max_window_bits=8, PerMessage-Deflate; server_max_window_bits=\"11\"; client_max_window_bits"), response));
+            EXPECT_STREQ(response.c_str(), _T("permessage-deflate; server_max_window_bits=11"));
+        }
+        {
+            // Not configured, nothing offered nor accepted.
+            Web::WebSocket::Protocol server(false, false);
+            Web::WebSocket::Protocol client(false, true);
+
+            EXPECT_TRUE(client.Offer().empty());
+            EXPECT_FALSE(server.Accept(_T("permessage-deflate; client_max_window_bits"), response));
+            EXPECT_FALSE(client.Confirm(_T("permessage-deflate")));
+        }
+    }
+
+    TEST(WebSocket_Deflate, RoundTrip)
+    {
+        const bool takeovers[] = { true, false };
+
+        for (const bool takeover : takeovers) {
+            Web::WebSocket::Protocol server(false, false);
+            Web::WebSocket::Protocol client(false, true);
+            MessageSource source;
+            MessageSink sink;
+            string response;
+
+            server.Compression(6, 64, 15, takeover);
+            client.Compression(6, 64, 15, takeover);
+
+            ASSERT_TRUE(Negotiate(server, client, response));
+
+            std::vector<string> messages;
+            messages.push_back(_T("{\"id\":1}"));
+            messages.push_back(Event(1));
+            messages.push_back(Event(15));
+            messages.push_back(string(Web::WebSocket::PerMessageDeflate::BufferSize, 'x'));
+            messages.push_back(string(Web::WebSocket::PerMessageDeflate::BufferSize * 3 + 7, 'y'));
+            messages.push_back(Event(31) + Event(47));
+            messages.push_back(Event(2));
+
+            // Events from server to client, in frames that do not hold a message.
+            for (const string& message : messages) {
+                source.Add(message);
+            }
+            Transfer(server, source, client, sink, 256);
+
+            EXPECT_EQ(sink.Messages(), messages);
+            sink.Clear();
+
+            // Requests from the client, masked.
+            for (const string& message : messages) {
+                source.Add(message);
+            }
+            Transfer(client, source, server, sink, 1024);
+
+            EXPECT_EQ(sink.Messages(), messages);
+        }
+        {
+            // A compressed frame on a link that did not negotiate it, is a protocol violation.
+            Web::WebSocket::Protocol server(false, false);
+            Web::WebSocket::Protocol client(false, true);
+            MessageSource source;
+            uint8_t buffer[256];
+            string response;
+
+            server.Compression(6, 0, 15, true);
+            server.Accept(_T("permessage-deflate"), response);
+
+            source.Add(Event(3));
+            uint16_t size = server.Encoder(buffer, sizeof(buffer) - 4, server.Deflate(source, &(buffer[4]), sizeof(buffer) - 4));
+
+            EXPECT_EQ(buffer[0] & 0x40, 0x40);
+            client.Decoder(buffer, size);
+            EXPECT_EQ(client.FrameType(), Web::WebSocket::Protocol::VIOLATION);
+        }
+    }
+
+    TEST(WebSocket_Deflate, DISABLED_EventBenchmark)
+    {
+        static constexpr uint32_t Events = 20000;
+
+        MessageSource source;
+        MessageSink sink;
+        uint32_t raw = 0;
+
+        {
+            Web::WebSocket::Protocol server(false, false);
+            Web::WebSocket::Protocol client(false, true);
+
+            for (uint32_t index = 0; index < Events; index++) {
+                string event(Event(index));
+                raw += static_cast<uint32_t>(event.length());
+                source.Add(event);
+            }
+
+            uint64_t start = Core::Time::Now().Ticks();
+            uint32_t wire = Transfer(server, source, client, sink, 1024);
+            uint64_t duration = Core::Time::Now().Ticks() - start;
+
+            printf("Events uncompressed: %d bytes, %d on the wire in %d us\n", raw, wire, static_cast<uint32_t>(duration));
+
+            EXPECT_EQ(sink.Messages().size(), Events);
+            sink.Clear();
+        }
+
+        const bool takeovers[] = { true, false };
+
+        for (const bool takeover : takeovers) {
+            Web::WebSocket::Protocol server(false, false);
+            Web::WebSocket::Protocol client(false, true);
+            string response;
+
+            server.Compression(6, 0, 15, takeover);
+            client.Compression(6, 0, 15, takeover);
+            ASSERT_TRUE(Negotiate(server, client, response));
+
+            for (uint32_t index = 0; index < Events; index++) {
+                source.Add(Event(index));
+            }
+
+            uint64_t start = Core::Time::Now().Ticks();
+            uint32_t wire = Transfer(server, source, client, sink, 1024);
+            uint64_t duration = Core::Time::Now().Ticks() - start;
+
+            printf("Events compressed (context takeover %s): %d on the wire (%d%% saved) in %d us\n",
+                (takeover ? "on" : "off"), wire, static_cast<uint32_t>(100 - ((static_cast<uint64_t>(wire) * 100) / raw)), static_cast<uint32_t>(duration));
+
+            ASSERT_EQ(sink.Messages().size(), Events);
+            EXPECT_EQ(sink.Messages()[Events - 1], Event(Events - 1));
+            EXPECT_LT(wire, raw);
+            sink.Clear();
+        }
+    }
+
+} // Tests
+} // WPEFramework
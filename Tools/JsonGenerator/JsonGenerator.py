@@ -98,6 +98,7 @@ except:
 INDENT_SIZE = 4
 DOC_ISSUES = True
 ALWAYS_COPYCTOR = False
+STATIC_FIELDS = False
 KEEP_EMPTY = False
 CLASSNAME_FROM_REF = True
 DEFAULT_EMPTY_STRING = ""
@@ -1986,13 +1987,32 @@ def EmitObjects(root, emit, if_file, emitCommon=False):
             for prop in jsonObj.Properties():
                 emit.Line("Add(_T(\"%s\"), &%s);" % (prop.JsonName(), prop.CppName()))
 
+        def EmitFields(jsonObj):
+            # One table per class, the instances only keep a pointer to it
+            emit.Line("static const %s* Fields()" % TypePrefix("Container::Field"))
+            emit.Line("{")
+            emit.Indent()
+            emit.Line("static const %s fields[] = {" % TypePrefix("Container::Field"))
+            emit.Indent()
+            for prop in jsonObj.Properties():
+                emit.Line("{ _T(\"%s\"), &%s<%s, %s, &%s::%s> }," % (prop.JsonName(), TypePrefix("Container::Member"), jsonObj.CppClass(), prop.CppType(), jsonObj.CppClass(), prop.CppName()))
+            emit.Unindent()
+            emit.Line("};")
+            emit.Line()
+            emit.Line("return (fields);")
+            emit.Unindent()
+            emit.Line("}")
+
         def EmitCtor(jsonObj, noInitCode=False, copyCtor=False):
             if copyCtor:
                 emit.Line("%s(const %s& other)" % (jsonObj.CppClass(), jsonObj.CppClass()))
             else:
                 emit.Line("%s()" % (jsonObj.CppClass()))
             emit.Indent()
-            emit.Line(": %s" % TypePrefix("Container()"))
+            if STATIC_FIELDS:
+                emit.Line(": %s" % TypePrefix("Container(Fields(), %i)" % len(jsonObj.Properties())))
+            else:
+                emit.Line(": %s" % TypePrefix("Container()"))
             for prop in jsonObj.Properties():
                 if copyCtor:
                     emit.Line(", %s(other.%s)" % (prop.CppName(), prop.CppName()))
@@ -2001,7 +2021,9 @@ def EmitObjects(root, emit, if_file, emitCommon=False):
             emit.Unindent()
             emit.Line("{")
             emit.Indent()
-            if not noInitCode:
+            if STATIC_FIELDS:
+                pass
+            elif not noInitCode:
                 EmitInit(jsonObj)
             else:
                 emit.Line("Init();")
@@ -2055,15 +2077,24 @@ def EmitObjects(root, emit, if_file, emitCommon=False):
                 emit.Line()
                 emit.Line("private:")
                 emit.Indent()
-                emit.Line("void Init()")
-                emit.Line("{")
-                emit.Indent()
-                EmitInit(jsonObj)
-                emit.Unindent()
-                emit.Line("}")
+                if STATIC_FIELDS:
+                    EmitFields(jsonObj)
+                else:
+                    emit.Line("void Init()")
+                    emit.Line("{")
+                    emit.Indent()
+                    EmitInit(jsonObj)
+                    emit.Unindent()
+                    emit.Line("}")
             else:
                 emit.Line("%s(const %s&) = delete;" % (jsonObj.CppClass(), jsonObj.CppClass()))
                 emit.Line("%s& operator=(const %s&) = delete;" % (jsonObj.CppClass(), jsonObj.CppClass()))
+                if STATIC_FIELDS:
+                    emit.Unindent()
+                    emit.Line()
+                    emit.Line("private:")
+                    emit.Indent()
+                    EmitFields(jsonObj)
             emit.Line()
             emit.Unindent()
             emit.Line("public:")
@@ -2889,6 +2920,12 @@ if __name__ == "__main__":
         action="store_true",
         default=False,
         help="always emit a copy constructor and assignment operator for a class (default: emit only when needed)")
+    argparser.add_argument(
+        "--static-fields",
+        dest="static_fields",
+        action="store_true",
+        default=False,
+        help="describe class members in a static table instead of registering them for each instance (default: register for each instance)")
     argparser.add_argument("--keep-empty",
                            dest="keep_empty",
                            action="store_true",
@@ -2948,6 +2985,7 @@ if __name__ == "__main__":
     NO_DUP_WARNINGS = args.no_duplicates_warnings
     INDENT_SIZE = args.indent_size
     ALWAYS_COPYCTOR = args.copy_ctor
+    STATIC_FIELDS = args.static_fields
     KEEP_EMPTY = args.keep_empty
     CLASSNAME_FROM_REF = not args.no_ref_names
     DEFAULT_EMPTY_STRING = args.def_string